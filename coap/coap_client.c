@@ -313,6 +313,10 @@ error_t coapClientConnect(CoapClientContext *context,
          //Check status code
          if(error == NO_ERROR)
          {
+#if (COAP_CLIENT_COCOA_SUPPORT == ENABLED)
+            //Initialize RTT estimators
+            coapClientInitRto(context);
+#endif
             //Update CoAP client state
             context->state = COAP_CLIENT_STATE_CONNECTED;
          }
@@ -65,6 +65,13 @@
    #error COAP_CLIENT_BLOCK_SUPPORT parameter is not valid
 #endif
 
+//CoCoA congestion control support
+#ifndef COAP_CLIENT_COCOA_SUPPORT
+   #define COAP_CLIENT_COCOA_SUPPORT DISABLED
+#elif (COAP_CLIENT_COCOA_SUPPORT != ENABLED && COAP_CLIENT_COCOA_SUPPORT != DISABLED)
+   #error COAP_CLIENT_COCOA_SUPPORT parameter is not valid
+#endif
+
 //CoAP client tick interval
 #ifndef COAP_CLIENT_TICK_INTERVAL
    #define COAP_CLIENT_TICK_INTERVAL 100
@@ -86,6 +93,13 @@
    #error COAP_CLIENT_NSTART parameter is not valid
 #endif
 
+//Maximum number of simultaneous CoAP requests
+#ifndef COAP_CLIENT_MAX_REQUESTS
+   #define COAP_CLIENT_MAX_REQUESTS COAP_CLIENT_NSTART
+#elif (COAP_CLIENT_MAX_REQUESTS < COAP_CLIENT_NSTART)
+   #error COAP_CLIENT_MAX_REQUESTS parameter is not valid
+#endif
+
 //Maximum number of retransmissions
 #ifndef COAP_CLIENT_MAX_RETRANSMIT
    #define COAP_CLIENT_MAX_RETRANSMIT 4
@@ -107,6 +121,13 @@
    #error COAP_CLIENT_ACK_TIMEOUT_MAX parameter is not valid
 #endif
 
+//Upper limit for the retransmission timeout
+#ifndef COAP_CLIENT_MAX_RTO
+   #define COAP_CLIENT_MAX_RTO 60000
+#elif (COAP_CLIENT_MAX_RTO < COAP_CLIENT_ACK_TIMEOUT_MAX)
+   #error COAP_CLIENT_MAX_RTO parameter is not valid
+#endif
+
 //Random delay after Max-Age has expired (minimum)
 #ifndef COAP_CLIENT_RAND_DELAY_MIN
    #define COAP_CLIENT_RAND_DELAY_MIN 5000
@@ -181,31 +202,50 @@ typedef error_t (*CoapClientDtlsInitCallback)(CoapClientContext *context,
 #endif
 
 
+/**
+ * @brief RTT estimator
+ **/
+
+typedef struct
+{
+   bool_t valid;     ///<The estimator has been initialized
+   systime_t srtt;   ///<Smoothed round-trip time
+   systime_t rttvar; ///<Round-trip time variation
+   systime_t rto;    ///<Retransmission timeout computed by the estimator
+} CoapClientRttEstimator;
+
+
 /**
  * @brief CoAP client context
  **/
 
 struct _CoapClientContext
 {
-   OsMutex mutex;                                 ///<Mutex preventing simultaneous access to the context
-   OsEvent event;                                 ///<Event object used to receive notifications
-   CoapClientState state;                         ///<CoAP client state
-   CoapTransportProtocol transportProtocol;       ///<Transport protocol (UDP or DTLS)
-   NetContext *netContext;                        ///<TCP/IP stack context
-   NetInterface *interface;                       ///<Underlying network interface
-   Socket *socket;                                ///<Underlying UDP socket
+   OsMutex mutex;                                       ///<Mutex preventing simultaneous access to the context
+   OsEvent event;                                       ///<Event object used to receive notifications
+   CoapClientState state;                               ///<CoAP client state
+   CoapTransportProtocol transportProtocol;             ///<Transport protocol (UDP or DTLS)
+   NetContext *netContext;                              ///<TCP/IP stack context
+   NetInterface *interface;                             ///<Underlying network interface
+   Socket *socket;                                      ///<Underlying UDP socket
 #if (COAP_CLIENT_DTLS_SUPPORT == ENABLED)
-   TlsContext *dtlsContext;                       ///<DTLS context
-   TlsSessionState dtlsSession;                   ///<DTLS session state
-   CoapClientDtlsInitCallback dtlsInitCallback;   ///<DTLS initialization callback
-#endif
-   systime_t startTime;                           ///<Start time
-   systime_t timeout;                             ///<Timeout value
-   uint16_t mid;                                  ///<Message identifier
-   size_t tokenLen;                               ///<Token length
-   CoapClientRequest request[COAP_CLIENT_NSTART]; ///<Outstanding CoAP requests
-   CoapMessage response;                          ///<CoAP response message
-   COAP_CLIENT_PRIVATE_CONTEXT                    ///<Application specific context
+   TlsContext *dtlsContext;                             ///<DTLS context
+   TlsSessionState dtlsSession;                         ///<DTLS session state
+   CoapClientDtlsInitCallback dtlsInitCallback;         ///<DTLS initialization callback
+#endif
+   systime_t startTime;                                 ///<Start time
+   systime_t timeout;                                   ///<Timeout value
+   uint16_t mid;                                        ///<Message identifier
+   size_t tokenLen;                                     ///<Token length
+   CoapClientRequest request[COAP_CLIENT_MAX_REQUESTS]; ///<Outstanding CoAP requests
+#if (COAP_CLIENT_COCOA_SUPPORT == ENABLED)
+   CoapClientRttEstimator strongEstimator;              ///<Strong RTT estimator
+   CoapClientRttEstimator weakEstimator;                ///<Weak RTT estimator
+   systime_t rto;                                       ///<Overall retransmission timeout
+   systime_t rtoTimestamp;                              ///<Time at which the overall RTO was last updated
+#endif
+   CoapMessage response;                                ///<CoAP response message
+   COAP_CLIENT_PRIVATE_CONTEXT                          ///<Application specific context
 };
 
 
@@ -119,7 +119,7 @@ error_t coapClientProcessEvents(CoapClientContext *context, systime_t timeout)
                context->response.length);
 
             //Try to match the response with an outstanding request
-            for(i = 0; i < COAP_CLIENT_NSTART; i++)
+            for(i = 0; i < COAP_CLIENT_MAX_REQUESTS; i++)
             {
                //Apply request/response matching rules
                error = coapClientMatchResponse(&context->request[i],
@@ -169,7 +169,7 @@ error_t coapClientProcessEvents(CoapClientContext *context, systime_t timeout)
       if(error == NO_ERROR)
       {
          //Process request-specific events
-         for(i = 0; i < COAP_CLIENT_NSTART; i++)
+         for(i = 0; i < COAP_CLIENT_MAX_REQUESTS; i++)
          {
             //Manage retransmission for the current request
             error = coapClientProcessRequestEvents(&context->request[i]);
@@ -216,41 +216,61 @@ error_t coapClientProcessRequestEvents(CoapClientRequest *request)
    //Check current state
    if(request->state == COAP_REQ_STATE_TRANSMIT)
    {
-      //Debug message
-      TRACE_INFO("Sending CoAP message (%" PRIuSIZE " bytes)...\r\n",
-         request->message.length);
-
-      //Dump the contents of the message for debugging purpose
-      coapDumpMessage(request->message.buffer, request->message.length);
-
-      //Send CoAP request
-      error = coapClientSendDatagram(context, request->message.buffer,
-         request->message.length);
-
-      //Save the time at which the message was sent
-      request->retransmitStartTime = osGetSystemTime();
-
-      //Check retransmission counter
-      if(request->retransmitCount == 0)
+      //The number of simultaneous outstanding interactions with the server
+      //is limited to NSTART (refer to RFC 7252, section 4.7)
+      if(request->retransmitCount == 0 &&
+         coapClientGetOutstandingRequests(context) >= COAP_CLIENT_NSTART)
       {
-         //Save request start time
-         request->startTime = request->retransmitStartTime;
-
-         //The initial timeout is set to a random duration
-         request->retransmitTimeout = netGetRandRange(request->context->netContext,
-            COAP_CLIENT_ACK_TIMEOUT_MIN, COAP_CLIENT_ACK_TIMEOUT_MAX);
+         //Defer the transmission until an outstanding interaction completes
       }
       else
       {
-         //The timeout is doubled
-         request->retransmitTimeout *= 2;
-      }
+         //Debug message
+         TRACE_INFO("Sending CoAP message (%" PRIuSIZE " bytes)...\r\n",
+            request->message.length);
+
+         //Dump the contents of the message for debugging purpose
+         coapDumpMessage(request->message.buffer, request->message.length);
+
+         //Send CoAP request
+         error = coapClientSendDatagram(context, request->message.buffer,
+            request->message.length);
 
-      //Increment retransmission counter
-      request->retransmitCount++;
+         //Save the time at which the message was sent
+         request->retransmitStartTime = osGetSystemTime();
 
-      //Wait for a response to be received
-      coapClientChangeRequestState(request, COAP_REQ_STATE_RECEIVE);
+         //Check retransmission counter
+         if(request->retransmitCount == 0)
+         {
+            //Save request start time
+            request->startTime = request->retransmitStartTime;
+
+#if (COAP_CLIENT_COCOA_SUPPORT == ENABLED)
+            //The initial timeout is derived from the RTO estimate
+            request->retransmitTimeout = coapClientGetInitialTimeout(request);
+#else
+            //The initial timeout is set to a random duration
+            request->retransmitTimeout = netGetRandRange(request->context->netContext,
+               COAP_CLIENT_ACK_TIMEOUT_MIN, COAP_CLIENT_ACK_TIMEOUT_MAX);
+#endif
+         }
+         else
+         {
+#if (COAP_CLIENT_COCOA_SUPPORT == ENABLED)
+            //The timeout is multiplied by a variable backoff factor
+            request->retransmitTimeout = coapClientGetBackoffTimeout(request);
+#else
+            //The timeout is doubled
+            request->retransmitTimeout *= 2;
+#endif
+         }
+
+         //Increment retransmission counter
+         request->retransmitCount++;
+
+         //Wait for a response to be received
+         coapClientChangeRequestState(request, COAP_REQ_STATE_RECEIVE);
+      }
    }
    else if(request->state == COAP_REQ_STATE_RECEIVE)
    {
@@ -422,6 +442,243 @@ error_t coapClientChangeRequestState(CoapClientRequest *request,
 }
 
 
+/**
+ * @brief Get the number of outstanding interactions
+ * @param[in] context Pointer to the CoAP client context
+ * @return Number of requests waiting for an acknowledgement or a response
+ **/
+
+uint_t coapClientGetOutstandingRequests(CoapClientContext *context)
+{
+   uint_t i;
+   uint_t n;
+
+   //Initialize counter
+   n = 0;
+
+   //Loop through the CoAP request table
+   for(i = 0; i < COAP_CLIENT_MAX_REQUESTS; i++)
+   {
+      //An outstanding interaction is a request for which neither an
+      //acknowledgement nor a response has been received yet
+      if(context->request[i].state == COAP_REQ_STATE_RECEIVE)
+      {
+         n++;
+      }
+   }
+
+   //Return the number of outstanding interactions
+   return n;
+}
+
+
+#if (COAP_CLIENT_COCOA_SUPPORT == ENABLED)
+
+/**
+ * @brief Initialize RTT estimators
+ * @param[in] context Pointer to the CoAP client context
+ **/
+
+void coapClientInitRto(CoapClientContext *context)
+{
+   //The RTT estimators are specific to the destination endpoint
+   osMemset(&context->strongEstimator, 0, sizeof(CoapClientRttEstimator));
+   osMemset(&context->weakEstimator, 0, sizeof(CoapClientRttEstimator));
+
+   //Until an RTT measurement is available, the initial RTO is used
+   context->rto = COAP_CLIENT_ACK_TIMEOUT_MIN;
+   context->rtoTimestamp = osGetSystemTime();
+}
+
+
+/**
+ * @brief Update RTO estimate
+ * @param[in] request CoAP request handle
+ **/
+
+void coapClientUpdateRto(CoapClientRequest *request)
+{
+   systime_t rtt;
+   CoapClientContext *context;
+   const CoapMessageHeader *header;
+
+   //Point to the CoAP client context
+   context = request->context;
+   //Point to the CoAP request header
+   header = (CoapMessageHeader *) request->message.buffer;
+
+   //RTT measurements are only available for confirmable requests
+   if(header->type != COAP_TYPE_CON)
+      return;
+
+   //The RTT is measured from the first transmission of the request
+   rtt = osGetSystemTime() - request->startTime;
+
+   //Check the number of transmissions
+   if(request->retransmitCount <= 1)
+   {
+      //The strong estimator is updated when the acknowledgement is received
+      //for the original transmission (K = 4)
+      coapClientUpdateRttEstimator(&context->strongEstimator, rtt, 4);
+
+      //RTO := 0.5 * E_strong + 0.5 * RTO
+      context->rto = (context->strongEstimator.rto + context->rto) / 2;
+   }
+   else if(request->retransmitCount <= 3)
+   {
+      //The weak estimator is updated when the acknowledgement is received
+      //after one or two retransmissions (K = 1)
+      coapClientUpdateRttEstimator(&context->weakEstimator, rtt, 1);
+
+      //RTO := 0.25 * E_weak + 0.75 * RTO
+      context->rto = (context->weakEstimator.rto + 3 * context->rto) / 4;
+   }
+   else
+   {
+      //RTT measurements of exchanges that required more than two
+      //retransmissions are not taken into account
+      return;
+   }
+
+   //Limit the RTO
+   context->rto = MIN(context->rto, COAP_CLIENT_MAX_RTO);
+   //Save the time at which the RTO was updated
+   context->rtoTimestamp = osGetSystemTime();
+
+   //Debug message
+   TRACE_DEBUG("CoAP RTT = %" PRIu32 " ms, RTO = %" PRIu32 " ms\r\n",
+      (uint32_t) rtt, (uint32_t) context->rto);
+}
+
+
+/**
+ * @brief Update RTT estimator with a new measurement
+ * @param[in] estimator Pointer to the RTT estimator
+ * @param[in] rtt Round-trip time, in milliseconds
+ * @param[in] k Weight of the RTT variation
+ **/
+
+void coapClientUpdateRttEstimator(CoapClientRttEstimator *estimator,
+   systime_t rtt, uint_t k)
+{
+   systime_t delta;
+
+   //First RTT measurement?
+   if(!estimator->valid)
+   {
+      //SRTT := R, RTTVAR := R / 2
+      estimator->srtt = rtt;
+      estimator->rttvar = rtt / 2;
+      estimator->valid = TRUE;
+   }
+   else
+   {
+      //Compute |SRTT - R|
+      if(estimator->srtt > rtt)
+      {
+         delta = estimator->srtt - rtt;
+      }
+      else
+      {
+         delta = rtt - estimator->srtt;
+      }
+
+      //RTTVAR := (1 - 1/4) * RTTVAR + 1/4 * |SRTT - R|
+      estimator->rttvar = (3 * estimator->rttvar + delta) / 4;
+      //SRTT := (1 - 1/8) * SRTT + 1/8 * R
+      estimator->srtt = (7 * estimator->srtt + rtt) / 8;
+   }
+
+   //RTO := SRTT + max(G, K * RTTVAR)
+   estimator->rto = estimator->srtt + MAX(COAP_CLIENT_TICK_INTERVAL,
+      k * estimator->rttvar);
+}
+
+
+/**
+ * @brief Get the initial timeout of a new exchange
+ * @param[in] request CoAP request handle
+ * @return Initial timeout, in milliseconds
+ **/
+
+systime_t coapClientGetInitialTimeout(CoapClientRequest *request)
+{
+   systime_t time;
+   CoapClientContext *context;
+
+   //Point to the CoAP client context
+   context = request->context;
+   //Get current time
+   time = osGetSystemTime();
+
+   //An RTO estimate that is not updated for a long time is aged so that it
+   //converges towards the default value
+   if(context->rto < 1000)
+   {
+      //A small RTO is doubled if it has not been updated for 16 * RTO
+      if(timeCompare(time, context->rtoTimestamp + 16 * context->rto) >= 0)
+      {
+         context->rto *= 2;
+         context->rtoTimestamp = time;
+      }
+   }
+   else if(context->rto > 3000)
+   {
+      //A large RTO converges to 2 seconds if it has not been updated for
+      //4 * RTO
+      if(timeCompare(time, context->rtoTimestamp + 4 * context->rto) >= 0)
+      {
+         context->rto = (context->rto + 2000) / 2;
+         context->rtoTimestamp = time;
+      }
+   }
+   else
+   {
+      //No aging
+   }
+
+   //Save the RTO at the time the exchange starts
+   request->rto = context->rto;
+
+   //The initial timeout is dithered between RTO and 1.5 * RTO
+   return netGetRandRange(context->netContext, request->rto,
+      request->rto + request->rto / 2);
+}
+
+
+/**
+ * @brief Get the timeout of the next retransmission
+ * @param[in] request CoAP request handle
+ * @return Retransmission timeout, in milliseconds
+ **/
+
+systime_t coapClientGetBackoffTimeout(CoapClientRequest *request)
+{
+   systime_t timeout;
+
+   //The variable backoff factor depends on the RTO at the time the exchange
+   //started, so that small RTOs back off faster and large RTOs back off
+   //slower than the default factor of 2
+   if(request->rto < 1000)
+   {
+      timeout = request->retransmitTimeout * 3;
+   }
+   else if(request->rto > 3000)
+   {
+      timeout = request->retransmitTimeout + request->retransmitTimeout / 2;
+   }
+   else
+   {
+      timeout = request->retransmitTimeout * 2;
+   }
+
+   //Limit the retransmission timeout
+   return MIN(timeout, COAP_CLIENT_MAX_RTO);
+}
+
+#endif
+
+
 /**
  * @brief Check whether a response matches the specified request
  * @param[in] request CoAP request handle
@@ -579,6 +836,15 @@ error_t coapClientProcessResponse(CoapClientRequest *request,
    //Point to CoAP response header
    header = (CoapMessageHeader *) response->buffer;
 
+#if (COAP_CLIENT_COCOA_SUPPORT == ENABLED)
+   //Response to an outstanding request?
+   if(request->state == COAP_REQ_STATE_RECEIVE)
+   {
+      //Update the RTO estimate
+      coapClientUpdateRto(request);
+   }
+#endif
+
    //Confirmable response received?
    if(header->type == COAP_TYPE_CON)
    {
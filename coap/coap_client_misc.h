@@ -47,6 +47,17 @@ error_t coapClientProcessRequestEvents(CoapClientRequest *request);
 error_t coapClientChangeRequestState(CoapClientRequest *request,
    CoapRequestState newState);
 
+uint_t coapClientGetOutstandingRequests(CoapClientContext *context);
+
+void coapClientInitRto(CoapClientContext *context);
+void coapClientUpdateRto(CoapClientRequest *request);
+
+void coapClientUpdateRttEstimator(CoapClientRttEstimator *estimator,
+   systime_t rtt, uint_t k);
+
+systime_t coapClientGetInitialTimeout(CoapClientRequest *request);
+systime_t coapClientGetBackoffTimeout(CoapClientRequest *request);
+
 error_t coapClientMatchResponse(const CoapClientRequest *request,
    const CoapMessage *response);
 
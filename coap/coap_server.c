@@ -128,6 +128,11 @@ error_t coapServerInit(CoapServerContext *context,
 #endif
    context->requestCallback = settings->requestCallback;
 
+#if (COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+   //Initialize message ID of notifications
+   context->mid = (uint16_t) netGetRand(context->netContext);
+#endif
+
    //Create an event object to poll the state of the UDP socket
    if(!osCreateEvent(&context->event))
    {
@@ -183,6 +188,54 @@ error_t coapServerSetCookieSecret(CoapServerContext *context,
 }
 
 
+/**
+ * @brief Notify observers of a change in the state of a resource
+ *
+ * This function marks the specified resource as changed. Notifications are
+ * then sent by the CoAP server task to all the clients observing the resource
+ *
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] uri NULL-terminated string that contains the resource identifier
+ * @return Error code
+ **/
+
+error_t coapServerNotifyObservers(CoapServerContext *context,
+   const char_t *uri)
+{
+#if (COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+   uint_t i;
+   CoapServerObserver *observer;
+
+   //Ensure the parameters are valid
+   if(context == NULL || uri == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Loop through the list of observers
+   for(i = 0; i < COAP_SERVER_MAX_OBSERVERS; i++)
+   {
+      //Point to the current entry
+      observer = &context->observer[i];
+
+      //Matching resource?
+      if(observer->valid && !osStrcmp(observer->uri, uri))
+      {
+         //A notification will be sent by the CoAP server task
+         observer->changed = TRUE;
+      }
+   }
+
+   //Send a signal to the task so that notifications are sent without delay
+   osSetEvent(&context->event);
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief Start CoAP server
  * @param[in] context Pointer to the CoAP server context
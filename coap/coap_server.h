@@ -51,6 +51,27 @@
    #error COAP_SERVER_DTLS_SUPPORT parameter is not valid
 #endif
 
+//Block-wise transfer support
+#ifndef COAP_SERVER_BLOCK_SUPPORT
+   #define COAP_SERVER_BLOCK_SUPPORT DISABLED
+#elif (COAP_SERVER_BLOCK_SUPPORT != ENABLED && COAP_SERVER_BLOCK_SUPPORT != DISABLED)
+   #error COAP_SERVER_BLOCK_SUPPORT parameter is not valid
+#endif
+
+//Resource observation support
+#ifndef COAP_SERVER_OBSERVE_SUPPORT
+   #define COAP_SERVER_OBSERVE_SUPPORT DISABLED
+#elif (COAP_SERVER_OBSERVE_SUPPORT != ENABLED && COAP_SERVER_OBSERVE_SUPPORT != DISABLED)
+   #error COAP_SERVER_OBSERVE_SUPPORT parameter is not valid
+#endif
+
+//Message deduplication and response cache support
+#ifndef COAP_SERVER_CACHE_SUPPORT
+   #define COAP_SERVER_CACHE_SUPPORT DISABLED
+#elif (COAP_SERVER_CACHE_SUPPORT != ENABLED && COAP_SERVER_CACHE_SUPPORT != DISABLED)
+   #error COAP_SERVER_CACHE_SUPPORT parameter is not valid
+#endif
+
 //Stack size required to run the CoAP server
 #ifndef COAP_SERVER_STACK_SIZE
    #define COAP_SERVER_STACK_SIZE 650
@@ -100,6 +121,113 @@
    #error COAP_SERVER_MAX_URI_LEN parameter is not valid
 #endif
 
+//Size of the message deduplication table
+#ifndef COAP_SERVER_CACHE_SIZE
+   #define COAP_SERVER_CACHE_SIZE 8
+#elif (COAP_SERVER_CACHE_SIZE < 1)
+   #error COAP_SERVER_CACHE_SIZE parameter is not valid
+#endif
+
+//Number of hash buckets of the message deduplication table
+#ifndef COAP_SERVER_CACHE_NUM_BUCKETS
+   #define COAP_SERVER_CACHE_NUM_BUCKETS 8
+#elif (COAP_SERVER_CACHE_NUM_BUCKETS < 1)
+   #error COAP_SERVER_CACHE_NUM_BUCKETS parameter is not valid
+#endif
+
+//Time from starting to send a confirmable message to the time when an
+//acknowledgement is no longer expected (EXCHANGE_LIFETIME)
+#ifndef COAP_SERVER_EXCHANGE_LIFETIME
+   #define COAP_SERVER_EXCHANGE_LIFETIME 247000
+#elif (COAP_SERVER_EXCHANGE_LIFETIME < 1000)
+   #error COAP_SERVER_EXCHANGE_LIFETIME parameter is not valid
+#endif
+
+//Time from sending a non-confirmable message to the time its message ID
+//can be safely reused (NON_LIFETIME)
+#ifndef COAP_SERVER_NON_LIFETIME
+   #define COAP_SERVER_NON_LIFETIME 145000
+#elif (COAP_SERVER_NON_LIFETIME < 1000)
+   #error COAP_SERVER_NON_LIFETIME parameter is not valid
+#endif
+
+//Maximum number of simultaneous block-wise transfers
+#ifndef COAP_SERVER_MAX_BLOCK_TRANSFERS
+   #define COAP_SERVER_MAX_BLOCK_TRANSFERS 2
+#elif (COAP_SERVER_MAX_BLOCK_TRANSFERS < 1)
+   #error COAP_SERVER_MAX_BLOCK_TRANSFERS parameter is not valid
+#endif
+
+//Maximum size of request and response bodies
+#ifndef COAP_SERVER_MAX_BODY_SIZE
+   #define COAP_SERVER_MAX_BODY_SIZE 4096
+#elif (COAP_SERVER_MAX_BODY_SIZE < 16)
+   #error COAP_SERVER_MAX_BODY_SIZE parameter is not valid
+#endif
+
+//Block-wise transfer timeout
+#ifndef COAP_SERVER_BLOCK_TIMEOUT
+   #define COAP_SERVER_BLOCK_TIMEOUT 60000
+#elif (COAP_SERVER_BLOCK_TIMEOUT < 1000)
+   #error COAP_SERVER_BLOCK_TIMEOUT parameter is not valid
+#endif
+
+//Maximum number of observers
+#ifndef COAP_SERVER_MAX_OBSERVERS
+   #define COAP_SERVER_MAX_OBSERVERS 4
+#elif (COAP_SERVER_MAX_OBSERVERS < 1)
+   #error COAP_SERVER_MAX_OBSERVERS parameter is not valid
+#endif
+
+//Maximum number of retransmissions of confirmable notifications
+#ifndef COAP_SERVER_MAX_RETRANSMIT
+   #define COAP_SERVER_MAX_RETRANSMIT 4
+#elif (COAP_SERVER_MAX_RETRANSMIT < 1)
+   #error COAP_SERVER_MAX_RETRANSMIT parameter is not valid
+#endif
+
+//Minimum initial timeout for confirmable notifications
+#ifndef COAP_SERVER_ACK_TIMEOUT_MIN
+   #define COAP_SERVER_ACK_TIMEOUT_MIN 2000
+#elif (COAP_SERVER_ACK_TIMEOUT_MIN < 1000)
+   #error COAP_SERVER_ACK_TIMEOUT_MIN parameter is not valid
+#endif
+
+//Maximum initial timeout for confirmable notifications
+#ifndef COAP_SERVER_ACK_TIMEOUT_MAX
+   #define COAP_SERVER_ACK_TIMEOUT_MAX 3000
+#elif (COAP_SERVER_ACK_TIMEOUT_MAX < COAP_SERVER_ACK_TIMEOUT_MIN)
+   #error COAP_SERVER_ACK_TIMEOUT_MAX parameter is not valid
+#endif
+
+//Minimum interval between two non-confirmable notifications
+#ifndef COAP_SERVER_NON_NOTIFICATION_INTERVAL
+   #define COAP_SERVER_NON_NOTIFICATION_INTERVAL 3000
+#elif (COAP_SERVER_NON_NOTIFICATION_INTERVAL < 0)
+   #error COAP_SERVER_NON_NOTIFICATION_INTERVAL parameter is not valid
+#endif
+
+//Maximum number of consecutive non-confirmable notifications
+#ifndef COAP_SERVER_MAX_NON_NOTIFICATIONS
+   #define COAP_SERVER_MAX_NON_NOTIFICATIONS 16
+#elif (COAP_SERVER_MAX_NON_NOTIFICATIONS < 0)
+   #error COAP_SERVER_MAX_NON_NOTIFICATIONS parameter is not valid
+#endif
+
+//Maximum number of consecutive notifications that cannot be sent
+#ifndef COAP_SERVER_MAX_NOTIFICATION_ERRORS
+   #define COAP_SERVER_MAX_NOTIFICATION_ERRORS 3
+#elif (COAP_SERVER_MAX_NOTIFICATION_ERRORS < 1)
+   #error COAP_SERVER_MAX_NOTIFICATION_ERRORS parameter is not valid
+#endif
+
+//Maximum interval between two confirmable notifications
+#ifndef COAP_SERVER_CON_NOTIFICATION_INTERVAL
+   #define COAP_SERVER_CON_NOTIFICATION_INTERVAL 86400000
+#elif (COAP_SERVER_CON_NOTIFICATION_INTERVAL < 1000)
+   #error COAP_SERVER_CON_NOTIFICATION_INTERVAL parameter is not valid
+#endif
+
 //Priority at which the CoAP server should run
 #ifndef COAP_SERVER_PRIORITY
    #define COAP_SERVER_PRIORITY OS_TASK_PRIORITY_NORMAL
@@ -124,6 +252,10 @@ struct _CoapServerContext;
 struct _CoapDtlsSession;
 #define CoapDtlsSession struct _CoapDtlsSession
 
+//Forward declaration of CoapServerCacheEntry structure
+struct _CoapServerCacheEntry;
+#define CoapServerCacheEntry struct _CoapServerCacheEntry
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -194,6 +326,84 @@ struct _CoapDtlsSession
 };
 
 
+/**
+ * @brief Message deduplication table entry
+ **/
+
+struct _CoapServerCacheEntry
+{
+   bool_t valid;                           ///<Valid entry
+   uint32_t hash;                          ///<Hash value of the (endpoint, message ID) pair
+   CoapServerCacheEntry *next;             ///<Next entry in the same hash bucket
+   IpAddr clientIpAddr;                    ///<Client's IP address
+   uint16_t clientPort;                    ///<Client's port
+   uint16_t mid;                           ///<Message ID of the request
+   CoapMessageType type;                   ///<Message type of the request
+   systime_t timestamp;                    ///<Time at which the request was received
+   uint8_t response[COAP_MAX_MSG_SIZE];    ///<Response to the request
+   size_t responseLen;                     ///<Length of the response, in bytes
+};
+
+
+/**
+ * @brief Block-wise transfer state
+ **/
+
+typedef enum
+{
+   COAP_SERVER_BLOCK_STATE_UNUSED    = 0, ///<Free entry
+   COAP_SERVER_BLOCK_STATE_RECEIVING = 1, ///<Request body reassembly in progress
+   COAP_SERVER_BLOCK_STATE_RECEIVED  = 2, ///<Request body fully reassembled
+   COAP_SERVER_BLOCK_STATE_SENDING   = 3  ///<Response body segmentation in progress
+} CoapServerBlockState;
+
+
+/**
+ * @brief Block-wise transfer
+ **/
+
+typedef struct
+{
+   CoapServerBlockState state;                ///<State of the block-wise transfer
+   IpAddr clientIpAddr;                       ///<Client's IP address
+   uint16_t clientPort;                       ///<Client's port
+   CoapCode method;                           ///<Request method
+   char_t uri[COAP_SERVER_MAX_URI_LEN + 1];   ///<Resource identifier
+   uint32_t block1;                           ///<Value of the last Block1 option
+   uint8_t body[COAP_SERVER_MAX_BODY_SIZE];   ///<Request or response body
+   size_t bodyLen;                            ///<Length of the body, in bytes
+   size_t bodyPos;                            ///<Current read position
+   systime_t timestamp;                       ///<Time of the last exchange
+} CoapServerBlockTransfer;
+
+
+/**
+ * @brief Observer
+ **/
+
+typedef struct
+{
+   bool_t valid;                              ///<Valid entry
+   IpAddr serverIpAddr;                       ///<Server's IP address
+   IpAddr clientIpAddr;                       ///<Client's IP address
+   uint16_t clientPort;                       ///<Client's port
+   uint8_t token[COAP_MAX_TOKEN_LEN];         ///<Token of the registration request
+   size_t tokenLen;                           ///<Length of the token, in bytes
+   char_t uri[COAP_SERVER_MAX_URI_LEN + 1];   ///<Resource identifier
+   uint32_t seqNum;                           ///<Sequence number of the last notification
+   bool_t changed;                            ///<The state of the resource has changed
+   uint16_t mid;                              ///<Message ID of the last notification
+   bool_t ackPending;                         ///<Confirmable notification in progress
+   uint_t retransmitCount;                    ///<Retransmission counter
+   systime_t retransmitStartTime;             ///<Time at which the last confirmable notification was sent
+   systime_t retransmitTimeout;               ///<Retransmission timeout
+   uint_t nonCount;                           ///<Number of consecutive non-confirmable notifications
+   uint_t errorCount;                         ///<Number of consecutive notifications that cannot be sent
+   systime_t conTimestamp;                    ///<Time of the last confirmable notification
+   systime_t timestamp;                       ///<Time of the last notification
+} CoapServerObserver;
+
+
 /**
  * @brief CoAP server context
  **/
@@ -227,6 +437,20 @@ struct _CoapServerContext
    char_t uri[COAP_SERVER_MAX_URI_LEN + 1];                  ///<Resource identifier
    CoapMessage request;                                      ///<CoAP request message
    CoapMessage response;                                     ///<CoAP response message
+#if (COAP_SERVER_CACHE_SUPPORT == ENABLED)
+   CoapServerCacheEntry cache[COAP_SERVER_CACHE_SIZE];       ///<Message deduplication table
+   CoapServerCacheEntry *cacheBuckets[COAP_SERVER_CACHE_NUM_BUCKETS]; ///<Hash buckets of the deduplication table
+#endif
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   CoapServerBlockTransfer blockTransfer[COAP_SERVER_MAX_BLOCK_TRANSFERS]; ///<Block-wise transfers
+   CoapServerBlockTransfer *transfer;                        ///<Block-wise transfer attached to the current request
+   uint8_t body[COAP_SERVER_MAX_BODY_SIZE];                  ///<Response body
+   size_t bodyLen;                                           ///<Length of the response body, in bytes
+#endif
+#if (COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+   CoapServerObserver observer[COAP_SERVER_MAX_OBSERVERS];   ///<List of observers
+   uint16_t mid;                                             ///<Message ID of notifications
+#endif
    COAP_SERVER_PRIVATE_CONTEXT                               ///<Application specific context
 };
 
@@ -240,6 +464,9 @@ error_t coapServerInit(CoapServerContext *context,
 error_t coapServerSetCookieSecret(CoapServerContext *context,
    const uint8_t *cookieSecret, size_t cookieSecretLen);
 
+error_t coapServerNotifyObservers(CoapServerContext *context,
+   const char_t *uri);
+
 error_t coapServerStart(CoapServerContext *context);
 error_t coapServerStop(CoapServerContext *context);
 
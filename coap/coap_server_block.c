@@ -0,0 +1,650 @@
+/**
+ * @file coap_server_block.c
+ * @brief CoAP server block-wise transfer
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL COAP_TRACE_LEVEL
+
+//Dependencies
+#include "core/net.h"
+#include "coap/coap_server.h"
+#include "coap/coap_server_block.h"
+#include "debug.h"
+
+//Check TCP/IP stack configuration
+#if (COAP_SERVER_SUPPORT == ENABLED && COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Process Block1 and Block2 options of an incoming request
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @param[out] done This flag is set if the response has already been formatted
+ *   and the request callback must not be invoked
+ * @return Error code
+ **/
+
+error_t coapServerProcessBlockRequest(CoapServerContext *context,
+   CoapCode method, bool_t *done)
+{
+   error_t error;
+   bool_t more;
+   uint32_t value;
+   CoapServerBlockTransfer *transfer;
+
+   //Initialize flags
+   *done = FALSE;
+   more = FALSE;
+
+   //Reset the response body
+   context->transfer = NULL;
+   context->bodyLen = 0;
+
+   //Search the CoAP request for a Block1 option
+   error = coapGetUintOption(&context->request, COAP_OPT_BLOCK1, 0, &value);
+
+   //Block1 option found?
+   if(!error)
+   {
+      //The request payload is a block of a larger body
+      error = coapServerReceiveBlock(context, method, value, done);
+   }
+   else
+   {
+      //Search the CoAP request for a Block2 option
+      error = coapGetUintOption(&context->request, COAP_OPT_BLOCK2, 0, &value);
+
+      //Request for a subsequent block of the response body?
+      if(!error && COAP_GET_BLOCK_NUM(value) > 0)
+      {
+         //Search for the representation that was generated when the first
+         //block was requested
+         transfer = coapServerFindBlockTransfer(context, method,
+            COAP_SERVER_BLOCK_STATE_SENDING);
+
+         //Any cached representation?
+         if(transfer != NULL)
+         {
+            //The server has the option of serving the subsequent blocks from
+            //the representation it generated for the first block, which
+            //guarantees a consistent body (refer to RFC 7959, section 2.4)
+            error = coapSetCode(&context->response, COAP_CODE_CONTENT);
+
+            //Check status code
+            if(!error)
+            {
+               //Format the requested block
+               error = coapServerWriteBlock(context, transfer->body,
+                  transfer->bodyLen, value, &more);
+            }
+
+            //Last block?
+            if(!more)
+            {
+               //The block-wise transfer is complete
+               transfer->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+            }
+            else
+            {
+               //Save the time of the last exchange
+               transfer->timestamp = osGetSystemTime();
+            }
+
+            //The response has been formatted
+            *done = TRUE;
+         }
+         else
+         {
+            //The representation will be regenerated by the request callback
+            error = NO_ERROR;
+         }
+      }
+      else
+      {
+         //The request is not part of a block-wise transfer
+         error = NO_ERROR;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Process a block of the request body (Block1 option)
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @param[in] value Value of the Block1 option
+ * @param[out] done This flag is set if the response has already been formatted
+ *   and the request callback must not be invoked
+ * @return Error code
+ **/
+
+error_t coapServerReceiveBlock(CoapServerContext *context, CoapCode method,
+   uint32_t value, bool_t *done)
+{
+   error_t error;
+   uint32_t blockPos;
+   uint32_t blockSzx;
+   size_t payloadLen;
+   const uint8_t *payload;
+   CoapServerBlockTransfer *transfer;
+
+   //The value 7 for SZX is reserved
+   if(COAP_GET_BLOCK_SZX(value) >= COAP_BLOCK_SIZE_RESERVED)
+   {
+      //The response has been formatted
+      *done = TRUE;
+      //Generate a 4.00 piggybacked response
+      return coapSetCode(&context->response, COAP_CODE_BAD_REQUEST);
+   }
+
+   //Retrieve the payload of the request
+   error = coapGetPayload(&context->request, &payload, &payloadLen);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Retrieve the position of the block within the body
+   blockPos = COAP_GET_BLOCK_POS(value);
+
+   //Search for a block-wise transfer in progress
+   transfer = coapServerFindBlockTransfer(context, method,
+      COAP_SERVER_BLOCK_STATE_RECEIVING);
+
+   //First block?
+   if(blockPos == 0)
+   {
+      //Start a new block-wise transfer if necessary
+      if(transfer == NULL)
+      {
+         transfer = coapServerCreateBlockTransfer(context, method);
+      }
+
+      //Discard any previously received data
+      transfer->state = COAP_SERVER_BLOCK_STATE_RECEIVING;
+      transfer->bodyLen = 0;
+   }
+   else
+   {
+      //Blocks must be received in sequence
+      if(transfer == NULL || blockPos != transfer->bodyLen)
+      {
+         //Abort the block-wise transfer
+         if(transfer != NULL)
+         {
+            transfer->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+         }
+
+         //The response has been formatted
+         *done = TRUE;
+
+         //The server has not received all the blocks of the request body
+         //that it needs to proceed (refer to RFC 7959, section 2.9.2)
+         return coapSetCode(&context->response,
+            COAP_CODE_REQUEST_ENTITY_INCOMPLETE);
+      }
+   }
+
+   //The payload of a block that is not the last one must match the size
+   //indicated by the SZX field
+   if(COAP_GET_BLOCK_M(value) && payloadLen != COAP_GET_BLOCK_SIZE(value))
+   {
+      //Abort the block-wise transfer
+      transfer->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+      //The response has been formatted
+      *done = TRUE;
+
+      //Generate a 4.00 piggybacked response
+      return coapSetCode(&context->response, COAP_CODE_BAD_REQUEST);
+   }
+
+   //Make sure the body does not exceed the capacity of the server
+   if((transfer->bodyLen + payloadLen) > COAP_SERVER_MAX_BODY_SIZE)
+   {
+      //Abort the block-wise transfer
+      transfer->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+      //The response has been formatted
+      *done = TRUE;
+
+      //Generate a 4.13 piggybacked response
+      error = coapSetCode(&context->response,
+         COAP_CODE_REQUEST_ENTITY_TO_LARGE);
+
+      //Check status code
+      if(!error)
+      {
+         //The Size1 option indicates the maximum size of request entity the
+         //server is able and willing to handle (refer to RFC 7959, section 4)
+         error = coapSetUintOption(&context->response, COAP_OPT_SIZE1, 0,
+            COAP_SERVER_MAX_BODY_SIZE);
+      }
+
+      //Return status code
+      return error;
+   }
+
+   //Append the block to the request body
+   osMemcpy(transfer->body + transfer->bodyLen, payload, payloadLen);
+   transfer->bodyLen += payloadLen;
+
+   //Save the time of the last exchange
+   transfer->timestamp = osGetSystemTime();
+
+   //Further blocks need to be transferred to complete the body?
+   if(COAP_GET_BLOCK_M(value))
+   {
+      //A server receiving a block-wise request may want to indicate a
+      //smaller block size preference (late negotiation)
+      blockSzx = MIN(COAP_GET_BLOCK_SZX(value), coapServerGetMaxBlockSize());
+
+      //The NUM field of the Block1 option indicates what block number is
+      //being acknowledged
+      COAP_SET_BLOCK_NUM(value, blockPos >> (blockSzx + 4));
+      COAP_SET_BLOCK_SZX(value, blockSzx);
+
+      //A Block1 option is used in control usage in a response
+      error = coapSetUintOption(&context->response, COAP_OPT_BLOCK1, 0, value);
+
+      //Check status code
+      if(!error)
+      {
+         //The 2.31 response code indicates that the transfer of this block of
+         //the request body was successful (refer to RFC 7959, section 2.9.1)
+         error = coapSetCode(&context->response, COAP_CODE_CONTINUE);
+      }
+
+      //The response has been formatted
+      *done = TRUE;
+   }
+   else
+   {
+      //The request body is now complete
+      transfer->state = COAP_SERVER_BLOCK_STATE_RECEIVED;
+      transfer->bodyPos = 0;
+
+      //The final response carries the Block1 option of the last block
+      transfer->block1 = value;
+
+      //The request callback reads the reassembled body
+      context->transfer = transfer;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Format the payload of the response
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @return Error code
+ **/
+
+error_t coapServerFormatBlockResponse(CoapServerContext *context,
+   CoapCode method)
+{
+   error_t error;
+   bool_t more;
+   bool_t found;
+   uint32_t value;
+   CoapServerBlockTransfer *transfer;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Point to the block-wise transfer attached to the current request
+   transfer = context->transfer;
+
+   //Request body received in multiple blocks?
+   if(transfer != NULL)
+   {
+      //The final response carries a Block1 option in control usage
+      error = coapSetUintOption(&context->response, COAP_OPT_BLOCK1, 0,
+         transfer->block1);
+
+      //The reassembled body is no longer needed
+      transfer->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+      context->transfer = NULL;
+   }
+
+   //Check status code
+   if(!error && context->bodyLen > 0)
+   {
+      //Search the CoAP request for a Block2 option
+      error = coapGetUintOption(&context->request, COAP_OPT_BLOCK2, 0, &value);
+
+      //Block2 option found?
+      if(!error)
+      {
+         //The client controls the block size and the block number
+         found = TRUE;
+      }
+      else
+      {
+         //Use the preferred block size of the server
+         found = FALSE;
+         value = 0;
+         COAP_SET_BLOCK_SZX(value, coapServerGetMaxBlockSize());
+      }
+
+      //Check whether the body fits in a single message
+      if(!found && context->bodyLen <= COAP_GET_BLOCK_SIZE(value))
+      {
+         //Set message payload
+         error = coapSetPayload(&context->response, context->body,
+            context->bodyLen);
+      }
+      else
+      {
+         //Format the requested block of the response body
+         error = coapServerWriteBlock(context, context->body, context->bodyLen,
+            value, &more);
+
+         //Search for a block-wise transfer with the same endpoint
+         transfer = coapServerFindBlockTransfer(context, method,
+            COAP_SERVER_BLOCK_STATE_SENDING);
+
+         //Further blocks need to be transferred?
+         if(!error && more)
+         {
+            //Start a new block-wise transfer if necessary
+            if(transfer == NULL)
+            {
+               transfer = coapServerCreateBlockTransfer(context, method);
+            }
+
+            //Keep a copy of the representation so that subsequent blocks are
+            //consistent with the first one
+            osMemcpy(transfer->body, context->body, context->bodyLen);
+            transfer->bodyLen = context->bodyLen;
+
+            //Update the state of the block-wise transfer
+            transfer->state = COAP_SERVER_BLOCK_STATE_SENDING;
+            transfer->timestamp = osGetSystemTime();
+         }
+         else if(transfer != NULL)
+         {
+            //The block-wise transfer is complete
+            transfer->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+         }
+         else
+         {
+            //Just for sanity
+         }
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Format a block of the response body (Block2 option)
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] body Pointer to the response body
+ * @param[in] bodyLen Length of the response body, in bytes
+ * @param[in] value Value of the Block2 option found in the request
+ * @param[out] more This flag is set if further blocks need to be transferred
+ * @return Error code
+ **/
+
+error_t coapServerWriteBlock(CoapServerContext *context, const uint8_t *body,
+   size_t bodyLen, uint32_t value, bool_t *more)
+{
+   error_t error;
+   size_t n;
+   uint32_t blockPos;
+   uint32_t blockSzx;
+
+   //Initialize flag
+   *more = FALSE;
+
+   //The value 7 for SZX is reserved
+   if(COAP_GET_BLOCK_SZX(value) >= COAP_BLOCK_SIZE_RESERVED)
+   {
+      //Generate a 4.00 piggybacked response
+      return coapSetCode(&context->response, COAP_CODE_BAD_REQUEST);
+   }
+
+   //Retrieve the position of the requested block
+   blockPos = COAP_GET_BLOCK_POS(value);
+
+   //The server uses the block size indicated by the client or a smaller one
+   blockSzx = MIN(COAP_GET_BLOCK_SZX(value), coapServerGetMaxBlockSize());
+
+   //The requested block must lie within the representation
+   if(blockPos > 0 && blockPos >= bodyLen)
+   {
+      //Generate a 4.02 piggybacked response
+      return coapSetCode(&context->response, COAP_CODE_BAD_OPTION);
+   }
+
+   //Number of bytes in the block
+   n = MIN(bodyLen - blockPos, COAP_GET_BLOCK_SIZE(blockSzx));
+
+   //The M bit indicates whether further blocks need to be transferred
+   *more = ((blockPos + n) < bodyLen) ? TRUE : FALSE;
+
+   //Format the Block2 option (descriptive usage in a response)
+   COAP_SET_BLOCK_NUM(value, blockPos >> (blockSzx + 4));
+   COAP_SET_BLOCK_M(value, *more);
+   COAP_SET_BLOCK_SZX(value, blockSzx);
+
+   //Add the Block2 option to the response
+   error = coapSetUintOption(&context->response, COAP_OPT_BLOCK2, 0, value);
+
+   //Check status code
+   if(!error && blockPos == 0)
+   {
+      //The Size2 option gives an indication of the total size of the
+      //resource representation (refer to RFC 7959, section 4)
+      error = coapSetUintOption(&context->response, COAP_OPT_SIZE2, 0,
+         bodyLen);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Set message payload
+      error = coapSetPayload(&context->response, body + blockPos, n);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Create a new block-wise transfer
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @return Pointer to the block-wise transfer
+ **/
+
+CoapServerBlockTransfer *coapServerCreateBlockTransfer(CoapServerContext *context,
+   CoapCode method)
+{
+   uint_t i;
+   CoapServerBlockTransfer *entry;
+   CoapServerBlockTransfer *oldestEntry;
+
+   //Keep track of the oldest entry
+   oldestEntry = &context->blockTransfer[0];
+
+   //Loop through block-wise transfers
+   for(i = 0; i < COAP_SERVER_MAX_BLOCK_TRANSFERS; i++)
+   {
+      //Point to the current entry
+      entry = &context->blockTransfer[i];
+
+      //Check whether the entry is available
+      if(entry->state == COAP_SERVER_BLOCK_STATE_UNUSED)
+      {
+         //Use the current entry
+         oldestEntry = entry;
+         break;
+      }
+
+      //Keep track of the oldest entry
+      if(timeCompare(entry->timestamp, oldestEntry->timestamp) < 0)
+      {
+         oldestEntry = entry;
+      }
+   }
+
+   //The oldest transfer is aborted when the table runs out of space
+   entry = oldestEntry;
+
+   //Save the endpoint and the resource the transfer relates to
+   entry->clientIpAddr = context->clientIpAddr;
+   entry->clientPort = context->clientPort;
+   entry->method = method;
+   osStrcpy(entry->uri, context->uri);
+
+   //Initialize block-wise transfer
+   entry->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+   entry->bodyLen = 0;
+   entry->bodyPos = 0;
+   entry->timestamp = osGetSystemTime();
+
+   //Return a pointer to the block-wise transfer
+   return entry;
+}
+
+
+/**
+ * @brief Search for a block-wise transfer
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @param[in] state State of the block-wise transfer
+ * @return Pointer to the matching block-wise transfer, if any
+ **/
+
+CoapServerBlockTransfer *coapServerFindBlockTransfer(CoapServerContext *context,
+   CoapCode method, CoapServerBlockState state)
+{
+   uint_t i;
+   CoapServerBlockTransfer *entry;
+
+   //Loop through block-wise transfers
+   for(i = 0; i < COAP_SERVER_MAX_BLOCK_TRANSFERS; i++)
+   {
+      //Point to the current entry
+      entry = &context->blockTransfer[i];
+
+      //Block-wise transfers are identified by the endpoint, the method and
+      //the target resource of the request
+      if(entry->state == state &&
+         entry->method == method &&
+         entry->clientPort == context->clientPort &&
+         ipCompAddr(&entry->clientIpAddr, &context->clientIpAddr) &&
+         !osStrcmp(entry->uri, context->uri))
+      {
+         return entry;
+      }
+   }
+
+   //No matching block-wise transfer
+   return NULL;
+}
+
+
+/**
+ * @brief Release stale block-wise transfers
+ * @param[in] context Pointer to the CoAP server context
+ **/
+
+void coapServerCheckBlockTransfers(CoapServerContext *context)
+{
+   uint_t i;
+   systime_t time;
+   CoapServerBlockTransfer *entry;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Loop through block-wise transfers
+   for(i = 0; i < COAP_SERVER_MAX_BLOCK_TRANSFERS; i++)
+   {
+      //Point to the current entry
+      entry = &context->blockTransfer[i];
+
+      //Block-wise transfer in progress?
+      if(entry->state != COAP_SERVER_BLOCK_STATE_UNUSED)
+      {
+         //Clients that do not complete a transfer must not tie up resources
+         //indefinitely
+         if(timeCompare(time, entry->timestamp + COAP_SERVER_BLOCK_TIMEOUT) >= 0)
+         {
+            //Debug message
+            TRACE_INFO("CoAP Server: Block-wise transfer timeout!\r\n");
+
+            //Release the entry
+            entry->state = COAP_SERVER_BLOCK_STATE_UNUSED;
+         }
+      }
+   }
+}
+
+
+/**
+ * @brief Get maximum block size
+ * @return Block size
+ **/
+
+CoapBlockSize coapServerGetMaxBlockSize(void)
+{
+   CoapBlockSize blockSize;
+
+   //Retrieve maximum block size
+#if (COAP_MAX_MSG_SIZE >= (COAP_HEADER_SIZE + 1024))
+   blockSize = COAP_BLOCK_SIZE_1024;
+#elif (COAP_MAX_MSG_SIZE >= (COAP_HEADER_SIZE + 512))
+   blockSize = COAP_BLOCK_SIZE_512;
+#elif (COAP_MAX_MSG_SIZE >= (COAP_HEADER_SIZE + 256))
+   blockSize = COAP_BLOCK_SIZE_256;
+#elif (COAP_MAX_MSG_SIZE >= (COAP_HEADER_SIZE + 128))
+   blockSize = COAP_BLOCK_SIZE_128;
+#elif (COAP_MAX_MSG_SIZE >= (COAP_HEADER_SIZE + 64))
+   blockSize = COAP_BLOCK_SIZE_64;
+#elif (COAP_MAX_MSG_SIZE >= (COAP_HEADER_SIZE + 32))
+   blockSize = COAP_BLOCK_SIZE_32;
+#else
+   blockSize = COAP_BLOCK_SIZE_16;
+#endif
+
+   //Return maximum block size
+   return blockSize;
+}
+
+#endif
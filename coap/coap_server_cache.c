@@ -0,0 +1,344 @@
+/**
+ * @file coap_server_cache.c
+ * @brief CoAP server message deduplication
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL COAP_TRACE_LEVEL
+
+//Dependencies
+#include "core/net.h"
+#include "coap/coap_server.h"
+#include "coap/coap_server_cache.h"
+#include "debug.h"
+
+//Check TCP/IP stack configuration
+#if (COAP_SERVER_SUPPORT == ENABLED && COAP_SERVER_CACHE_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Detect duplicate requests
+ *
+ * A retransmitted confirmable request is answered with the response that was
+ * sent for the first copy, whereas a duplicate non-confirmable request is
+ * silently ignored. In both cases, the request callback is not invoked
+ *
+ * @param[in] context Pointer to the CoAP server context
+ * @return TRUE if the request is a duplicate, else FALSE
+ **/
+
+bool_t coapServerCheckDuplicate(CoapServerContext *context)
+{
+   uint16_t mid;
+   uint32_t hash;
+   CoapServerCacheEntry *entry;
+   const CoapMessageHeader *header;
+
+   //Point to the CoAP request header
+   header = (CoapMessageHeader *) context->request.buffer;
+   //Retrieve message ID
+   mid = ntohs(header->mid);
+
+   //Compute the hash value of the (endpoint, message ID) pair
+   hash = coapServerComputeCacheHash(&context->clientIpAddr,
+      context->clientPort, mid);
+
+   //Search the deduplication table
+   entry = coapServerFindCacheEntry(context, hash, mid);
+
+   //No matching entry?
+   if(entry == NULL)
+      return FALSE;
+
+   //Debug message
+   TRACE_INFO("CoAP Server: Duplicate message received (MID = %" PRIu16 ")...\r\n",
+      mid);
+
+   //The recipient should acknowledge each duplicate copy of a confirmable
+   //message using the same acknowledgement or Reset message but should
+   //process any request only once (refer to RFC 7252, section 4.5)
+   if(entry->type == COAP_TYPE_CON && entry->responseLen > 0)
+   {
+      //Replay the cached response
+      osMemcpy(context->response.buffer, entry->response, entry->responseLen);
+      context->response.length = entry->responseLen;
+   }
+   else
+   {
+      //Duplicate non-confirmable messages are silently ignored
+      context->response.length = 0;
+   }
+
+   //The request is a duplicate
+   return TRUE;
+}
+
+
+/**
+ * @brief Save the response to the current request
+ * @param[in] context Pointer to the CoAP server context
+ **/
+
+void coapServerSaveResponse(CoapServerContext *context)
+{
+   uint_t i;
+   uint16_t mid;
+   systime_t time;
+   CoapServerCacheEntry *entry;
+   CoapServerCacheEntry *oldestEntry;
+   const CoapMessageHeader *header;
+
+   //Point to the CoAP request header
+   header = (CoapMessageHeader *) context->request.buffer;
+   //Retrieve message ID
+   mid = ntohs(header->mid);
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Keep track of the oldest entry
+   oldestEntry = &context->cache[0];
+
+   //Loop through the deduplication table
+   for(i = 0; i < COAP_SERVER_CACHE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &context->cache[i];
+
+      //Check whether the entry is available
+      if(!entry->valid)
+      {
+         //Use the current entry
+         oldestEntry = entry;
+         break;
+      }
+
+      //Keep track of the oldest entry
+      if(timeCompare(entry->timestamp, oldestEntry->timestamp) < 0)
+      {
+         oldestEntry = entry;
+      }
+   }
+
+   //The table is bounded. When no entry is available, the oldest one is
+   //replaced
+   entry = oldestEntry;
+
+   //Detach the entry from its current hash bucket, if any
+   if(entry->valid)
+   {
+      coapServerRemoveCacheEntry(context, entry);
+   }
+
+   //Save the (endpoint, message ID) pair
+   entry->hash = coapServerComputeCacheHash(&context->clientIpAddr,
+      context->clientPort, mid);
+   entry->clientIpAddr = context->clientIpAddr;
+   entry->clientPort = context->clientPort;
+   entry->mid = mid;
+   entry->type = (CoapMessageType) header->type;
+   entry->timestamp = time;
+
+   //Only the responses to confirmable requests need to be replayed
+   if(header->type == COAP_TYPE_CON)
+   {
+      //Save the response
+      osMemcpy(entry->response, context->response.buffer,
+         context->response.length);
+      entry->responseLen = context->response.length;
+   }
+   else
+   {
+      //Duplicate non-confirmable requests are silently ignored
+      entry->responseLen = 0;
+   }
+
+   //Attach the entry to the relevant hash bucket
+   coapServerAddCacheEntry(context, entry);
+}
+
+
+/**
+ * @brief Search the deduplication table for a given (endpoint, message ID) pair
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] hash Hash value of the (endpoint, message ID) pair
+ * @param[in] mid Message ID
+ * @return Pointer to the matching entry, if any
+ **/
+
+CoapServerCacheEntry *coapServerFindCacheEntry(CoapServerContext *context,
+   uint32_t hash, uint16_t mid)
+{
+   systime_t time;
+   systime_t lifetime;
+   CoapServerCacheEntry *entry;
+   CoapServerCacheEntry *next;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Only the entries that share the same hash bucket need to be examined
+   for(entry = context->cacheBuckets[hash % COAP_SERVER_CACHE_NUM_BUCKETS];
+      entry != NULL; entry = next)
+   {
+      //Save the next entry of the chain before the current one is released
+      next = entry->next;
+
+      //A message ID can be reused once the corresponding exchange is over
+      if(entry->type == COAP_TYPE_CON)
+      {
+         lifetime = COAP_SERVER_EXCHANGE_LIFETIME;
+      }
+      else
+      {
+         lifetime = COAP_SERVER_NON_LIFETIME;
+      }
+
+      //Release expired entries
+      if(timeCompare(time, entry->timestamp + lifetime) >= 0)
+      {
+         coapServerRemoveCacheEntry(context, entry);
+         continue;
+      }
+
+      //The hash value is compared first so that the full comparison is
+      //performed for likely matches only
+      if(entry->hash == hash &&
+         entry->mid == mid &&
+         entry->clientPort == context->clientPort &&
+         ipCompAddr(&entry->clientIpAddr, &context->clientIpAddr))
+      {
+         return entry;
+      }
+   }
+
+   //No matching entry
+   return NULL;
+}
+
+
+/**
+ * @brief Insert an entry in the hash bucket that matches its hash value
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] entry Pointer to the entry to be inserted
+ **/
+
+void coapServerAddCacheEntry(CoapServerContext *context,
+   CoapServerCacheEntry *entry)
+{
+   uint_t i;
+
+   //Select the relevant hash bucket
+   i = entry->hash % COAP_SERVER_CACHE_NUM_BUCKETS;
+
+   //Insert the entry at the head of the chain
+   entry->next = context->cacheBuckets[i];
+   context->cacheBuckets[i] = entry;
+
+   //The entry is now in use
+   entry->valid = TRUE;
+}
+
+
+/**
+ * @brief Remove an entry from its hash bucket
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] entry Pointer to the entry to be removed
+ **/
+
+void coapServerRemoveCacheEntry(CoapServerContext *context,
+   CoapServerCacheEntry *entry)
+{
+   CoapServerCacheEntry **p;
+
+   //Point to the head of the chain
+   p = &context->cacheBuckets[entry->hash % COAP_SERVER_CACHE_NUM_BUCKETS];
+
+   //Search the chain for the specified entry
+   while(*p != NULL && *p != entry)
+   {
+      p = &(*p)->next;
+   }
+
+   //Unlink the entry
+   if(*p != NULL)
+   {
+      *p = entry->next;
+   }
+
+   //The entry is now available
+   entry->next = NULL;
+   entry->valid = FALSE;
+}
+
+
+/**
+ * @brief Compute the hash value of an (endpoint, message ID) pair
+ * @param[in] ipAddr IP address of the client
+ * @param[in] port Port number of the client
+ * @param[in] mid Message ID
+ * @return Hash value (FNV-1a)
+ **/
+
+uint32_t coapServerComputeCacheHash(const IpAddr *ipAddr, uint16_t port,
+   uint16_t mid)
+{
+   size_t i;
+   uint32_t h;
+   const uint8_t *p;
+
+   //Initialize hash value
+   h = 2166136261;
+
+   //Point to the IP address
+   p = (const uint8_t *) &ipAddr->addr;
+
+   //Process the IP address
+   for(i = 0; i < ipAddr->length; i++)
+   {
+      h ^= p[i];
+      h *= 16777619;
+   }
+
+   //Process the port number
+   h ^= port & 0xFF;
+   h *= 16777619;
+   h ^= (port >> 8) & 0xFF;
+   h *= 16777619;
+
+   //Process the message ID
+   h ^= mid & 0xFF;
+   h *= 16777619;
+   h ^= (mid >> 8) & 0xFF;
+   h *= 16777619;
+
+   //Return the resulting hash value
+   return h;
+}
+
+#endif
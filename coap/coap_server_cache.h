@@ -0,0 +1,64 @@
+/**
+ * @file coap_server_cache.h
+ * @brief CoAP server message deduplication
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+#ifndef _COAP_SERVER_CACHE_H
+#define _COAP_SERVER_CACHE_H
+
+//Dependencies
+#include "core/net.h"
+#include "coap/coap_server.h"
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//CoAP server related functions
+bool_t coapServerCheckDuplicate(CoapServerContext *context);
+void coapServerSaveResponse(CoapServerContext *context);
+
+CoapServerCacheEntry *coapServerFindCacheEntry(CoapServerContext *context,
+   uint32_t hash, uint16_t mid);
+
+void coapServerAddCacheEntry(CoapServerContext *context,
+   CoapServerCacheEntry *entry);
+
+void coapServerRemoveCacheEntry(CoapServerContext *context,
+   CoapServerCacheEntry *entry);
+
+uint32_t coapServerComputeCacheHash(const IpAddr *ipAddr, uint16_t port,
+   uint16_t mid);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
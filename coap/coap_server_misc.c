@@ -36,6 +36,9 @@
 #include "coap/coap_server.h"
 #include "coap/coap_server_transport.h"
 #include "coap/coap_server_misc.h"
+#include "coap/coap_server_block.h"
+#include "coap/coap_server_cache.h"
+#include "coap/coap_server_observe.h"
 #include "coap/coap_common.h"
 #include "coap/coap_debug.h"
 #include "debug.h"
@@ -100,6 +103,16 @@ void coapServerTick(CoapServerContext *context)
       }
    }
 #endif
+
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Release stale block-wise transfers
+   coapServerCheckBlockTransfers(context);
+#endif
+
+#if (COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+   //Send pending notifications and retransmit confirmable notifications
+   coapServerCheckObservers(context);
+#endif
 }
 
 
@@ -117,11 +130,19 @@ error_t coapServerProcessRequest(CoapServerContext *context,
    error_t error;
    CoapCode code;
    CoapMessageType type;
+#if (COAP_SERVER_CACHE_SUPPORT == ENABLED)
+   bool_t duplicate;
+#endif
 
    //Check the length of the CoAP message
    if(length > COAP_MAX_MSG_SIZE)
       return ERROR_INVALID_LENGTH;
 
+#if (COAP_SERVER_CACHE_SUPPORT == ENABLED)
+   //Initialize flag
+   duplicate = FALSE;
+#endif
+
    //Copy the request message
    osMemcpy(context->request.buffer, data, length);
 
@@ -155,6 +176,16 @@ error_t coapServerProcessRequest(CoapServerContext *context,
       //Check the type of the request
       if(type == COAP_TYPE_CON || type == COAP_TYPE_NON)
       {
+#if (COAP_SERVER_CACHE_SUPPORT == ENABLED)
+         //Duplicate of a previously processed request?
+         if(coapServerCheckDuplicate(context))
+         {
+            //The request callback must not be invoked twice for the same
+            //request (refer to RFC 7252, section 4.5)
+            duplicate = TRUE;
+         }
+         else
+#endif
          //Check message code
          if(code == COAP_CODE_GET ||
             code == COAP_CODE_POST ||
@@ -175,17 +206,8 @@ error_t coapServerProcessRequest(CoapServerContext *context,
                osStrcpy(context->uri, "/");
             }
 
-            //Any registered callback?
-            if(context->requestCallback != NULL)
-            {
-               //Invoke user callback function
-               error = context->requestCallback(context, code, context->uri);
-            }
-            else
-            {
-               //Generate a 4.04 piggybacked response
-               error = coapSetCode(&context->response, COAP_CODE_NOT_FOUND);
-            }
+            //Process the request
+            error = coapServerHandleRequest(context, code);
          }
          else if(code == COAP_CODE_EMPTY)
          {
@@ -204,6 +226,10 @@ error_t coapServerProcessRequest(CoapServerContext *context,
       }
       else
       {
+#if (COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+         //Acknowledgement or Reset message matching a notification?
+         coapServerProcessObserverReply(context, type);
+#endif
          //Recipients of Acknowledgement and Reset messages must not respond
          //with either Acknowledgement or Reset messages
          error = ERROR_INVALID_REQUEST;
@@ -238,6 +264,83 @@ error_t coapServerProcessRequest(CoapServerContext *context,
          error = coapServerSendResponse(context, context->response.buffer,
             context->response.length);
       }
+
+#if (COAP_SERVER_CACHE_SUPPORT == ENABLED)
+      //Check status code
+      if(!error && !duplicate)
+      {
+         //Retransmissions of the request will be answered from the cache
+         coapServerSaveResponse(context);
+      }
+#endif
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Handle CoAP request
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @return Error code
+ **/
+
+error_t coapServerHandleRequest(CoapServerContext *context, CoapCode method)
+{
+   error_t error;
+   bool_t done;
+
+   //Initialize flag
+   done = FALSE;
+
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Reassemble the request body and serve subsequent blocks of the response
+   //body (refer to RFC 7959, section 2)
+   error = coapServerProcessBlockRequest(context, method, &done);
+   //Any error to report?
+   if(error)
+      return error;
+#endif
+
+   //The request callback is not invoked until the request body is complete
+   if(!done)
+   {
+      //Any registered callback?
+      if(context->requestCallback != NULL)
+      {
+         //Invoke user callback function
+         error = context->requestCallback(context, method, context->uri);
+      }
+      else
+      {
+         //Generate a 4.04 piggybacked response
+         error = coapSetCode(&context->response, COAP_CODE_NOT_FOUND);
+      }
+
+#if (COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+      //Check status code
+      if(!error)
+      {
+         //Add or remove the client from the list of observers
+         error = coapServerProcessObserve(context, method);
+      }
+#endif
+
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+      //Check status code
+      if(!error)
+      {
+         //Large response bodies are transferred using block-wise mode
+         error = coapServerFormatBlockResponse(context, method);
+      }
+#endif
+   }
+   else
+   {
+      //The response has already been formatted
+      error = NO_ERROR;
    }
 
    //Return status code
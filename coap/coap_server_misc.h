@@ -46,6 +46,8 @@ void coapServerTick(CoapServerContext *context);
 error_t coapServerProcessRequest(CoapServerContext *context,
    const uint8_t *data, size_t length);
 
+error_t coapServerHandleRequest(CoapServerContext *context, CoapCode method);
+
 error_t coapServerRejectRequest(CoapServerContext *context);
 
 error_t coapServerInitResponse(CoapServerContext *context);
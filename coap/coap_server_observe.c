@@ -0,0 +1,592 @@
+/**
+ * @file coap_server_observe.c
+ * @brief CoAP server resource observation
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL COAP_TRACE_LEVEL
+
+//Dependencies
+#include "core/net.h"
+#include "coap/coap_server.h"
+#include "coap/coap_server_observe.h"
+#include "coap/coap_server_block.h"
+#include "coap/coap_server_misc.h"
+#include "coap/coap_debug.h"
+#include "debug.h"
+
+//Check TCP/IP stack configuration
+#if (COAP_SERVER_SUPPORT == ENABLED && COAP_SERVER_OBSERVE_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Process Observe option of an incoming request
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] method Request method
+ * @return Error code
+ **/
+
+error_t coapServerProcessObserve(CoapServerContext *context, CoapCode method)
+{
+   error_t error;
+   uint32_t value;
+   systime_t time;
+   CoapCode code;
+   CoapServerObserver *observer;
+   const CoapMessageHeader *header;
+
+   //Notifications are generated by replaying a GET request on behalf of
+   //the observer
+   if(method != COAP_CODE_GET)
+      return NO_ERROR;
+
+   //Search the CoAP request for an Observe option
+   error = coapGetUintOption(&context->request, COAP_OPT_OBSERVE, 0, &value);
+   //Observe option not found?
+   if(error)
+      return NO_ERROR;
+
+   //Retrieve response code
+   error = coapGetCode(&context->response, &code);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Search the list of observers for the client endpoint
+   observer = coapServerFindObserver(context);
+
+   //Registration request?
+   if(value == COAP_OBSERVE_REGISTER &&
+      COAP_GET_CODE_CLASS(code) == COAP_CODE_CLASS_SUCCESS)
+   {
+      //If the list of observers already contains an entry for the client
+      //endpoint, the server must not add a new entry but must replace or
+      //update the existing one (refer to RFC 7641, section 4.1)
+      if(observer == NULL)
+      {
+         observer = coapServerCreateObserver(context);
+      }
+
+      //Any entry available?
+      if(observer != NULL)
+      {
+         //Point to the CoAP request header
+         header = (CoapMessageHeader *) context->request.buffer;
+
+         //Get current time
+         time = osGetSystemTime();
+
+         //Notifications carry the token of the registration request
+         osMemcpy(observer->token, header->token, header->tokenLen);
+         observer->tokenLen = header->tokenLen;
+
+         //The sequence number is incremented with each notification
+         observer->seqNum = (observer->seqNum + 1) & 0xFFFFFF;
+
+         //Initialize notification state
+         observer->changed = FALSE;
+         observer->ackPending = FALSE;
+         observer->nonCount = 0;
+         observer->errorCount = 0;
+         observer->conTimestamp = time;
+         observer->timestamp = time;
+
+         //The Observe option indicates that the client has been added to the
+         //list of observers
+         error = coapSetUintOption(&context->response, COAP_OPT_OBSERVE, 0,
+            observer->seqNum);
+      }
+      else
+      {
+         //The request is served as if the Observe option was not present
+         TRACE_INFO("CoAP Server: Too many observers!\r\n");
+      }
+   }
+   else
+   {
+      //A client may explicitly deregister by issuing a GET request that
+      //includes an Observe option set to 1. A non-2.xx response also
+      //removes the client from the list of observers
+      if(observer != NULL)
+      {
+         observer->valid = FALSE;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Process Acknowledgement or Reset message matching a notification
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] type Message type
+ **/
+
+void coapServerProcessObserverReply(CoapServerContext *context,
+   CoapMessageType type)
+{
+   uint_t i;
+   uint16_t mid;
+   CoapServerObserver *observer;
+   const CoapMessageHeader *header;
+
+   //Point to the CoAP message header
+   header = (CoapMessageHeader *) context->request.buffer;
+   //Retrieve message ID
+   mid = ntohs(header->mid);
+
+   //Loop through the list of observers
+   for(i = 0; i < COAP_SERVER_MAX_OBSERVERS; i++)
+   {
+      //Point to the current entry
+      observer = &context->observer[i];
+
+      //Matching notification?
+      if(observer->valid && observer->mid == mid &&
+         observer->clientPort == context->clientPort &&
+         ipCompAddr(&observer->clientIpAddr, &context->clientIpAddr))
+      {
+         //Check message type
+         if(type == COAP_TYPE_ACK)
+         {
+            //The confirmable notification has been acknowledged
+            observer->ackPending = FALSE;
+         }
+         else
+         {
+            //A client that rejects a notification with a Reset message is
+            //removed from the list of observers (refer to RFC 7641,
+            //section 4.5)
+            TRACE_INFO("CoAP Server: Observer removed!\r\n");
+            observer->valid = FALSE;
+         }
+
+         //We are done
+         break;
+      }
+   }
+}
+
+
+/**
+ * @brief Send pending notifications
+ * @param[in] context Pointer to the CoAP server context
+ **/
+
+void coapServerCheckObservers(CoapServerContext *context)
+{
+   error_t error;
+   uint_t i;
+   systime_t time;
+   CoapServerObserver *observer;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Loop through the list of observers
+   for(i = 0; i < COAP_SERVER_MAX_OBSERVERS; i++)
+   {
+      //Point to the current entry
+      observer = &context->observer[i];
+
+      //Skip unused entries
+      if(!observer->valid)
+         continue;
+
+      //Confirmable notification in progress?
+      if(observer->ackPending)
+      {
+         //A server should not send a new notification while a confirmable
+         //notification is in progress. A change of the resource state is
+         //reflected by the next retransmission (refer to RFC 7641,
+         //section 4.5.2)
+         if(timeCompare(time, observer->retransmitStartTime +
+            observer->retransmitTimeout) >= 0)
+         {
+            //Check whether the maximum number of retransmissions has been
+            //reached
+            if(observer->retransmitCount < COAP_SERVER_MAX_RETRANSMIT)
+            {
+               //The timeout is doubled upon each retransmission
+               observer->retransmitTimeout *= 2;
+               //Increment retransmission counter
+               observer->retransmitCount++;
+
+               //Retransmit the notification
+               error = coapServerSendNotification(context, observer, TRUE);
+               //Update the error counter of the observer
+               coapServerProcessNotificationError(context, observer, error);
+            }
+            else
+            {
+               //The client is considered no longer interested in the resource
+               //and is removed from the list of observers
+               TRACE_INFO("CoAP Server: Observer removed!\r\n");
+               observer->valid = FALSE;
+            }
+         }
+      }
+      else if(observer->changed)
+      {
+         //A server should not send more than one non-confirmable notification
+         //per round-trip time to a client on average. Without an RTT estimate,
+         //notifications are paced (refer to RFC 7641, section 4.5.1). After
+         //a failure, the next attempt is always delayed
+         if((observer->nonCount >= COAP_SERVER_MAX_NON_NOTIFICATIONS &&
+            observer->errorCount == 0) ||
+            timeCompare(time, observer->timestamp +
+            COAP_SERVER_NON_NOTIFICATION_INTERVAL) >= 0)
+         {
+            //Send a notification reflecting the current resource state
+            error = coapServerSendNotification(context, observer, FALSE);
+            //Update the error counter of the observer
+            coapServerProcessNotificationError(context, observer, error);
+         }
+      }
+      else
+      {
+         //No pending notification
+      }
+   }
+}
+
+
+/**
+ * @brief Send a notification to an observer
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] observer Pointer to the observer
+ * @param[in] retransmit Retransmission of a confirmable notification
+ * @return Error code
+ **/
+
+error_t coapServerSendNotification(CoapServerContext *context,
+   CoapServerObserver *observer, bool_t retransmit)
+{
+   error_t error;
+   systime_t time;
+   CoapCode code;
+   CoapMessageType type;
+   CoapMessageHeader *header;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Restore the endpoint of the observer
+   context->serverIpAddr = observer->serverIpAddr;
+   context->clientIpAddr = observer->clientIpAddr;
+   context->clientPort = observer->clientPort;
+
+   //Point to the CoAP request header
+   header = (CoapMessageHeader *) context->request.buffer;
+
+   //The representation is generated by replaying the registration request
+   header->version = COAP_VERSION_1;
+   header->type = COAP_TYPE_NON;
+   header->tokenLen = observer->tokenLen;
+   header->code = COAP_CODE_GET;
+   header->mid = 0;
+
+   //Copy the token of the registration request
+   osMemcpy(header->token, observer->token, observer->tokenLen);
+
+   //Set the length of the CoAP message
+   context->request.length = sizeof(CoapMessageHeader) + observer->tokenLen;
+   context->request.pos = 0;
+
+   //Encode the path component into multiple Uri-Path options
+   error = coapSplitRepeatableOption(&context->request, COAP_OPT_URI_PATH,
+      observer->uri, '/');
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save the resource identifier
+   osStrcpy(context->uri, observer->uri);
+
+   //Initialize CoAP response message
+   coapServerInitResponse(context);
+
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Reset the response body
+   context->transfer = NULL;
+   context->bodyLen = 0;
+#endif
+
+   //Any registered callback?
+   if(context->requestCallback != NULL)
+   {
+      //Invoke user callback function
+      error = context->requestCallback(context, COAP_CODE_GET, context->uri);
+   }
+   else
+   {
+      //Generate a 4.04 response
+      error = coapSetCode(&context->response, COAP_CODE_NOT_FOUND);
+   }
+
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Retrieve response code
+   error = coapGetCode(&context->response, &code);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //A notification that reflects a new resource state is a new message
+   if(!retransmit || observer->changed)
+   {
+      //Allocate a new message ID
+      observer->mid = context->mid++;
+      //The sequence number is incremented with each new notification
+      observer->seqNum = (observer->seqNum + 1) & 0xFFFFFF;
+   }
+
+   //The notification reflects the current resource state
+   observer->changed = FALSE;
+
+   //A notification is sent in a confirmable message at least every 24 hours
+   //so that the server can detect observers that are no longer interested
+   //(refer to RFC 7641, section 4.5)
+   if(retransmit)
+   {
+      type = COAP_TYPE_CON;
+   }
+   else if(observer->nonCount >= COAP_SERVER_MAX_NON_NOTIFICATIONS ||
+      timeCompare(time, observer->conTimestamp +
+      COAP_SERVER_CON_NOTIFICATION_INTERVAL) >= 0)
+   {
+      //Initialize retransmission state
+      observer->ackPending = TRUE;
+      observer->retransmitCount = 0;
+
+      //The initial timeout is set to a random duration
+      observer->retransmitTimeout = netGetRandRange(context->netContext,
+         COAP_SERVER_ACK_TIMEOUT_MIN, COAP_SERVER_ACK_TIMEOUT_MAX);
+
+      //Reset the number of consecutive non-confirmable notifications
+      observer->nonCount = 0;
+      observer->conTimestamp = time;
+
+      //Send a confirmable notification
+      type = COAP_TYPE_CON;
+   }
+   else
+   {
+      //Increment the number of consecutive non-confirmable notifications
+      observer->nonCount++;
+
+      //Send a non-confirmable notification
+      type = COAP_TYPE_NON;
+   }
+
+   //Save the time at which the notification was sent
+   observer->retransmitStartTime = time;
+   observer->timestamp = time;
+
+   //Point to the CoAP response header
+   header = (CoapMessageHeader *) context->response.buffer;
+
+   //Set message type and message ID
+   header->type = type;
+   header->mid = htons(observer->mid);
+
+   //Successful response?
+   if(COAP_GET_CODE_CLASS(code) == COAP_CODE_CLASS_SUCCESS)
+   {
+      //The Observe option carries the sequence number of the notification
+      error = coapSetUintOption(&context->response, COAP_OPT_OBSERVE, 0,
+         observer->seqNum);
+   }
+   else
+   {
+      //A non-2.xx notification removes the client from the list of observers
+      //(refer to RFC 7641, section 3.2)
+      observer->valid = FALSE;
+   }
+
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Check status code
+   if(!error)
+   {
+      //A large representation is transferred using block-wise mode. The
+      //notification carries the first block only
+      error = coapServerFormatBlockResponse(context, COAP_CODE_GET);
+   }
+#endif
+
+   //Check status code
+   if(!error)
+   {
+      //Debug message
+      TRACE_INFO("CoAP Server: Sending notification (%" PRIuSIZE " bytes)...\r\n",
+         context->response.length);
+
+      //Dump the contents of the message for debugging purpose
+      coapDumpMessage(context->response.buffer, context->response.length);
+
+      //Send CoAP notification
+      error = coapServerSendResponse(context, context->response.buffer,
+         context->response.length);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Keep track of the notifications that cannot be sent
+ *
+ * When the notification cannot be generated or sent, the next attempt is
+ * delayed so that a failing resource does not keep the server busy. The
+ * observer is removed after COAP_SERVER_MAX_NOTIFICATION_ERRORS consecutive
+ * failures
+ *
+ * @param[in] context Pointer to the CoAP server context
+ * @param[in] observer Pointer to the observer
+ * @param[in] error Status code returned by coapServerSendNotification
+ **/
+
+void coapServerProcessNotificationError(CoapServerContext *context,
+   CoapServerObserver *observer, error_t error)
+{
+   systime_t time;
+
+   //Successful notification?
+   if(!error)
+   {
+      //Reset the error counter
+      observer->errorCount = 0;
+   }
+   else
+   {
+      //Get current time
+      time = osGetSystemTime();
+
+      //Increment the number of consecutive failures
+      observer->errorCount++;
+
+      //Check whether the maximum number of failures has been reached
+      if(observer->errorCount >= COAP_SERVER_MAX_NOTIFICATION_ERRORS)
+      {
+         //The client cannot be notified anymore and is removed from the list
+         //of observers
+         TRACE_INFO("CoAP Server: Observer removed!\r\n");
+         observer->valid = FALSE;
+      }
+      else
+      {
+         //Back off before the next attempt. The pending state change, if
+         //any, is reported by the next notification
+         observer->retransmitStartTime = time;
+         observer->timestamp = time;
+      }
+   }
+}
+
+
+/**
+ * @brief Add a new entry to the list of observers
+ * @param[in] context Pointer to the CoAP server context
+ * @return Pointer to the newly created entry
+ **/
+
+CoapServerObserver *coapServerCreateObserver(CoapServerContext *context)
+{
+   uint_t i;
+   CoapServerObserver *observer;
+
+   //Loop through the list of observers
+   for(i = 0; i < COAP_SERVER_MAX_OBSERVERS; i++)
+   {
+      //Point to the current entry
+      observer = &context->observer[i];
+
+      //Check whether the entry is available
+      if(!observer->valid)
+      {
+         //Clear entry
+         osMemset(observer, 0, sizeof(CoapServerObserver));
+
+         //Save the endpoint of the client
+         observer->serverIpAddr = context->serverIpAddr;
+         observer->clientIpAddr = context->clientIpAddr;
+         observer->clientPort = context->clientPort;
+
+         //Save the resource identifier
+         osStrcpy(observer->uri, context->uri);
+
+         //The entry is now in use
+         observer->valid = TRUE;
+
+         //Return a pointer to the newly created entry
+         return observer;
+      }
+   }
+
+   //The list of observers is full
+   return NULL;
+}
+
+
+/**
+ * @brief Search the list of observers for the client endpoint
+ * @param[in] context Pointer to the CoAP server context
+ * @return Pointer to the matching entry, if any
+ **/
+
+CoapServerObserver *coapServerFindObserver(CoapServerContext *context)
+{
+   uint_t i;
+   CoapServerObserver *observer;
+
+   //Loop through the list of observers
+   for(i = 0; i < COAP_SERVER_MAX_OBSERVERS; i++)
+   {
+      //Point to the current entry
+      observer = &context->observer[i];
+
+      //An entry is identified by the client endpoint and the target resource
+      if(observer->valid &&
+         observer->clientPort == context->clientPort &&
+         ipCompAddr(&observer->clientIpAddr, &context->clientIpAddr) &&
+         !osStrcmp(observer->uri, context->uri))
+      {
+         return observer;
+      }
+   }
+
+   //No matching entry
+   return NULL;
+}
+
+#endif
@@ -183,6 +183,19 @@ error_t coapServerGetPayload(CoapServerContext *context, const uint8_t **payload
    if(context == NULL || payload == NULL || payloadLen == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Request body received in multiple blocks?
+   if(context->transfer != NULL)
+   {
+      //Point to the reassembled body
+      *payload = context->transfer->body;
+      *payloadLen = context->transfer->bodyLen;
+
+      //Successful processing
+      return NO_ERROR;
+   }
+#endif
+
    //Get response payload
    return coapGetPayload(&context->request, payload, payloadLen);
 }
@@ -204,6 +217,37 @@ error_t coapServerReadPayload(CoapServerContext *context, void *data, size_t siz
    if(context == NULL || data == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Request body received in multiple blocks?
+   if(context->transfer != NULL)
+   {
+      CoapServerBlockTransfer *transfer;
+
+      //Point to the block-wise transfer
+      transfer = context->transfer;
+
+      //Any data to be copied?
+      if(transfer->bodyPos < transfer->bodyLen)
+      {
+         //Limit the number of bytes to copy at a time
+         *length = MIN(transfer->bodyLen - transfer->bodyPos, size);
+
+         //Copy data
+         osMemcpy(data, transfer->body + transfer->bodyPos, *length);
+         //Advance current position
+         transfer->bodyPos += *length;
+
+         //Successful processing
+         return NO_ERROR;
+      }
+      else
+      {
+         //No more data available
+         return ERROR_END_OF_STREAM;
+      }
+   }
+#endif
+
    //Read payload data
    return coapReadPayload(&context->request, data, size, length);
 }
@@ -382,8 +426,26 @@ error_t coapServerSetPayload(CoapServerContext *context, const void *payload,
    if(payload == NULL && payloadLen != 0)
       return ERROR_INVALID_PARAMETER;
 
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Make sure the buffer is large enough to hold the response body
+   if(payloadLen > COAP_SERVER_MAX_BODY_SIZE)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //The response body is split into blocks once the request callback returns
+   if(payloadLen > 0)
+   {
+      osMemcpy(context->body, payload, payloadLen);
+   }
+
+   //Save the length of the response body
+   context->bodyLen = payloadLen;
+
+   //Successful processing
+   return NO_ERROR;
+#else
    //Set message payload
    return coapSetPayload(&context->response, payload, payloadLen);
+#endif
 }
 
 
@@ -402,8 +464,21 @@ error_t coapServerWritePayload(CoapServerContext *context, const void *data,
    if(context == NULL || data == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (COAP_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Make sure the buffer is large enough to hold the response body
+   if((context->bodyLen + length) > COAP_SERVER_MAX_BODY_SIZE)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Append data to the response body
+   osMemcpy(context->body + context->bodyLen, data, length);
+   context->bodyLen += length;
+
+   //Successful processing
+   return NO_ERROR;
+#else
    //Write payload data
    return coapWritePayload(&context->response, data, length);
+#endif
 }
 
 #endif
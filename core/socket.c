@@ -2465,3 +2465,75 @@ error_t getHostByName(NetInterface *interface, const char_t *name,
    //Return status code
    return error;
 }
+
+
+/**
+ * @brief Resolve a host name into an IP address without blocking
+ *
+ * The host name is resolved using DNS. The function returns
+ * ERROR_IN_PROGRESS while the resolution is pending and must be called
+ * again with the same parameters until it completes. When no address type
+ * is specified in the flags, A and AAAA queries are issued in parallel
+ *
+ * @param[in] interface Underlying network interface (optional parameter)
+ * @param[in] name Name of the host to be resolved
+ * @param[out] ipAddr IP address corresponding to the specified host name
+ * @param[in] flags Set of flags that influences the behavior of this function
+ * @return Error code
+ **/
+
+error_t getHostByNameAsync(NetInterface *interface, const char_t *name,
+   IpAddr *ipAddr, uint_t flags)
+{
+#if (DNS_CLIENT_SUPPORT == ENABLED)
+   error_t error;
+   HostType type;
+
+   //Check parameters
+   if(name == NULL || ipAddr == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Use default network interface?
+   if(interface == NULL)
+   {
+      interface = netGetDefaultInterface(NULL);
+   }
+
+   //The specified name can be either an IP or a host name
+   error = ipStringToAddr(name, ipAddr);
+
+   //Perform name resolution if necessary
+   if(error)
+   {
+      //The user may provide a hint to choose between IPv4 and IPv6
+      if((flags & HOST_TYPE_IPV4) != 0)
+      {
+         type = HOST_TYPE_IPV4;
+      }
+      else if((flags & HOST_TYPE_IPV6) != 0)
+      {
+         type = HOST_TYPE_IPV6;
+      }
+      else
+      {
+#if (IPV4_SUPPORT == ENABLED && IPV6_SUPPORT == ENABLED)
+         //Resolve both address types in parallel
+         type = HOST_TYPE_ANY;
+#elif (IPV4_SUPPORT == ENABLED)
+         type = HOST_TYPE_IPV4;
+#else
+         type = HOST_TYPE_IPV6;
+#endif
+      }
+
+      //Perform host name resolution
+      error = dnsResolveAsync(interface, name, type, ipAddr);
+   }
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
@@ -542,6 +542,9 @@ error_t socketPoll(SocketEventDesc *eventDesc, uint_t size, OsEvent *extEvent,
 error_t getHostByName(NetInterface *interface, const char_t *name,
    IpAddr *ipAddr, uint_t flags);
 
+error_t getHostByNameAsync(NetInterface *interface, const char_t *name,
+   IpAddr *ipAddr, uint_t flags);
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -47,6 +47,17 @@
 
 //DNS cache
 DnsCacheEntry dnsCache[DNS_CACHE_SIZE];
+//Number of usable entries in the DNS cache
+uint_t dnsCacheSize;
+
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+//Domain name index
+DnsCacheEntry *dnsCacheHashTable[DNS_CACHE_HASH_TABLE_SIZE];
+//Timer heap (entries ordered by expiration time)
+DnsCacheEntry *dnsCacheHeap[DNS_CACHE_SIZE];
+//Number of entries in the timer heap
+uint_t dnsCacheHeapSize;
+#endif
 
 
 /**
@@ -58,12 +69,70 @@ error_t dnsInit(void)
 {
    //Initialize DNS cache
    osMemset(dnsCache, 0, sizeof(dnsCache));
+   //All the entries are usable by default
+   dnsCacheSize = DNS_CACHE_SIZE;
+
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+   //Initialize domain name index
+   osMemset(dnsCacheHashTable, 0, sizeof(dnsCacheHashTable));
+   //The timer heap is initially empty
+   dnsCacheHeapSize = 0;
+#endif
 
    //Successful initialization
    return NO_ERROR;
 }
 
 
+/**
+ * @brief Set the number of usable entries in the DNS cache
+ *
+ * The DNS cache is statically allocated with DNS_CACHE_SIZE entries. This
+ * function limits the number of entries the resolvers are allowed to use.
+ * Entries that fall beyond the new limit are deleted. The function may be
+ * called at any time, since the DNS cache is accessed under the protection
+ * of the TCP/IP stack mutex
+ *
+ * @param[in] size Number of usable entries (1 to DNS_CACHE_SIZE)
+ * @return Error code
+ **/
+
+error_t dnsSetCacheSize(uint_t size)
+{
+   uint_t i;
+   NetContext *context;
+
+   //Make sure the specified size is acceptable
+   if(size < 1 || size > DNS_CACHE_SIZE)
+      return ERROR_INVALID_PARAMETER;
+
+   //Point to the TCP/IP stack context
+   context = netGetDefaultContext();
+
+   //Get exclusive access
+   netLock(context);
+
+   //Delete the entries that are no longer usable
+   for(i = size; i < DNS_CACHE_SIZE; i++)
+   {
+      //Check whether the entry is currently in use
+      if(dnsCache[i].state != DNS_STATE_NONE)
+      {
+         dnsDeleteEntry(&dnsCache[i]);
+      }
+   }
+
+   //Save the number of usable entries
+   dnsCacheSize = size;
+
+   //Release exclusive access
+   netUnlock(context);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
 /**
  * @brief Flush DNS cache
  * @param[in] interface Underlying network interface
@@ -111,8 +180,8 @@ DnsCacheEntry *dnsCreateEntry(void)
    //Keep track of the oldest entry
    oldestEntry = &dnsCache[0];
 
-   //Loop through DNS cache entries
-   for(i = 0; i < DNS_CACHE_SIZE; i++)
+   //Loop through the usable DNS cache entries
+   for(i = 0; i < dnsCacheSize; i++)
    {
       //Point to the current entry
       entry = &dnsCache[i];
@@ -120,6 +189,11 @@ DnsCacheEntry *dnsCreateEntry(void)
       //Check whether the entry is currently in use or not
       if(entry->state == DNS_STATE_NONE)
       {
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+         //Make sure the entry is no longer referenced by the index
+         dnsUnlinkEntry(entry);
+         dnsUnscheduleEntry(entry);
+#endif
          //Erase contents
          osMemset(entry, 0, sizeof(DnsCacheEntry));
          //Return a pointer to the DNS entry
@@ -163,6 +237,12 @@ void dnsDeleteEntry(DnsCacheEntry *entry)
          }
       }
 
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+      //Remove the entry from the domain name index and from the timer heap
+      dnsUnlinkEntry(entry);
+      dnsUnscheduleEntry(entry);
+#endif
+
       //Delete DNS cache entry
       entry->state = DNS_STATE_NONE;
       entry->refCount = 0;
@@ -170,6 +250,51 @@ void dnsDeleteEntry(DnsCacheEntry *entry)
 }
 
 
+/**
+ * @brief Update the lookup structures after a DNS cache entry has changed
+ *
+ * This function must be called whenever the state, the timestamp or the
+ * timeout of an entry is modified, so that the domain name index and the
+ * timer heap remain consistent with the contents of the DNS cache
+ *
+ * @param[in] entry Pointer to the DNS cache entry
+ **/
+
+void dnsUpdateEntry(DnsCacheEntry *entry)
+{
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+   //Deleted entry?
+   if(entry->state == DNS_STATE_NONE)
+   {
+      //Remove the entry from the lookup structures
+      dnsUnlinkEntry(entry);
+      dnsUnscheduleEntry(entry);
+   }
+   else
+   {
+      //Make sure the entry can be found by name
+      dnsLinkEntry(entry);
+
+      //Check whether the entry is associated with a timer
+      if(entry->state == DNS_STATE_IN_PROGRESS ||
+         entry->state == DNS_STATE_RESOLVED ||
+         entry->state == DNS_STATE_NEGATIVE)
+      {
+         //Calculate the time at which the entry must be processed
+         entry->deadline = entry->timestamp + entry->timeout;
+         //Insert the entry in the timer heap
+         dnsScheduleEntry(entry);
+      }
+      else
+      {
+         //Failed and permanent entries do not expire
+         dnsUnscheduleEntry(entry);
+      }
+   }
+#endif
+}
+
+
 /**
  * @brief Search the DNS cache for a given domain name
  * @param[in] interface Underlying network interface
@@ -186,6 +311,39 @@ DnsCacheEntry *dnsFindEntry(NetInterface *interface,
    uint_t i;
    DnsCacheEntry *entry;
 
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+   //Search by name?
+   if(name != NULL)
+   {
+      //Point to the first entry of the relevant hash bucket
+      entry = dnsCacheHashTable[dnsHashName(name) &
+         (DNS_CACHE_HASH_TABLE_SIZE - 1)];
+
+      //Loop through the entries sharing the same hash bucket
+      for(; entry != NULL; entry = entry->next)
+      {
+         //Make sure that the entry is currently in use
+         if(entry->state == DNS_STATE_NONE)
+            continue;
+
+         //Filter out entries that do not match the specified criteria
+         if(entry->interface != interface)
+            continue;
+         if(entry->type != type && type != HOST_TYPE_ANY)
+            continue;
+         if(entry->protocol != protocol && protocol != HOST_NAME_RESOLVER_ANY)
+            continue;
+
+         //Does the entry match the specified domain name?
+         if(osStrcasecmp(entry->name, name) == 0)
+            return entry;
+      }
+
+      //No matching entry in the DNS cache
+      return NULL;
+   }
+#endif
+
    //Loop through DNS cache entries
    for(i = 0; i < DNS_CACHE_SIZE; i++)
    {
@@ -224,7 +382,6 @@ DnsCacheEntry *dnsFindEntry(NetInterface *interface,
 
 void dnsTick(void)
 {
-   error_t error;
    uint_t i;
    systime_t time;
    DnsCacheEntry *entry;
@@ -232,92 +389,110 @@ void dnsTick(void)
    //Get current time
    time = osGetSystemTime();
 
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+   //Each entry of the timer heap is processed at most once per tick
+   for(i = dnsCacheHeapSize; i > 0 && dnsCacheHeapSize > 0; i--)
+   {
+      //Point to the entry that expires first
+      entry = dnsCacheHeap[0];
+
+      //The remaining entries have not expired yet
+      if(timeCompare(time, entry->deadline) < 0)
+         break;
+
+      //Remove the entry from the timer heap
+      dnsUnscheduleEntry(entry);
+
+      //Process the entry
+      dnsProcessEntryTimer(entry, time);
+
+      //Reschedule the entry if necessary
+      dnsUpdateEntry(entry);
+   }
+#else
    //Go through DNS cache
    for(i = 0; i < DNS_CACHE_SIZE; i++)
    {
       //Point to the current entry
       entry = &dnsCache[i];
 
-      //Name resolution in progress?
-      if(entry->state == DNS_STATE_IN_PROGRESS)
+      //Process the entry
+      dnsProcessEntryTimer(entry, time);
+   }
+#endif
+}
+
+
+/**
+ * @brief Manage the timers associated with a DNS cache entry
+ * @param[in] entry Pointer to the DNS cache entry
+ * @param[in] time Current time
+ **/
+
+void dnsProcessEntryTimer(DnsCacheEntry *entry, systime_t time)
+{
+   error_t error;
+
+   //Name resolution in progress?
+   if(entry->state == DNS_STATE_IN_PROGRESS)
+   {
+      //The request timed out?
+      if(timeCompare(time, entry->timestamp + entry->timeout) >= 0)
       {
-         //The request timed out?
-         if(timeCompare(time, entry->timestamp + entry->timeout) >= 0)
+         //Check whether the maximum number of retransmissions has been exceeded
+         if(entry->retransmitCount > 0)
          {
-            //Check whether the maximum number of retransmissions has been exceeded
-            if(entry->retransmitCount > 0)
-            {
 #if (DNS_CLIENT_SUPPORT == ENABLED)
-               //DNS resolver?
-               if(entry->protocol == HOST_NAME_RESOLVER_DNS)
-               {
-                  //Retransmit DNS query
-                  error = dnsSendQuery(entry);
-               }
-               else
+            //DNS resolver?
+            if(entry->protocol == HOST_NAME_RESOLVER_DNS)
+            {
+               //Retransmit DNS query
+               error = dnsSendQuery(entry);
+            }
+            else
 #endif
 #if (MDNS_CLIENT_SUPPORT == ENABLED)
-               //mDNS resolver?
-               if(entry->protocol == HOST_NAME_RESOLVER_MDNS)
-               {
-                  //Retransmit mDNS query
-                  error = mdnsClientSendQuery(entry);
-               }
-               else
+            //mDNS resolver?
+            if(entry->protocol == HOST_NAME_RESOLVER_MDNS)
+            {
+               //Retransmit mDNS query
+               error = mdnsClientSendQuery(entry);
+            }
+            else
 #endif
 #if (NBNS_CLIENT_SUPPORT == ENABLED && IPV4_SUPPORT == ENABLED)
-               //NetBIOS Name Service resolver?
-               if(entry->protocol == HOST_NAME_RESOLVER_NBNS)
-               {
-                  //Retransmit NBNS query
-                  error = nbnsSendQuery(entry);
-               }
-               else
+            //NetBIOS Name Service resolver?
+            if(entry->protocol == HOST_NAME_RESOLVER_NBNS)
+            {
+               //Retransmit NBNS query
+               error = nbnsSendQuery(entry);
+            }
+            else
 #endif
 #if (LLMNR_CLIENT_SUPPORT == ENABLED)
-               //LLMNR resolver?
-               if(entry->protocol == HOST_NAME_RESOLVER_LLMNR)
-               {
-                  //Retransmit LLMNR query
-                  error = llmnrSendQuery(entry);
-               }
-               else
+            //LLMNR resolver?
+            if(entry->protocol == HOST_NAME_RESOLVER_LLMNR)
+            {
+               //Retransmit LLMNR query
+               error = llmnrSendQuery(entry);
+            }
+            else
 #endif
-               //Unknown protocol?
-               {
-                  error = ERROR_FAILURE;
-               }
-
-               //Query message successfully sent?
-               if(!error)
-               {
-                  //Save the time at which the query message was sent
-                  entry->timestamp = time;
-                  //The timeout value is doubled for each subsequent retransmission
-                  entry->timeout = MIN(entry->timeout * 2, entry->maxTimeout);
-                  //Decrement retransmission counter
-                  entry->retransmitCount--;
-               }
-               else
-               {
-                  //Unregister UDP callback function
-                  if(entry->port != 0)
-                  {
-                     udpUnregisterRxCallback(entry->interface, entry->port);
-                  }
-
-                  //Host name resolution failed
-                  entry->state = DNS_STATE_FAILED;
-               }
+            //Unknown protocol?
+            {
+               error = ERROR_FAILURE;
             }
-#if (DNS_CLIENT_SUPPORT == ENABLED)
-            //DNS resolver?
-            else if(entry->protocol == HOST_NAME_RESOLVER_DNS)
+
+            //Query message successfully sent?
+            if(!error)
             {
-               //Select the next DNS server
-               dnsSelectNextServer(entry);
+               //Save the time at which the query message was sent
+               entry->timestamp = time;
+               //The timeout value is doubled for each subsequent retransmission
+               entry->timeout = MIN(entry->timeout * 2, entry->maxTimeout);
+               //Decrement retransmission counter
+               entry->retransmitCount--;
             }
-#endif
             else
             {
                //Unregister UDP callback function
@@ -330,18 +505,275 @@ void dnsTick(void)
                entry->state = DNS_STATE_FAILED;
             }
          }
-      }
-      //Name successfully resolved?
-      else if(entry->state == DNS_STATE_RESOLVED)
-      {
-         //Check the lifetime of the current DNS cache entry
-         if(timeCompare(time, entry->timestamp + entry->timeout) >= 0)
+#if (DNS_CLIENT_SUPPORT == ENABLED)
+         //DNS resolver?
+         else if(entry->protocol == HOST_NAME_RESOLVER_DNS)
          {
-            //Periodically time out DNS cache entries
-            dnsDeleteEntry(entry);
+            //Select the next DNS server
+            dnsSelectNextServer(entry);
+         }
+#endif
+         else
+         {
+            //Unregister UDP callback function
+            if(entry->port != 0)
+            {
+               udpUnregisterRxCallback(entry->interface, entry->port);
+            }
+
+            //Host name resolution failed
+            entry->state = DNS_STATE_FAILED;
          }
       }
    }
+   //Name successfully resolved or known not to exist?
+   else if(entry->state == DNS_STATE_RESOLVED ||
+      entry->state == DNS_STATE_NEGATIVE)
+   {
+      //Check the lifetime of the current DNS cache entry
+      if(timeCompare(time, entry->timestamp + entry->timeout) >= 0)
+      {
+         //Periodically time out DNS cache entries
+         dnsDeleteEntry(entry);
+      }
+   }
+}
+
+
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+
+/**
+ * @brief Compute the hash value of a domain name
+ * @param[in] name NULL-terminated string that contains the domain name
+ * @return Case-insensitive hash value (FNV-1a)
+ **/
+
+uint32_t dnsHashName(const char_t *name)
+{
+   uint32_t h;
+
+   //Initialize hash value
+   h = 2166136261;
+
+   //Domain names are compared in a case-insensitive manner
+   while(*name != '\0')
+   {
+      h ^= (uint8_t) osTolower(*name);
+      h *= 16777619;
+      name++;
+   }
+
+   //Return the resulting hash value
+   return h;
+}
+
+
+/**
+ * @brief Add a DNS cache entry to the domain name index
+ * @param[in] entry Pointer to the DNS cache entry
+ **/
+
+void dnsLinkEntry(DnsCacheEntry *entry)
+{
+   uint_t k;
+
+   //Check whether the entry is already linked
+   if(!entry->indexed)
+   {
+      //Compute the hash value of the domain name
+      entry->hash = dnsHashName(entry->name);
+      //Select the relevant hash bucket
+      k = entry->hash & (DNS_CACHE_HASH_TABLE_SIZE - 1);
+
+      //Insert the entry at the head of the bucket
+      entry->next = dnsCacheHashTable[k];
+      dnsCacheHashTable[k] = entry;
+
+      //The entry is now linked
+      entry->indexed = TRUE;
+   }
+}
+
+
+/**
+ * @brief Remove a DNS cache entry from the domain name index
+ * @param[in] entry Pointer to the DNS cache entry
+ **/
+
+void dnsUnlinkEntry(DnsCacheEntry *entry)
+{
+   DnsCacheEntry **p;
+
+   //Check whether the entry is linked
+   if(entry->indexed)
+   {
+      //Point to the head of the relevant hash bucket
+      p = &dnsCacheHashTable[entry->hash & (DNS_CACHE_HASH_TABLE_SIZE - 1)];
+
+      //Search the bucket for the specified entry
+      while(*p != NULL && *p != entry)
+      {
+         p = &(*p)->next;
+      }
+
+      //Unlink the entry
+      if(*p != NULL)
+      {
+         *p = entry->next;
+      }
+
+      //The entry is no longer linked
+      entry->next = NULL;
+      entry->indexed = FALSE;
+   }
+}
+
+
+/**
+ * @brief Insert or reposition a DNS cache entry in the timer heap
+ * @param[in] entry Pointer to the DNS cache entry
+ **/
+
+void dnsScheduleEntry(DnsCacheEntry *entry)
+{
+   uint_t i;
+
+   //Check whether the entry is already present in the timer heap
+   if(entry->heapIndex == 0)
+   {
+      //Append the entry to the timer heap
+      i = dnsCacheHeapSize++;
+      dnsCacheHeap[i] = entry;
+      entry->heapIndex = i + 1;
+   }
+   else
+   {
+      //Retrieve the position of the entry
+      i = entry->heapIndex - 1;
+   }
+
+   //The expiration time may have moved in either direction
+   dnsSiftUpEntry(i);
+   dnsSiftDownEntry(entry->heapIndex - 1);
+}
+
+
+/**
+ * @brief Remove a DNS cache entry from the timer heap
+ * @param[in] entry Pointer to the DNS cache entry
+ **/
+
+void dnsUnscheduleEntry(DnsCacheEntry *entry)
+{
+   uint_t i;
+   DnsCacheEntry *last;
+
+   //Check whether the entry is present in the timer heap
+   if(entry->heapIndex != 0)
+   {
+      //Retrieve the position of the entry
+      i = entry->heapIndex - 1;
+      //The entry is no longer present in the timer heap
+      entry->heapIndex = 0;
+
+      //Remove the last entry of the timer heap
+      last = dnsCacheHeap[--dnsCacheHeapSize];
+
+      //Fill the hole with the last entry
+      if(last != entry)
+      {
+         dnsCacheHeap[i] = last;
+         last->heapIndex = i + 1;
+
+         //Restore the heap property
+         dnsSiftUpEntry(i);
+         dnsSiftDownEntry(last->heapIndex - 1);
+      }
+   }
 }
 
+
+/**
+ * @brief Move an entry of the timer heap towards the root
+ * @param[in] i Position of the entry in the timer heap
+ **/
+
+void dnsSiftUpEntry(uint_t i)
+{
+   uint_t parent;
+   DnsCacheEntry *entry;
+
+   //Point to the entry to be moved
+   entry = dnsCacheHeap[i];
+
+   //Move the entry up as long as it expires before its parent
+   while(i > 0)
+   {
+      //Position of the parent entry
+      parent = (i - 1) / 2;
+
+      //The heap property is satisfied?
+      if(timeCompare(entry->deadline, dnsCacheHeap[parent]->deadline) >= 0)
+         break;
+
+      //Move the parent entry down
+      dnsCacheHeap[i] = dnsCacheHeap[parent];
+      dnsCacheHeap[i]->heapIndex = i + 1;
+
+      //Continue with the parent position
+      i = parent;
+   }
+
+   //Save the final position of the entry
+   dnsCacheHeap[i] = entry;
+   entry->heapIndex = i + 1;
+}
+
+
+/**
+ * @brief Move an entry of the timer heap towards the leaves
+ * @param[in] i Position of the entry in the timer heap
+ **/
+
+void dnsSiftDownEntry(uint_t i)
+{
+   uint_t child;
+   DnsCacheEntry *entry;
+
+   //Point to the entry to be moved
+   entry = dnsCacheHeap[i];
+
+   //Move the entry down as long as one of its children expires first
+   while((2 * i + 1) < dnsCacheHeapSize)
+   {
+      //Position of the left child
+      child = 2 * i + 1;
+
+      //Select the child that expires first
+      if((child + 1) < dnsCacheHeapSize &&
+         timeCompare(dnsCacheHeap[child + 1]->deadline,
+         dnsCacheHeap[child]->deadline) < 0)
+      {
+         child++;
+      }
+
+      //The heap property is satisfied?
+      if(timeCompare(dnsCacheHeap[child]->deadline, entry->deadline) >= 0)
+         break;
+
+      //Move the child entry up
+      dnsCacheHeap[i] = dnsCacheHeap[child];
+      dnsCacheHeap[i]->heapIndex = i + 1;
+
+      //Continue with the child position
+      i = child;
+   }
+
+   //Save the final position of the entry
+   dnsCacheHeap[i] = entry;
+   entry->heapIndex = i + 1;
+}
+
+#endif
+
 #endif
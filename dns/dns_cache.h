@@ -49,6 +49,21 @@
    #error DNS_CACHE_SIZE parameter is not valid
 #endif
 
+//DNS cache index support
+#ifndef DNS_CACHE_INDEX_SUPPORT
+   #define DNS_CACHE_INDEX_SUPPORT DISABLED
+#elif (DNS_CACHE_INDEX_SUPPORT != ENABLED && DNS_CACHE_INDEX_SUPPORT != DISABLED)
+   #error DNS_CACHE_INDEX_SUPPORT parameter is not valid
+#endif
+
+//Number of buckets in the domain name index (must be a power of 2)
+#ifndef DNS_CACHE_HASH_TABLE_SIZE
+   #define DNS_CACHE_HASH_TABLE_SIZE 16
+#elif (DNS_CACHE_HASH_TABLE_SIZE < 1 || \
+   (DNS_CACHE_HASH_TABLE_SIZE & (DNS_CACHE_HASH_TABLE_SIZE - 1)) != 0)
+   #error DNS_CACHE_HASH_TABLE_SIZE parameter is not valid
+#endif
+
 //Maximum length of domain names
 #ifndef DNS_MAX_NAME_LEN
    #define DNS_MAX_NAME_LEN 63
@@ -86,7 +101,8 @@ typedef enum
    DNS_STATE_IN_PROGRESS = 1,
    DNS_STATE_RESOLVED    = 2,
    DNS_STATE_FAILED      = 3,
-   DNS_STATE_PERMANENT   = 4
+   DNS_STATE_PERMANENT   = 4,
+   DNS_STATE_NEGATIVE    = 5
 } DnsState;
 
 
@@ -94,7 +110,9 @@ typedef enum
  * @brief DNS cache entry
  **/
 
-typedef struct
+typedef struct _DnsCacheEntry DnsCacheEntry;
+
+struct _DnsCacheEntry
 {
    DnsState state;                    ///<Entry state
    uint_t refCount;                   ///<Reference count for the current entry
@@ -102,6 +120,7 @@ typedef struct
    HostnameResolver protocol;         ///<Name resolution protocol
    NetInterface *interface;           ///<Underlying network interface
    uint_t dnsServerIndex;             ///<This parameter selects between the primary and secondary DNS server
+   uint_t serverCount;                ///<Number of DNS servers queried in parallel that have not answered yet
    uint16_t port;                     ///<Port number used by the resolver
    uint16_t id;                       ///<Identifier used to match queries and responses
    char_t name[DNS_MAX_NAME_LEN + 1]; ///<Domain name
@@ -110,24 +129,51 @@ typedef struct
    systime_t timeout;                 ///<Retransmission timeout
    systime_t maxTimeout;              ///<Maximum retransmission timeout
    uint_t retransmitCount;            ///<Retransmission counter
-} DnsCacheEntry;
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+   bool_t indexed;                    ///<The entry is linked in the domain name index
+   uint32_t hash;                     ///<Case-insensitive hash of the domain name
+   DnsCacheEntry *next;               ///<Next entry in the same hash bucket
+   uint_t heapIndex;                  ///<Position in the timer heap (plus one)
+   systime_t deadline;                ///<Time at which the timer heap expires the entry
+#endif
+};
 
 
 //Global variables
 extern DnsCacheEntry dnsCache[DNS_CACHE_SIZE];
+extern uint_t dnsCacheSize;
+
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+extern DnsCacheEntry *dnsCacheHashTable[DNS_CACHE_HASH_TABLE_SIZE];
+extern DnsCacheEntry *dnsCacheHeap[DNS_CACHE_SIZE];
+extern uint_t dnsCacheHeapSize;
+#endif
 
 //DNS related functions
 error_t dnsInit(void);
+error_t dnsSetCacheSize(uint_t size);
 
 void dnsFlushCache(NetInterface *interface);
 
 DnsCacheEntry *dnsCreateEntry(void);
 void dnsDeleteEntry(DnsCacheEntry *entry);
+void dnsUpdateEntry(DnsCacheEntry *entry);
 
 DnsCacheEntry *dnsFindEntry(NetInterface *interface,
    const char_t *name, HostType type, HostnameResolver protocol);
 
 void dnsTick(void);
+void dnsProcessEntryTimer(DnsCacheEntry *entry, systime_t time);
+
+#if (DNS_CACHE_INDEX_SUPPORT == ENABLED)
+uint32_t dnsHashName(const char_t *name);
+void dnsLinkEntry(DnsCacheEntry *entry);
+void dnsUnlinkEntry(DnsCacheEntry *entry);
+void dnsScheduleEntry(DnsCacheEntry *entry);
+void dnsUnscheduleEntry(DnsCacheEntry *entry);
+void dnsSiftUpEntry(uint_t i);
+void dnsSiftDownEntry(uint_t i);
+#endif
 
 //C++ guard
 #ifdef __cplusplus
@@ -55,10 +55,10 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
    HostType type, IpAddr *ipAddr)
 {
    error_t error;
-   DnsCacheEntry *entry;
 
 #if (NET_RTOS_SUPPORT == ENABLED)
    systime_t delay;
+   DnsCacheEntry *entry;
 
    //Debug message
    TRACE_INFO("Resolving host name %s (DNS resolver)...\r\n", name);
@@ -67,6 +67,229 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
    //Get exclusive access
    netLock(interface->netContext);
 
+   //Search the DNS cache for the specified host name, or send a new query
+   error = dnsResolveEntry(interface, name, type, ipAddr);
+
+#if (NET_RTOS_SUPPORT == ENABLED)
+   //Host name resolution in progress?
+   if(error == ERROR_IN_PROGRESS)
+   {
+      //Search the DNS cache for the specified host name
+      entry = dnsFindEntry(interface, name, type, HOST_NAME_RESOLVER_DNS);
+
+      //Increment the reference count
+      if(entry != NULL)
+      {
+         entry->refCount++;
+      }
+   }
+#endif
+
+   //Release exclusive access
+   netUnlock(interface->netContext);
+
+#if (NET_RTOS_SUPPORT == ENABLED)
+   //Set default polling interval
+   delay = DNS_CACHE_INIT_POLLING_INTERVAL;
+
+   //Wait the host name resolution to complete
+   while(error == ERROR_IN_PROGRESS)
+   {
+      //Wait until the next polling period
+      osDelayTask(delay);
+
+      //Get exclusive access
+      netLock(interface->netContext);
+
+      //Search the DNS cache for the specified host name
+      entry = dnsFindEntry(interface, name, type, HOST_NAME_RESOLVER_DNS);
+
+      //Check whether a matching entry has been found
+      if(entry != NULL)
+      {
+         //Host name successfully resolved?
+         if(entry->state == DNS_STATE_RESOLVED)
+         {
+            //Return the corresponding IP address
+            *ipAddr = entry->ipAddr;
+            //Successful host name resolution
+            error = NO_ERROR;
+         }
+         else if(entry->state == DNS_STATE_NEGATIVE)
+         {
+            //The domain name is known not to exist (negative caching)
+            error = ERROR_FAILURE;
+         }
+         else if(entry->state == DNS_STATE_FAILED)
+         {
+            //Decrement the reference count
+            if(entry->refCount > 0)
+            {
+               entry->refCount--;
+            }
+
+            //The entry should be deleted since name resolution has failed
+            if(entry->refCount == 0)
+            {
+               dnsDeleteEntry(entry);
+            }
+
+            //Report an error
+            error = ERROR_FAILURE;
+         }
+         else
+         {
+            //Host name resolution is in progress
+         }
+      }
+      else
+      {
+         //Host name resolution failed
+         error = ERROR_FAILURE;
+      }
+
+      //Release exclusive access
+      netUnlock(interface->netContext);
+
+      //Backoff support for less aggressive polling
+      delay = MIN(delay * 2, DNS_CACHE_MAX_POLLING_INTERVAL);
+   }
+
+   //Check status code
+   if(error)
+   {
+      //Failed to resolve host name
+      TRACE_INFO("Host name resolution failed!\r\n");
+   }
+   else
+   {
+      //Successful host name resolution
+      TRACE_INFO("Host name resolved to %s...\r\n", ipAddrToString(ipAddr, NULL));
+   }
+#endif
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Resolve a host name using DNS without blocking
+ *
+ * This function never blocks the calling task. It returns ERROR_IN_PROGRESS
+ * as long as the host name resolution is pending, and may be called again
+ * later with the same parameters to poll the result. When HOST_TYPE_ANY is
+ * specified, A and AAAA queries are issued in parallel. The IPv6 address is
+ * preferred, but the IPv4 address is returned if the AAAA query fails or if
+ * it is still pending DNS_CLIENT_RESOLUTION_DELAY after the IPv4 address has
+ * been resolved (refer to RFC 8305, section 3)
+ *
+ * @param[in] interface Underlying network interface
+ * @param[in] name Name of the host to be resolved
+ * @param[in] type Host type (IPv4, IPv6 or any)
+ * @param[out] ipAddr IP address corresponding to the specified host name
+ * @return Error code
+ **/
+
+error_t dnsResolveAsync(NetInterface *interface, const char_t *name,
+   HostType type, IpAddr *ipAddr)
+{
+   error_t error;
+#if (IPV4_SUPPORT == ENABLED && IPV6_SUPPORT == ENABLED)
+   error_t error4;
+   error_t error6;
+   IpAddr ipAddr4;
+   DnsCacheEntry *entry;
+#endif
+
+   //Get exclusive access
+   netLock(interface->netContext);
+
+#if (IPV4_SUPPORT == ENABLED && IPV6_SUPPORT == ENABLED)
+   //Dual-stack host name resolution?
+   if(type == HOST_TYPE_ANY)
+   {
+      //Issue A and AAAA queries in parallel
+      error6 = dnsPollEntry(interface, name, HOST_TYPE_IPV6, ipAddr);
+      error4 = dnsPollEntry(interface, name, HOST_TYPE_IPV4, &ipAddr4);
+
+      //IPv6 address successfully resolved?
+      if(!error6)
+      {
+         //The IPv6 address is preferred
+         error = NO_ERROR;
+      }
+      else if(!error4)
+      {
+         //Search the DNS cache for the IPv4 entry
+         entry = dnsFindEntry(interface, name, HOST_TYPE_IPV4,
+            HOST_NAME_RESOLVER_DNS);
+
+         //Give the AAAA query a chance to complete before falling back to
+         //the IPv4 address
+         if(error6 == ERROR_IN_PROGRESS && entry != NULL &&
+            timeCompare(osGetSystemTime(), entry->timestamp +
+            DNS_CLIENT_RESOLUTION_DELAY) < 0)
+         {
+            //Host name resolution is in progress
+            error = ERROR_IN_PROGRESS;
+         }
+         else
+         {
+            //Return the IPv4 address
+            *ipAddr = ipAddr4;
+            //Successful host name resolution
+            error = NO_ERROR;
+         }
+      }
+      else if(error4 == ERROR_IN_PROGRESS || error6 == ERROR_IN_PROGRESS)
+      {
+         //Host name resolution is in progress
+         error = ERROR_IN_PROGRESS;
+      }
+      else
+      {
+         //Host name resolution failed
+         error = ERROR_FAILURE;
+      }
+
+      //Once the resolution is complete, failed entries can be deleted
+      if(error != ERROR_IN_PROGRESS)
+      {
+         dnsReleaseEntry(interface, name, HOST_TYPE_IPV4);
+         dnsReleaseEntry(interface, name, HOST_TYPE_IPV6);
+      }
+   }
+   else
+#endif
+   {
+      //Search the DNS cache for the specified host name, or send a new query
+      error = dnsResolveEntry(interface, name, type, ipAddr);
+   }
+
+   //Release exclusive access
+   netUnlock(interface->netContext);
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Search the DNS cache for a host name, or send a new DNS query
+ * @param[in] interface Underlying network interface
+ * @param[in] name Name of the host to be resolved
+ * @param[in] type Host type (IPv4 or IPv6)
+ * @param[out] ipAddr IP address corresponding to the specified host name
+ * @return Error code
+ **/
+
+error_t dnsResolveEntry(NetInterface *interface, const char_t *name,
+   HostType type, IpAddr *ipAddr)
+{
+   error_t error;
+   DnsCacheEntry *entry;
+
    //Search the DNS cache for the specified host name
    entry = dnsFindEntry(interface, name, type, HOST_NAME_RESOLVER_DNS);
 
@@ -82,6 +305,11 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
          //Successful host name resolution
          error = NO_ERROR;
       }
+      else if(entry->state == DNS_STATE_NEGATIVE)
+      {
+         //The domain name is known not to exist (negative caching)
+         error = ERROR_FAILURE;
+      }
       else if(entry->state == DNS_STATE_FAILED)
       {
          //The entry should be deleted since name resolution has failed
@@ -96,10 +324,6 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
       }
       else
       {
-#if (NET_RTOS_SUPPORT == ENABLED)
-         //Increment the reference count
-         entry->refCount++;
-#endif
          //Host name resolution is in progress
          error = ERROR_IN_PROGRESS;
       }
@@ -153,10 +377,9 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
             //Switch state
             entry->state = DNS_STATE_IN_PROGRESS;
 
-#if (NET_RTOS_SUPPORT == ENABLED)
-            //Initialize the reference count
-            entry->refCount = 1;
-#endif
+            //Update the DNS cache index
+            dnsUpdateEntry(entry);
+
             //Host name resolution is in progress
             error = ERROR_IN_PROGRESS;
          }
@@ -168,89 +391,93 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
       }
    }
 
-   //Release exclusive access
-   netUnlock(interface->netContext);
+   //Return status code
+   return error;
+}
 
-#if (NET_RTOS_SUPPORT == ENABLED)
-   //Set default polling interval
-   delay = DNS_CACHE_INIT_POLLING_INTERVAL;
 
-   //Wait the host name resolution to complete
-   while(error == ERROR_IN_PROGRESS)
-   {
-      //Wait until the next polling period
-      osDelayTask(delay);
+/**
+ * @brief Poll the status of a DNS cache entry without deleting it
+ *
+ * Unlike dnsResolveEntry, this function keeps failed entries in the DNS
+ * cache so that no new query is issued while another query for the same
+ * host name is still pending
+ *
+ * @param[in] interface Underlying network interface
+ * @param[in] name Name of the host to be resolved
+ * @param[in] type Host type (IPv4 or IPv6)
+ * @param[out] ipAddr IP address corresponding to the specified host name
+ * @return Error code
+ **/
 
-      //Get exclusive access
-      netLock(interface->netContext);
+error_t dnsPollEntry(NetInterface *interface, const char_t *name,
+   HostType type, IpAddr *ipAddr)
+{
+   error_t error;
+   DnsCacheEntry *entry;
 
-      //Search the DNS cache for the specified host name
-      entry = dnsFindEntry(interface, name, type, HOST_NAME_RESOLVER_DNS);
+   //Search the DNS cache for the specified host name
+   entry = dnsFindEntry(interface, name, type, HOST_NAME_RESOLVER_DNS);
 
-      //Check whether a matching entry has been found
-      if(entry != NULL)
+   //Check whether a matching entry has been found
+   if(entry != NULL)
+   {
+      //Host name already resolved?
+      if(entry->state == DNS_STATE_RESOLVED ||
+         entry->state == DNS_STATE_PERMANENT)
       {
-         //Host name successfully resolved?
-         if(entry->state == DNS_STATE_RESOLVED)
-         {
-            //Return the corresponding IP address
-            *ipAddr = entry->ipAddr;
-            //Successful host name resolution
-            error = NO_ERROR;
-         }
-         else if(entry->state == DNS_STATE_FAILED)
-         {
-            //Decrement the reference count
-            if(entry->refCount > 0)
-            {
-               entry->refCount--;
-            }
-
-            //The entry should be deleted since name resolution has failed
-            if(entry->refCount == 0)
-            {
-               dnsDeleteEntry(entry);
-            }
-
-            //Report an error
-            error = ERROR_FAILURE;
-         }
-         else
-         {
-            //Host name resolution is in progress
-         }
+         //Return the corresponding IP address
+         *ipAddr = entry->ipAddr;
+         //Successful host name resolution
+         error = NO_ERROR;
       }
-      else
+      else if(entry->state == DNS_STATE_FAILED ||
+         entry->state == DNS_STATE_NEGATIVE)
       {
-         //Host name resolution failed
+         //Report an error
          error = ERROR_FAILURE;
       }
-
-      //Release exclusive access
-      netUnlock(interface->netContext);
-
-      //Backoff support for less aggressive polling
-      delay = MIN(delay * 2, DNS_CACHE_MAX_POLLING_INTERVAL);
-   }
-
-   //Check status code
-   if(error)
-   {
-      //Failed to resolve host name
-      TRACE_INFO("Host name resolution failed!\r\n");
+      else
+      {
+         //Host name resolution is in progress
+         error = ERROR_IN_PROGRESS;
+      }
    }
    else
    {
-      //Successful host name resolution
-      TRACE_INFO("Host name resolved to %s...\r\n", ipAddrToString(ipAddr, NULL));
+      //If no entry exists, then send a new query
+      error = dnsResolveEntry(interface, name, type, ipAddr);
    }
-#endif
 
    //Return status code
    return error;
 }
 
 
+/**
+ * @brief Delete a DNS cache entry whose resolution has failed
+ * @param[in] interface Underlying network interface
+ * @param[in] name Name of the host
+ * @param[in] type Host type (IPv4 or IPv6)
+ **/
+
+void dnsReleaseEntry(NetInterface *interface, const char_t *name,
+   HostType type)
+{
+   DnsCacheEntry *entry;
+
+   //Search the DNS cache for the specified host name
+   entry = dnsFindEntry(interface, name, type, HOST_NAME_RESOLVER_DNS);
+
+   //The entry should be deleted since name resolution has failed
+   if(entry != NULL && entry->state == DNS_STATE_FAILED &&
+      entry->refCount == 0)
+   {
+      dnsDeleteEntry(entry);
+   }
+}
+
+
 /**
  * @brief Send a DNS query message
  * @param[in] entry Pointer to a valid DNS cache entry
@@ -260,38 +487,89 @@ error_t dnsResolve(NetInterface *interface, const char_t *name,
 error_t dnsSendQuery(DnsCacheEntry *entry)
 {
    error_t error;
-   size_t length;
-   size_t offset;
-   NetBuffer *buffer;
-   DnsHeader *message;
-   DnsQuestion *dnsQuestion;
    IpAddr destIpAddr;
-   NetTxAncillary ancillary;
+#if (DNS_CLIENT_PARALLEL_QUERY_SUPPORT == ENABLED)
+   uint_t i;
+#endif
 
-#if (IPV4_SUPPORT == ENABLED)
-   //An IPv4 address is expected?
-   if(entry->type == HOST_TYPE_IPV4)
+   //Select the relevant DNS server
+   while(1)
    {
-      //Point to the IPv4 context
-      Ipv4Context *ipv4Context = &entry->interface->ipv4Context;
+      //Retrieve the address of the DNS server
+      error = dnsGetServerAddr(entry, entry->dnsServerIndex, &destIpAddr);
+
+      //Skip unspecified addresses
+      if(error != ERROR_INVALID_ADDRESS)
+         break;
 
-      //Select the relevant DNS server
-      while(1)
+      //Select the next DNS server in the list
+      entry->dnsServerIndex++;
+   }
+
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Send DNS query message to the selected DNS server
+   error = dnsSendQueryToServer(entry, &destIpAddr);
+
+#if (DNS_CLIENT_PARALLEL_QUERY_SUPPORT == ENABLED)
+   //Number of DNS servers that have been queried
+   entry->serverCount = error ? 0 : 1;
+
+   //Race the remaining DNS servers of the list
+   for(i = entry->dnsServerIndex + 1; ; i++)
+   {
+      //Retrieve the address of the DNS server
+      if(dnsGetServerAddr(entry, i, &destIpAddr) == ERROR_NO_DNS_SERVER)
+         break;
+
+      //Make sure the IP address is valid
+      if(destIpAddr.length != 0)
       {
-         //Out of range index?
-         if(entry->dnsServerIndex >= IPV4_DNS_SERVER_LIST_SIZE)
-            return ERROR_NO_DNS_SERVER;
+         //Send the same DNS query message to the current DNS server
+         if(!dnsSendQueryToServer(entry, &destIpAddr))
+         {
+            //The first usable answer will be accepted
+            entry->serverCount++;
+            error = NO_ERROR;
+         }
+      }
+   }
+#endif
+
+   //Return status code
+   return error;
+}
 
-         //Copy the address of the DNS server
-         destIpAddr.length = sizeof(Ipv4Addr);
-         destIpAddr.ipv4Addr = ipv4Context->dnsServerList[entry->dnsServerIndex];
 
-         //Make sure the IP address is valid
-         if(destIpAddr.ipv4Addr != IPV4_UNSPECIFIED_ADDR)
-            break;
+/**
+ * @brief Retrieve the address of a DNS server
+ * @param[in] entry Pointer to a valid DNS cache entry
+ * @param[in] index Index of the DNS server in the list
+ * @param[out] ipAddr IP address of the DNS server
+ * @return Error code
+ **/
+
+error_t dnsGetServerAddr(DnsCacheEntry *entry, uint_t index, IpAddr *ipAddr)
+{
+#if (IPV4_SUPPORT == ENABLED)
+   //An IPv4 address is expected?
+   if(entry->type == HOST_TYPE_IPV4)
+   {
+      //Out of range index?
+      if(index >= IPV4_DNS_SERVER_LIST_SIZE)
+         return ERROR_NO_DNS_SERVER;
 
-         //Select the next DNS server in the list
-         entry->dnsServerIndex++;
+      //Copy the address of the DNS server
+      ipAddr->length = sizeof(Ipv4Addr);
+      ipAddr->ipv4Addr = entry->interface->ipv4Context.dnsServerList[index];
+
+      //Make sure the IP address is valid
+      if(ipAddr->ipv4Addr == IPV4_UNSPECIFIED_ADDR)
+      {
+         ipAddr->length = 0;
+         return ERROR_INVALID_ADDRESS;
       }
    }
    else
@@ -300,26 +578,19 @@ error_t dnsSendQuery(DnsCacheEntry *entry)
    //An IPv6 address is expected?
    if(entry->type == HOST_TYPE_IPV6)
    {
-      //Point to the IPv6 context
-      Ipv6Context *ipv6Context = &entry->interface->ipv6Context;
-
-      //Select the relevant DNS server
-      while(1)
-      {
-         //Out of range index?
-         if(entry->dnsServerIndex >= IPV6_DNS_SERVER_LIST_SIZE)
-            return ERROR_NO_DNS_SERVER;
+      //Out of range index?
+      if(index >= IPV6_DNS_SERVER_LIST_SIZE)
+         return ERROR_NO_DNS_SERVER;
 
-         //Copy the address of the DNS server
-         destIpAddr.length = sizeof(Ipv6Addr);
-         destIpAddr.ipv6Addr = ipv6Context->dnsServerList[entry->dnsServerIndex];
+      //Copy the address of the DNS server
+      ipAddr->length = sizeof(Ipv6Addr);
+      ipAddr->ipv6Addr = entry->interface->ipv6Context.dnsServerList[index];
 
-         //Make sure the IP address is valid
-         if(!ipv6CompAddr(&destIpAddr.ipv6Addr, &IPV6_UNSPECIFIED_ADDR))
-            break;
-
-         //Select the next DNS server in the list
-         entry->dnsServerIndex++;
+      //Make sure the IP address is valid
+      if(ipv6CompAddr(&ipAddr->ipv6Addr, &IPV6_UNSPECIFIED_ADDR))
+      {
+         ipAddr->length = 0;
+         return ERROR_INVALID_ADDRESS;
       }
    }
    else
@@ -330,6 +601,28 @@ error_t dnsSendQuery(DnsCacheEntry *entry)
       return ERROR_INVALID_PARAMETER;
    }
 
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Send a DNS query message to a given DNS server
+ * @param[in] entry Pointer to a valid DNS cache entry
+ * @param[in] destIpAddr IP address of the DNS server
+ * @return Error code
+ **/
+
+error_t dnsSendQueryToServer(DnsCacheEntry *entry, const IpAddr *destIpAddr)
+{
+   error_t error;
+   size_t length;
+   size_t offset;
+   NetBuffer *buffer;
+   DnsHeader *message;
+   DnsQuestion *dnsQuestion;
+   NetTxAncillary ancillary;
+
    //Allocate a memory buffer to hold the DNS query message
    buffer = udpAllocBuffer(DNS_MESSAGE_MAX_SIZE, &offset);
    //Failed to allocate buffer?
@@ -400,7 +693,7 @@ error_t dnsSendQuery(DnsCacheEntry *entry)
 
    //Send DNS query message
    error = udpSendBuffer(entry->interface->netContext, entry->interface, NULL,
-      entry->port, &destIpAddr, DNS_PORT, buffer, offset, &ancillary);
+      entry->port, destIpAddr, DNS_PORT, buffer, offset, &ancillary);
 
    //Free previously allocated memory
    netBufferFree(buffer);
@@ -427,6 +720,9 @@ void dnsProcessResponse(NetInterface *interface,
    const NetBuffer *buffer, size_t offset, const NetRxAncillary *ancillary,
    void *param)
 {
+#if (DNS_NEGATIVE_CACHE_SUPPORT == ENABLED)
+   error_t error;
+#endif
    uint_t i;
    uint_t j;
    size_t pos;
@@ -518,6 +814,27 @@ void dnsProcessResponse(NetInterface *interface,
             //Check response code
             if(message->rcode != DNS_RCODE_NOERROR)
             {
+#if (DNS_NEGATIVE_CACHE_SUPPORT == ENABLED)
+               //Name error (refer to RFC 2308, section 2.1)
+               if(message->rcode == DNS_RCODE_NXDOMAIN)
+               {
+                  //Cache the negative response
+                  error = dnsParseNegativeResponse(entry, message, length,
+                     pos + sizeof(DnsQuestion));
+
+                  //Negative response successfully cached?
+                  if(!error)
+                     break;
+               }
+#endif
+#if (DNS_CLIENT_PARALLEL_QUERY_SUPPORT == ENABLED)
+               //Wait for the other DNS servers to answer
+               if(entry->serverCount > 1)
+               {
+                  entry->serverCount--;
+                  break;
+               }
+#endif
                //Select the next DNS server
                dnsSelectNextServer(entry);
                //Exit immediately
@@ -573,6 +890,9 @@ void dnsProcessResponse(NetInterface *interface,
                      //Host name successfully resolved
                      entry->state = DNS_STATE_RESOLVED;
 
+                     //Update the DNS cache index
+                     dnsUpdateEntry(entry);
+
                      //Exit immediately
                      break;
                   }
@@ -604,6 +924,9 @@ void dnsProcessResponse(NetInterface *interface,
                      //Host name successfully resolved
                      entry->state = DNS_STATE_RESOLVED;
 
+                     //Update the DNS cache index
+                     dnsUpdateEntry(entry);
+
                      //Exit immediately
                      break;
                   }
@@ -613,6 +936,19 @@ void dnsProcessResponse(NetInterface *interface,
                pos += ntohs(record->rdlength);
             }
 
+#if (DNS_NEGATIVE_CACHE_SUPPORT == ENABLED)
+            //No relevant answer found in the response?
+            if(entry->state == DNS_STATE_IN_PROGRESS)
+            {
+               //Point to the first answer
+               pos = dnsParseName(message, length, sizeof(DnsHeader), NULL, 0);
+
+               //No data (refer to RFC 2308, section 2.2)
+               dnsParseNegativeResponse(entry, message, length,
+                  pos + sizeof(DnsQuestion));
+            }
+#endif
+
             //We are done
             break;
          }
@@ -638,6 +974,10 @@ void dnsSelectNextServer(DnsCacheEntry *entry)
    DNS_SELECT_NEXT_SERVER_HOOK(entry);
 #endif
 
+#if (DNS_CLIENT_PARALLEL_QUERY_SUPPORT == ENABLED)
+   //All the DNS servers have already been queried in parallel
+   error = ERROR_NO_DNS_SERVER;
+#else
    //Select the next DNS server
    entry->dnsServerIndex++;
 
@@ -649,6 +989,7 @@ void dnsSelectNextServer(DnsCacheEntry *entry)
    entry->retransmitCount = DNS_CLIENT_MAX_RETRIES;
    //Send DNS query
    error = dnsSendQuery(entry);
+#endif
 
    //DNS message successfully sent?
    if(!error)
@@ -667,6 +1008,114 @@ void dnsSelectNextServer(DnsCacheEntry *entry)
       //Host name resolution failed
       entry->state = DNS_STATE_FAILED;
    }
+
+   //Update the DNS cache index
+   dnsUpdateEntry(entry);
 }
 
+
+#if (DNS_NEGATIVE_CACHE_SUPPORT == ENABLED)
+
+/**
+ * @brief Cache a negative DNS response
+ *
+ * A negative response (name error or no data) is cached only when the
+ * authority section carries a SOA record. The lifetime of the entry is the
+ * minimum of the SOA TTL and of the SOA MINIMUM field (refer to RFC 2308,
+ * section 5)
+ *
+ * @param[in] entry Pointer to the DNS cache entry
+ * @param[in] message Pointer to the DNS response message
+ * @param[in] length Length of the DNS response message
+ * @param[in] pos Offset to the answer section
+ * @return Error code
+ **/
+
+error_t dnsParseNegativeResponse(DnsCacheEntry *entry,
+   const DnsHeader *message, size_t length, size_t pos)
+{
+   uint_t i;
+   uint_t n;
+   size_t p;
+   uint32_t ttl;
+   uint32_t minimum;
+   DnsResourceRecord *record;
+
+   //Total number of resource records in the answer and authority sections
+   n = ntohs(message->ancount) + ntohs(message->nscount);
+
+   //Parse resource records
+   for(i = 0; i < n; i++)
+   {
+      //Parse domain name
+      pos = dnsParseName(message, length, pos, NULL, 0);
+      //Invalid name?
+      if(!pos)
+         break;
+
+      //Point to the associated resource record
+      record = DNS_GET_RESOURCE_RECORD(message, pos);
+      //Point to the resource data
+      pos += sizeof(DnsResourceRecord);
+
+      //Make sure the resource record is valid
+      if(pos > length)
+         break;
+      if((pos + ntohs(record->rdlength)) > length)
+         break;
+
+      //SOA resource record found in the authority section?
+      if(i >= ntohs(message->ancount) &&
+         ntohs(record->rtype) == DNS_RR_TYPE_SOA &&
+         ntohs(record->rclass) == DNS_RR_CLASS_IN)
+      {
+         //Skip the MNAME and RNAME fields
+         p = dnsParseName(message, length, pos, NULL, 0);
+         //Invalid name?
+         if(!p)
+            break;
+
+         p = dnsParseName(message, length, p, NULL, 0);
+         //Invalid name?
+         if(!p)
+            break;
+
+         //The RNAME field is followed by SERIAL, REFRESH, RETRY, EXPIRE
+         //and MINIMUM fields
+         if((p + 20) > (pos + ntohs(record->rdlength)))
+            break;
+
+         //Retrieve the value of the MINIMUM field
+         minimum = LOAD32BE((uint8_t *) message + p + 16);
+         //The TTL of the negative response is the minimum of the SOA TTL
+         //and the MINIMUM field
+         ttl = MIN(ntohl(record->ttl), minimum);
+
+         //Save current time
+         entry->timestamp = osGetSystemTime();
+         //Save TTL value
+         entry->timeout = MIN(ttl, DNS_NEGATIVE_MAX_LIFETIME / 1000) * 1000;
+
+         //Unregister UDP callback function
+         udpUnregisterRxCallback(entry->interface, entry->port);
+         //The domain name is known not to exist
+         entry->state = DNS_STATE_NEGATIVE;
+
+         //Update the DNS cache index
+         dnsUpdateEntry(entry);
+
+         //Successful processing
+         return NO_ERROR;
+      }
+
+      //Point to the next resource record
+      pos += ntohs(record->rdlength);
+   }
+
+   //Negative responses without SOA records should not be cached
+   return ERROR_NOT_FOUND;
+}
+
+#endif
+
 #endif
@@ -36,6 +36,7 @@
 #include "core/socket.h"
 #include "core/udp.h"
 #include "dns/dns_cache.h"
+#include "dns/dns_common.h"
 
 //DNS client support
 #ifndef DNS_CLIENT_SUPPORT
@@ -79,6 +80,34 @@
    #error DNS_MAX_LIFETIME parameter is not valid
 #endif
 
+//Parallel queries to all the configured DNS servers
+#ifndef DNS_CLIENT_PARALLEL_QUERY_SUPPORT
+   #define DNS_CLIENT_PARALLEL_QUERY_SUPPORT DISABLED
+#elif (DNS_CLIENT_PARALLEL_QUERY_SUPPORT != ENABLED && DNS_CLIENT_PARALLEL_QUERY_SUPPORT != DISABLED)
+   #error DNS_CLIENT_PARALLEL_QUERY_SUPPORT parameter is not valid
+#endif
+
+//Time to wait for a AAAA response after the A response has been received
+#ifndef DNS_CLIENT_RESOLUTION_DELAY
+   #define DNS_CLIENT_RESOLUTION_DELAY 50
+#elif (DNS_CLIENT_RESOLUTION_DELAY < 0)
+   #error DNS_CLIENT_RESOLUTION_DELAY parameter is not valid
+#endif
+
+//Negative caching support
+#ifndef DNS_NEGATIVE_CACHE_SUPPORT
+   #define DNS_NEGATIVE_CACHE_SUPPORT DISABLED
+#elif (DNS_NEGATIVE_CACHE_SUPPORT != ENABLED && DNS_NEGATIVE_CACHE_SUPPORT != DISABLED)
+   #error DNS_NEGATIVE_CACHE_SUPPORT parameter is not valid
+#endif
+
+//Maximum cache lifetime for negative responses
+#ifndef DNS_NEGATIVE_MAX_LIFETIME
+   #define DNS_NEGATIVE_MAX_LIFETIME 600000
+#elif (DNS_NEGATIVE_MAX_LIFETIME < 1000)
+   #error DNS_NEGATIVE_MAX_LIFETIME parameter is not valid
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -88,7 +117,21 @@ extern "C" {
 error_t dnsResolve(NetInterface *interface, const char_t *name,
    HostType type, IpAddr *ipAddr);
 
+error_t dnsResolveAsync(NetInterface *interface, const char_t *name,
+   HostType type, IpAddr *ipAddr);
+
+error_t dnsResolveEntry(NetInterface *interface, const char_t *name,
+   HostType type, IpAddr *ipAddr);
+
+error_t dnsPollEntry(NetInterface *interface, const char_t *name,
+   HostType type, IpAddr *ipAddr);
+
+void dnsReleaseEntry(NetInterface *interface, const char_t *name,
+   HostType type);
+
 error_t dnsSendQuery(DnsCacheEntry *entry);
+error_t dnsGetServerAddr(DnsCacheEntry *entry, uint_t index, IpAddr *ipAddr);
+error_t dnsSendQueryToServer(DnsCacheEntry *entry, const IpAddr *destIpAddr);
 
 void dnsProcessResponse(NetInterface *interface,
    const IpPseudoHeader *pseudoHeader, const UdpHeader *udpHeader,
@@ -97,6 +140,11 @@ void dnsProcessResponse(NetInterface *interface,
 
 void dnsSelectNextServer(DnsCacheEntry *entry);
 
+#if (DNS_NEGATIVE_CACHE_SUPPORT == ENABLED)
+error_t dnsParseNegativeResponse(DnsCacheEntry *entry,
+   const DnsHeader *message, size_t length, size_t pos);
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -470,6 +470,215 @@ int_t dnsCompareEncodedName(const DnsHeader *message1, size_t length1,
 }
 
 
+/**
+ * @brief Write a domain name using message compression
+ *
+ * The longest suffix of the name that already appears in the message is
+ * replaced by a pointer to the prior occurrence (refer to RFC 1035,
+ * section 4.1.4)
+ *
+ * @param[in] message Pointer to the DNS message
+ * @param[in] pos Offset where to write the name
+ * @param[in] name Domain name encoded using the DNS name notation (must not
+ *   overlap the message)
+ * @param[in] length Length of the encoded domain name
+ * @param[in,out] dictionary Offsets of the names already written to the message
+ * @return Number of bytes written to the message
+ **/
+
+size_t dnsCompressName(DnsHeader *message, size_t pos, const uint8_t *name,
+   size_t length, DnsNameDictionary *dictionary)
+{
+   size_t i;
+   size_t pointer;
+   uint8_t *p;
+
+   //Cast DNS message to byte array
+   p = (uint8_t *) message;
+
+   //Initialize pointer
+   pointer = 0;
+
+   //Loop through the labels of the name, starting with the longest suffix
+   for(i = 0; i < length && name[i] != 0; i += name[i] + 1)
+   {
+      //Search the dictionary for a matching suffix
+      pointer = dnsSearchNameDictionary(message, pos, name + i, dictionary);
+
+      //Any match found?
+      if(pointer != 0)
+         break;
+   }
+
+   //Compressed name?
+   if(pointer != 0)
+   {
+      //Copy the labels that precede the matching suffix
+      osMemcpy(p + pos, name, i);
+
+      //Write the pointer to the prior occurrence of the suffix
+      p[pos + i] = DNS_COMPRESSION_TAG | (uint8_t) (pointer >> 8);
+      p[pos + i + 1] = (uint8_t) pointer;
+
+      //Length of the compressed name
+      length = i + 2;
+   }
+   else
+   {
+      //The name is written uncompressed
+      osMemcpy(p + pos, name, length);
+      //Point to the end of the name
+      i = length;
+   }
+
+   //Pointers are limited to 14 bits. Names that are fully replaced by a
+   //pointer are not worth adding to the dictionary
+   if(i > 0 && pos < 0x4000)
+   {
+      //Check whether the dictionary is full
+      if(dictionary->count < DNS_NAME_COMPRESSION_DICT_SIZE)
+      {
+         //Save the offset of the name
+         dictionary->offset[dictionary->count++] = (uint16_t) pos;
+      }
+   }
+
+   //Return the number of bytes written to the message
+   return length;
+}
+
+
+/**
+ * @brief Search the compression dictionary for a given name
+ * @param[in] message Pointer to the DNS message
+ * @param[in] length Length of the DNS message
+ * @param[in] name Domain name encoded using the DNS name notation
+ * @param[in] dictionary Offsets of the names already written to the message
+ * @return Offset of a prior occurrence of the name, or 0 if not found
+ **/
+
+size_t dnsSearchNameDictionary(const DnsHeader *message, size_t length,
+   const uint8_t *name, const DnsNameDictionary *dictionary)
+{
+   uint_t i;
+   uint_t k;
+   size_t pos;
+   uint8_t *p;
+
+   //Cast DNS message to byte array
+   p = (uint8_t *) message;
+
+   //Loop through the dictionary
+   for(i = 0; i < dictionary->count; i++)
+   {
+      //Point to the first label of the current entry
+      pos = dictionary->offset[i];
+
+      //Any suffix of the entry may match the name
+      for(k = 0; pos < length && p[pos] != 0; )
+      {
+         //Compression tag found?
+         if(p[pos] >= DNS_COMPRESSION_TAG)
+         {
+            //Recursion limit exceeded?
+            if(++k > DNS_NAME_MAX_RECURSION || (pos + 1) >= length)
+               break;
+
+            //Follow the pointer
+            pos = ((p[pos] & ~DNS_COMPRESSION_TAG) << 8) | p[pos + 1];
+         }
+         else
+         {
+            //Compare the suffix with the name
+            if(pos < 0x4000 && dnsMatchEncodedName(message, length, pos, name))
+               return pos;
+
+            //Point to the next label
+            pos += p[pos] + 1;
+         }
+      }
+   }
+
+   //No matching name found
+   return 0;
+}
+
+
+/**
+ * @brief Check whether a name of the message matches a given name
+ *
+ * Labels are compared octet by octet, so that compression never alters the
+ * case of the names. Names that could not be decoded once referenced by an
+ * additional pointer (see DNS_NAME_MAX_RECURSION) are not considered
+ *
+ * @param[in] message Pointer to the DNS message
+ * @param[in] length Length of the DNS message
+ * @param[in] pos Offset of the name in the message
+ * @param[in] name Domain name encoded using the DNS name notation
+ * @return TRUE if the names are identical, else FALSE
+ **/
+
+bool_t dnsMatchEncodedName(const DnsHeader *message, size_t length,
+   size_t pos, const uint8_t *name)
+{
+   uint_t k;
+   size_t n;
+   uint8_t *p;
+
+   //Cast DNS message to byte array
+   p = (uint8_t *) message;
+
+   //The pointer to this name adds one level of indirection
+   k = 1;
+
+   //Compare encoded domain names
+   while(k < DNS_NAME_MAX_RECURSION && pos < length)
+   {
+      //Retrieve the length of the current label
+      n = p[pos];
+
+      //Compression tag found?
+      if(n >= DNS_COMPRESSION_TAG)
+      {
+         //Malformed DNS message?
+         if((pos + 1) >= length)
+            return FALSE;
+
+         //Increment the level of indirection
+         k++;
+
+         //Follow the pointer
+         pos = ((n & ~DNS_COMPRESSION_TAG) << 8) | p[pos + 1];
+      }
+      else
+      {
+         //Mismatching label length?
+         if(n != name[0])
+            return FALSE;
+
+         //End marker found?
+         if(n == 0)
+            return TRUE;
+
+         //Malformed DNS message?
+         if((pos + n + 1) > length)
+            return FALSE;
+
+         //Compare labels
+         if(osMemcmp(p + pos + 1, name + 1, n))
+            return FALSE;
+
+         //Point to the next label
+         pos += n + 1;
+         name += n + 1;
+      }
+   }
+
+   //Malformed DNS message or recursion limit exceeded
+   return FALSE;
+}
+
+
 /**
  * @brief Generate domain name for reverse DNS lookup (IPv4)
  * @param[in] ipv4Addr IPv4 address
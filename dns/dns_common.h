@@ -41,6 +41,13 @@
    #error DNS_NAME_MAX_RECURSION parameter is not valid
 #endif
 
+//Size of the name compression dictionary
+#ifndef DNS_NAME_COMPRESSION_DICT_SIZE
+   #define DNS_NAME_COMPRESSION_DICT_SIZE 16
+#elif (DNS_NAME_COMPRESSION_DICT_SIZE < 1)
+   #error DNS_NAME_COMPRESSION_DICT_SIZE parameter is not valid
+#endif
+
 //Maximum size of DNS messages
 #define DNS_MESSAGE_MAX_SIZE 512
 //Maximum size of names
@@ -279,6 +286,17 @@ typedef __packed_struct
    #pragma pack(pop)
 #endif
 
+/**
+ * @brief Name compression dictionary
+ **/
+
+typedef struct
+{
+   uint_t count;                                    ///<Number of entries
+   uint16_t offset[DNS_NAME_COMPRESSION_DICT_SIZE]; ///<Offsets of the names already written to the message
+} DnsNameDictionary;
+
+
 //DNS related functions
 size_t dnsEncodeName(const char_t *src, uint8_t *dest);
 
@@ -292,6 +310,15 @@ int_t dnsCompareEncodedName(const DnsHeader *message1, size_t length1,
    size_t pos1, const DnsHeader *message2, size_t length2, size_t pos2,
    uint_t level);
 
+size_t dnsCompressName(DnsHeader *message, size_t pos, const uint8_t *name,
+   size_t length, DnsNameDictionary *dictionary);
+
+size_t dnsSearchNameDictionary(const DnsHeader *message, size_t length,
+   const uint8_t *name, const DnsNameDictionary *dictionary);
+
+bool_t dnsMatchEncodedName(const DnsHeader *message, size_t length,
+   size_t pos, const uint8_t *name);
+
 void dnsGenerateIpv4ReverseName(Ipv4Addr ipv4Addr, char_t *buffer);
 void dnsGenerateIpv6ReverseName(const Ipv6Addr *ipv6Addr, char_t *buffer);
 
@@ -348,6 +348,9 @@ error_t dnsSdResponderRegisterService(DnsSdResponderContext *context,
       service->metadataLen = 1;
    }
 
+   //Precompute the wire format of the service records
+   dnsSdResponderCompileService(service);
+
    //Restart probing process
    dnsSdResponderStartProbing(context);
 
@@ -130,6 +130,12 @@ struct _DnsSdResponderService
    uint16_t port;                                         ///<Port on the target host of this service
    uint8_t metadata[DNS_SD_MAX_METADATA_LEN];             ///<Discovery-time metadata (TXT record)
    size_t metadataLen;                                    ///<Length of the metadata
+   uint8_t serviceFqdn[DNS_SD_MAX_SERVICE_NAME_LEN + 8];  ///<Service name (DNS encoded)
+   size_t serviceFqdnLen;                                 ///<Length of the encoded service name
+   uint8_t instanceFqdn[DNS_SD_MAX_INSTANCE_NAME_LEN +
+      DNS_SD_MAX_SERVICE_NAME_LEN + 9];                   ///<Service instance name (DNS encoded)
+   size_t instanceFqdnLen;                                ///<Length of the encoded service instance name
+   uint8_t srvData[6];                                    ///<Priority, Weight and Port fields of the SRV record
    bool_t conflict;                                       ///<Conflict detected
    bool_t tieBreakLost;                                   ///<Tie-break lost
    systime_t timestamp;                                   ///<Timestamp to manage retransmissions
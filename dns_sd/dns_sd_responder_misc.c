@@ -34,6 +34,7 @@
 //Dependencies
 #include "core/net.h"
 #include "mdns/mdns_responder.h"
+#include "mdns/mdns_responder_misc.h"
 #include "dns_sd/dns_sd_responder.h"
 #include "dns_sd/dns_sd_responder_misc.h"
 #include "debug.h"
@@ -150,6 +151,36 @@ void dnsSdResponderChangeInstanceName(DnsSdResponderService *service)
       //Programmatically change the service instance name
       osStrcat(service->instanceName, s);
    }
+
+   //The service records must be compiled again
+   dnsSdResponderCompileService(service);
+}
+
+
+/**
+ * @brief Precompute the wire format of the service records
+ *
+ * The encoded names and the fixed part of the SRV record are computed once,
+ * when the service is registered or renamed, so that records can be copied
+ * and compared as raw bytes
+ *
+ * @param[in] service Pointer to a DNS-SD service
+ **/
+
+void dnsSdResponderCompileService(DnsSdResponderService *service)
+{
+   //Encode the service name using the DNS name notation
+   service->serviceFqdnLen = mdnsEncodeName("", service->serviceName,
+      ".local", service->serviceFqdn);
+
+   //Encode the service instance name using the DNS name notation
+   service->instanceFqdnLen = mdnsEncodeName(service->instanceName,
+      service->serviceName, ".local", service->instanceFqdn);
+
+   //Format the Priority, Weight and Port fields of the SRV record
+   STORE16BE(service->priority, service->srvData);
+   STORE16BE(service->weight, service->srvData + 2);
+   STORE16BE(service->port, service->srvData + 4);
 }
 
 
@@ -881,15 +912,15 @@ error_t dnsSdResponderFormatServiceEnumPtrRecord(NetInterface *interface,
    p = (uint8_t *) message->dnsHeader + message->length;
    offset = message->length;
 
-   //The first pass calculates the length of the DNS encoded service name
-   n = mdnsEncodeName("", service->serviceName, ".local", NULL);
+   //Retrieve the length of the DNS encoded service name
+   n = service->serviceFqdnLen;
 
    //Sanity check
    if((message->length + n) > MDNS_MESSAGE_MAX_SIZE)
       return ERROR_MESSAGE_TOO_LONG;
 
-   //The second pass encodes the service name using DNS notation
-   n = mdnsEncodeName("", service->serviceName, ".local", p);
+   //Copy the service name encoded using DNS notation
+   osMemcpy(p, service->serviceFqdn, n);
 
    //Check whether the resource record is already present in the Answer
    //Section of the message
@@ -929,15 +960,15 @@ error_t dnsSdResponderFormatServiceEnumPtrRecord(NetInterface *interface,
       //Advance write index
       offset += sizeof(DnsResourceRecord);
 
-      //The first pass calculates the length of the DNS encoded service name
-      n = mdnsEncodeName("", service->serviceName, ".local", NULL);
+      //Retrieve the length of the DNS encoded service name
+      n = service->serviceFqdnLen;
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the service name using DNS notation
-      n = mdnsEncodeName("", service->serviceName, ".local", record->rdata);
+      //Copy the service name encoded using DNS notation
+      osMemcpy(record->rdata, service->serviceFqdn, n);
 
       //Convert length field to network byte order
       record->rdlength = htons(n);
@@ -975,16 +1006,15 @@ error_t dnsSdResponderFormatPtrRecord(NetInterface *interface,
    p = (uint8_t *) message->dnsHeader + message->length;
    offset = message->length;
 
-   //The first pass calculates the length of the DNS encoded instance name
-   n = mdnsEncodeName(service->instanceName, service->serviceName, ".local",
-      NULL);
+   //Retrieve the length of the DNS encoded instance name
+   n = service->instanceFqdnLen;
 
    //Sanity check
    if((message->length + n) > MDNS_MESSAGE_MAX_SIZE)
       return ERROR_MESSAGE_TOO_LONG;
 
-   //The second pass encodes the instance name using DNS notation
-   n = mdnsEncodeName(service->instanceName, service->serviceName, ".local", p);
+   //Copy the instance name encoded using DNS notation
+   osMemcpy(p, service->instanceFqdn, n);
 
    //Check whether the resource record is already present in the Answer
    //Section of the message
@@ -995,15 +1025,16 @@ error_t dnsSdResponderFormatPtrRecord(NetInterface *interface,
    //appear only once in the list
    if(!duplicate)
    {
-      //The first pass calculates the length of the DNS encoded service name
-      n = mdnsEncodeName("", service->serviceName, ".local", NULL);
+      //Retrieve the length of the DNS encoded service name
+      n = service->serviceFqdnLen;
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the service name using the DNS name notation
-      offset += mdnsEncodeName("", service->serviceName, ".local", p);
+      //Copy the service name encoded using the DNS name notation
+      osMemcpy(p, service->serviceFqdn, n);
+      offset += n;
 
       //Consider the length of the resource record itself
       if((offset + sizeof(DnsResourceRecord)) > MDNS_MESSAGE_MAX_SIZE)
@@ -1020,17 +1051,15 @@ error_t dnsSdResponderFormatPtrRecord(NetInterface *interface,
       //Advance write index
       offset += sizeof(DnsResourceRecord);
 
-      //The first pass calculates the length of the DNS encoded instance name
-      n = mdnsEncodeName(service->instanceName, service->serviceName, ".local",
-         NULL);
+      //Retrieve the length of the DNS encoded instance name
+      n = service->instanceFqdnLen;
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the instance name using DNS notation
-      n = mdnsEncodeName(service->instanceName, service->serviceName, ".local",
-         record->rdata);
+      //Copy the instance name encoded using DNS notation
+      osMemcpy(record->rdata, service->instanceFqdn, n);
 
       //Convert length field to network byte order
       record->rdlength = htons(n);
@@ -1081,17 +1110,17 @@ error_t dnsSdResponderFormatSrvRecord(NetInterface *interface,
       //Set the position to the end of the buffer
       offset = message->length;
 
-      //The first pass calculates the length of the DNS encoded instance name
-      n = mdnsEncodeName(service->instanceName, service->serviceName,
-         ".local", NULL);
+      //Retrieve the length of the DNS encoded instance name
+      n = service->instanceFqdnLen;
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the instance name using DNS notation
-      offset += mdnsEncodeName(service->instanceName, service->serviceName,
-         ".local", (uint8_t *) message->dnsHeader + offset);
+      //Copy the instance name encoded using DNS notation
+      osMemcpy((uint8_t *) message->dnsHeader + offset, service->instanceFqdn,
+         n);
+      offset += n;
 
       //Consider the length of the resource record itself
       if((offset + sizeof(DnsSrvResourceRecord)) > MDNS_MESSAGE_MAX_SIZE)
@@ -1105,9 +1134,9 @@ error_t dnsSdResponderFormatSrvRecord(NetInterface *interface,
       record->rtype = HTONS(DNS_RR_TYPE_SRV);
       record->rclass = HTONS(DNS_RR_CLASS_IN);
       record->ttl = htonl(ttl);
-      record->priority = htons(service->priority);
-      record->weight = htons(service->weight);
-      record->port = htons(service->port);
+
+      //Copy the Priority, Weight and Port fields
+      osMemcpy(&record->priority, service->srvData, sizeof(service->srvData));
 
       //Check whether the cache-flush bit should be set
       if(cacheFlush)
@@ -1118,16 +1147,15 @@ error_t dnsSdResponderFormatSrvRecord(NetInterface *interface,
       //Advance write index
       offset += sizeof(DnsSrvResourceRecord);
 
-      //The first pass calculates the length of the DNS encoded target name
-      n = mdnsEncodeName("", mdnsResponderContext->hostname, ".local", NULL);
+      //Retrieve the length of the DNS encoded target name
+      n = mdnsResponderEncodeHostname(mdnsResponderContext, NULL);
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the target name using DNS notation
-      n = mdnsEncodeName("", mdnsResponderContext->hostname, ".local",
-         record->target);
+      //Copy the target name encoded using DNS notation
+      n = mdnsResponderEncodeHostname(mdnsResponderContext, record->target);
 
       //Calculate data length
       record->rdlength = htons(sizeof(DnsSrvResourceRecord) -
@@ -1175,17 +1203,17 @@ error_t dnsSdResponderFormatTxtRecord(NetInterface *interface,
       //Set the position to the end of the buffer
       offset = message->length;
 
-      //The first pass calculates the length of the DNS encoded instance name
-      n = mdnsEncodeName(service->instanceName, service->serviceName, ".local",
-         NULL);
+      //Retrieve the length of the DNS encoded instance name
+      n = service->instanceFqdnLen;
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the instance name using DNS notation
-      offset += mdnsEncodeName(service->instanceName, service->serviceName,
-         ".local", (uint8_t *) message->dnsHeader + offset);
+      //Copy the instance name encoded using DNS notation
+      osMemcpy((uint8_t *) message->dnsHeader + offset, service->instanceFqdn,
+         n);
+      offset += n;
 
       //Consider the length of the resource record itself
       if((offset + sizeof(DnsResourceRecord)) > MDNS_MESSAGE_MAX_SIZE)
@@ -1278,17 +1306,17 @@ error_t dnsSdResponderFormatNsecRecord(NetInterface *interface,
       //Set the position to the end of the buffer
       offset = message->length;
 
-      //The first pass calculates the length of the DNS encoded instance name
-      n = mdnsEncodeName(service->instanceName, service->serviceName, ".local",
-         NULL);
+      //Retrieve the length of the DNS encoded instance name
+      n = service->instanceFqdnLen;
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the instance name using the DNS name notation
-      offset += mdnsEncodeName(service->instanceName, service->serviceName,
-         ".local", (uint8_t *) message->dnsHeader + offset);
+      //Copy the instance name encoded using the DNS name notation
+      osMemcpy((uint8_t *) message->dnsHeader + offset, service->instanceFqdn,
+         n);
+      offset += n;
 
       //Consider the length of the resource record itself
       if((offset + sizeof(DnsResourceRecord)) > MDNS_MESSAGE_MAX_SIZE)
@@ -1316,8 +1344,7 @@ error_t dnsSdResponderFormatNsecRecord(NetInterface *interface,
          return ERROR_MESSAGE_TOO_LONG;
 
       //The Next Domain Name field contains the record's own name
-      mdnsEncodeName(service->instanceName, service->serviceName,
-         ".local", record->rdata);
+      osMemcpy(record->rdata, service->instanceFqdn, n);
 
       //DNS NSEC record is limited to Window Block number zero
       record->rdata[n++] = 0;
@@ -1481,47 +1508,18 @@ int_t dnsSdResponderCompareSrvRecord(NetInterface *interface,
 
    //If the rrtype and rrclass both match, then the rdata is compared
    srvRecord = (DnsSrvResourceRecord *) record;
-   //Convert the Priority field to host byte order
-   value = ntohs(srvRecord->priority);
-
-   //Compare Priority fields
-   if(value < service->priority)
-   {
-      return -1;
-   }
-   else if(value > service->priority)
-   {
-      return 1;
-   }
-   else
-   {
-   }
-
-   //Convert the Weight field to host byte order
-   value = ntohs(srvRecord->weight);
-
-   //Compare Weight fields
-   if(value < service->weight)
-   {
-      return -1;
-   }
-   else if(value > service->weight)
-   {
-      return 1;
-   }
-   else
-   {
-   }
 
-   //Convert the Port field to host byte order
-   value = ntohs(srvRecord->port);
+   //The Priority, Weight and Port fields are stored in network byte order,
+   //so a raw comparison yields the same result as a field-wise comparison
+   res = osMemcmp(&srvRecord->priority, service->srvData,
+      sizeof(service->srvData));
 
-   //Compare Port fields
-   if(value < service->port)
+   //Check comparison result
+   if(res < 0)
    {
       return -1;
    }
-   else if(value > service->port)
+   else if(res > 0)
    {
       return 1;
    }
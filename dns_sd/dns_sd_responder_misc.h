@@ -45,6 +45,7 @@ void dnsSdResponderChangeState(DnsSdResponderService *service,
    MdnsState newState, systime_t delay);
 
 void dnsSdResponderChangeInstanceName(DnsSdResponderService *service);
+void dnsSdResponderCompileService(DnsSdResponderService *service);
 
 error_t dnsSdResponderSendProbe(DnsSdResponderService *service);
 error_t dnsSdResponderSendAnnouncement(DnsSdResponderService *service);
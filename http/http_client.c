@@ -210,6 +210,41 @@ error_t httpClientSetTimeout(HttpClientContext *context, systime_t timeout)
 }
 
 
+/**
+ * @brief Enable or disable HTTP pipelining
+ *
+ * When HTTP pipelining is enabled, a new idempotent request can be sent on
+ * a persistent connection before the responses to the previous requests have
+ * been received. Responses are then read in the order the requests were sent
+ *
+ * @param[in] context Pointer to the HTTP client context
+ * @param[in] enable Specifies whether HTTP pipelining is enabled
+ * @return Error code
+ **/
+
+error_t httpClientEnablePipelining(HttpClientContext *context, bool_t enable)
+{
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   //Make sure the HTTP client context is valid
+   if(context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Pipelining cannot be disabled while requests are awaiting a response
+   if(!enable && context->numPendingRequests > 0)
+      return ERROR_WRONG_STATE;
+
+   //Save setting
+   context->pipelining = enable;
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //HTTP pipelining is not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief Set allowed HTTP authentication modes
  * @param[in] context Pointer to the HTTP client context
@@ -352,6 +387,11 @@ error_t httpClientConnect(HttpClientContext *context,
 #endif
          }
 
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+         //Pipelined requests cannot survive the loss of the connection
+         context->numPendingRequests = 0;
+#endif
+
          //Open network connection
          error = httpClientOpenConnection(context);
 
@@ -424,6 +464,14 @@ error_t httpClientCreateRequest(HttpClientContext *context)
    if(context == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   //Keep track of the previous request if its response is still pending
+   error = httpClientPipelineRequest(context);
+   //Any error to report?
+   if(error)
+      return error;
+#endif
+
    //Format default HTTP request header
    error = httpClientFormatRequestHeader(context);
 
@@ -1093,9 +1141,18 @@ error_t httpClientWriteHeader(HttpClientContext *context)
          //Check HTTP request state
          if(context->requestState == HTTP_REQ_STATE_FORMAT_HEADER)
          {
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+            //Non-idempotent methods must not be pipelined (refer to RFC 7230,
+            //section 6.3.2)
+            if(context->numPendingRequests > 0 &&
+               !httpClientIsIdempotentMethod(context->method))
+            {
+               error = ERROR_WRONG_STATE;
+            }
+#endif
 #if (HTTP_CLIENT_AUTH_SUPPORT == ENABLED)
             //HTTP authentication requested by the server?
-            if(context->authParams.selectedMode != HTTP_AUTH_MODE_NONE &&
+            if(!error && context->authParams.selectedMode != HTTP_AUTH_MODE_NONE &&
                context->authParams.username[0] != '\0')
             {
                //Format Authorization header field
@@ -1429,6 +1486,9 @@ error_t httpClientReadHeader(HttpClientContext *context)
 {
    error_t error;
    size_t n;
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   bool_t skip;
+#endif
 
    //Make sure the HTTP client context is valid
    if(context == NULL)
@@ -1441,6 +1501,27 @@ error_t httpClientReadHeader(HttpClientContext *context)
    //Initialize status code
    error = NO_ERROR;
 
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   //The header of the current pipelined response has already been delivered
+   //to the application? If so, the rest of the response must be discarded
+   //before the header of the next response can be read
+   if(context->numPendingRequests > 0 &&
+      (context->requestState == HTTP_REQ_STATE_PARSE_HEADER ||
+      context->requestState == HTTP_REQ_STATE_RECEIVE_BODY ||
+      context->requestState == HTTP_REQ_STATE_RECEIVE_CHUNK_SIZE ||
+      context->requestState == HTTP_REQ_STATE_RECEIVE_CHUNK_DATA ||
+      context->requestState == HTTP_REQ_STATE_RECEIVE_TRAILER ||
+      context->requestState == HTTP_REQ_STATE_PARSE_TRAILER ||
+      context->requestState == HTTP_REQ_STATE_COMPLETE))
+   {
+      skip = TRUE;
+   }
+   else
+   {
+      skip = FALSE;
+   }
+#endif
+
    //Send HTTP request header
    while(!error)
    {
@@ -1457,6 +1538,46 @@ error_t httpClientReadHeader(HttpClientContext *context)
          //The last chunk is followed by an optional trailer
          error = httpClientWriteTrailer(context);
       }
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+      else if(skip &&
+         (context->requestState == HTTP_REQ_STATE_PARSE_HEADER ||
+         context->requestState == HTTP_REQ_STATE_RECEIVE_BODY ||
+         context->requestState == HTTP_REQ_STATE_RECEIVE_CHUNK_SIZE ||
+         context->requestState == HTTP_REQ_STATE_RECEIVE_CHUNK_DATA ||
+         context->requestState == HTTP_REQ_STATE_RECEIVE_TRAILER))
+      {
+         //Discard the remaining part of the previous pipelined response
+         error = httpClientCloseBody(context);
+      }
+      else if(skip &&
+         (context->requestState == HTTP_REQ_STATE_PARSE_TRAILER ||
+         context->requestState == HTTP_REQ_STATE_COMPLETE))
+      {
+         //The previous pipelined response is complete
+         httpClientDequeueRequest(context);
+         //The header of the next response is not delivered yet
+         skip = FALSE;
+
+         //Check whether the server has decided to close the connection
+         if(context->keepAlive && context->state == HTTP_CLIENT_STATE_CONNECTED)
+         {
+            //Flush receive buffer
+            context->bufferLen = 0;
+            context->bufferPos = 0;
+
+            //Receive the next response in the pipeline
+            httpClientChangeRequestState(context,
+               HTTP_REQ_STATE_RECEIVE_STATUS_LINE);
+         }
+         else
+         {
+            //The remaining pipelined requests will not be answered
+            context->numPendingRequests = 0;
+            //Report an error
+            error = ERROR_CONNECTION_CLOSING;
+         }
+      }
+#endif
       else if(context->requestState == HTTP_REQ_STATE_RECEIVE_STATUS_LINE ||
          context->requestState == HTTP_REQ_STATE_RECEIVE_HEADER)
       {
@@ -1736,7 +1857,7 @@ error_t httpClientReadBody(HttpClientContext *context, void *data,
          //304 status code is always terminated by the first empty line after
          //the header fields, regardless of the header fields present in the
          //message, and thus cannot contain a message body
-         if(osStrcasecmp(context->method, "HEAD") == 0 ||
+         if(osStrcasecmp(httpClientGetResponseMethod(context), "HEAD") == 0 ||
             HTTP_STATUS_CODE_1YZ(context->statusCode) ||
             context->statusCode == 204 ||
             context->statusCode == 304)
@@ -84,6 +84,20 @@
    #error HTTP_CLIENT_SHA512_256_SUPPORT parameter is not valid
 #endif
 
+//HTTP pipelining support
+#ifndef HTTP_CLIENT_PIPELINING_SUPPORT
+   #define HTTP_CLIENT_PIPELINING_SUPPORT DISABLED
+#elif (HTTP_CLIENT_PIPELINING_SUPPORT != ENABLED && HTTP_CLIENT_PIPELINING_SUPPORT != DISABLED)
+   #error HTTP_CLIENT_PIPELINING_SUPPORT parameter is not valid
+#endif
+
+//Maximum number of pipelined requests awaiting a response
+#ifndef HTTP_CLIENT_MAX_PIPELINED_REQUESTS
+   #define HTTP_CLIENT_MAX_PIPELINED_REQUESTS 4
+#elif (HTTP_CLIENT_MAX_PIPELINED_REQUESTS < 1)
+   #error HTTP_CLIENT_MAX_PIPELINED_REQUESTS parameter is not valid
+#endif
+
 //Default timeout
 #ifndef HTTP_CLIENT_DEFAULT_TIMEOUT
    #define HTTP_CLIENT_DEFAULT_TIMEOUT 20000
@@ -290,6 +304,11 @@ struct _HttpClientContext
    char_t method[HTTP_CLIENT_MAX_METHOD_LEN + 1]; ///<HTTP request method
    bool_t keepAlive;                              ///<HTTP persistent connection
    bool_t chunkedEncoding;                        ///<Chunked transfer encoding
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   bool_t pipelining;                             ///<HTTP pipelining
+   uint_t numPendingRequests;                     ///<Number of pipelined requests awaiting a response
+   char_t pendingMethods[HTTP_CLIENT_MAX_PIPELINED_REQUESTS][HTTP_CLIENT_MAX_METHOD_LEN + 1]; ///<Methods of the pipelined requests
+#endif
    char_t buffer[HTTP_CLIENT_BUFFER_SIZE + 1];    ///<Memory buffer for input/output operations
    size_t bufferLen;                              ///<Length of the buffer, in bytes
    size_t bufferPos;                              ///<Current position in the buffer
@@ -315,6 +334,7 @@ error_t httpClientRegisterRandCallback(HttpClientContext *context,
 
 error_t httpClientSetVersion(HttpClientContext *context, HttpVersion version);
 error_t httpClientSetTimeout(HttpClientContext *context, systime_t timeout);
+error_t httpClientEnablePipelining(HttpClientContext *context, bool_t enable);
 
 error_t httpClientSetAllowedAuthModes(HttpClientContext *context,
    uint_t allowedAuthModes);
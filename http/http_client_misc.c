@@ -575,6 +575,151 @@ error_t httpClientParseChunkSize(HttpClientContext *context, char_t *line,
 }
 
 
+/**
+ * @brief Check whether a request method is idempotent
+ * @param[in] method NULL-terminated string containing the HTTP method
+ * @return TRUE if the method is idempotent, else FALSE
+ **/
+
+bool_t httpClientIsIdempotentMethod(const char_t *method)
+{
+   bool_t res;
+
+   //GET, HEAD, PUT, DELETE, OPTIONS and TRACE methods are idempotent (refer
+   //to RFC 7231, section 4.2.2)
+   if(osStrcasecmp(method, "GET") == 0 ||
+      osStrcasecmp(method, "HEAD") == 0 ||
+      osStrcasecmp(method, "PUT") == 0 ||
+      osStrcasecmp(method, "DELETE") == 0 ||
+      osStrcasecmp(method, "OPTIONS") == 0 ||
+      osStrcasecmp(method, "TRACE") == 0)
+   {
+      res = TRUE;
+   }
+   else
+   {
+      res = FALSE;
+   }
+
+   //Return TRUE if the method is idempotent
+   return res;
+}
+
+
+/**
+ * @brief Get the method of the request the current response relates to
+ * @param[in] context Pointer to the HTTP client context
+ * @return NULL-terminated string containing the HTTP method
+ **/
+
+const char_t *httpClientGetResponseMethod(HttpClientContext *context)
+{
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   //Responses to pipelined requests are received in the order the requests
+   //were sent
+   if(context->numPendingRequests > 0)
+      return context->pendingMethods[0];
+#endif
+
+   //The response relates to the last request
+   return context->method;
+}
+
+
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+
+/**
+ * @brief Keep track of the previous request before creating a new one
+ * @param[in] context Pointer to the HTTP client context
+ * @return Error code
+ **/
+
+error_t httpClientPipelineRequest(HttpClientContext *context)
+{
+   //HTTP pipelining disabled?
+   if(!context->pipelining)
+      return NO_ERROR;
+
+   //No response can be pending if the connection is not established
+   if(context->state != HTTP_CLIENT_STATE_CONNECTED)
+      return NO_ERROR;
+
+   //Check HTTP request state
+   if(context->requestState == HTTP_REQ_STATE_RECEIVE_STATUS_LINE &&
+      context->bufferPos == context->bufferLen)
+   {
+      //The previous request has been sent, but no part of its response has
+      //been received yet
+   }
+   else if((context->requestState == HTTP_REQ_STATE_PARSE_TRAILER ||
+      context->requestState == HTTP_REQ_STATE_COMPLETE) &&
+      context->numPendingRequests > 0)
+   {
+      //The response to the oldest pipelined request is complete
+      httpClientDequeueRequest(context);
+   }
+   else if(context->numPendingRequests > 0)
+   {
+      //The response to the oldest pipelined request is being received
+      return ERROR_WRONG_STATE;
+   }
+   else
+   {
+      //The previous request does not need to be tracked
+      return NO_ERROR;
+   }
+
+   //Pipelining requires a persistent HTTP/1.1 connection
+   if(context->version != HTTP_VERSION_1_1 || !context->keepAlive)
+      return ERROR_WRONG_STATE;
+
+   //A user agent should not pipeline requests after a non-idempotent method
+   //(refer to RFC 7230, section 6.3.2)
+   if(!httpClientIsIdempotentMethod(context->method))
+      return ERROR_WRONG_STATE;
+
+   //Limit the depth of the pipeline
+   if(context->numPendingRequests >= HTTP_CLIENT_MAX_PIPELINED_REQUESTS)
+      return ERROR_OUT_OF_RESOURCES;
+
+   //Save the method of the previous request
+   osStrcpy(context->pendingMethods[context->numPendingRequests],
+      context->method);
+
+   //One more request is awaiting a response
+   context->numPendingRequests++;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Remove the oldest pipelined request
+ * @param[in] context Pointer to the HTTP client context
+ **/
+
+void httpClientDequeueRequest(HttpClientContext *context)
+{
+   uint_t i;
+
+   //Any pipelined request awaiting a response?
+   if(context->numPendingRequests > 0)
+   {
+      //Shift the remaining entries
+      for(i = 1; i < context->numPendingRequests; i++)
+      {
+         osStrcpy(context->pendingMethods[i - 1], context->pendingMethods[i]);
+      }
+
+      //Update the number of pipelined requests
+      context->numPendingRequests--;
+   }
+}
+
+#endif
+
+
 /**
  * @brief Determine whether a timeout error has occurred
  * @param[in] context Pointer to the HTTP client context
@@ -69,6 +69,12 @@ error_t httpClientParseContentLengthField(HttpClientContext *context,
 error_t httpClientParseChunkSize(HttpClientContext *context, char_t *line,
    size_t length);
 
+bool_t httpClientIsIdempotentMethod(const char_t *method);
+const char_t *httpClientGetResponseMethod(HttpClientContext *context);
+
+error_t httpClientPipelineRequest(HttpClientContext *context);
+void httpClientDequeueRequest(HttpClientContext *context);
+
 error_t httpClientCheckTimeout(HttpClientContext *context);
 
 //C++ guard
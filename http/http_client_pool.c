@@ -0,0 +1,733 @@
+/**
+ * @file http_client_pool.c
+ * @brief HTTP client connection pool
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @section Description
+ *
+ * The connection pool keeps persistent HTTP connections open between
+ * transactions. Connections are keyed by server address, port number and
+ * TLS settings, so that subsequent requests to the same endpoint skip the
+ * TCP and TLS handshakes. When a new connection is required, the pool first
+ * selects the entry that previously served the same endpoint, in order to
+ * resume the TLS session saved by httpClientSaveSession()
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL HTTP_TRACE_LEVEL
+
+//Dependencies
+#include "core/net.h"
+#include "http/http_client.h"
+#include "http/http_client_transport.h"
+#include "http/http_client_pool.h"
+#include "debug.h"
+
+//Check TCP/IP stack configuration
+#if (HTTP_CLIENT_SUPPORT == ENABLED && HTTP_CLIENT_POOL_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Initialize connection pool
+ * @param[in] pool Pointer to the connection pool
+ * @return Error code
+ **/
+
+error_t httpClientPoolInit(HttpClientPool *pool)
+{
+   error_t error;
+   uint_t i;
+
+   //Make sure the connection pool is valid
+   if(pool == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Clear connection pool
+   osMemset(pool, 0, sizeof(HttpClientPool));
+
+   //Create a mutex to prevent simultaneous access to the pool
+   if(!osCreateMutex(&pool->mutex))
+      return ERROR_OUT_OF_RESOURCES;
+
+   //Default communication timeout
+   pool->timeout = HTTP_CLIENT_DEFAULT_TIMEOUT;
+   //Default idle timeout
+   pool->idleTimeout = HTTP_CLIENT_POOL_DEFAULT_IDLE_TIMEOUT;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Initialize HTTP client contexts
+   for(i = 0; i < HTTP_CLIENT_POOL_SIZE && !error; i++)
+   {
+      error = httpClientInit(&pool->entries[i].context);
+   }
+
+   //Any error to report?
+   if(error)
+   {
+      //Clean up side effects
+      httpClientPoolDeinit(pool);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Set communication timeout
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] timeout Timeout value, in milliseconds
+ * @return Error code
+ **/
+
+error_t httpClientPoolSetTimeout(HttpClientPool *pool, systime_t timeout)
+{
+   //Make sure the connection pool is valid
+   if(pool == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Save timeout value
+   pool->timeout = timeout;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Set idle timeout
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] idleTimeout Time after which an unused connection is closed,
+ *   in milliseconds
+ * @return Error code
+ **/
+
+error_t httpClientPoolSetIdleTimeout(HttpClientPool *pool,
+   systime_t idleTimeout)
+{
+   //Make sure the connection pool is valid
+   if(pool == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Save idle timeout
+   pool->idleTimeout = idleTimeout;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Bind the connection pool to a particular network interface
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] interface Network interface to be used
+ * @return Error code
+ **/
+
+error_t httpClientPoolBindToInterface(HttpClientPool *pool,
+   NetInterface *interface)
+{
+   //Make sure the connection pool is valid
+   if(pool == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Explicitly associate the connection pool with the specified interface
+   pool->interface = interface;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Get a connection to the specified HTTP server
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] serverIpAddr IP address of the HTTP server
+ * @param[in] serverPort Port number
+ * @param[out] context HTTP client context connected to the server
+ * @return Error code
+ **/
+
+error_t httpClientPoolAcquire(HttpClientPool *pool,
+   const IpAddr *serverIpAddr, uint16_t serverPort,
+   HttpClientContext **context)
+{
+   HttpClientPoolKey key;
+
+   //Check parameters
+   if(serverIpAddr == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Plain HTTP connection
+   osMemset(&key, 0, sizeof(HttpClientPoolKey));
+   key.serverIpAddr = *serverIpAddr;
+   key.serverPort = serverPort;
+
+   //Get a connection to the HTTP server
+   return httpClientPoolAcquireEx(pool, &key, context);
+}
+
+
+#if (HTTP_CLIENT_TLS_SUPPORT == ENABLED)
+
+/**
+ * @brief Get a TLS-secured connection to the specified HTTP server
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] serverIpAddr IP address of the HTTP server
+ * @param[in] serverPort Port number
+ * @param[in] tlsInitCallback TLS initialization callback function
+ * @param[in] tlsInitParam Opaque pointer passed to the callback function
+ * @param[out] context HTTP client context connected to the server
+ * @return Error code
+ **/
+
+error_t httpClientPoolAcquireTls(HttpClientPool *pool,
+   const IpAddr *serverIpAddr, uint16_t serverPort,
+   HttpClientTlsInitCallback tlsInitCallback, void *tlsInitParam,
+   HttpClientContext **context)
+{
+   HttpClientPoolKey key;
+
+   //Check parameters
+   if(serverIpAddr == NULL || tlsInitCallback == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //HTTP over TLS connection
+   osMemset(&key, 0, sizeof(HttpClientPoolKey));
+   key.serverIpAddr = *serverIpAddr;
+   key.serverPort = serverPort;
+   key.tlsInitCallback = tlsInitCallback;
+   key.tlsInitParam = tlsInitParam;
+
+   //Get a connection to the HTTP server
+   return httpClientPoolAcquireEx(pool, &key, context);
+}
+
+#endif
+
+
+/**
+ * @brief Get a connection matching the specified key
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] key Server address, port number and TLS settings
+ * @param[out] context HTTP client context connected to the server
+ * @return Error code
+ **/
+
+error_t httpClientPoolAcquireEx(HttpClientPool *pool,
+   const HttpClientPoolKey *key, HttpClientContext **context)
+{
+   error_t error;
+   uint_t i;
+   HttpClientPoolEntry *entry;
+
+   //Check parameters
+   if(pool == NULL || key == NULL || context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize pointer
+   entry = NULL;
+
+   //Acquire exclusive access to the pool
+   osAcquireMutex(&pool->mutex);
+
+   //Close the connections that have been idle for too long
+   httpClientPoolCheckIdleTimeout(pool);
+
+   //Loop through the connection pool
+   for(i = 0; i < HTTP_CLIENT_POOL_SIZE && entry == NULL; i++)
+   {
+      //Idle persistent connection to the same server?
+      if(pool->entries[i].valid && !pool->entries[i].used &&
+         pool->entries[i].context.state == HTTP_CLIENT_STATE_CONNECTED &&
+         httpClientPoolCompareKey(&pool->entries[i].context, key))
+      {
+         //The server may have closed the connection in the meantime
+         if(tcpGetState(pool->entries[i].context.socket) == TCP_STATE_ESTABLISHED)
+         {
+            //The connection can be reused
+            entry = &pool->entries[i];
+         }
+         else
+         {
+            //Close the connection
+            httpClientPoolCloseConnection(&pool->entries[i].context);
+         }
+      }
+   }
+
+   //Idle persistent connection found?
+   if(entry != NULL)
+   {
+      //The connection is now used by the application
+      entry->used = TRUE;
+      //Update statistics
+      pool->stats.hits++;
+
+      //Debug message
+      TRACE_DEBUG("HTTP client pool: reusing connection %u\r\n",
+         (uint_t) (entry - pool->entries));
+   }
+   else
+   {
+      //Select an entry for the new connection
+      entry = httpClientPoolSelectEntry(pool, key);
+
+      //Any entry available?
+      if(entry != NULL)
+      {
+         //Reserve the entry
+         entry->used = TRUE;
+         //Update statistics
+         pool->stats.misses++;
+      }
+   }
+
+   //Release exclusive access to the pool
+   osReleaseMutex(&pool->mutex);
+
+   //All connections are currently used?
+   if(entry == NULL)
+      return ERROR_OUT_OF_RESOURCES;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //A new connection must be established?
+   if(entry->context.state != HTTP_CLIENT_STATE_CONNECTED)
+   {
+      //The entry was bound to another server?
+      if(!entry->valid || !httpClientPoolCompareKey(&entry->context, key))
+      {
+#if (HTTP_CLIENT_TLS_SUPPORT == ENABLED)
+         //The TLS session saved for the previous server cannot be resumed
+         tlsFreeSessionState(&entry->context.tlsSession);
+         error = tlsInitSessionState(&entry->context.tlsSession);
+
+         //Save TLS settings
+         entry->context.tlsInitCallback = key->tlsInitCallback;
+         entry->context.tlsInitParam = key->tlsInitParam;
+#endif
+         //The entry is now bound to the new server
+         entry->valid = TRUE;
+      }
+      else
+      {
+         //Reconnect to the same server (the TLS session saved during the
+         //previous connection is restored by httpClientOpenConnection)
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Apply pool settings
+         entry->context.timeout = pool->timeout;
+         entry->context.interface = pool->interface;
+
+         //Establish connection with the HTTP server
+         error = httpClientConnect(&entry->context, &key->serverIpAddr,
+            key->serverPort);
+      }
+
+#if (HTTP_CLIENT_TLS_SUPPORT == ENABLED)
+      //Check status code
+      if(!error && entry->context.tlsContext != NULL)
+      {
+         //The saved TLS session has been resumed by the server?
+         if(entry->context.tlsContext->resume)
+         {
+            //Update statistics
+            osAcquireMutex(&pool->mutex);
+            pool->stats.resumptions++;
+            osReleaseMutex(&pool->mutex);
+         }
+      }
+#endif
+
+      //Failed to establish connection?
+      if(error)
+      {
+         //Clean up side effects
+         httpClientClose(&entry->context);
+
+         //Release the entry
+         osAcquireMutex(&pool->mutex);
+         entry->used = FALSE;
+         osReleaseMutex(&pool->mutex);
+      }
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Return a pointer to the HTTP client context
+      *context = &entry->context;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Give a connection back to the pool
+ *
+ * The connection is kept open for subsequent requests if it is persistent
+ * and the response has been entirely read. Otherwise it is closed
+ *
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] context HTTP client context returned by httpClientPoolAcquire
+ * @return Error code
+ **/
+
+error_t httpClientPoolRelease(HttpClientPool *pool,
+   HttpClientContext *context)
+{
+   uint_t i;
+   bool_t reusable;
+   HttpClientPoolEntry *entry;
+
+   //Check parameters
+   if(pool == NULL || context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize pointer
+   entry = NULL;
+
+   //Search the pool for the specified context
+   for(i = 0; i < HTTP_CLIENT_POOL_SIZE && entry == NULL; i++)
+   {
+      if(&pool->entries[i].context == context && pool->entries[i].used)
+      {
+         entry = &pool->entries[i];
+      }
+   }
+
+   //The context does not belong to the pool?
+   if(entry == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check whether the connection can serve subsequent requests
+   if(context->state != HTTP_CLIENT_STATE_CONNECTED)
+   {
+      reusable = FALSE;
+   }
+   else if(context->requestState == HTTP_REQ_STATE_INIT)
+   {
+      reusable = TRUE;
+   }
+   else if(context->keepAlive &&
+      (context->requestState == HTTP_REQ_STATE_PARSE_TRAILER ||
+      context->requestState == HTTP_REQ_STATE_COMPLETE))
+   {
+      reusable = TRUE;
+   }
+   else
+   {
+      reusable = FALSE;
+   }
+
+#if (HTTP_CLIENT_PIPELINING_SUPPORT == ENABLED)
+   //Responses to pipelined requests are still pending?
+   if(context->numPendingRequests > 0)
+   {
+      reusable = FALSE;
+   }
+#endif
+
+   //Acquire exclusive access to the pool
+   osAcquireMutex(&pool->mutex);
+
+   //Persistent connection?
+   if(reusable)
+   {
+      //Save current time
+      entry->timestamp = osGetSystemTime();
+   }
+   else
+   {
+      //Close the connection
+      httpClientPoolCloseConnection(context);
+   }
+
+   //The connection is no longer used by the application
+   entry->used = FALSE;
+
+   //Release exclusive access to the pool
+   osReleaseMutex(&pool->mutex);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Close all idle connections
+ * @param[in] pool Pointer to the connection pool
+ **/
+
+void httpClientPoolCloseIdleConnections(HttpClientPool *pool)
+{
+   uint_t i;
+
+   //Make sure the connection pool is valid
+   if(pool != NULL)
+   {
+      //Acquire exclusive access to the pool
+      osAcquireMutex(&pool->mutex);
+
+      //Loop through the connection pool
+      for(i = 0; i < HTTP_CLIENT_POOL_SIZE; i++)
+      {
+         //Idle connection?
+         if(!pool->entries[i].used &&
+            pool->entries[i].context.state != HTTP_CLIENT_STATE_DISCONNECTED)
+         {
+            //Close the connection
+            httpClientPoolCloseConnection(&pool->entries[i].context);
+         }
+      }
+
+      //Release exclusive access to the pool
+      osReleaseMutex(&pool->mutex);
+   }
+}
+
+
+/**
+ * @brief Retrieve connection pool statistics
+ * @param[in] pool Pointer to the connection pool
+ * @param[out] stats Statistics
+ * @return Error code
+ **/
+
+error_t httpClientPoolGetStats(HttpClientPool *pool,
+   HttpClientPoolStats *stats)
+{
+   //Check parameters
+   if(pool == NULL || stats == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Acquire exclusive access to the pool
+   osAcquireMutex(&pool->mutex);
+   //Copy statistics
+   *stats = pool->stats;
+   //Release exclusive access to the pool
+   osReleaseMutex(&pool->mutex);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Release connection pool
+ * @param[in] pool Pointer to the connection pool
+ **/
+
+void httpClientPoolDeinit(HttpClientPool *pool)
+{
+   uint_t i;
+
+   //Make sure the connection pool is valid
+   if(pool != NULL)
+   {
+      //Release HTTP client contexts
+      for(i = 0; i < HTTP_CLIENT_POOL_SIZE; i++)
+      {
+         httpClientDeinit(&pool->entries[i].context);
+      }
+
+      //Release previously allocated resources
+      osDeleteMutex(&pool->mutex);
+
+      //Clear connection pool
+      osMemset(pool, 0, sizeof(HttpClientPool));
+   }
+}
+
+
+/**
+ * @brief Select an entry for a new connection
+ * @param[in] pool Pointer to the connection pool
+ * @param[in] key Server address, port number and TLS settings
+ * @return Pointer to the selected entry, if any
+ **/
+
+HttpClientPoolEntry *httpClientPoolSelectEntry(HttpClientPool *pool,
+   const HttpClientPoolKey *key)
+{
+   uint_t i;
+   HttpClientPoolEntry *entry;
+   HttpClientPoolEntry *freeEntry;
+   HttpClientPoolEntry *oldestEntry;
+
+   //Initialize pointers
+   freeEntry = NULL;
+   oldestEntry = NULL;
+
+   //Loop through the connection pool
+   for(i = 0; i < HTTP_CLIENT_POOL_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &pool->entries[i];
+
+      //Skip the connections that are currently used
+      if(entry->used)
+         continue;
+
+      //Check connection state
+      if(entry->context.state == HTTP_CLIENT_STATE_DISCONNECTED)
+      {
+         //Give preference to the entry that last served the same server, so
+         //that the saved TLS session can be resumed
+         if(entry->valid && httpClientPoolCompareKey(&entry->context, key))
+            return entry;
+
+         //Keep track of the first free entry
+         if(freeEntry == NULL)
+            freeEntry = entry;
+      }
+      else
+      {
+         //Keep track of the least recently used idle connection
+         if(oldestEntry == NULL ||
+            timeCompare(entry->timestamp, oldestEntry->timestamp) < 0)
+         {
+            oldestEntry = entry;
+         }
+      }
+   }
+
+   //Any free entry?
+   if(freeEntry != NULL)
+      return freeEntry;
+
+   //Any idle connection?
+   if(oldestEntry != NULL)
+   {
+      //Close the least recently used idle connection to make room
+      httpClientPoolCloseConnection(&oldestEntry->context);
+      //Update statistics
+      pool->stats.evictions++;
+   }
+
+   //Return a pointer to the selected entry
+   return oldestEntry;
+}
+
+
+/**
+ * @brief Check whether a connection matches the specified key
+ * @param[in] context Pointer to the HTTP client context
+ * @param[in] key Server address, port number and TLS settings
+ * @return TRUE if the connection matches the key, else FALSE
+ **/
+
+bool_t httpClientPoolCompareKey(HttpClientContext *context,
+   const HttpClientPoolKey *key)
+{
+   //Compare server address and port number
+   if(!ipCompAddr(&context->serverIpAddr, &key->serverIpAddr))
+      return FALSE;
+
+   if(context->serverPort != key->serverPort)
+      return FALSE;
+
+#if (HTTP_CLIENT_TLS_SUPPORT == ENABLED)
+   //Compare TLS settings
+   if(context->tlsInitCallback != key->tlsInitCallback ||
+      context->tlsInitParam != key->tlsInitParam)
+   {
+      return FALSE;
+   }
+#endif
+
+   //The connection matches the key
+   return TRUE;
+}
+
+
+/**
+ * @brief Close a pooled connection
+ *
+ * The TLS session is saved before the connection is closed, so that it can
+ * be resumed by the next connection to the same server
+ *
+ * @param[in] context Pointer to the HTTP client context
+ **/
+
+void httpClientPoolCloseConnection(HttpClientContext *context)
+{
+   //Established connection?
+   if(context->state == HTTP_CLIENT_STATE_CONNECTED)
+   {
+      //Save TLS session
+      httpClientSaveSession(context);
+   }
+
+   //Close the connection
+   httpClientClose(context);
+}
+
+
+/**
+ * @brief Close the connections that have been idle for too long
+ * @param[in] pool Pointer to the connection pool
+ **/
+
+void httpClientPoolCheckIdleTimeout(HttpClientPool *pool)
+{
+   uint_t i;
+   systime_t time;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Loop through the connection pool
+   for(i = 0; i < HTTP_CLIENT_POOL_SIZE; i++)
+   {
+      //Idle connection?
+      if(!pool->entries[i].used &&
+         pool->entries[i].context.state != HTTP_CLIENT_STATE_DISCONNECTED)
+      {
+         //Check whether the idle timeout has elapsed
+         if(timeCompare(time, pool->entries[i].timestamp +
+            pool->idleTimeout) >= 0)
+         {
+            //Close the connection
+            httpClientPoolCloseConnection(&pool->entries[i].context);
+            //Update statistics
+            pool->stats.expirations++;
+         }
+      }
+   }
+}
+
+#endif
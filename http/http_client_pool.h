@@ -0,0 +1,174 @@
+/**
+ * @file http_client_pool.h
+ * @brief HTTP client connection pool
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+#ifndef _HTTP_CLIENT_POOL_H
+#define _HTTP_CLIENT_POOL_H
+
+//Dependencies
+#include "core/net.h"
+#include "http/http_client.h"
+
+//HTTP client connection pool support
+#ifndef HTTP_CLIENT_POOL_SUPPORT
+   #define HTTP_CLIENT_POOL_SUPPORT DISABLED
+#elif (HTTP_CLIENT_POOL_SUPPORT != ENABLED && HTTP_CLIENT_POOL_SUPPORT != DISABLED)
+   #error HTTP_CLIENT_POOL_SUPPORT parameter is not valid
+#endif
+
+//Number of connections in the pool
+#ifndef HTTP_CLIENT_POOL_SIZE
+   #define HTTP_CLIENT_POOL_SIZE 4
+#elif (HTTP_CLIENT_POOL_SIZE < 1)
+   #error HTTP_CLIENT_POOL_SIZE parameter is not valid
+#endif
+
+//Default idle timeout
+#ifndef HTTP_CLIENT_POOL_DEFAULT_IDLE_TIMEOUT
+   #define HTTP_CLIENT_POOL_DEFAULT_IDLE_TIMEOUT 30000
+#elif (HTTP_CLIENT_POOL_DEFAULT_IDLE_TIMEOUT < 1000)
+   #error HTTP_CLIENT_POOL_DEFAULT_IDLE_TIMEOUT parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Connection pool key
+ **/
+
+typedef struct
+{
+   IpAddr serverIpAddr;                       ///<IP address of the HTTP server
+   uint16_t serverPort;                       ///<TCP port number
+#if (HTTP_CLIENT_TLS_SUPPORT == ENABLED)
+   HttpClientTlsInitCallback tlsInitCallback; ///<TLS initialization callback function
+   void *tlsInitParam;                        ///<Opaque pointer passed to the callback function
+#endif
+} HttpClientPoolKey;
+
+
+/**
+ * @brief Connection pool entry
+ **/
+
+typedef struct
+{
+   HttpClientContext context; ///<HTTP client context
+   bool_t valid;              ///<The entry has been bound to a server
+   bool_t used;               ///<The connection is currently used by the application
+   systime_t timestamp;       ///<Time at which the connection was released
+} HttpClientPoolEntry;
+
+
+/**
+ * @brief Connection pool statistics
+ **/
+
+typedef struct
+{
+   uint32_t hits;        ///<Number of requests served by an idle persistent connection
+   uint32_t misses;      ///<Number of new connections
+   uint32_t resumptions; ///<Number of new connections reusing a saved TLS session
+   uint32_t expirations; ///<Number of idle connections closed after the idle timeout
+   uint32_t evictions;   ///<Number of idle connections closed to make room
+} HttpClientPoolStats;
+
+
+/**
+ * @brief HTTP client connection pool
+ **/
+
+typedef struct
+{
+   OsMutex mutex;                                     ///<Mutex preventing simultaneous access to the pool
+   NetInterface *interface;                           ///<Underlying network interface
+   systime_t timeout;                                 ///<Communication timeout
+   systime_t idleTimeout;                             ///<Idle timeout
+   HttpClientPoolEntry entries[HTTP_CLIENT_POOL_SIZE]; ///<Connections
+   HttpClientPoolStats stats;                         ///<Statistics
+} HttpClientPool;
+
+
+//HTTP client connection pool related functions
+error_t httpClientPoolInit(HttpClientPool *pool);
+
+error_t httpClientPoolSetTimeout(HttpClientPool *pool, systime_t timeout);
+
+error_t httpClientPoolSetIdleTimeout(HttpClientPool *pool,
+   systime_t idleTimeout);
+
+error_t httpClientPoolBindToInterface(HttpClientPool *pool,
+   NetInterface *interface);
+
+error_t httpClientPoolAcquire(HttpClientPool *pool,
+   const IpAddr *serverIpAddr, uint16_t serverPort,
+   HttpClientContext **context);
+
+#if (HTTP_CLIENT_TLS_SUPPORT == ENABLED)
+
+error_t httpClientPoolAcquireTls(HttpClientPool *pool,
+   const IpAddr *serverIpAddr, uint16_t serverPort,
+   HttpClientTlsInitCallback tlsInitCallback, void *tlsInitParam,
+   HttpClientContext **context);
+
+#endif
+
+error_t httpClientPoolAcquireEx(HttpClientPool *pool,
+   const HttpClientPoolKey *key, HttpClientContext **context);
+
+error_t httpClientPoolRelease(HttpClientPool *pool,
+   HttpClientContext *context);
+
+void httpClientPoolCloseIdleConnections(HttpClientPool *pool);
+
+error_t httpClientPoolGetStats(HttpClientPool *pool,
+   HttpClientPoolStats *stats);
+
+void httpClientPoolDeinit(HttpClientPool *pool);
+
+HttpClientPoolEntry *httpClientPoolSelectEntry(HttpClientPool *pool,
+   const HttpClientPoolKey *key);
+
+bool_t httpClientPoolCompareKey(HttpClientContext *context,
+   const HttpClientPoolKey *key);
+
+void httpClientPoolCloseConnection(HttpClientContext *context);
+
+void httpClientPoolCheckIdleTimeout(HttpClientPool *pool);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -149,6 +149,15 @@ error_t httpServerInit(HttpServerContext *context, const HttpServerSettings *set
    //Clear the HTTP server context
    osMemset(context, 0, sizeof(HttpServerContext));
 
+   //Build the extension lookup table used to resolve MIME types
+   mimeInit();
+
+#if (HTTP_SERVER_ROUTE_SUPPORT == ENABLED)
+   //The root node of the routing tree matches the path "/"
+   context->routeNodes[0].segment = "";
+   context->numRouteNodes = 1;
+#endif
+
    //Initialize task parameters
    context->taskParams = settings->listenerTask;
    context->taskId = OS_INVALID_TASK_ID;
@@ -290,6 +299,94 @@ error_t httpServerStart(HttpServerContext *context)
 }
 
 
+/**
+ * @brief Register a request handler for a given method and path
+ *
+ * The pattern is made of '/'-separated segments. The wildcard segment "*"
+ * matches any single segment of the request path, whereas a trailing "**"
+ * segment matches the rest of the path. Routes must be registered once
+ * httpServerInit has completed and before the HTTP server is started
+ *
+ * @param[in] context Pointer to the HTTP server context
+ * @param[in] method HTTP method (NULL to match any method)
+ * @param[in] pattern NULL-terminated string describing the path. The string
+ *   is not copied and must remain valid for the lifetime of the HTTP server
+ * @param[in] callback Function to invoke when a request matches the route
+ * @return Error code
+ **/
+
+error_t httpServerRegisterRoute(HttpServerContext *context,
+   const char_t *method, const char_t *pattern, HttpRequestCallback callback)
+{
+#if (HTTP_SERVER_ROUTE_SUPPORT == ENABLED)
+   error_t error;
+   uint_t i;
+   uint_t j;
+   HttpRoute *route;
+   HttpRouteNode *node;
+
+   //Check parameters
+   if(context == NULL || pattern == NULL || callback == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The pattern must be an absolute path
+   if(pattern[0] != '/')
+      return ERROR_INVALID_PARAMETER;
+
+   //Insert the path segments into the routing tree
+   error = httpAddRouteNode(context, pattern, &i);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Point to the node matching the last segment of the path
+   node = &context->routeNodes[i];
+
+   //Loop through the routes that are attached to the node
+   for(j = node->route; j != 0; j = route->next)
+   {
+      //Point to the current route
+      route = &context->routes[j - 1];
+
+      //Check whether the method has already been registered
+      if(route->method == NULL && method == NULL)
+         break;
+      if(route->method != NULL && method != NULL &&
+         osStrcasecmp(route->method, method) == 0)
+      {
+         break;
+      }
+   }
+
+   //New route?
+   if(j == 0)
+   {
+      //Make sure the routing table is not full
+      if(context->numRoutes >= HTTP_SERVER_MAX_ROUTES)
+         return ERROR_OUT_OF_RESOURCES;
+
+      //Allocate a new entry
+      route = &context->routes[context->numRoutes++];
+
+      //Save HTTP method
+      route->method = method;
+      //Attach the route to the node
+      route->next = node->route;
+      node->route = context->numRoutes;
+   }
+
+   //Save request handler
+   route->callback = callback;
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief HTTP server listener task
  * @param[in] param Pointer to the HTTP server context
@@ -549,17 +646,21 @@ void httpConnectionTask(void *param)
                //Default HTTP header fields
                httpInitResponseHeader(connection);
 
+#if (HTTP_SERVER_ROUTE_SUPPORT == ENABLED)
+               //Invoke the request handler registered for the URI, if any
+               error = httpDispatchRoute(connection);
+#else
+               //No routing table
+               error = ERROR_NOT_FOUND;
+#endif
+
                //Invoke user-defined callback, if any
-               if(connection->settings->requestCallback != NULL)
+               if(error == ERROR_NOT_FOUND &&
+                  connection->settings->requestCallback != NULL)
                {
                   error = connection->settings->requestCallback(connection,
                      connection->request.uri);
                }
-               else
-               {
-                  //Keep processing...
-                  error = ERROR_NOT_FOUND;
-               }
 
                //Check status code
                if(error == ERROR_NOT_FOUND)
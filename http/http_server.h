@@ -100,6 +100,13 @@
    #error HTTP_SERVER_WEB_SOCKET_SUPPORT parameter is not valid
 #endif
 
+//URI routing table support
+#ifndef HTTP_SERVER_ROUTE_SUPPORT
+   #define HTTP_SERVER_ROUTE_SUPPORT DISABLED
+#elif (HTTP_SERVER_ROUTE_SUPPORT != ENABLED && HTTP_SERVER_ROUTE_SUPPORT != DISABLED)
+   #error HTTP_SERVER_ROUTE_SUPPORT parameter is not valid
+#endif
+
 //Gzip content type support
 #ifndef HTTP_SERVER_GZIP_TYPE_SUPPORT
    #define HTTP_SERVER_GZIP_TYPE_SUPPORT DISABLED
@@ -281,6 +288,20 @@
    #error HTTP_SERVER_BOUNDARY_MAX_LEN parameter is not valid
 #endif
 
+//Maximum number of routes
+#ifndef HTTP_SERVER_MAX_ROUTES
+   #define HTTP_SERVER_MAX_ROUTES 16
+#elif (HTTP_SERVER_MAX_ROUTES < 1)
+   #error HTTP_SERVER_MAX_ROUTES parameter is not valid
+#endif
+
+//Maximum number of nodes in the routing tree
+#ifndef HTTP_SERVER_MAX_ROUTE_NODES
+   #define HTTP_SERVER_MAX_ROUTE_NODES 32
+#elif (HTTP_SERVER_MAX_ROUTE_NODES < 2)
+   #error HTTP_SERVER_MAX_ROUTE_NODES parameter is not valid
+#endif
+
 //Maximum length for cookies
 #ifndef HTTP_SERVER_COOKIE_MAX_LEN
    #define HTTP_SERVER_COOKIE_MAX_LEN 256
@@ -441,6 +462,36 @@ typedef error_t (*HttpUriNotFoundCallback)(HttpConnection *connection,
    const char_t *uri);
 
 
+/**
+ * @brief Route
+ **/
+
+typedef struct
+{
+   const char_t *method;         ///<HTTP method (NULL matches any method)
+   HttpRequestCallback callback; ///<Request handler
+   uint_t next;                  ///<Next route attached to the same node (index + 1)
+} HttpRoute;
+
+
+/**
+ * @brief Node of the routing tree
+ *
+ * Each node matches a single path segment. The wildcard segment "*" matches
+ * any segment whereas the trailing segment "**" matches the rest of the path
+ *
+ **/
+
+typedef struct
+{
+   const char_t *segment; ///<Path segment
+   size_t length;         ///<Length of the path segment
+   uint_t child;          ///<First child node (index + 1)
+   uint_t sibling;        ///<Next sibling node (index + 1)
+   uint_t route;          ///<First route attached to the node (index + 1)
+} HttpRouteNode;
+
+
 /**
  * @brief HTTP status code
  **/
@@ -624,6 +675,12 @@ struct _HttpServerContext
    OsMutex nonceCacheMutex;                                      ///<Mutex preventing simultaneous access to the nonce cache
    HttpNonceCacheEntry nonceCache[HTTP_SERVER_NONCE_CACHE_SIZE]; ///<Nonce cache
 #endif
+#if (HTTP_SERVER_ROUTE_SUPPORT == ENABLED)
+   HttpRouteNode routeNodes[HTTP_SERVER_MAX_ROUTE_NODES];        ///<Routing tree
+   uint_t numRouteNodes;                                         ///<Number of nodes in the routing tree
+   HttpRoute routes[HTTP_SERVER_MAX_ROUTES];                     ///<Routing table
+   uint_t numRoutes;                                             ///<Number of routes
+#endif
 };
 
 
@@ -671,6 +728,9 @@ void httpServerGetDefaultSettings(HttpServerSettings *settings);
 error_t httpServerInit(HttpServerContext *context, const HttpServerSettings *settings);
 error_t httpServerStart(HttpServerContext *context);
 
+error_t httpServerRegisterRoute(HttpServerContext *context,
+   const char_t *method, const char_t *pattern, HttpRequestCallback callback);
+
 void httpListenerTask(void *param);
 void httpConnectionTask(void *param);
 
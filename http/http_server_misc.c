@@ -1235,4 +1235,321 @@ void httpConvertArrayToHexString(const uint8_t *input,
    output[i * 2] = '\0';
 }
 
+#if (HTTP_SERVER_ROUTE_SUPPORT == ENABLED)
+
+/**
+ * @brief Insert the segments of a path into the routing tree
+ * @param[in] context Pointer to the HTTP server context
+ * @param[in] pattern NULL-terminated string describing the path
+ * @param[out] index Index of the node matching the last segment
+ * @return Error code
+ **/
+
+error_t httpAddRouteNode(HttpServerContext *context, const char_t *pattern,
+   uint_t *index)
+{
+   uint_t i;
+   uint_t j;
+   size_t n;
+   const char_t *p;
+   const char_t *end;
+   HttpRouteNode *node;
+
+   //Start from the root node
+   i = 0;
+
+   //Skip the leading slash
+   p = pattern + 1;
+   //The path "/" is matched by the root node
+   p = (*p != '\0') ? p : NULL;
+
+   //Process the path segment by segment
+   while(p != NULL)
+   {
+      //Search for the end of the current segment
+      end = osStrchr(p, '/');
+      //Retrieve the length of the segment
+      n = (end != NULL) ? (size_t) (end - p) : osStrlen(p);
+
+      //The "**" wildcard can only appear as the last segment
+      if(end != NULL && n == 2 && p[0] == '*' && p[1] == '*')
+         return ERROR_INVALID_PARAMETER;
+
+      //Search the children of the current node for a matching segment
+      for(j = context->routeNodes[i].child; j != 0; j = node->sibling)
+      {
+         //Point to the current child node
+         node = &context->routeNodes[j - 1];
+
+         //Compare segments
+         if(node->length == n && osStrncmp(node->segment, p, n) == 0)
+            break;
+      }
+
+      //No matching segment?
+      if(j == 0)
+      {
+         //Make sure the routing tree is not full
+         if(context->numRouteNodes >= HTTP_SERVER_MAX_ROUTE_NODES)
+            return ERROR_OUT_OF_RESOURCES;
+
+         //Allocate a new node
+         j = ++context->numRouteNodes;
+         node = &context->routeNodes[j - 1];
+
+         //Save the path segment
+         node->segment = p;
+         node->length = n;
+         node->child = 0;
+         node->route = 0;
+
+         //Insert the new node at the head of the list of children
+         node->sibling = context->routeNodes[i].child;
+         context->routeNodes[i].child = j;
+      }
+
+      //Move to the next level of the tree
+      i = j - 1;
+      //Point to the next segment, if any
+      p = (end != NULL) ? end + 1 : NULL;
+   }
+
+   //Return the index of the node matching the last segment
+   *index = i;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Search the routing table for a given request
+ *
+ * The routing tree is walked one path segment at a time, so that the cost of
+ * the lookup depends on the length of the path rather than on the number of
+ * registered routes. Literal segments take precedence over the "*" wildcard,
+ * and the deepest "**" wildcard that accepts the HTTP method is used as a
+ * last resort
+ *
+ * @param[in] context Pointer to the HTTP server context
+ * @param[in] method HTTP method of the request
+ * @param[in] path NULL-terminated string containing the path of the request
+ * @return Pointer to the matching route, if any
+ **/
+
+const HttpRoute *httpFindRoute(HttpServerContext *context,
+   const char_t *method, const char_t *path)
+{
+   uint_t fallbackLevel;
+   const char_t *p;
+   const HttpRoute *route;
+   const HttpRoute *fallback;
+
+   //Initialize variables
+   fallback = NULL;
+   fallbackLevel = 0;
+
+   //Skip the leading slash
+   p = (path[0] == '/') ? path + 1 : path;
+   //The path "/" is matched by the root node
+   p = (*p != '\0') ? p : NULL;
+
+   //Search for a route matching the whole path
+   route = httpMatchRouteNode(context, 1, 0, method, p, &fallback,
+      &fallbackLevel);
+
+   //No route matches the whole path?
+   if(route == NULL)
+   {
+      //Use the deepest "**" wildcard that accepts the HTTP method, if any
+      route = fallback;
+   }
+
+   //Return the matching route, if any
+   return route;
+}
+
+
+/**
+ * @brief Match the remaining path segments against a node of the routing tree
+ *
+ * When the literal branch leads to a dead end, the search backtracks to the
+ * "*" wildcard sibling, so that a route remains reachable even if another
+ * route has a literal segment at the same position
+ *
+ * @param[in] context Pointer to the HTTP server context
+ * @param[in] i Index of the current node
+ * @param[in] level Depth of the current node
+ * @param[in] method HTTP method of the request
+ * @param[in] path Remaining path segments (NULL if the whole path has been
+ *   consumed)
+ * @param[in,out] fallback Route of the deepest "**" wildcard that accepts
+ *   the HTTP method
+ * @param[in,out] fallbackLevel Depth of the corresponding "**" wildcard node
+ * @return Pointer to the matching route, if any
+ **/
+
+const HttpRoute *httpMatchRouteNode(HttpServerContext *context, uint_t i,
+   uint_t level, const char_t *method, const char_t *path,
+   const HttpRoute **fallback, uint_t *fallbackLevel)
+{
+   uint_t j;
+   uint_t exact;
+   uint_t wildcard;
+   size_t n;
+   const char_t *end;
+   const HttpRoute *route;
+   const HttpRouteNode *node;
+
+   //Initialize variables
+   end = NULL;
+   n = 0;
+
+   //Check whether the whole path has been consumed
+   if(path != NULL)
+   {
+      //Search for the end of the current segment
+      end = osStrchr(path, '/');
+      //Retrieve the length of the segment
+      n = (end != NULL) ? (size_t) (end - path) : osStrlen(path);
+   }
+
+   //Initialize variables
+   exact = 0;
+   wildcard = 0;
+
+   //Loop through the children of the current node
+   for(j = context->routeNodes[i - 1].child; j != 0; j = node->sibling)
+   {
+      //Point to the current child node
+      node = &context->routeNodes[j - 1];
+
+      //Check the segment
+      if(node->length == 2 && node->segment[0] == '*' &&
+         node->segment[1] == '*')
+      {
+         //The "**" wildcard matches the rest of the path. A wildcard that
+         //does not accept the HTTP method must not hide a shallower one
+         if(*fallback == NULL || level >= *fallbackLevel)
+         {
+            //Check whether a route is registered for the HTTP method
+            route = httpGetNodeRoute(context, j, method);
+
+            //Keep track of the deepest matching "**" wildcard
+            if(route != NULL)
+            {
+               *fallback = route;
+               *fallbackLevel = level;
+            }
+         }
+      }
+      else if(node->length == 1 && node->segment[0] == '*')
+      {
+         //The "*" wildcard matches any non-empty segment
+         wildcard = (n != 0) ? j : 0;
+      }
+      else if(path != NULL && node->length == n &&
+         osStrncmp(node->segment, path, n) == 0)
+      {
+         //Literal match
+         exact = j;
+      }
+      else
+      {
+         //Not a match
+      }
+   }
+
+   //Whole path consumed?
+   if(path == NULL)
+      return httpGetNodeRoute(context, i, method);
+
+   //Point to the next segment, if any
+   path = (end != NULL) ? end + 1 : NULL;
+
+   //Initialize pointer
+   route = NULL;
+
+   //Literal segments take precedence over wildcards
+   if(exact != 0)
+   {
+      route = httpMatchRouteNode(context, exact, level + 1, method, path,
+         fallback, fallbackLevel);
+   }
+
+   //Backtrack to the wildcard if the literal branch leads to a dead end
+   if(route == NULL && wildcard != 0)
+   {
+      route = httpMatchRouteNode(context, wildcard, level + 1, method, path,
+         fallback, fallbackLevel);
+   }
+
+   //Return the matching route, if any
+   return route;
+}
+
+
+/**
+ * @brief Get the route attached to a node for a given HTTP method
+ * @param[in] context Pointer to the HTTP server context
+ * @param[in] i Index of the node
+ * @param[in] method HTTP method of the request
+ * @return Pointer to the matching route, if any
+ **/
+
+const HttpRoute *httpGetNodeRoute(HttpServerContext *context, uint_t i,
+   const char_t *method)
+{
+   uint_t j;
+   const HttpRoute *route;
+
+   //Loop through the routes attached to the node
+   for(j = context->routeNodes[i - 1].route; j != 0; j = route->next)
+   {
+      //Point to the current route
+      route = &context->routes[j - 1];
+
+      //Check HTTP method
+      if(route->method == NULL || osStrcasecmp(route->method, method) == 0)
+         return route;
+   }
+
+   //No matching route
+   return NULL;
+}
+
+
+/**
+ * @brief Invoke the request handler matching the current request
+ * @param[in] connection Structure representing an HTTP connection
+ * @return Error code (ERROR_NOT_FOUND if no route matches the request)
+ **/
+
+error_t httpDispatchRoute(HttpConnection *connection)
+{
+   error_t error;
+   const HttpRoute *route;
+
+   //Search the routing table
+   route = httpFindRoute(connection->serverContext,
+      connection->request.method, connection->request.uri);
+
+   //Any matching route?
+   if(route != NULL)
+   {
+      //Invoke the request handler
+      error = route->callback(connection, connection->request.uri);
+   }
+   else
+   {
+      //Keep processing...
+      error = ERROR_NOT_FOUND;
+   }
+
+   //Return status code
+   return error;
+}
+
+#endif
+
 #endif
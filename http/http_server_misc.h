@@ -82,6 +82,21 @@ error_t httpDecodePercentEncodedString(const char_t *input,
 void httpConvertArrayToHexString(const uint8_t *input,
    size_t inputLen, char_t *output);
 
+error_t httpAddRouteNode(HttpServerContext *context, const char_t *pattern,
+   uint_t *index);
+
+const HttpRoute *httpFindRoute(HttpServerContext *context,
+   const char_t *method, const char_t *path);
+
+const HttpRoute *httpMatchRouteNode(HttpServerContext *context, uint_t i,
+   uint_t level, const char_t *method, const char_t *path,
+   const HttpRoute **fallback, uint_t *fallbackLevel);
+
+const HttpRoute *httpGetNodeRoute(HttpServerContext *context, uint_t i,
+   const char_t *method);
+
+error_t httpDispatchRoute(HttpConnection *connection);
+
 //C++ guard
 #ifdef __cplusplus
 }
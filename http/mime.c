@@ -101,6 +101,82 @@ static const MimeType mimeTypeList[] =
 };
 
 
+//Extension lookup table (index of the matching entry plus one)
+static uint16_t mimeHashTable[MIME_HASH_TABLE_SIZE];
+//The lookup table is valid once built
+static bool_t mimeHashTableReady = FALSE;
+
+
+/**
+ * @brief Build the extension lookup table
+ *
+ * This function indexes the MIME type list so that mimeGetType can resolve
+ * an extension with a single hash probe instead of scanning the whole list.
+ * The list is only indexed when all the extensions are of the form ".ext".
+ * Otherwise, mimeGetType keeps matching filename suffixes linearly
+ *
+ **/
+
+void mimeInit(void)
+{
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   const char_t *extension;
+
+   //The lookup table is built only once
+   if(mimeHashTableReady)
+      return;
+
+   //Make sure the lookup table cannot be filled up
+   if(arraysize(mimeTypeList) >= MIME_HASH_TABLE_SIZE)
+      return;
+
+   //Clear the lookup table
+   osMemset(mimeHashTable, 0, sizeof(mimeHashTable));
+
+   //Loop through the MIME type list
+   for(i = 0; i < arraysize(mimeTypeList); i++)
+   {
+      //Point to the current extension
+      extension = mimeTypeList[i].extension;
+
+      //Only extensions of the form ".ext" can be indexed
+      if(extension[0] != '.' || extension[1] == '\0' ||
+         osStrchr(extension + 1, '.') != NULL)
+      {
+         return;
+      }
+
+      //Compute the hash value of the extension
+      k = mimeHashExtension(extension) & (MIME_HASH_TABLE_SIZE - 1);
+
+      //Resolve collisions using linear probing
+      while(mimeHashTable[k] != 0)
+      {
+         //Retrieve the entry occupying the current slot
+         j = mimeHashTable[k] - 1;
+
+         //Duplicate extension?
+         if(osStrcasecmp(mimeTypeList[j].extension, extension) == 0)
+            break;
+
+         //Try the next slot
+         k = (k + 1) & (MIME_HASH_TABLE_SIZE - 1);
+      }
+
+      //The first entry of the list takes precedence over duplicates
+      if(mimeHashTable[k] == 0)
+      {
+         mimeHashTable[k] = (uint16_t) (i + 1);
+      }
+   }
+
+   //The lookup table is now valid
+   mimeHashTableReady = TRUE;
+}
+
+
 /**
  * @brief Get the MIME type from a given extension
  *
@@ -113,14 +189,44 @@ static const MimeType mimeTypeList[] =
 const char_t *mimeGetType(const char_t *filename)
 {
    uint_t i;
+   uint_t k;
    uint_t n;
    uint_t m;
+   const char_t *p;
 
    //MIME type for unknown extensions
    static const char_t defaultMimeType[] = "application/octet-stream";
 
    //Valid filename?
-   if(filename != NULL)
+   if(filename != NULL && mimeHashTableReady)
+   {
+      //Locate the extension of the filename
+      p = osStrrchr(filename, '.');
+
+      //Any extension found?
+      if(p != NULL)
+      {
+         //Compute the hash value of the extension
+         k = mimeHashExtension(p) & (MIME_HASH_TABLE_SIZE - 1);
+
+         //Search the lookup table for a matching entry
+         while(mimeHashTable[k] != 0)
+         {
+            //Retrieve the corresponding entry
+            i = mimeHashTable[k] - 1;
+
+            //Compare file extensions
+            if(osStrcasecmp(p, mimeTypeList[i].extension) == 0)
+            {
+               return mimeTypeList[i].type;
+            }
+
+            //Try the next slot
+            k = (k + 1) & (MIME_HASH_TABLE_SIZE - 1);
+         }
+      }
+   }
+   else if(filename != NULL)
    {
       //Get the length of the specified filename
       n = osStrlen(filename);
@@ -146,3 +252,29 @@ const char_t *mimeGetType(const char_t *filename)
    //Return the default MIME type when an unknown extension is encountered
    return defaultMimeType;
 }
+
+
+/**
+ * @brief Compute the hash value of a file extension
+ * @param[in] extension NULL-terminated string holding the extension
+ * @return Case-insensitive hash value (FNV-1a)
+ **/
+
+uint32_t mimeHashExtension(const char_t *extension)
+{
+   uint32_t h;
+
+   //Initialize hash value
+   h = 2166136261;
+
+   //Process the extension, ignoring case
+   while(*extension != '\0')
+   {
+      h ^= (uint8_t) osTolower(*extension);
+      h *= 16777619;
+      extension++;
+   }
+
+   //Return the resulting hash value
+   return h;
+}
@@ -39,6 +39,14 @@
    #define MIME_CUSTOM_TYPES
 #endif
 
+//Size of the extension lookup table (must be a power of 2)
+#ifndef MIME_HASH_TABLE_SIZE
+   #define MIME_HASH_TABLE_SIZE 128
+#elif (MIME_HASH_TABLE_SIZE < 2 || MIME_HASH_TABLE_SIZE > 65536 || \
+   (MIME_HASH_TABLE_SIZE & (MIME_HASH_TABLE_SIZE - 1)) != 0)
+   #error MIME_HASH_TABLE_SIZE parameter is not valid
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -57,7 +65,9 @@ typedef struct
 
 
 //MIME related functions
+void mimeInit(void);
 const char_t *mimeGetType(const char_t *filename);
+uint32_t mimeHashExtension(const char_t *extension);
 
 //C++ guard
 #ifdef __cplusplus
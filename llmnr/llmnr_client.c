@@ -149,6 +149,9 @@ error_t llmnrResolve(NetInterface *interface, const char_t *name,
             //Switch state
             entry->state = DNS_STATE_IN_PROGRESS;
 
+            //Update the DNS cache index
+            dnsUpdateEntry(entry);
+
 #if (NET_RTOS_SUPPORT == ENABLED)
             //Initialize the reference count
             entry->refCount = 1;
@@ -543,6 +546,9 @@ void llmnrProcessResponse(NetInterface *interface,
                      //Host name successfully resolved
                      entry->state = DNS_STATE_RESOLVED;
 
+                     //Update the DNS cache index
+                     dnsUpdateEntry(entry);
+
                      //Exit immediately
                      break;
                   }
@@ -572,6 +578,9 @@ void llmnrProcessResponse(NetInterface *interface,
                      //Host name successfully resolved
                      entry->state = DNS_STATE_RESOLVED;
 
+                     //Update the DNS cache index
+                     dnsUpdateEntry(entry);
+
                      //Exit immediately
                      break;
                   }
@@ -137,6 +137,9 @@ error_t mdnsClientResolve(NetInterface *interface, const char_t *name,
          //Switch state
          entry->state = DNS_STATE_IN_PROGRESS;
 
+         //Update the DNS cache index
+         dnsUpdateEntry(entry);
+
 #if (NET_RTOS_SUPPORT == ENABLED)
          //Initialize the reference count
          entry->refCount = 1;
@@ -347,6 +350,9 @@ void mdnsClientParseAnRecord(NetInterface *interface,
 
                         //Host name successfully resolved
                         entry->state = DNS_STATE_RESOLVED;
+
+                        //Update the DNS cache index
+                        dnsUpdateEntry(entry);
                      }
                   }
                }
@@ -374,6 +380,9 @@ void mdnsClientParseAnRecord(NetInterface *interface,
 
                         //Host name successfully resolved
                         entry->state = DNS_STATE_RESOLVED;
+
+                        //Update the DNS cache index
+                        dnsUpdateEntry(entry);
                      }
                   }
                }
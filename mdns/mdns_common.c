@@ -459,9 +459,18 @@ error_t mdnsSendMessage(NetInterface *interface, const MdnsMessage *message,
    const IpAddr *destIpAddr, uint_t destPort)
 {
    error_t error;
+   size_t length;
    IpAddr ipAddr;
    NetTxAncillary ancillary;
 
+#if (MDNS_NAME_COMPRESSION_SUPPORT == ENABLED)
+   //Compress the domain names contained in the message
+   length = mdnsCompressMessage(message);
+#else
+   //Retrieve the length of the message
+   length = message->length;
+#endif
+
    //Convert 16-bit values to network byte order
    message->dnsHeader->qdcount = htons(message->dnsHeader->qdcount);
    message->dnsHeader->nscount = htons(message->dnsHeader->nscount);
@@ -469,15 +478,15 @@ error_t mdnsSendMessage(NetInterface *interface, const MdnsMessage *message,
    message->dnsHeader->arcount = htons(message->dnsHeader->arcount);
 
    //Adjust the length of the multi-part buffer
-   error = netBufferSetLength(message->buffer, message->offset + message->length);
+   error = netBufferSetLength(message->buffer, message->offset + length);
 
    //Check status code
    if(!error)
    {
       //Debug message
-      TRACE_INFO("Sending mDNS message (%" PRIuSIZE " bytes)...\r\n", message->length);
+      TRACE_INFO("Sending mDNS message (%" PRIuSIZE " bytes)...\r\n", length);
       //Dump message
-      dnsDumpMessage(message->dnsHeader, message->length);
+      dnsDumpMessage(message->dnsHeader, length);
 
       //Check whether the message should be sent to a specific IP address
       if(destIpAddr != NULL)
@@ -532,6 +541,245 @@ error_t mdnsSendMessage(NetInterface *interface, const MdnsMessage *message,
 }
 
 
+/**
+ * @brief Compress the domain names of a mDNS message
+ *
+ * The message is rewritten in place. Owner names, question names and the
+ * names carried by PTR and SRV records are compressed (refer to RFC 6762,
+ * section 18.14). The message is left unchanged if it already contains
+ * compressed names
+ *
+ * @param[in] message Pointer to the mDNS message
+ * @return Length of the resulting message
+ **/
+
+size_t mdnsCompressMessage(const MdnsMessage *message)
+{
+   error_t error;
+   uint_t i;
+   uint_t k;
+   uint_t pass;
+   size_t n;
+   size_t start;
+   size_t end;
+   size_t readPos;
+   size_t writePos;
+   uint16_t rtype;
+   uint8_t *p;
+   DnsResourceRecord *record;
+   DnsNameDictionary dictionary;
+
+   //Cast DNS message to byte array
+   p = (uint8_t *) message->dnsHeader;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Total number of entries (the 16-bit values are still in host byte order)
+   k = message->dnsHeader->qdcount + message->dnsHeader->ancount +
+      message->dnsHeader->nscount + message->dnsHeader->arcount;
+
+   //The first pass checks that the message is well-formed and that none of
+   //its names is compressed. The second pass rewrites the message
+   for(pass = 0; pass < 2 && !error; pass++)
+   {
+      //Point to the first entry of the message
+      readPos = sizeof(DnsHeader);
+      writePos = sizeof(DnsHeader);
+
+      //The dictionary is initially empty
+      dictionary.count = 0;
+
+      //Loop through the questions and the resource records
+      for(i = 0; i < k && !error; i++)
+      {
+         //Process the owner name
+         error = mdnsCompressName(message, &readPos, &writePos, &dictionary,
+            pass == 1);
+         //Any error to report?
+         if(error)
+            break;
+
+         //Question entry?
+         if(i < message->dnsHeader->qdcount)
+         {
+            //Retrieve the length of the fixed part
+            n = sizeof(DnsQuestion);
+         }
+         else
+         {
+            //Retrieve the length of the fixed part
+            n = sizeof(DnsResourceRecord);
+         }
+
+         //Malformed message?
+         if((readPos + n) > message->length)
+         {
+            error = ERROR_INVALID_MESSAGE;
+            break;
+         }
+
+         //Copy the fixed part
+         osMemmove(p + writePos, p + readPos, n);
+
+         //Point to the resource record
+         record = DNS_GET_RESOURCE_RECORD(p, writePos);
+
+         //Advance data pointers
+         readPos += n;
+         writePos += n;
+
+         //Question entry?
+         if(i < message->dnsHeader->qdcount)
+            continue;
+
+         //Retrieve the length of the rdata
+         n = ntohs(record->rdlength);
+         //Get resource record type
+         rtype = ntohs(record->rtype);
+
+         //Malformed message?
+         if((readPos + n) > message->length)
+         {
+            error = ERROR_INVALID_MESSAGE;
+            break;
+         }
+
+         //Save the boundaries of the rdata
+         start = writePos;
+         end = readPos + n;
+
+         //Check the type of the resource record
+         if(rtype == DNS_RR_TYPE_PTR)
+         {
+            //The rdata consists of a single domain name
+            error = mdnsCompressName(message, &readPos, &writePos, &dictionary,
+               pass == 1);
+         }
+         else if(rtype == DNS_RR_TYPE_SRV && n > 6)
+         {
+            //Copy the Priority, Weight and Port fields
+            osMemmove(p + writePos, p + readPos, 6);
+
+            //Advance data pointers
+            readPos += 6;
+            writePos += 6;
+
+            //The Target field is a domain name
+            error = mdnsCompressName(message, &readPos, &writePos, &dictionary,
+               pass == 1);
+         }
+         else
+         {
+            //Copy the rdata
+            osMemmove(p + writePos, p + readPos, n);
+
+            //Advance data pointers
+            readPos += n;
+            writePos += n;
+         }
+
+         //Any error to report?
+         if(error)
+            break;
+
+         //The name must fill the rdata entirely
+         if(readPos != end)
+         {
+            error = ERROR_INVALID_MESSAGE;
+            break;
+         }
+
+         //Update the length of the rdata
+         record->rdlength = htons(writePos - start);
+      }
+
+      //The whole message must have been parsed
+      if(!error && readPos != message->length)
+      {
+         error = ERROR_INVALID_MESSAGE;
+      }
+   }
+
+   //Return the length of the resulting message
+   return error ? message->length : writePos;
+}
+
+
+/**
+ * @brief Compress a domain name of a mDNS message
+ * @param[in] message Pointer to the mDNS message
+ * @param[in,out] readPos Offset of the uncompressed name
+ * @param[in,out] writePos Offset where to write the compressed name
+ * @param[in,out] dictionary Offsets of the names already written to the message
+ * @param[in] compress Rewrite the name (TRUE) or only check its format (FALSE)
+ * @return Error code
+ **/
+
+error_t mdnsCompressName(const MdnsMessage *message, size_t *readPos,
+   size_t *writePos, DnsNameDictionary *dictionary, bool_t compress)
+{
+   size_t n;
+   size_t pos;
+   uint8_t *p;
+   uint8_t name[DNS_NAME_MAX_SIZE];
+
+   //Cast DNS message to byte array
+   p = (uint8_t *) message->dnsHeader;
+
+   //Point to the first label
+   pos = *readPos;
+
+   //Parse the labels of the name
+   while(1)
+   {
+      //Malformed message?
+      if(pos >= message->length)
+         return ERROR_INVALID_MESSAGE;
+
+      //End marker found?
+      if(p[pos] == 0)
+         break;
+
+      //Compressed names are not supported
+      if(p[pos] > DNS_LABEL_MAX_SIZE)
+         return ERROR_INVALID_MESSAGE;
+
+      //Point to the next label
+      pos += p[pos] + 1;
+   }
+
+   //Length of the uncompressed name
+   n = pos + 1 - *readPos;
+
+   //Make sure the name is valid
+   if(n > DNS_NAME_MAX_SIZE)
+      return ERROR_INVALID_MESSAGE;
+
+   //Rewrite the name?
+   if(compress)
+   {
+      //The compressed name may overlap the original name
+      osMemcpy(name, p + *readPos, n);
+
+      //Write the compressed name
+      *writePos += dnsCompressName(message->dnsHeader, *writePos, name, n,
+         dictionary);
+   }
+   else
+   {
+      //The name is left unchanged
+      *writePos += n;
+   }
+
+   //Point to the end of the uncompressed name
+   *readPos += n;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
 /**
  * @brief Encode instance, service and domain names using the DNS name notation
  * @param[in] instance Instance name
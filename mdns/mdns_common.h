@@ -42,6 +42,13 @@
    #error MDNS_MESSAGE_MAX_SIZE parameter is not valid
 #endif
 
+//Name compression support
+#ifndef MDNS_NAME_COMPRESSION_SUPPORT
+   #define MDNS_NAME_COMPRESSION_SUPPORT DISABLED
+#elif (MDNS_NAME_COMPRESSION_SUPPORT != ENABLED && MDNS_NAME_COMPRESSION_SUPPORT != DISABLED)
+   #error MDNS_NAME_COMPRESSION_SUPPORT parameter is not valid
+#endif
+
 //Default resource record TTL (cache lifetime)
 #ifndef MDNS_DEFAULT_RR_TTL
    #define MDNS_DEFAULT_RR_TTL 120
@@ -110,6 +117,11 @@ void mdnsDeleteMessage(MdnsMessage *message);
 error_t mdnsSendMessage(NetInterface *interface, const MdnsMessage *message,
    const IpAddr *destIpAddr, uint_t destPort);
 
+size_t mdnsCompressMessage(const MdnsMessage *message);
+
+error_t mdnsCompressName(const MdnsMessage *message, size_t *readPos,
+   size_t *writePos, DnsNameDictionary *dictionary, bool_t compress);
+
 size_t mdnsEncodeName(const char_t *instance, const char_t *service,
    const char_t *domain, uint8_t *dest);
 
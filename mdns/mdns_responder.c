@@ -268,6 +268,8 @@ error_t mdnsResponderStartProbing(MdnsResponderContext *context)
    //Reset variables
    context->ipv4AddrCount = 0;
    context->ipv6AddrCount = 0;
+   //The encoded host name must be regenerated
+   context->encodedHostnameLen = 0;
 
 #if (IPV4_SUPPORT == ENABLED)
    //Loop through the list of IPv4 addresses assigned to the interface
@@ -549,22 +551,32 @@ void mdnsResponderTick(MdnsResponderContext *context)
       if(timeCompare(time, context->ipv4Response.timestamp +
          context->ipv4Response.timeout) >= 0)
       {
-#if (DNS_SD_RESPONDER_SUPPORT == ENABLED)
-         //Generate additional records (DNS-SD)
-         dnsSdResponderGenerateAdditionalRecords(interface,
-            &context->ipv4Response, FALSE);
-#endif
-         //Generate additional records (mDNS)
-         mdnsResponderGenerateAdditionalRecords(context,
-            &context->ipv4Response, FALSE);
-
          //Use mDNS IPv4 multicast address
          destIpAddr.length = sizeof(Ipv4Addr);
          destIpAddr.ipv4Addr = MDNS_IPV4_MULTICAST_ADDR;
 
-         //Send mDNS response message
-         mdnsSendMessage(interface, &context->ipv4Response, &destIpAddr,
-            MDNS_PORT);
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+         //Do not multicast the host records that have been sent recently
+         mdnsResponderLimitRate(context, &context->ipv4Response, &destIpAddr,
+            MDNS_RESPONDER_RATE_LIMIT_INTERVAL);
+
+         //Any answer left?
+         if(context->ipv4Response.dnsHeader->ancount > 0)
+#endif
+         {
+#if (DNS_SD_RESPONDER_SUPPORT == ENABLED)
+            //Generate additional records (DNS-SD)
+            dnsSdResponderGenerateAdditionalRecords(interface,
+               &context->ipv4Response, FALSE);
+#endif
+            //Generate additional records (mDNS)
+            mdnsResponderGenerateAdditionalRecords(context,
+               &context->ipv4Response, FALSE);
+
+            //Send mDNS response message
+            mdnsSendMessage(interface, &context->ipv4Response, &destIpAddr,
+               MDNS_PORT);
+         }
 
          //Free previously allocated memory
          mdnsDeleteMessage(&context->ipv4Response);
@@ -580,22 +592,32 @@ void mdnsResponderTick(MdnsResponderContext *context)
       if(timeCompare(time, context->ipv6Response.timestamp +
          context->ipv6Response.timeout) >= 0)
       {
-#if (DNS_SD_RESPONDER_SUPPORT == ENABLED)
-         //Generate additional records (DNS-SD)
-         dnsSdResponderGenerateAdditionalRecords(interface,
-            &context->ipv6Response, FALSE);
-#endif
-         //Generate additional records (mDNS)
-         mdnsResponderGenerateAdditionalRecords(context,
-            &context->ipv6Response, FALSE);
-
          //Use mDNS IPv6 multicast address
          destIpAddr.length = sizeof(Ipv6Addr);
          destIpAddr.ipv6Addr = MDNS_IPV6_MULTICAST_ADDR;
 
-         //Send mDNS response message
-         mdnsSendMessage(interface, &context->ipv6Response, &destIpAddr,
-            MDNS_PORT);
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+         //Do not multicast the host records that have been sent recently
+         mdnsResponderLimitRate(context, &context->ipv6Response, &destIpAddr,
+            MDNS_RESPONDER_RATE_LIMIT_INTERVAL);
+
+         //Any answer left?
+         if(context->ipv6Response.dnsHeader->ancount > 0)
+#endif
+         {
+#if (DNS_SD_RESPONDER_SUPPORT == ENABLED)
+            //Generate additional records (DNS-SD)
+            dnsSdResponderGenerateAdditionalRecords(interface,
+               &context->ipv6Response, FALSE);
+#endif
+            //Generate additional records (mDNS)
+            mdnsResponderGenerateAdditionalRecords(context,
+               &context->ipv6Response, FALSE);
+
+            //Send mDNS response message
+            mdnsSendMessage(interface, &context->ipv6Response, &destIpAddr,
+               MDNS_PORT);
+         }
 
          //Free previously allocated memory
          mdnsDeleteMessage(&context->ipv6Response);
@@ -121,6 +121,34 @@
    #error MDNS_ANNOUNCE_DELAY parameter is not valid
 #endif
 
+//Response aggregation window (0 means responses are not delayed)
+#ifndef MDNS_RESPONDER_AGGREGATION_DELAY
+   #define MDNS_RESPONDER_AGGREGATION_DELAY 0
+#elif (MDNS_RESPONDER_AGGREGATION_DELAY < 0 || MDNS_RESPONDER_AGGREGATION_DELAY > 500)
+   #error MDNS_RESPONDER_AGGREGATION_DELAY parameter is not valid
+#endif
+
+//Multicast rate limiting support
+#ifndef MDNS_RESPONDER_RATE_LIMIT_SUPPORT
+   #define MDNS_RESPONDER_RATE_LIMIT_SUPPORT DISABLED
+#elif (MDNS_RESPONDER_RATE_LIMIT_SUPPORT != ENABLED && MDNS_RESPONDER_RATE_LIMIT_SUPPORT != DISABLED)
+   #error MDNS_RESPONDER_RATE_LIMIT_SUPPORT parameter is not valid
+#endif
+
+//Minimum interval between two multicasts of the same record
+#ifndef MDNS_RESPONDER_RATE_LIMIT_INTERVAL
+   #define MDNS_RESPONDER_RATE_LIMIT_INTERVAL 1000
+#elif (MDNS_RESPONDER_RATE_LIMIT_INTERVAL < 250)
+   #error MDNS_RESPONDER_RATE_LIMIT_INTERVAL parameter is not valid
+#endif
+
+//Minimum interval between two multicasts of the same record (probe defense)
+#ifndef MDNS_RESPONDER_PROBE_RATE_LIMIT_INTERVAL
+   #define MDNS_RESPONDER_PROBE_RATE_LIMIT_INTERVAL 250
+#elif (MDNS_RESPONDER_PROBE_RATE_LIMIT_INTERVAL < 0)
+   #error MDNS_RESPONDER_PROBE_RATE_LIMIT_INTERVAL parameter is not valid
+#endif
+
 //Additional record generation
 #ifndef DNS_SD_ADDITIONAL_RECORDS_SUPPORT
    #define DNS_SD_ADDITIONAL_RECORDS_SUPPORT ENABLED
@@ -169,6 +197,10 @@ typedef struct
    bool_t valid;                                          ///<Valid entry
    DnsIpv4AddrResourceRecord record;                      ///<A resource record
    char_t reverseName[DNS_MAX_IPV4_REVERSE_NAME_LEN + 1]; ///<Reverse DNS lookup for IPv4
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+   systime_t recordTimestamp[2];                          ///<Time at which the A record was last multicast (IPv4 and IPv6)
+   systime_t ptrRecordTimestamp[2];                       ///<Time at which the PTR record was last multicast (IPv4 and IPv6)
+#endif
 } MdnsIpv4AddrEntry;
 
 
@@ -181,6 +213,10 @@ typedef struct
    bool_t valid;                                          ///<Valid entry
    DnsIpv6AddrResourceRecord record;                      ///<AAAA resource record
    char_t reverseName[DNS_MAX_IPV6_REVERSE_NAME_LEN + 1]; ///<Reverse DNS lookup for IPv6
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+   systime_t recordTimestamp[2];                          ///<Time at which the AAAA record was last multicast (IPv4 and IPv6)
+   systime_t ptrRecordTimestamp[2];                       ///<Time at which the PTR record was last multicast (IPv4 and IPv6)
+#endif
 } MdnsIpv6AddrEntry;
 
 
@@ -216,6 +252,8 @@ struct _MdnsResponderContext
    systime_t timeout;                                    ///<Timeout value
    uint_t retransmitCount;                               ///<Retransmission counter
    char_t hostname[MDNS_RESPONDER_MAX_HOSTNAME_LEN + 1]; ///<Host name
+   uint8_t encodedHostname[MDNS_RESPONDER_MAX_HOSTNAME_LEN + 8]; ///<Host name encoded using the DNS name notation
+   size_t encodedHostnameLen;                            ///<Length of the encoded host name (0 if not yet encoded)
    bool_t ipv4AddrCount;                                 ///<Number of valid IPv4 addresses
    bool_t ipv6AddrCount;                                 ///<Number of valid IPv6 addresses
 #if (IPV4_SUPPORT == ENABLED)
@@ -226,6 +264,9 @@ struct _MdnsResponderContext
    MdnsIpv6AddrEntry ipv6AddrList[IPV6_ADDR_LIST_SIZE];  ///<IPv6 address list
    MdnsMessage ipv6Response;                             ///<IPv6 response message
 #endif
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+   systime_t nsecRecordTimestamp[2];                     ///<Time at which the NSEC record was last multicast (IPv4 and IPv6)
+#endif
 };
 
 
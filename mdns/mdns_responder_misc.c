@@ -133,6 +133,9 @@ void mdnsResponderChangeHostname(MdnsResponderContext *context)
       //Programmatically change the host name
       osStrcat(context->hostname, s);
    }
+
+   //The encoded host name is no longer valid
+   context->encodedHostnameLen = 0;
 }
 
 
@@ -255,6 +258,11 @@ error_t mdnsResponderSendAnnouncement(MdnsResponderContext *context)
       if(error)
          break;
 
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+      //Record the time at which the resource records are multicast
+      mdnsResponderLimitRate(context, &message, NULL, 0);
+#endif
+
       //Send mDNS message
       error = mdnsSendMessage(context->interface, &message, NULL, MDNS_PORT);
 
@@ -346,6 +354,12 @@ void mdnsResponderProcessQuery(NetInterface *interface, MdnsMessage *query)
    MdnsResponderContext *context;
    MdnsMessage *response;
    MdnsMessage legacyUnicastResponse;
+#if (MDNS_RESPONDER_AGGREGATION_DELAY > 0)
+   bool_t pending;
+
+   //Check whether a response is already pending to be sent
+   pending = FALSE;
+#endif
 
    //Point to the mDNS responder context
    context = interface->mdnsResponderContext;
@@ -446,6 +460,13 @@ void mdnsResponderProcessQuery(NetInterface *interface, MdnsMessage *query)
       if(error)
          return;
    }
+#if (MDNS_RESPONDER_AGGREGATION_DELAY > 0)
+   else
+   {
+      //The answers will be appended to the pending response
+      pending = TRUE;
+   }
+#endif
 
    //Take the identifier from the query message
    response->dnsHeader->id = query->dnsHeader->id;
@@ -590,17 +611,53 @@ void mdnsResponderProcessQuery(NetInterface *interface, MdnsMessage *query)
             //Save current time
             response->timestamp = osGetSystemTime();
          }
+#if (MDNS_RESPONDER_AGGREGATION_DELAY > 0)
+         else if(query->dnsHeader->nscount == 0)
+         {
+            //Responses to subsequent queries are aggregated into the same
+            //message until the aggregation window expires (refer to RFC 6762,
+            //section 6.4)
+            if(!pending)
+            {
+               //Set the aggregation window
+               response->timeout = MDNS_RESPONDER_AGGREGATION_DELAY;
+               //Save current time
+               response->timestamp = osGetSystemTime();
+            }
+         }
+#endif
          else
          {
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+            //A record must not be multicast again within one second, except
+            //when defending it against a probe (refer to RFC 6762, section 6)
+            if(query->dnsHeader->nscount != 0)
+            {
+               mdnsResponderLimitRate(context, response, &destIpAddr,
+                  MDNS_RESPONDER_PROBE_RATE_LIMIT_INTERVAL);
+            }
+            else
+            {
+               mdnsResponderLimitRate(context, response, &destIpAddr,
+                  MDNS_RESPONDER_RATE_LIMIT_INTERVAL);
+            }
+
+            //Any answer left?
+            if(response->dnsHeader->ancount > 0)
+#endif
+            {
 #if (DNS_SD_RESPONDER_SUPPORT == ENABLED)
-            //Generate additional records (refer to RFC 6763, section 12)
-            dnsSdResponderGenerateAdditionalRecords(interface, response, FALSE);
+               //Generate additional records (refer to RFC 6763, section 12)
+               dnsSdResponderGenerateAdditionalRecords(interface, response,
+                  FALSE);
 #endif
-            //Generate additional records (mDNS)
-            mdnsResponderGenerateAdditionalRecords(context, response, FALSE);
+               //Generate additional records (mDNS)
+               mdnsResponderGenerateAdditionalRecords(context, response, FALSE);
+
+               //Send mDNS response message
+               mdnsSendMessage(interface, response, &destIpAddr, MDNS_PORT);
+            }
 
-            //Send mDNS response message
-            mdnsSendMessage(interface, response, &destIpAddr, MDNS_PORT);
             //Free previously allocated memory
             mdnsDeleteMessage(response);
          }
@@ -1584,15 +1641,15 @@ error_t mdnsResponderFormatIpv4AddrRecord(MdnsResponderContext *context,
       //Set the position to the end of the buffer
       offset = message->length;
 
-      //The first pass calculates the length of the DNS encoded host name
-      n = mdnsEncodeName(context->hostname, "", ".local", NULL);
+      //Retrieve the length of the DNS encoded host name
+      n = mdnsResponderEncodeHostname(context, NULL);
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the host name using the DNS name notation
-      offset += mdnsEncodeName(context->hostname, "", ".local",
+      //Copy the host name encoded using the DNS name notation
+      offset += mdnsResponderEncodeHostname(context,
          (uint8_t *) message->dnsHeader + offset);
 
       //Consider the length of the resource record itself
@@ -1662,15 +1719,15 @@ error_t mdnsResponderFormatIpv6AddrRecord(MdnsResponderContext *context,
       //Set the position to the end of the buffer
       offset = message->length;
 
-      //The first pass calculates the length of the DNS encoded host name
-      n = mdnsEncodeName(context->hostname, "", ".local", NULL);
+      //Retrieve the length of the DNS encoded host name
+      n = mdnsResponderEncodeHostname(context, NULL);
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the host name using the DNS name notation
-      offset += mdnsEncodeName(context->hostname, "", ".local",
+      //Copy the host name encoded using the DNS name notation
+      offset += mdnsResponderEncodeHostname(context,
          (uint8_t *) message->dnsHeader + offset);
 
       //Consider the length of the resource record itself
@@ -1775,15 +1832,15 @@ error_t mdnsResponderFormatIpv4PtrRecord(MdnsResponderContext *context,
       //Advance write index
       offset += sizeof(DnsResourceRecord);
 
-      //The first pass calculates the length of the DNS encoded host name
-      n = mdnsEncodeName("", context->hostname, ".local", NULL);
+      //Retrieve the length of the DNS encoded host name
+      n = mdnsResponderEncodeHostname(context, NULL);
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the host name using DNS notation
-      n = mdnsEncodeName("", context->hostname, ".local", record->rdata);
+      //Copy the host name encoded using DNS notation
+      n = mdnsResponderEncodeHostname(context, record->rdata);
 
       //Convert length field to network byte order
       record->rdlength = htons(n);
@@ -1865,15 +1922,15 @@ error_t mdnsResponderFormatIpv6PtrRecord(MdnsResponderContext *context,
       //Advance write index
       offset += sizeof(DnsResourceRecord);
 
-      //The first pass calculates the length of the DNS encoded host name
-      n = mdnsEncodeName("", context->hostname, ".local", NULL);
+      //Retrieve the length of the DNS encoded host name
+      n = mdnsResponderEncodeHostname(context, NULL);
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the host name using DNS notation
-      n = mdnsEncodeName("", context->hostname, ".local", record->rdata);
+      //Copy the host name encoded using DNS notation
+      n = mdnsResponderEncodeHostname(context, record->rdata);
 
       //Convert length field to network byte order
       record->rdlength = htons(n);
@@ -1945,15 +2002,15 @@ error_t mdnsResponderFormatNsecRecord(MdnsResponderContext *context,
       //Set the position to the end of the buffer
       offset = message->length;
 
-      //The first pass calculates the length of the DNS encoded host name
-      n = mdnsEncodeName(context->hostname, "", ".local", NULL);
+      //Retrieve the length of the DNS encoded host name
+      n = mdnsResponderEncodeHostname(context, NULL);
 
       //Check the length of the resulting mDNS message
       if((offset + n) > MDNS_MESSAGE_MAX_SIZE)
          return ERROR_MESSAGE_TOO_LONG;
 
-      //The second pass encodes the host name using the DNS name notation
-      offset += mdnsEncodeName(context->hostname, "", ".local",
+      //Copy the host name encoded using the DNS name notation
+      offset += mdnsResponderEncodeHostname(context,
          (uint8_t *) message->dnsHeader + offset);
 
       //Consider the length of the resource record itself
@@ -1982,7 +2039,7 @@ error_t mdnsResponderFormatNsecRecord(MdnsResponderContext *context,
          return ERROR_MESSAGE_TOO_LONG;
 
       //The Next Domain Name field contains the record's own name
-      mdnsEncodeName(context->hostname, "", ".local", record->rdata);
+      mdnsResponderEncodeHostname(context, record->rdata);
 
       //DNS NSEC record is limited to Window Block number zero
       record->rdata[n++] = 0;
@@ -2006,6 +2063,256 @@ error_t mdnsResponderFormatNsecRecord(MdnsResponderContext *context,
 }
 
 
+/**
+ * @brief Encode the host name using the DNS name notation
+ *
+ * The encoded host name is computed once and reused by all the host records
+ * until the host name or the address list changes
+ *
+ * @param[in] context Pointer to the mDNS responder context
+ * @param[out] dest Pointer to the encoded host name (optional parameter)
+ * @return Length of the encoded host name
+ **/
+
+size_t mdnsResponderEncodeHostname(MdnsResponderContext *context,
+   uint8_t *dest)
+{
+   //The host name has not been encoded yet?
+   if(context->encodedHostnameLen == 0)
+   {
+      //Encode the host name using the DNS name notation
+      context->encodedHostnameLen = mdnsEncodeName(context->hostname, "",
+         ".local", context->encodedHostname);
+   }
+
+   //Copy the encoded host name, if necessary
+   if(dest != NULL)
+   {
+      osMemcpy(dest, context->encodedHostname, context->encodedHostnameLen);
+   }
+
+   //Return the length of the encoded host name
+   return context->encodedHostnameLen;
+}
+
+
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+
+/**
+ * @brief Enforce the multicast rate limit of the host records
+ *
+ * A record that has been multicast within the specified interval is removed
+ * from the Answer Section of the response (refer to RFC 6762, section 6).
+ * The remaining host records are marked as multicast at the current time
+ *
+ * @param[in] context Pointer to the mDNS responder context
+ * @param[in] message Pointer to the mDNS response message
+ * @param[in] destIpAddr Destination IP address (NULL for both IPv4 and IPv6)
+ * @param[in] interval Minimum interval between two multicasts of a record
+ **/
+
+void mdnsResponderLimitRate(MdnsResponderContext *context,
+   MdnsMessage *message, const IpAddr *destIpAddr, systime_t interval)
+{
+   uint_t i;
+   uint_t j;
+   size_t n;
+   size_t offset;
+   systime_t time;
+   systime_t *timestamp;
+   DnsResourceRecord *record;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Point to the first resource record
+   offset = sizeof(DnsHeader);
+
+   //Parse the Answer Section of the response
+   for(i = 0; i < message->dnsHeader->ancount; i++)
+   {
+      //Parse resource record name
+      n = dnsParseName(message->dnsHeader, message->length, offset, NULL, 0);
+      //Invalid name?
+      if(!n)
+         break;
+
+      //Point to the associated resource record
+      record = DNS_GET_RESOURCE_RECORD(message->dnsHeader, n);
+      //Point to the resource data
+      n += sizeof(DnsResourceRecord);
+
+      //Make sure the resource record is valid
+      if(n > message->length)
+         break;
+
+      //Point to the end of the resource record
+      n += ntohs(record->rdlength);
+
+      //Make sure the resource record is valid
+      if(n > message->length)
+         break;
+
+      //Loop through the IPv4 and IPv6 links
+      for(j = 0; j < 2; j++)
+      {
+         //Skip the links the response is not sent on
+         if(destIpAddr != NULL)
+         {
+            if((destIpAddr->length == sizeof(Ipv6Addr)) != (j == 1))
+               continue;
+         }
+
+         //Retrieve the time at which the host record was last multicast
+         timestamp = mdnsResponderGetRecordTimestamp(context, message, offset,
+            record, j);
+
+         //Host record?
+         if(timestamp != NULL)
+         {
+            //Check whether the record has been multicast recently
+            if(interval > 0 && (time - *timestamp) < interval)
+            {
+               //Remove the resource record from the Answer Section
+               osMemmove((uint8_t *) message->dnsHeader + offset,
+                  (uint8_t *) message->dnsHeader + n, message->length - n);
+
+               //Update the length of the mDNS response message
+               message->length -= (n - offset);
+               //Update the number of resource records in the Answer Section
+               message->dnsHeader->ancount--;
+
+               //Keep at the same position
+               n = offset;
+               i--;
+
+               //The record is not multicast
+               break;
+            }
+            else
+            {
+               //Save the time at which the record is multicast
+               *timestamp = time;
+            }
+         }
+      }
+
+      //Point to the next resource record
+      offset = n;
+   }
+}
+
+
+/**
+ * @brief Retrieve the multicast timestamp associated with a host record
+ * @param[in] context Pointer to the mDNS responder context
+ * @param[in] message Pointer to the mDNS response message
+ * @param[in] offset Offset to the name of the resource record
+ * @param[in] record Pointer to the resource record
+ * @param[in] index Link index (0 for IPv4, 1 for IPv6)
+ * @return Pointer to the timestamp, or NULL if the record is not a host record
+ **/
+
+systime_t *mdnsResponderGetRecordTimestamp(MdnsResponderContext *context,
+   const MdnsMessage *message, size_t offset, const DnsResourceRecord *record,
+   uint_t index)
+{
+   uint_t i;
+   uint16_t rtype;
+   uint16_t rclass;
+
+   //Convert the type and the class to host byte order
+   rtype = ntohs(record->rtype);
+   rclass = ntohs(record->rclass) & ~MDNS_RCLASS_CACHE_FLUSH;
+
+   //Only records of class IN are considered
+   if(rclass != DNS_RR_CLASS_IN)
+      return NULL;
+
+   //NSEC record?
+   if(rtype == DNS_RR_TYPE_NSEC)
+   {
+      //Check whether the record belongs to the host
+      if(!mdnsCompareName(message->dnsHeader, message->length, offset,
+         context->hostname, "", ".local", 0))
+      {
+         return &context->nsecRecordTimestamp[index];
+      }
+   }
+
+#if (IPV4_SUPPORT == ENABLED)
+   //Loop through the list of IPv4 addresses assigned to the interface
+   for(i = 0; i < IPV4_ADDR_LIST_SIZE; i++)
+   {
+      //Valid IPv4 address?
+      if(context->ipv4AddrList[i].valid)
+      {
+         //A record?
+         if(rtype == DNS_RR_TYPE_A &&
+            ntohs(record->rdlength) == sizeof(Ipv4Addr))
+         {
+            //Check the name and the address of the record
+            if(ipv4CompAddr(context->ipv4AddrList[i].record.rdata,
+               record->rdata) && !mdnsCompareName(message->dnsHeader,
+               message->length, offset, context->hostname, "", ".local", 0))
+            {
+               return &context->ipv4AddrList[i].recordTimestamp[index];
+            }
+         }
+         //PTR record?
+         else if(rtype == DNS_RR_TYPE_PTR)
+         {
+            //Check the name of the record
+            if(!mdnsCompareName(message->dnsHeader, message->length, offset,
+               context->ipv4AddrList[i].reverseName, "in-addr", ".arpa", 0))
+            {
+               return &context->ipv4AddrList[i].ptrRecordTimestamp[index];
+            }
+         }
+      }
+   }
+#endif
+
+#if (IPV6_SUPPORT == ENABLED)
+   //Loop through the list of IPv6 addresses assigned to the interface
+   for(i = 0; i < IPV6_ADDR_LIST_SIZE; i++)
+   {
+      //Valid IPv6 address?
+      if(context->ipv6AddrList[i].valid)
+      {
+         //AAAA record?
+         if(rtype == DNS_RR_TYPE_AAAA &&
+            ntohs(record->rdlength) == sizeof(Ipv6Addr))
+         {
+            //Check the name and the address of the record
+            if(ipv6CompAddr(context->ipv6AddrList[i].record.rdata,
+               record->rdata) && !mdnsCompareName(message->dnsHeader,
+               message->length, offset, context->hostname, "", ".local", 0))
+            {
+               return &context->ipv6AddrList[i].recordTimestamp[index];
+            }
+         }
+         //PTR record?
+         else if(rtype == DNS_RR_TYPE_PTR)
+         {
+            //Check the name of the record
+            if(!mdnsCompareName(message->dnsHeader, message->length, offset,
+               context->ipv6AddrList[i].reverseName, "ip6", ".arpa", 0))
+            {
+               return &context->ipv6AddrList[i].ptrRecordTimestamp[index];
+            }
+         }
+      }
+   }
+#endif
+
+   //The record is not a host record
+   return NULL;
+}
+
+#endif
+
+
 /**
  * @brief Sort the host records in lexicographical order
  * @param[in] context Pointer to the mDNS responder context
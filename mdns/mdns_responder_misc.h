@@ -101,6 +101,20 @@ error_t mdnsResponderFormatIpv6PtrRecord(MdnsResponderContext *context,
 error_t mdnsResponderFormatNsecRecord(MdnsResponderContext *context,
    MdnsMessage *message, bool_t cacheFlush, uint32_t ttl);
 
+size_t mdnsResponderEncodeHostname(MdnsResponderContext *context,
+   uint8_t *dest);
+
+#if (MDNS_RESPONDER_RATE_LIMIT_SUPPORT == ENABLED)
+
+void mdnsResponderLimitRate(MdnsResponderContext *context,
+   MdnsMessage *message, const IpAddr *destIpAddr, systime_t interval);
+
+systime_t *mdnsResponderGetRecordTimestamp(MdnsResponderContext *context,
+   const MdnsMessage *message, size_t offset, const DnsResourceRecord *record,
+   uint_t index);
+
+#endif
+
 DnsResourceRecord *mdnsResponderGetNextHostRecord(MdnsResponderContext *context,
    DnsResourceRecord *record);
 
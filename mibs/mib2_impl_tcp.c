@@ -305,6 +305,21 @@ error_t mib2GetNextTcpConnEntry(const MibObject *object, const uint8_t *oid,
    Ipv4Addr remoteIpAddr;
    uint16_t remotePort;
    Socket *socket;
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   MibSnapshot *snapshot;
+#endif
+
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   //Retrieve the sorted snapshot of the table
+   snapshot = mibGetSnapshot(mib2BuildTcpConnSnapshot);
+
+   //Search the snapshot rather than walking through the whole table
+   if(snapshot != NULL)
+   {
+      return mibGetNextSnapshotEntry(object, snapshot, oid, oidLen, nextOid,
+         nextOidLen);
+   }
+#endif
 
    //Initialize variables
    localIpAddr = IPV4_UNSPECIFIED_ADDR;
@@ -328,9 +343,11 @@ error_t mib2GetNextTcpConnEntry(const MibObject *object, const uint8_t *oid,
       //TCP socket?
       if(socket->type == SOCKET_TYPE_STREAM)
       {
-         //Filter out IPv6 connections
+         //Filter out IPv6 connections and unbound sockets (same row filter
+         //as mib2BuildTcpConnSnapshot)
          if(socket->localIpAddr.length != sizeof(Ipv6Addr) &&
-            socket->remoteIpAddr.length != sizeof(Ipv6Addr))
+            socket->remoteIpAddr.length != sizeof(Ipv6Addr) &&
+            (socket->localPort != 0 || socket->remotePort != 0))
          {
             //Append the instance identifier to the OID prefix
             n = object->oidLen;
@@ -453,4 +470,79 @@ error_t mib2GetNextTcpConnEntry(const MibObject *object, const uint8_t *oid,
    return NO_ERROR;
 }
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+/**
+ * @brief Capture the rows of the tcpConnTable
+ * @param[in] snapshot Pointer to the snapshot to be populated
+ * @return Error code
+ **/
+
+error_t mib2BuildTcpConnSnapshot(MibSnapshot *snapshot)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   uint8_t index[MIB_SNAPSHOT_MAX_INDEX_SIZE];
+   Socket *socket;
+
+   //Loop through socket descriptors
+   for(i = 0; i < SOCKET_MAX_COUNT; i++)
+   {
+      //Point to current socket
+      socket = &socketTable[i];
+
+      //Skip sockets that are not part of the table
+      if(socket->type != SOCKET_TYPE_STREAM)
+         continue;
+      if(socket->localIpAddr.length == sizeof(Ipv6Addr) ||
+         socket->remoteIpAddr.length == sizeof(Ipv6Addr))
+      {
+         continue;
+      }
+      if(socket->localPort == 0 && socket->remotePort == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //tcpConnLocalAddress is used as 1st instance identifier
+      error = mibEncodeIpv4Addr(index, sizeof(index), &n,
+         socket->localIpAddr.ipv4Addr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpConnLocalPort is used as 2nd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->localPort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpConnRemAddress is used as 3rd instance identifier
+      error = mibEncodeIpv4Addr(index, sizeof(index), &n,
+         socket->remoteIpAddr.ipv4Addr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpConnRemPort is used as 4th instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->remotePort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
+
 #endif
@@ -173,6 +173,21 @@ error_t mib2GetNextUdpEntry(const MibObject *object, const uint8_t *oid,
    bool_t acceptable;
    Ipv4Addr localIpAddr;
    uint16_t localPort;
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   MibSnapshot *snapshot;
+#endif
+
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   //Retrieve the sorted snapshot of the table
+   snapshot = mibGetSnapshot(mib2BuildUdpSnapshot);
+
+   //Search the snapshot rather than walking through the whole table
+   if(snapshot != NULL)
+   {
+      return mibGetNextSnapshotEntry(object, snapshot, oid, oidLen, nextOid,
+         nextOidLen);
+   }
+#endif
 
    //Initialize variables
    localIpAddr = IPV4_UNSPECIFIED_ADDR;
@@ -194,9 +209,11 @@ error_t mib2GetNextUdpEntry(const MibObject *object, const uint8_t *oid,
       //UDP socket?
       if(socket->type == SOCKET_TYPE_DGRAM)
       {
-         //Filter out IPv6 connections
+         //Filter out IPv6 connections and unbound sockets (same row filter
+         //as mib2BuildUdpSnapshot)
          if(socket->localIpAddr.length != sizeof(Ipv6Addr) &&
-            socket->remoteIpAddr.length != sizeof(Ipv6Addr))
+            socket->remoteIpAddr.length != sizeof(Ipv6Addr) &&
+            socket->localPort != 0)
          {
             //Append the instance identifier to the OID prefix
             n = object->oidLen;
@@ -258,7 +275,7 @@ error_t mib2GetNextUdpEntry(const MibObject *object, const uint8_t *oid,
       UdpRxCallbackEntry *entry = &udpCallbackTable[i];
 
       //Check whether the entry is currently in use
-      if(entry->callback != NULL)
+      if(entry->callback != NULL && entry->port != 0)
       {
          //Append the instance identifier to the OID prefix
          n = object->oidLen;
@@ -338,4 +355,100 @@ error_t mib2GetNextUdpEntry(const MibObject *object, const uint8_t *oid,
    return NO_ERROR;
 }
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+/**
+ * @brief Capture the rows of the udpTable
+ * @param[in] snapshot Pointer to the snapshot to be populated
+ * @return Error code
+ **/
+
+error_t mib2BuildUdpSnapshot(MibSnapshot *snapshot)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   uint8_t index[MIB_SNAPSHOT_MAX_INDEX_SIZE];
+   Socket *socket;
+   UdpRxCallbackEntry *entry;
+
+   //Loop through socket descriptors
+   for(i = 0; i < SOCKET_MAX_COUNT; i++)
+   {
+      //Point to current socket
+      socket = &socketTable[i];
+
+      //Skip sockets that are not part of the table
+      if(socket->type != SOCKET_TYPE_DGRAM)
+         continue;
+      if(socket->localIpAddr.length == sizeof(Ipv6Addr) ||
+         socket->remoteIpAddr.length == sizeof(Ipv6Addr))
+      {
+         continue;
+      }
+      if(socket->localPort == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //udpLocalAddress is used as 1st instance identifier
+      error = mibEncodeIpv4Addr(index, sizeof(index), &n,
+         socket->localIpAddr.ipv4Addr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpLocalPort is used as 2nd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->localPort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Loop through the UDP callback table
+   for(i = 0; i < UDP_CALLBACK_TABLE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &udpCallbackTable[i];
+
+      //Skip unused entries
+      if(entry->callback == NULL || entry->port == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //udpLocalAddress is used as 1st instance identifier
+      error = mibEncodeIpv4Addr(index, sizeof(index), &n,
+         IPV4_UNSPECIFIED_ADDR);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpLocalPort is used as 2nd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, entry->port);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
+
 #endif
@@ -47,6 +47,10 @@ error_t mib2GetUdpEntry(const MibObject *object, const uint8_t *oid,
 error_t mib2GetNextUdpEntry(const MibObject *object, const uint8_t *oid,
    size_t oidLen, uint8_t *nextOid, size_t *nextOidLen);
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+error_t mib2BuildUdpSnapshot(MibSnapshot *snapshot);
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 }
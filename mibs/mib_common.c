@@ -34,6 +34,16 @@
 #include "encoding/oid.h"
 #include "debug.h"
 
+//Sorted table snapshots supported?
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+//Table snapshots
+MibSnapshot mibSnapshotTable[MIB_SNAPSHOT_TABLE_SIZE];
+//Reference time used to check the freshness of the snapshots
+systime_t mibSnapshotTime;
+
+#endif
+
 
 /**
  * @brief Encode instance identifier (index)
@@ -994,6 +1004,317 @@ int_t mibCompIpAddr(const IpAddr *ipAddr1, const IpAddr *ipAddr2)
 }
 
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+/**
+ * @brief Update the reference time used to check the freshness of snapshots
+ *
+ * This function is called once per request PDU, so that all the variable
+ * bindings (and all the repetitions of a GetBulkRequest-PDU) are served from
+ * the same snapshots
+ *
+ **/
+
+void mibUpdateSnapshotTime(void)
+{
+   //Save current time
+   mibSnapshotTime = osGetSystemTime();
+}
+
+
+/**
+ * @brief Retrieve the sorted snapshot of a table
+ *
+ * The snapshot is reused as long as it is fresh. Otherwise it is rebuilt by
+ * invoking the specified callback, which adds one entry per row
+ *
+ * @param[in] callback Callback that populates the snapshot of the table
+ * @return Pointer to the snapshot, or NULL if the table could not be captured
+ **/
+
+MibSnapshot *mibGetSnapshot(MibSnapshotCallback callback)
+{
+   error_t error;
+   uint_t i;
+   MibSnapshot *entry;
+   MibSnapshot *snapshot;
+
+   //Initialize pointer
+   snapshot = NULL;
+
+   //Loop through the table snapshots
+   for(i = 0; i < MIB_SNAPSHOT_TABLE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &mibSnapshotTable[i];
+
+      //Snapshot of the same table?
+      if(entry->callback == callback)
+      {
+         //Check whether the snapshot is still fresh
+         if(timeCompare(mibSnapshotTime, entry->timestamp +
+            MIB_SNAPSHOT_LIFETIME) < 0)
+         {
+            return entry;
+         }
+
+         //The snapshot must be rebuilt
+         snapshot = entry;
+         break;
+      }
+      else if(entry->callback == NULL)
+      {
+         //Keep track of the first free entry
+         if(snapshot == NULL || snapshot->callback != NULL)
+         {
+            snapshot = entry;
+         }
+      }
+      else
+      {
+         //Keep track of the oldest entry
+         if(snapshot == NULL || (snapshot->callback != NULL &&
+            timeCompare(entry->timestamp, snapshot->timestamp) < 0))
+         {
+            snapshot = entry;
+         }
+      }
+   }
+
+   //Take a new snapshot of the table
+   snapshot->callback = callback;
+   snapshot->timestamp = mibSnapshotTime;
+   snapshot->numEntries = 0;
+
+   //Add all the rows of the table
+   error = callback(snapshot);
+
+   //The snapshot cannot hold all the rows?
+   if(error)
+   {
+      //Release the entry
+      snapshot->callback = NULL;
+      snapshot = NULL;
+   }
+
+   //Return a pointer to the snapshot
+   return snapshot;
+}
+
+
+/**
+ * @brief Add a row to a table snapshot
+ * @param[in] snapshot Pointer to the snapshot
+ * @param[in] index Instance identifier of the row
+ * @param[in] indexLen Length of the instance identifier, in bytes
+ * @return Error code
+ **/
+
+error_t mibAddSnapshotEntry(MibSnapshot *snapshot, const uint8_t *index,
+   size_t indexLen)
+{
+   int_t res;
+   uint_t i;
+   uint_t left;
+   uint_t right;
+   MibSnapshotEntry *entry;
+
+   //Make sure the instance identifier is acceptable
+   if(indexLen > MIB_SNAPSHOT_MAX_INDEX_SIZE)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Binary search for the position of the new row
+   left = 0;
+   right = snapshot->numEntries;
+
+   //Loop until the position is found
+   while(left < right)
+   {
+      //Point to the middle entry
+      i = (left + right) / 2;
+      entry = &snapshot->entries[i];
+
+      //Compare instance identifiers
+      res = osMemcmp(entry->index, index, MIN(entry->indexLen, indexLen));
+
+      //Identical prefixes?
+      if(res == 0)
+      {
+         //Shorter instance identifiers come first
+         if(entry->indexLen < indexLen)
+         {
+            res = -1;
+         }
+         else if(entry->indexLen > indexLen)
+         {
+            res = 1;
+         }
+      }
+
+      //Duplicate rows are ignored
+      if(res == 0)
+         return NO_ERROR;
+
+      //Narrow the search
+      if(res < 0)
+      {
+         left = i + 1;
+      }
+      else
+      {
+         right = i;
+      }
+   }
+
+   //Make sure the snapshot is large enough to hold the row
+   if(snapshot->numEntries >= MIB_SNAPSHOT_MAX_ENTRIES)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Make room for the new row
+   for(i = snapshot->numEntries; i > left; i--)
+   {
+      snapshot->entries[i] = snapshot->entries[i - 1];
+   }
+
+   //Save the instance identifier
+   osMemcpy(snapshot->entries[left].index, index, indexLen);
+   snapshot->entries[left].indexLen = indexLen;
+
+   //Update the number of rows
+   snapshot->numEntries++;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Search a table snapshot for the next object
+ * @param[in] object Pointer to the MIB object descriptor
+ * @param[in] snapshot Pointer to the snapshot of the table
+ * @param[in] oid Object identifier
+ * @param[in] oidLen Length of the OID, in bytes
+ * @param[out] nextOid OID of the next object in the MIB
+ * @param[out] nextOidLen Length of the next object identifier, in bytes
+ * @return Error code
+ **/
+
+error_t mibGetNextSnapshotEntry(const MibObject *object,
+   const MibSnapshot *snapshot, const uint8_t *oid, size_t oidLen,
+   uint8_t *nextOid, size_t *nextOidLen)
+{
+   uint_t i;
+   uint_t left;
+   uint_t right;
+   const MibSnapshotEntry *entry;
+
+   //Binary search for the first row that lexicographically follows the
+   //specified OID
+   left = 0;
+   right = snapshot->numEntries;
+
+   //Loop until the row is found
+   while(left < right)
+   {
+      //Point to the middle entry
+      i = (left + right) / 2;
+
+      //Compare object identifiers
+      if(mibCompSnapshotEntry(object, &snapshot->entries[i], oid, oidLen) > 0)
+      {
+         right = i;
+      }
+      else
+      {
+         left = i + 1;
+      }
+   }
+
+   //The specified OID does not lexicographically precede the name
+   //of some object?
+   if(left >= snapshot->numEntries)
+      return ERROR_OBJECT_NOT_FOUND;
+
+   //Point to the matching row
+   entry = &snapshot->entries[left];
+
+   //Make sure the buffer is large enough to hold the resulting OID
+   if(*nextOidLen < (object->oidLen + entry->indexLen))
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Append the instance identifier to the OID prefix
+   osMemcpy(nextOid, object->oid, object->oidLen);
+   osMemcpy(nextOid + object->oidLen, entry->index, entry->indexLen);
+
+   //Save the length of the resulting object identifier
+   *nextOidLen = object->oidLen + entry->indexLen;
+
+   //Next object found
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Compare the OID of a snapshot row with a given OID
+ * @param[in] object Pointer to the MIB object descriptor
+ * @param[in] entry Pointer to the snapshot row
+ * @param[in] oid Object identifier
+ * @param[in] oidLen Length of the OID, in bytes
+ * @return Comparison result
+ **/
+
+int_t mibCompSnapshotEntry(const MibObject *object,
+   const MibSnapshotEntry *entry, const uint8_t *oid, size_t oidLen)
+{
+   size_t i;
+   size_t n;
+   uint8_t value;
+
+   //Length of the OID of the row (object name and instance identifier)
+   n = object->oidLen + entry->indexLen;
+
+   //Perform lexicographic comparison
+   for(i = 0; i < n && i < oidLen; i++)
+   {
+      //Retrieve the current byte of the OID of the row
+      if(i < object->oidLen)
+      {
+         value = object->oid[i];
+      }
+      else
+      {
+         value = entry->index[i - object->oidLen];
+      }
+
+      //Compare bytes
+      if(value < oid[i])
+      {
+         return -1;
+      }
+      else if(value > oid[i])
+      {
+         return 1;
+      }
+   }
+
+   //Compare lengths
+   if(n < oidLen)
+   {
+      return -1;
+   }
+   else if(n > oidLen)
+   {
+      return 1;
+   }
+   else
+   {
+      return 0;
+   }
+}
+
+#endif
+
+
 /**
  * @brief Test and increment spin lock
  * @param[in,out] spinLock Pointer to the spin lock
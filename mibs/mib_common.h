@@ -41,10 +41,49 @@
    #error MIB_MAX_OID_SIZE parameter is not valid
 #endif
 
+//Sorted table snapshots
+#ifndef MIB_SNAPSHOT_SUPPORT
+   #define MIB_SNAPSHOT_SUPPORT DISABLED
+#elif (MIB_SNAPSHOT_SUPPORT != ENABLED && MIB_SNAPSHOT_SUPPORT != DISABLED)
+   #error MIB_SNAPSHOT_SUPPORT parameter is not valid
+#endif
+
+//Number of table snapshots that can be cached
+#ifndef MIB_SNAPSHOT_TABLE_SIZE
+   #define MIB_SNAPSHOT_TABLE_SIZE 2
+#elif (MIB_SNAPSHOT_TABLE_SIZE < 1)
+   #error MIB_SNAPSHOT_TABLE_SIZE parameter is not valid
+#endif
+
+//Maximum number of rows per snapshot
+#ifndef MIB_SNAPSHOT_MAX_ENTRIES
+   #define MIB_SNAPSHOT_MAX_ENTRIES 32
+#elif (MIB_SNAPSHOT_MAX_ENTRIES < 1)
+   #error MIB_SNAPSHOT_MAX_ENTRIES parameter is not valid
+#endif
+
+//Maximum size of the instance identifier of a row
+#ifndef MIB_SNAPSHOT_MAX_INDEX_SIZE
+   #define MIB_SNAPSHOT_MAX_INDEX_SIZE 40
+#elif (MIB_SNAPSHOT_MAX_INDEX_SIZE < 1)
+   #error MIB_SNAPSHOT_MAX_INDEX_SIZE parameter is not valid
+#endif
+
+//Snapshot lifetime
+#ifndef MIB_SNAPSHOT_LIFETIME
+   #define MIB_SNAPSHOT_LIFETIME 1000
+#elif (MIB_SNAPSHOT_LIFETIME < 0)
+   #error MIB_SNAPSHOT_LIFETIME parameter is not valid
+#endif
+
 //Forward declaration of MibObject structure
 struct _MibObject;
 #define MibObject struct _MibObject
 
+//Forward declaration of MibSnapshot structure
+struct _MibSnapshot;
+#define MibSnapshot struct _MibSnapshot
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -249,6 +288,42 @@ struct _MibObject
 };
 
 
+//Sorted table snapshots supported?
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+/**
+ * @brief Table snapshot entry
+ **/
+
+typedef struct
+{
+   uint8_t index[MIB_SNAPSHOT_MAX_INDEX_SIZE]; ///<Instance identifier
+   size_t indexLen;                           ///<Length of the instance identifier, in bytes
+} MibSnapshotEntry;
+
+
+/**
+ * @brief Snapshot population callback
+ **/
+
+typedef error_t (*MibSnapshotCallback)(MibSnapshot *snapshot);
+
+
+/**
+ * @brief Sorted table snapshot
+ **/
+
+struct _MibSnapshot
+{
+   MibSnapshotCallback callback;                       ///<Callback that populates the snapshot
+   systime_t timestamp;                                ///<Time at which the snapshot was taken
+   uint_t numEntries;                                  ///<Number of rows
+   MibSnapshotEntry entries[MIB_SNAPSHOT_MAX_ENTRIES]; ///<Rows, in lexicographic order
+};
+
+#endif
+
+
 /**
  * @brief MIB initialization
  **/
@@ -373,6 +448,24 @@ error_t mibDecodeIpAddr(const uint8_t *oid, size_t oidLen, size_t *pos,
 int_t mibCompMacAddr(const MacAddr *macAddr1, const MacAddr *macAddr2);
 int_t mibCompIpAddr(const IpAddr *ipAddr1, const IpAddr *ipAddr2);
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+void mibUpdateSnapshotTime(void);
+
+MibSnapshot *mibGetSnapshot(MibSnapshotCallback callback);
+
+error_t mibAddSnapshotEntry(MibSnapshot *snapshot, const uint8_t *index,
+   size_t indexLen);
+
+error_t mibGetNextSnapshotEntry(const MibObject *object,
+   const MibSnapshot *snapshot, const uint8_t *oid, size_t oidLen,
+   uint8_t *nextOid, size_t *nextOidLen);
+
+int_t mibCompSnapshotEntry(const MibObject *object,
+   const MibSnapshotEntry *entry, const uint8_t *oid, size_t oidLen);
+
+#endif
+
 error_t mibTestAndIncSpinLock(int32_t *spinLock, int32_t value, bool_t commit);
 
 //C++ guard
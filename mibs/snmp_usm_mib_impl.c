@@ -447,6 +447,11 @@ error_t snmpUsmMibSetUserEntry(const MibObject *object, const uint8_t *oid,
 
          //The raw authentication key (Ku) is no longer valid
          osMemset(&user->rawAuthKey, 0, sizeof(SnmpKey));
+
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+         //Precompute HMAC states and cipher key schedules
+         snmpUpdateKeyCache(user);
+#endif
       }
    }
    //usmUserPrivProtocol object?
@@ -548,6 +553,11 @@ error_t snmpUsmMibSetUserEntry(const MibObject *object, const uint8_t *oid,
 
          //The raw privacy key (Ku) is no longer valid
          osMemset(&user->rawPrivKey, 0, sizeof(SnmpKey));
+
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+         //Precompute HMAC states and cipher key schedules
+         snmpUpdateKeyCache(user);
+#endif
       }
    }
    //usmUserPublic object?
@@ -309,6 +309,21 @@ error_t tcpMibGetNextTcpConnectionEntry(const MibObject *object, const uint8_t *
    IpAddr remoteIpAddr;
    uint16_t remotePort;
    Socket *socket;
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   MibSnapshot *snapshot;
+#endif
+
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   //Retrieve the sorted snapshot of the table
+   snapshot = mibGetSnapshot(tcpMibBuildTcpConnectionSnapshot);
+
+   //Search the snapshot rather than walking through the whole table
+   if(snapshot != NULL)
+   {
+      return mibGetNextSnapshotEntry(object, snapshot, oid, oidLen, nextOid,
+         nextOidLen);
+   }
+#endif
 
    //Initialize variables
    localIpAddr = IP_ADDR_ANY;
@@ -332,8 +347,10 @@ error_t tcpMibGetNextTcpConnectionEntry(const MibObject *object, const uint8_t *
       //TCP socket?
       if(socket->type == SOCKET_TYPE_STREAM)
       {
-         //Check current state
-         if(socket->state != TCP_STATE_LISTEN)
+         //Skip listening and unbound sockets (same row filter as
+         //tcpMibBuildTcpConnectionSnapshot)
+         if(socket->state != TCP_STATE_LISTEN &&
+            (socket->localPort != 0 || socket->remotePort != 0))
          {
             //Append the instance identifier to the OID prefix
             n = object->oidLen;
@@ -567,6 +584,21 @@ error_t tcpMibGetNextTcpListenerEntry(const MibObject *object, const uint8_t *oi
    IpAddr localIpAddr;
    uint16_t localPort;
    Socket *socket;
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   MibSnapshot *snapshot;
+#endif
+
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   //Retrieve the sorted snapshot of the table
+   snapshot = mibGetSnapshot(tcpMibBuildTcpListenerSnapshot);
+
+   //Search the snapshot rather than walking through the whole table
+   if(snapshot != NULL)
+   {
+      return mibGetNextSnapshotEntry(object, snapshot, oid, oidLen, nextOid,
+         nextOidLen);
+   }
+#endif
 
    //Initialize variables
    localIpAddr = IP_ADDR_ANY;
@@ -588,8 +620,9 @@ error_t tcpMibGetNextTcpListenerEntry(const MibObject *object, const uint8_t *oi
       //TCP socket?
       if(socket->type == SOCKET_TYPE_STREAM)
       {
-         //Check current state
-         if(socket->state == TCP_STATE_LISTEN)
+         //Skip unbound sockets (same row filter as
+         //tcpMibBuildTcpListenerSnapshot)
+         if(socket->state == TCP_STATE_LISTEN && socket->localPort != 0)
          {
             //Append the instance identifier to the OID prefix
             n = object->oidLen;
@@ -672,4 +705,132 @@ error_t tcpMibGetNextTcpListenerEntry(const MibObject *object, const uint8_t *oi
    return NO_ERROR;
 }
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+/**
+ * @brief Capture the rows of the tcpConnectionTable
+ * @param[in] snapshot Pointer to the snapshot to be populated
+ * @return Error code
+ **/
+
+error_t tcpMibBuildTcpConnectionSnapshot(MibSnapshot *snapshot)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   uint8_t index[MIB_SNAPSHOT_MAX_INDEX_SIZE];
+   Socket *socket;
+
+   //Loop through socket descriptors
+   for(i = 0; i < SOCKET_MAX_COUNT; i++)
+   {
+      //Point to current socket
+      socket = &socketTable[i];
+
+      //Skip sockets that are not part of the table
+      if(socket->type != SOCKET_TYPE_STREAM)
+         continue;
+      if(socket->state == TCP_STATE_LISTEN)
+         continue;
+      if(socket->localPort == 0 && socket->remotePort == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //tcpConnectionLocalAddressType and tcpConnectionLocalAddress are used
+      //as 1st and 2nd instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &socket->localIpAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpConnectionLocalPort is used as 3rd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->localPort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpConnectionRemAddressType and tcpConnectionRemAddress are used
+      //as 4th and 5th instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &socket->remoteIpAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpConnectionRemPort is used as 6th instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->remotePort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Capture the rows of the tcpListenerTable
+ * @param[in] snapshot Pointer to the snapshot to be populated
+ * @return Error code
+ **/
+
+error_t tcpMibBuildTcpListenerSnapshot(MibSnapshot *snapshot)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   uint8_t index[MIB_SNAPSHOT_MAX_INDEX_SIZE];
+   Socket *socket;
+
+   //Loop through socket descriptors
+   for(i = 0; i < SOCKET_MAX_COUNT; i++)
+   {
+      //Point to current socket
+      socket = &socketTable[i];
+
+      //Skip sockets that are not part of the table
+      if(socket->type != SOCKET_TYPE_STREAM)
+         continue;
+      if(socket->state != TCP_STATE_LISTEN)
+         continue;
+      if(socket->localPort == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //tcpListenerLocalAddressType and tcpListenerLocalAddress are used
+      //as 1st and 2nd instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &socket->localIpAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //tcpListenerLocalPort is used as 3rd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->localPort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
+
 #endif
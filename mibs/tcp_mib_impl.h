@@ -60,6 +60,11 @@ error_t tcpMibGetTcpListenerEntry(const MibObject *object, const uint8_t *oid,
 error_t tcpMibGetNextTcpListenerEntry(const MibObject *object, const uint8_t *oid,
    size_t oidLen, uint8_t *nextOid, size_t *nextOidLen);
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+error_t tcpMibBuildTcpConnectionSnapshot(MibSnapshot *snapshot);
+error_t tcpMibBuildTcpListenerSnapshot(MibSnapshot *snapshot);
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 }
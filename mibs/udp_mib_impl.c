@@ -214,6 +214,21 @@ error_t udpMibGetNextUdpEndpointEntry(const MibObject *object, const uint8_t *oi
    IpAddr remoteIpAddr;
    uint16_t remotePort;
    uint32_t instance;
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   MibSnapshot *snapshot;
+#endif
+
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   //Retrieve the sorted snapshot of the table
+   snapshot = mibGetSnapshot(udpMibBuildUdpEndpointSnapshot);
+
+   //Search the snapshot rather than walking through the whole table
+   if(snapshot != NULL)
+   {
+      return mibGetNextSnapshotEntry(object, snapshot, oid, oidLen, nextOid,
+         nextOidLen);
+   }
+#endif
 
    //Initialize variables
    localIpAddr = IP_ADDR_ANY;
@@ -235,8 +250,9 @@ error_t udpMibGetNextUdpEndpointEntry(const MibObject *object, const uint8_t *oi
       //Point to current socket
       Socket *socket = &socketTable[i];
 
-      //UDP socket?
-      if(socket->type == SOCKET_TYPE_DGRAM)
+      //Skip unbound sockets (same row filter as udpMibBuildUdpEndpointSnapshot)
+      if(socket->type == SOCKET_TYPE_DGRAM &&
+         (socket->localPort != 0 || socket->remotePort != 0))
       {
          //Append the instance identifier to the OID prefix
          n = object->oidLen;
@@ -335,7 +351,7 @@ error_t udpMibGetNextUdpEndpointEntry(const MibObject *object, const uint8_t *oi
       UdpRxCallbackEntry *entry = &udpCallbackTable[i];
 
       //Check whether the entry is currently in use
-      if(entry->callback != NULL)
+      if(entry->callback != NULL && entry->port != 0)
       {
          //Append the instance identifier to the OID prefix
          n = object->oidLen;
@@ -473,4 +489,137 @@ error_t udpMibGetNextUdpEndpointEntry(const MibObject *object, const uint8_t *oi
    return NO_ERROR;
 }
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+
+/**
+ * @brief Capture the rows of the udpEndpointTable
+ * @param[in] snapshot Pointer to the snapshot to be populated
+ * @return Error code
+ **/
+
+error_t udpMibBuildUdpEndpointSnapshot(MibSnapshot *snapshot)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   uint8_t index[MIB_SNAPSHOT_MAX_INDEX_SIZE];
+   IpAddr ipAddr;
+   Socket *socket;
+   UdpRxCallbackEntry *entry;
+
+   //Loop through socket descriptors
+   for(i = 0; i < SOCKET_MAX_COUNT; i++)
+   {
+      //Point to current socket
+      socket = &socketTable[i];
+
+      //Skip sockets that are not part of the table
+      if(socket->type != SOCKET_TYPE_DGRAM)
+         continue;
+      if(socket->localPort == 0 && socket->remotePort == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //udpEndpointLocalAddressType and udpEndpointLocalAddress are used
+      //as 1st and 2nd instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &socket->localIpAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointLocalPort is used as 3rd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->localPort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointRemoteAddressType and udpEndpointRemoteAddress are used
+      //as 4th and 5th instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &socket->remoteIpAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointRemotePort is used as 6th instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, socket->remotePort);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointInstance is used as 7th instance identifier
+      error = mibEncodeUnsigned32(index, sizeof(index), &n, 1);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Unspecified address
+   ipAddr = IP_ADDR_ANY;
+
+   //Loop through the UDP callback table
+   for(i = 0; i < UDP_CALLBACK_TABLE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &udpCallbackTable[i];
+
+      //Skip unused entries
+      if(entry->callback == NULL || entry->port == 0)
+         continue;
+
+      //Encode the instance identifier
+      n = 0;
+
+      //udpEndpointLocalAddressType and udpEndpointLocalAddress are used
+      //as 1st and 2nd instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &ipAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointLocalPort is used as 3rd instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, entry->port);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointRemoteAddressType and udpEndpointRemoteAddress are used
+      //as 4th and 5th instance identifiers
+      error = mibEncodeIpAddr(index, sizeof(index), &n, &ipAddr);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointRemotePort is used as 6th instance identifier
+      error = mibEncodePort(index, sizeof(index), &n, 0);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //udpEndpointInstance is used as 7th instance identifier
+      error = mibEncodeUnsigned32(index, sizeof(index), &n, 1);
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Add the row to the snapshot
+      error = mibAddSnapshotEntry(snapshot, index, n);
+      //Any error to report?
+      if(error)
+         return error;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+#endif
+
 #endif
@@ -48,6 +48,10 @@ error_t udpMibGetUdpEndpointEntry(const MibObject *object, const uint8_t *oid,
 error_t udpMibGetNextUdpEndpointEntry(const MibObject *object, const uint8_t *oid,
    size_t oidLen, uint8_t *nextOid, size_t *nextOidLen);
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+error_t udpMibBuildUdpEndpointSnapshot(MibSnapshot *snapshot);
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 }
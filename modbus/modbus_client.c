@@ -936,6 +936,560 @@ error_t modbusClientReadWriteMultipleRegs(ModbusClientContext *context,
 }
 
 
+//Asynchronous transaction support?
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+
+/**
+ * @brief Read coils (asynchronous mode)
+ *
+ * The request is queued for transmission and the function returns
+ * immediately. The values are written to the supplied buffer when the
+ * response is received, and the user callback is then invoked from
+ * modbusClientTask()
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the first coil
+ * @param[in] quantity Number of coils
+ * @param[out] value Value of the discrete outputs
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientReadCoilsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint8_t *value,
+   ModbusClientCompleteCallback callback, void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Check parameters
+   if(context == NULL || value == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The number of coils must be in range 1 to 2000
+   if(quantity < 1 || quantity > 2000)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_READ_COILS;
+   request->address = address;
+   request->quantity = quantity;
+   request->value = 0;
+   request->buffer = value;
+   request->callback = callback;
+   request->param = param;
+
+   //Adjacent register reads may be merged into a single transaction
+   if(!modbusClientCoalesceAsyncRequest(context, request))
+   {
+      //Format request
+      error = modbusClientFormatReadCoilsReq(context, address,
+         quantity);
+
+      //Check status code
+      if(!error)
+      {
+         //Queue the request for transmission
+         modbusClientQueueAsyncRequest(context, request);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Read discrete inputs (asynchronous mode)
+ *
+ * The request is queued for transmission and the function returns
+ * immediately. The values are written to the supplied buffer when the
+ * response is received, and the user callback is then invoked from
+ * modbusClientTask()
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the first input
+ * @param[in] quantity Number of inputs
+ * @param[out] value Value of the discrete inputs
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientReadDiscreteInputsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint8_t *value,
+   ModbusClientCompleteCallback callback, void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Check parameters
+   if(context == NULL || value == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The number of discrete inputs must be in range 1 to 2000
+   if(quantity < 1 || quantity > 2000)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_READ_DISCRETE_INPUTS;
+   request->address = address;
+   request->quantity = quantity;
+   request->value = 0;
+   request->buffer = value;
+   request->callback = callback;
+   request->param = param;
+
+   //Adjacent register reads may be merged into a single transaction
+   if(!modbusClientCoalesceAsyncRequest(context, request))
+   {
+      //Format request
+      error = modbusClientFormatReadDiscreteInputsReq(context,
+         address, quantity);
+
+      //Check status code
+      if(!error)
+      {
+         //Queue the request for transmission
+         modbusClientQueueAsyncRequest(context, request);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Read holding registers (asynchronous mode)
+ *
+ * The request is queued for transmission and the function returns
+ * immediately. The values are written to the supplied buffer when the
+ * response is received, and the user callback is then invoked from
+ * modbusClientTask()
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the first register
+ * @param[in] quantity Number of registers
+ * @param[out] value Value of the holding registers
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientReadHoldingRegsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint16_t *value,
+   ModbusClientCompleteCallback callback, void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Check parameters
+   if(context == NULL || value == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The number of registers must be in range 1 to 125
+   if(quantity < 1 || quantity > 125)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_READ_HOLDING_REGS;
+   request->address = address;
+   request->quantity = quantity;
+   request->value = 0;
+   request->buffer = value;
+   request->callback = callback;
+   request->param = param;
+
+   //Adjacent register reads may be merged into a single transaction
+   if(!modbusClientCoalesceAsyncRequest(context, request))
+   {
+      //Format request
+      error = modbusClientFormatReadHoldingRegsReq(context,
+         address, quantity);
+
+      //Check status code
+      if(!error)
+      {
+         //Queue the request for transmission
+         modbusClientQueueAsyncRequest(context, request);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Read input registers (asynchronous mode)
+ *
+ * The request is queued for transmission and the function returns
+ * immediately. The values are written to the supplied buffer when the
+ * response is received, and the user callback is then invoked from
+ * modbusClientTask()
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the first register
+ * @param[in] quantity Number of registers
+ * @param[out] value Value of the input registers
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientReadInputRegsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint16_t *value,
+   ModbusClientCompleteCallback callback, void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Check parameters
+   if(context == NULL || value == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The number of registers must be in range 1 to 125
+   if(quantity < 1 || quantity > 125)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_READ_INPUT_REGS;
+   request->address = address;
+   request->quantity = quantity;
+   request->value = 0;
+   request->buffer = value;
+   request->callback = callback;
+   request->param = param;
+
+   //Adjacent register reads may be merged into a single transaction
+   if(!modbusClientCoalesceAsyncRequest(context, request))
+   {
+      //Format request
+      error = modbusClientFormatReadInputRegsReq(context, address,
+         quantity);
+
+      //Check status code
+      if(!error)
+      {
+         //Queue the request for transmission
+         modbusClientQueueAsyncRequest(context, request);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write single coil (asynchronous mode)
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the coil to be forced
+ * @param[in] value Value of the discrete output
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientWriteSingleCoilAsync(ModbusClientContext *context,
+   uint16_t address, bool_t value, ModbusClientCompleteCallback callback,
+   void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Make sure the Modbus/TCP client context is valid
+   if(context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_WRITE_SINGLE_COIL;
+   request->address = address;
+   request->quantity = 1;
+   request->value = value;
+   request->buffer = NULL;
+   request->callback = callback;
+   request->param = param;
+
+   //Format request
+   error = modbusClientFormatWriteSingleCoilReq(context, address,
+      value);
+
+   //Check status code
+   if(!error)
+   {
+      //Queue the request for transmission
+      modbusClientQueueAsyncRequest(context, request);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write single register (asynchronous mode)
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the register to be written
+ * @param[in] value Register value
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientWriteSingleRegAsync(ModbusClientContext *context,
+   uint16_t address, uint16_t value, ModbusClientCompleteCallback callback,
+   void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Make sure the Modbus/TCP client context is valid
+   if(context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_WRITE_SINGLE_REG;
+   request->address = address;
+   request->quantity = 1;
+   request->value = value;
+   request->buffer = NULL;
+   request->callback = callback;
+   request->param = param;
+
+   //Format request
+   error = modbusClientFormatWriteSingleRegReq(context, address,
+      value);
+
+   //Check status code
+   if(!error)
+   {
+      //Queue the request for transmission
+      modbusClientQueueAsyncRequest(context, request);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write multiple coils (asynchronous mode)
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the first coil to be forced
+ * @param[in] quantity Number of coils
+ * @param[in] value Value of the discrete outputs
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientWriteMultipleCoilsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, const uint8_t *value,
+   ModbusClientCompleteCallback callback, void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Check parameters
+   if(context == NULL || value == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The number of coils must be in range 1 to 1968
+   if(quantity < 1 || quantity > 1968)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_WRITE_MULTIPLE_COILS;
+   request->address = address;
+   request->quantity = quantity;
+   request->value = 0;
+   request->buffer = NULL;
+   request->callback = callback;
+   request->param = param;
+
+   //Format request
+   error = modbusClientFormatWriteMultipleCoilsReq(context,
+      address, quantity, value);
+
+   //Check status code
+   if(!error)
+   {
+      //Queue the request for transmission
+      modbusClientQueueAsyncRequest(context, request);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write multiple registers (asynchronous mode)
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] address Address of the first register to be written
+ * @param[in] quantity Number of registers
+ * @param[in] value Value of the holding registers
+ * @param[in] callback Completion callback function
+ * @param[in] param Opaque pointer passed to the callback function
+ * @return Error code
+ **/
+
+error_t modbusClientWriteMultipleRegsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, const uint16_t *value,
+   ModbusClientCompleteCallback callback, void *param)
+{
+   error_t error;
+   ModbusClientAsyncRequest *request;
+
+   //Check parameters
+   if(context == NULL || value == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //The number of registers must be in range 1 to 123
+   if(quantity < 1 || quantity > 123)
+      return ERROR_INVALID_PARAMETER;
+
+   //Allocate a new asynchronous request
+   error = modbusClientAllocateAsyncRequest(context, &request);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save request parameters
+   request->functionCode = MODBUS_FUNCTION_WRITE_MULTIPLE_REGS;
+   request->address = address;
+   request->quantity = quantity;
+   request->value = 0;
+   request->buffer = NULL;
+   request->callback = callback;
+   request->param = param;
+
+   //Format request
+   error = modbusClientFormatWriteMultipleRegsReq(context,
+      address, quantity, value);
+
+   //Check status code
+   if(!error)
+   {
+      //Queue the request for transmission
+      modbusClientQueueAsyncRequest(context, request);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Process asynchronous requests
+ *
+ * This function transmits queued requests, waits for responses and matches
+ * them against outstanding requests, in any order. Requests whose timeout
+ * has elapsed are completed with an ERROR_TIMEOUT status code
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] timeout Maximum time to wait for a response
+ * @return Error code
+ **/
+
+error_t modbusClientTask(ModbusClientContext *context, systime_t timeout)
+{
+   error_t error;
+
+   //Make sure the Modbus/TCP client context is valid
+   if(context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check current state
+   if(context->state == MODBUS_CLIENT_STATE_CONNECTED)
+   {
+      //Transmit queued requests
+      error = modbusClientSendAsyncRequests(context);
+
+      //Check status code
+      if(!error)
+      {
+         //Process incoming responses
+         error = modbusClientReceiveAsyncResponses(context, timeout);
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //Handle the expiration of outstanding requests
+         modbusClientCheckAsyncTimeouts(context);
+      }
+      else
+      {
+         //A communication error has occurred
+         modbusClientFlushAsyncRequests(context, error);
+      }
+   }
+   else if(context->state == MODBUS_CLIENT_STATE_SENDING ||
+      context->state == MODBUS_CLIENT_STATE_RECEIVING ||
+      context->state == MODBUS_CLIENT_STATE_COMPLETE)
+   {
+      //A blocking transaction is in progress
+      error = ERROR_WRONG_STATE;
+   }
+   else
+   {
+      //Invalid state
+      error = ERROR_NOT_CONNECTED;
+   }
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
 /**
  * @brief Retrieve exception code
  * @param[in] context Pointer to the Modbus/TCP client context
@@ -1030,6 +1584,14 @@ error_t modbusClientDisconnect(ModbusClientContext *context)
       context->state = MODBUS_CLIENT_STATE_DISCONNECTED;
    }
 
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+   //Abort outstanding asynchronous requests once disconnected
+   if(context->state == MODBUS_CLIENT_STATE_DISCONNECTED)
+   {
+      modbusClientFlushAsyncRequests(context, ERROR_NOT_CONNECTED);
+   }
+#endif
+
    //Return status code
    return error;
 }
@@ -1052,6 +1614,11 @@ error_t modbusClientClose(ModbusClientContext *context)
    //Update Modbus/TCP client state
    context->state = MODBUS_CLIENT_STATE_DISCONNECTED;
 
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+   //Abort outstanding asynchronous requests
+   modbusClientFlushAsyncRequests(context, ERROR_NOT_CONNECTED);
+#endif
+
    //Successful processing
    return NO_ERROR;
 }
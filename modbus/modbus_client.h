@@ -49,6 +49,27 @@
    #error MODBUS_CLIENT_TLS_SUPPORT parameter is not valid
 #endif
 
+//Asynchronous transaction support
+#ifndef MODBUS_CLIENT_ASYNC_SUPPORT
+   #define MODBUS_CLIENT_ASYNC_SUPPORT DISABLED
+#elif (MODBUS_CLIENT_ASYNC_SUPPORT != ENABLED && MODBUS_CLIENT_ASYNC_SUPPORT != DISABLED)
+   #error MODBUS_CLIENT_ASYNC_SUPPORT parameter is not valid
+#endif
+
+//Coalescing of adjacent register reads
+#ifndef MODBUS_CLIENT_COALESCING_SUPPORT
+   #define MODBUS_CLIENT_COALESCING_SUPPORT DISABLED
+#elif (MODBUS_CLIENT_COALESCING_SUPPORT != ENABLED && MODBUS_CLIENT_COALESCING_SUPPORT != DISABLED)
+   #error MODBUS_CLIENT_COALESCING_SUPPORT parameter is not valid
+#endif
+
+//Maximum number of outstanding asynchronous requests
+#ifndef MODBUS_CLIENT_MAX_ASYNC_REQUESTS
+   #define MODBUS_CLIENT_MAX_ASYNC_REQUESTS 8
+#elif (MODBUS_CLIENT_MAX_ASYNC_REQUESTS < 1)
+   #error MODBUS_CLIENT_MAX_ASYNC_REQUESTS parameter is not valid
+#endif
+
 //Default timeout
 #ifndef MODBUS_CLIENT_DEFAULT_TIMEOUT
    #define MODBUS_CLIENT_DEFAULT_TIMEOUT 20000
@@ -120,6 +141,55 @@ typedef error_t (*ModbusClientTlsInitCallback)(ModbusClientContext *context,
 #endif
 
 
+//Asynchronous transaction support?
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+
+/**
+ * @brief Asynchronous request states
+ **/
+
+typedef enum
+{
+   MODBUS_REQUEST_STATE_FREE    = 0,
+   MODBUS_REQUEST_STATE_QUEUED  = 1,
+   MODBUS_REQUEST_STATE_PENDING = 2
+} ModbusRequestState;
+
+
+/**
+ * @brief Asynchronous request completion callback function
+ **/
+
+typedef void (*ModbusClientCompleteCallback)(ModbusClientContext *context,
+   error_t error, void *param);
+
+
+/**
+ * @brief Asynchronous request
+ **/
+
+typedef struct
+{
+   ModbusRequestState state;                ///<State of the request
+   uint16_t transactionId;                  ///<Modbus transaction identifier
+   uint8_t unitId;                          ///<Identifier of the remote slave
+   uint8_t functionCode;                    ///<Function code
+   uint16_t address;                        ///<Address of the first item
+   uint_t quantity;                         ///<Number of items
+   uint16_t value;                          ///<Value of the coil or register to be written
+   void *buffer;                            ///<Buffer where to store the values read
+   ModbusClientCompleteCallback callback;   ///<Completion callback function
+   void *param;                             ///<Opaque pointer passed to the callback function
+   systime_t timestamp;                     ///<Timestamp to manage timeout
+   systime_t timeout;                       ///<Timeout value
+   uint8_t requestAdu[MODBUS_MAX_ADU_SIZE]; ///<Request ADU
+   size_t requestAduLen;                    ///<Length of the request ADU, in bytes
+   size_t requestAduPos;                    ///<Current position in the request ADU
+} ModbusClientAsyncRequest;
+
+#endif
+
+
 /**
  * @brief Modbus/TCP client context
  **/
@@ -146,6 +216,9 @@ struct _ModbusClientContext
    size_t responseAduLen;                       ///<Length of the response ADU, in bytes
    size_t responseAduPos;                       ///<Current position in the response ADU
    ModbusExceptionCode exceptionCode;           ///<Exception code
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+   ModbusClientAsyncRequest asyncRequests[MODBUS_CLIENT_MAX_ASYNC_REQUESTS]; ///<Asynchronous requests
+#endif
    MODBUS_CLIENT_PRIVATE_CONTEXT                ///<Application specific context
 };
 
@@ -200,6 +273,44 @@ error_t modbusClientReadWriteMultipleRegs(ModbusClientContext *context,
    uint16_t readAddress, uint_t readQuantity, uint16_t *readValue,
    uint16_t writeAddress, uint_t writeQuantity, const uint16_t *writeValue);
 
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+
+error_t modbusClientReadCoilsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint8_t *value,
+   ModbusClientCompleteCallback callback, void *param);
+
+error_t modbusClientReadDiscreteInputsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint8_t *value,
+   ModbusClientCompleteCallback callback, void *param);
+
+error_t modbusClientReadHoldingRegsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint16_t *value,
+   ModbusClientCompleteCallback callback, void *param);
+
+error_t modbusClientReadInputRegsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, uint16_t *value,
+   ModbusClientCompleteCallback callback, void *param);
+
+error_t modbusClientWriteSingleCoilAsync(ModbusClientContext *context,
+   uint16_t address, bool_t value, ModbusClientCompleteCallback callback,
+   void *param);
+
+error_t modbusClientWriteSingleRegAsync(ModbusClientContext *context,
+   uint16_t address, uint16_t value, ModbusClientCompleteCallback callback,
+   void *param);
+
+error_t modbusClientWriteMultipleCoilsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, const uint8_t *value,
+   ModbusClientCompleteCallback callback, void *param);
+
+error_t modbusClientWriteMultipleRegsAsync(ModbusClientContext *context,
+   uint16_t address, uint_t quantity, const uint16_t *value,
+   ModbusClientCompleteCallback callback, void *param);
+
+error_t modbusClientTask(ModbusClientContext *context, systime_t timeout);
+
+#endif
+
 error_t modbusClientGetExceptionCode(ModbusClientContext *context,
    ModbusExceptionCode *exceptionCode);
 
@@ -76,6 +76,21 @@ error_t modbusClientTransaction(ModbusClientContext *context)
    //Check current state
    if(context->state == MODBUS_CLIENT_STATE_SENDING)
    {
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+      //A partially transmitted asynchronous ADU must be completed before the
+      //request ADU can be sent, otherwise the MBAP framing would be broken
+      if(context->requestAduPos == 0)
+      {
+         error = modbusClientFinishAsyncTransmission(context);
+      }
+
+      //Check status code
+      if(error)
+      {
+         //The request ADU cannot be sent yet
+      }
+      else
+#endif
       //Send Modbus request
       if(context->requestAduPos < context->requestAduLen)
       {
@@ -94,9 +109,18 @@ error_t modbusClientTransaction(ModbusClientContext *context)
       }
       else
       {
-         //Flush receive buffer
-         context->responseAduLen = 0;
-         context->responseAduPos = 0;
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+         //Do not discard a partially received response to an asynchronous
+         //request
+         if(context->responseAduPos == 0 ||
+            (context->responseAduPos >= sizeof(ModbusHeader) &&
+            context->responseAduPos >= context->responseAduLen))
+#endif
+         {
+            //Flush receive buffer
+            context->responseAduLen = 0;
+            context->responseAduPos = 0;
+         }
 
          //Wait for response ADU
          context->state = MODBUS_CLIENT_STATE_RECEIVING;
@@ -163,6 +187,10 @@ error_t modbusClientTransaction(ModbusClientContext *context)
          }
          else if(error == ERROR_WRONG_IDENTIFIER)
          {
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+            //The response may refer to an outstanding asynchronous request
+            modbusClientProcessAsyncResp(context);
+#endif
             //If the transaction identifier does not refer to any pending
             //transaction, the response must be discarded
             context->responseAduLen = 0;
@@ -443,4 +471,842 @@ error_t modbusClientCheckTimeout(ModbusClientContext *context)
 #endif
 }
 
+
+//Asynchronous transaction support?
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+
+/**
+ * @brief Allocate a new asynchronous request
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[out] request Pointer to the newly allocated request
+ * @return Error code
+ **/
+
+error_t modbusClientAllocateAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest **request)
+{
+   uint_t i;
+
+   //Check current state
+   if(context->state == MODBUS_CLIENT_STATE_CONNECTED)
+   {
+      //Loop through the asynchronous requests
+      for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+      {
+         //Unused entry?
+         if(context->asyncRequests[i].state == MODBUS_REQUEST_STATE_FREE)
+         {
+            //Clear the contents of the entry
+            context->asyncRequests[i].requestAduLen = 0;
+            context->asyncRequests[i].requestAduPos = 0;
+
+            //Return a pointer to the entry
+            *request = &context->asyncRequests[i];
+
+            //Successful processing
+            return NO_ERROR;
+         }
+      }
+
+      //The table of outstanding requests is full
+      return ERROR_OUT_OF_RESOURCES;
+   }
+   else if(context->state == MODBUS_CLIENT_STATE_SENDING ||
+      context->state == MODBUS_CLIENT_STATE_RECEIVING ||
+      context->state == MODBUS_CLIENT_STATE_COMPLETE)
+   {
+      //A blocking transaction is in progress
+      return ERROR_WRONG_STATE;
+   }
+   else
+   {
+      //The Modbus/TCP client is not connected
+      return ERROR_NOT_CONNECTED;
+   }
+}
+
+
+/**
+ * @brief Queue an asynchronous request for transmission
+ *
+ * The request ADU must have been formatted beforehand in the context
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] request Pointer to the asynchronous request
+ **/
+
+void modbusClientQueueAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request)
+{
+   ModbusHeader *header;
+
+   //Save the request ADU
+   osMemcpy(request->requestAdu, context->requestAdu, context->requestAduLen);
+   request->requestAduLen = context->requestAduLen;
+   request->requestAduPos = 0;
+
+   //Point to the MBAP header of the request
+   header = (ModbusHeader *) request->requestAdu;
+
+   //Save the transaction and unit identifiers
+   request->transactionId = ntohs(header->transactionId);
+   request->unitId = header->unitId;
+
+   //Each request is subject to its own timeout
+   request->timestamp = osGetSystemTime();
+   request->timeout = context->timeout;
+
+   //The request is waiting for transmission
+   request->state = MODBUS_REQUEST_STATE_QUEUED;
+
+   //The request ADU is transmitted from the table of outstanding requests,
+   //so the blocking API remains available
+   context->state = MODBUS_CLIENT_STATE_CONNECTED;
+}
+
+
+/**
+ * @brief Merge a register read with an adjacent queued read
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] request Pointer to the asynchronous request
+ * @return TRUE if the request has been merged, else FALSE
+ **/
+
+bool_t modbusClientCoalesceAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request)
+{
+#if (MODBUS_CLIENT_COALESCING_SUPPORT == ENABLED)
+   uint_t i;
+   uint16_t address;
+   uint16_t quantity;
+   ModbusClientAsyncRequest *entry;
+   ModbusReadHoldingRegsReq *pdu;
+
+   //Only register reads can be coalesced
+   if(request->functionCode != MODBUS_FUNCTION_READ_HOLDING_REGS &&
+      request->functionCode != MODBUS_FUNCTION_READ_INPUT_REGS)
+   {
+      return FALSE;
+   }
+
+   //Loop through the asynchronous requests
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Point to the current entry
+      entry = &context->asyncRequests[i];
+
+      //The request ADU must not have been transmitted yet
+      if(entry->state == MODBUS_REQUEST_STATE_QUEUED &&
+         entry->requestAduLen > 0 && entry->requestAduPos == 0 &&
+         entry->functionCode == request->functionCode &&
+         entry->unitId == context->unitId)
+      {
+         //Read Holding Registers and Read Input Registers requests share the
+         //same layout
+         pdu = (ModbusReadHoldingRegsReq *) (entry->requestAdu +
+            sizeof(ModbusHeader));
+
+         //Retrieve the range of registers covered by the queued request
+         address = ntohs(pdu->startingAddr);
+         quantity = ntohs(pdu->quantityOfRegs);
+
+         //A single PDU can carry up to 125 registers
+         if((quantity + request->quantity) <= 125)
+         {
+            //Check whether the registers are adjacent
+            if(((uint32_t) address + quantity) == request->address)
+            {
+               //Extend the queued request
+               pdu->quantityOfRegs = htons(quantity + request->quantity);
+               break;
+            }
+            else if(((uint32_t) request->address + request->quantity) == address)
+            {
+               //Extend the queued request
+               pdu->startingAddr = htons(request->address);
+               pdu->quantityOfRegs = htons(quantity + request->quantity);
+               break;
+            }
+            else
+            {
+               //The registers are not adjacent
+            }
+         }
+      }
+   }
+
+   //No suitable request found?
+   if(i >= MODBUS_CLIENT_MAX_ASYNC_REQUESTS)
+      return FALSE;
+
+   //The request shares the transaction of the queued request
+   request->transactionId = entry->transactionId;
+   request->unitId = entry->unitId;
+   request->timestamp = entry->timestamp;
+   request->timeout = entry->timeout;
+
+   //The ADU is transmitted on behalf of the queued request
+   request->requestAduLen = 0;
+   request->requestAduPos = 0;
+
+   //The request is waiting for transmission
+   request->state = MODBUS_REQUEST_STATE_QUEUED;
+
+   //The request has been merged
+   return TRUE;
+#else
+   //Coalescing is not supported
+   return FALSE;
+#endif
+}
+
+
+/**
+ * @brief Transmit queued asynchronous requests
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @return Error code
+ **/
+
+error_t modbusClientSendAsyncRequests(ModbusClientContext *context)
+{
+   error_t error;
+   uint_t i;
+   uint_t k;
+   uint_t flags;
+   size_t n;
+   ModbusClientAsyncRequest *request;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Do not block while the socket buffer is full
+   socketSetTimeout(context->socket, 0);
+
+   //Transmit as many requests as possible
+   while(!error)
+   {
+      //Initialize variables
+      request = NULL;
+      k = 0;
+
+      //Loop through the asynchronous requests
+      for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+      {
+         //Any ADU waiting for transmission?
+         if(context->asyncRequests[i].state == MODBUS_REQUEST_STATE_QUEUED &&
+            context->asyncRequests[i].requestAduLen > 0)
+         {
+            //A partially transmitted ADU must be completed first
+            if(request == NULL || context->asyncRequests[i].requestAduPos > 0)
+            {
+               request = &context->asyncRequests[i];
+            }
+
+            //Number of ADUs waiting for transmission
+            k++;
+         }
+      }
+
+      //No more ADUs to send?
+      if(request == NULL)
+         break;
+
+      //Consecutive ADUs are allowed to share the same TCP segment. The last
+      //one is pushed out immediately
+      flags = (k > 1) ? 0 : SOCKET_FLAG_NO_DELAY;
+
+      //Send more data
+      error = modbusClientSendData(context,
+         request->requestAdu + request->requestAduPos,
+         request->requestAduLen - request->requestAduPos, &n, flags);
+
+      //Check status code
+      if(error == NO_ERROR || error == ERROR_TIMEOUT)
+      {
+         //Advance data pointer
+         request->requestAduPos += n;
+      }
+
+      //Complete ADU transmitted?
+      if(request->requestAduPos >= request->requestAduLen)
+      {
+         //Debug message
+         TRACE_DEBUG("Modbus Client: Request %" PRIu16 " sent\r\n",
+            request->transactionId);
+
+         //The request and any request coalesced with it are now waiting for
+         //the response
+         for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+         {
+            if(context->asyncRequests[i].state == MODBUS_REQUEST_STATE_QUEUED &&
+               context->asyncRequests[i].transactionId == request->transactionId)
+            {
+               context->asyncRequests[i].state = MODBUS_REQUEST_STATE_PENDING;
+            }
+         }
+      }
+   }
+
+   //The socket buffer is full?
+   if(error == ERROR_WOULD_BLOCK || error == ERROR_TIMEOUT)
+   {
+      //Remaining data will be sent later
+      error = NO_ERROR;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Complete the transmission of a partially sent asynchronous ADU
+ *
+ * This function is called by the blocking API before a request ADU is sent
+ * on the same TCP connection
+ *
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @return Error code
+ **/
+
+error_t modbusClientFinishAsyncTransmission(ModbusClientContext *context)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   ModbusClientAsyncRequest *request;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Loop through the asynchronous requests
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Point to the current entry
+      request = &context->asyncRequests[i];
+
+      //Partially transmitted ADU?
+      if(request->state == MODBUS_REQUEST_STATE_QUEUED &&
+         request->requestAduPos > 0 &&
+         request->requestAduPos < request->requestAduLen)
+      {
+         break;
+      }
+   }
+
+   //Any partially transmitted ADU?
+   if(i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS)
+   {
+      //Send the remaining part of the ADU
+      while(!error && request->requestAduPos < request->requestAduLen)
+      {
+         //Send more data
+         error = modbusClientSendData(context,
+            request->requestAdu + request->requestAduPos,
+            request->requestAduLen - request->requestAduPos, &n,
+            SOCKET_FLAG_NO_DELAY);
+
+         //Check status code
+         if(error == NO_ERROR || error == ERROR_TIMEOUT)
+         {
+            //Advance data pointer
+            request->requestAduPos += n;
+         }
+      }
+
+      //Complete ADU transmitted?
+      if(request->requestAduPos >= request->requestAduLen)
+      {
+         //The request and any request coalesced with it are now waiting for
+         //the response
+         for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+         {
+            if(context->asyncRequests[i].state == MODBUS_REQUEST_STATE_QUEUED &&
+               context->asyncRequests[i].transactionId == request->transactionId)
+            {
+               context->asyncRequests[i].state = MODBUS_REQUEST_STATE_PENDING;
+            }
+         }
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Receive responses to asynchronous requests
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] timeout Maximum time to wait for a response
+ * @return Error code
+ **/
+
+error_t modbusClientReceiveAsyncResponses(ModbusClientContext *context,
+   systime_t timeout)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   systime_t time;
+   systime_t deadline;
+   uint8_t *pdu;
+   ModbusClientAsyncRequest *request;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //A response that has already been processed by the blocking API must be
+   //discarded
+   if(context->responseAduPos >= sizeof(ModbusHeader) &&
+      context->responseAduPos >= context->responseAduLen)
+   {
+      context->responseAduLen = 0;
+      context->responseAduPos = 0;
+   }
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Loop through the asynchronous requests
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Point to the current entry
+      request = &context->asyncRequests[i];
+
+      //Outstanding request?
+      if(request->state != MODBUS_REQUEST_STATE_FREE)
+      {
+         //Do not wait beyond the expiration of the request
+         deadline = request->timestamp + request->timeout;
+
+         //Adjust timeout value
+         if(timeCompare(deadline, time) <= 0)
+         {
+            timeout = 0;
+         }
+         else if(timeCompare(deadline, time + timeout) < 0)
+         {
+            timeout = deadline - time;
+         }
+         else
+         {
+            //Keep the current timeout value
+         }
+      }
+   }
+
+   //Set timeout for the first response
+   socketSetTimeout(context->socket, timeout);
+
+   //Process as many responses as possible
+   while(!error)
+   {
+      //Receive Modbus response
+      if(context->responseAduPos < sizeof(ModbusHeader))
+      {
+         //Receive more data
+         error = modbusClientReceiveData(context,
+            context->responseAdu + context->responseAduPos,
+            sizeof(ModbusHeader) - context->responseAduPos, &n, 0);
+
+         //Check status code
+         if(error == NO_ERROR)
+         {
+            //Advance data pointer
+            context->responseAduPos += n;
+
+            //MBAP header successfully received?
+            if(context->responseAduPos >= sizeof(ModbusHeader))
+            {
+               //Parse MBAP header
+               error = modbusClientParseMbapHeader(context);
+            }
+         }
+      }
+      else if(context->responseAduPos < context->responseAduLen)
+      {
+         //Receive more data
+         error = modbusClientReceiveData(context,
+            context->responseAdu + context->responseAduPos,
+            context->responseAduLen - context->responseAduPos, &n, 0);
+
+         //Check status code
+         if(error == NO_ERROR)
+         {
+            //Advance data pointer
+            context->responseAduPos += n;
+         }
+      }
+      else
+      {
+         //Point to the Modbus response PDU
+         pdu = modbusClientGetResponsePdu(context, &n);
+
+         //Debug message
+         TRACE_INFO("Modbus Client: Response PDU received (%" PRIuSIZE " bytes)...\r\n", n);
+         //Dump the contents of the PDU for debugging purpose
+         modbusDumpResponsePdu(pdu, n);
+
+         //Responses may be received in any order. A response that does not
+         //refer to any outstanding request is silently discarded
+         modbusClientProcessAsyncResp(context);
+
+         //Flush receive buffer
+         context->responseAduLen = 0;
+         context->responseAduPos = 0;
+
+         //Do not wait for further responses
+         socketSetTimeout(context->socket, 0);
+      }
+   }
+
+   //No more data available?
+   if(error == ERROR_WOULD_BLOCK || error == ERROR_TIMEOUT)
+   {
+      //Catch exception
+      error = NO_ERROR;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Match a response against outstanding asynchronous requests
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @return Error code
+ **/
+
+error_t modbusClientProcessAsyncResp(ModbusClientContext *context)
+{
+   error_t error;
+   uint_t i;
+   uint_t quantity;
+   uint16_t address;
+   uint16_t transactionId;
+   bool_t found;
+   ModbusHeader *header;
+   ModbusClientAsyncRequest *request;
+
+   //Point to the MBAP header of the Modbus response
+   header = (ModbusHeader *) context->responseAdu;
+   //Retrieve transaction identifier
+   transactionId = ntohs(header->transactionId);
+
+   //Initialize variables
+   found = FALSE;
+   address = 0;
+   quantity = 0;
+
+   //Several register reads may have been coalesced into a single transaction
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Point to the current entry
+      request = &context->asyncRequests[i];
+
+      //Matching transaction identifier?
+      if(request->state == MODBUS_REQUEST_STATE_PENDING &&
+         request->transactionId == transactionId)
+      {
+         //Compute the range of items covered by the transaction
+         if(!found || request->address < address)
+         {
+            address = request->address;
+         }
+
+         //Total number of items
+         quantity += request->quantity;
+         found = TRUE;
+      }
+   }
+
+   //The transaction identifier does not refer to any outstanding request?
+   if(!found)
+      return ERROR_WRONG_IDENTIFIER;
+
+   //Loop through the asynchronous requests
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Point to the current entry
+      request = &context->asyncRequests[i];
+
+      //Matching transaction identifier?
+      if(request->state == MODBUS_REQUEST_STATE_PENDING &&
+         request->transactionId == transactionId)
+      {
+         //Parse the response on behalf of the request
+         error = modbusClientParseAsyncResp(context, request, address,
+            quantity);
+
+         //Send a confirmation to the user application
+         modbusClientCompleteAsyncRequest(context, request, error);
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Parse a response to an asynchronous request
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] request Pointer to the asynchronous request
+ * @param[in] address Address of the first item covered by the transaction
+ * @param[in] quantity Number of items covered by the transaction
+ * @return Error code
+ **/
+
+error_t modbusClientParseAsyncResp(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request, uint16_t address, uint_t quantity)
+{
+   error_t error;
+   ModbusHeader *header;
+
+   //Malformed response?
+   if(context->responseAduLen < (sizeof(ModbusHeader) + sizeof(uint8_t)))
+      return ERROR_INVALID_LENGTH;
+
+   //Point to the MBAP header of the Modbus response
+   header = (ModbusHeader *) context->responseAdu;
+
+   //Check unit identifier
+   if(header->unitId != request->unitId)
+      return ERROR_UNEXPECTED_RESPONSE;
+
+   //Check function code
+   if((header->pdu[0] & MODBUS_FUNCTION_CODE_MASK) != request->functionCode)
+      return ERROR_UNEXPECTED_RESPONSE;
+
+   //Exception response?
+   if((header->pdu[0] & MODBUS_EXCEPTION_MASK) != 0)
+      return modbusClientParseExceptionResp(context);
+
+   //Check function code
+   switch(request->functionCode)
+   {
+   case MODBUS_FUNCTION_READ_COILS:
+      //Parse Read Coils response
+      error = modbusClientParseReadCoilsResp(context, request->quantity,
+         request->buffer);
+      break;
+
+   case MODBUS_FUNCTION_READ_DISCRETE_INPUTS:
+      //Parse Discrete Inputs response
+      error = modbusClientParseReadDiscreteInputsResp(context,
+         request->quantity, request->buffer);
+      break;
+
+   case MODBUS_FUNCTION_READ_HOLDING_REGS:
+   case MODBUS_FUNCTION_READ_INPUT_REGS:
+      //Extract the registers that belong to the request
+      error = modbusClientParseAsyncReadRegsResp(context,
+         request->address - address, request->quantity, quantity,
+         request->buffer);
+      break;
+
+   case MODBUS_FUNCTION_WRITE_SINGLE_COIL:
+      //Parse Write Single Coil response
+      error = modbusClientParseWriteSingleCoilResp(context, request->address,
+         request->value);
+      break;
+
+   case MODBUS_FUNCTION_WRITE_SINGLE_REG:
+      //Parse Write Single Register response
+      error = modbusClientParseWriteSingleRegResp(context, request->address,
+         request->value);
+      break;
+
+   case MODBUS_FUNCTION_WRITE_MULTIPLE_COILS:
+      //Parse Write Multiple Coils response
+      error = modbusClientParseWriteMultipleCoilsResp(context,
+         request->address, request->quantity);
+      break;
+
+   case MODBUS_FUNCTION_WRITE_MULTIPLE_REGS:
+      //Parse Write Multiple Registers response
+      error = modbusClientParseWriteMultipleRegsResp(context,
+         request->address, request->quantity);
+      break;
+
+   default:
+      //Unknown function code
+      error = ERROR_INVALID_RESPONSE;
+      break;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Parse a register read response on behalf of an asynchronous request
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] offset Offset of the first register that belongs to the request
+ * @param[in] quantity Number of registers that belong to the request
+ * @param[in] totalQuantity Number of registers carried by the response
+ * @param[out] value Value of the registers
+ * @return Error code
+ **/
+
+error_t modbusClientParseAsyncReadRegsResp(ModbusClientContext *context,
+   uint_t offset, uint_t quantity, uint_t totalQuantity, uint16_t *value)
+{
+   uint_t i;
+   size_t n;
+   size_t length;
+   ModbusReadHoldingRegsResp *response;
+
+   //Point to the Modbus response PDU
+   response = modbusClientGetResponsePdu(context, &length);
+
+   //Malformed PDU?
+   if(length < sizeof(ModbusReadHoldingRegsResp))
+      return ERROR_INVALID_LENGTH;
+
+   //Compute the length of the data field
+   n = length - sizeof(ModbusReadHoldingRegsResp);
+
+   //Check byte count field
+   if(response->byteCount != n ||
+      response->byteCount != (totalQuantity * sizeof(uint16_t)))
+   {
+      return ERROR_INVALID_LENGTH;
+   }
+
+   //Copy register values
+   for(i = 0; i < quantity; i++)
+   {
+      value[i] = ntohs(response->regValue[offset + i]);
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Release an asynchronous request and notify the user application
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] request Pointer to the asynchronous request
+ * @param[in] error Status code of the transaction
+ **/
+
+void modbusClientCompleteAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request, error_t error)
+{
+   //Debug message
+   TRACE_DEBUG("Modbus Client: Request %" PRIu16 " complete (error = %u)\r\n",
+      request->transactionId, error);
+
+   //Release the entry before invoking the callback, so that a new request
+   //can be issued from the callback function
+   request->state = MODBUS_REQUEST_STATE_FREE;
+
+   //Any registered callback?
+   if(request->callback != NULL)
+   {
+      //Invoke user callback function
+      request->callback(context, error, request->param);
+   }
+}
+
+
+/**
+ * @brief Handle the expiration of asynchronous requests
+ * @param[in] context Pointer to the Modbus/TCP client context
+ **/
+
+void modbusClientCheckAsyncTimeouts(ModbusClientContext *context)
+{
+   uint_t i;
+   uint_t j;
+   systime_t time;
+   ModbusClientAsyncRequest *request;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Loop through the asynchronous requests
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Point to the current entry
+      request = &context->asyncRequests[i];
+
+      //A partially transmitted ADU cannot be withdrawn
+      if(request->state != MODBUS_REQUEST_STATE_FREE &&
+         (request->requestAduPos == 0 ||
+         request->requestAduPos >= request->requestAduLen))
+      {
+         //Check whether the timeout has elapsed
+         if(timeCompare(time, request->timestamp + request->timeout) >= 0)
+         {
+            //Loop through the requests that share the same transaction
+            for(j = 0; j < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; j++)
+            {
+               //The primary ADU of a coalesced request may be partially
+               //transmitted
+               if(context->asyncRequests[j].state != MODBUS_REQUEST_STATE_FREE &&
+                  context->asyncRequests[j].transactionId == request->transactionId &&
+                  context->asyncRequests[j].requestAduPos > 0 &&
+                  context->asyncRequests[j].requestAduPos <
+                  context->asyncRequests[j].requestAduLen)
+               {
+                  break;
+               }
+            }
+
+            //The transaction cannot expire until the ADU has been entirely
+            //transmitted, otherwise the framing of the TCP stream would be
+            //corrupted
+            if(j < MODBUS_CLIENT_MAX_ASYNC_REQUESTS)
+               continue;
+
+            //Coalesced requests share the same transaction and expire
+            //together
+            for(j = 0; j < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; j++)
+            {
+               if(context->asyncRequests[j].state != MODBUS_REQUEST_STATE_FREE &&
+                  context->asyncRequests[j].transactionId == request->transactionId)
+               {
+                  //Report a timeout error
+                  modbusClientCompleteAsyncRequest(context,
+                     &context->asyncRequests[j], ERROR_TIMEOUT);
+               }
+            }
+         }
+      }
+   }
+}
+
+
+/**
+ * @brief Abort all outstanding asynchronous requests
+ * @param[in] context Pointer to the Modbus/TCP client context
+ * @param[in] error Status code to be reported to the user application
+ **/
+
+void modbusClientFlushAsyncRequests(ModbusClientContext *context,
+   error_t error)
+{
+   uint_t i;
+
+   //Loop through the asynchronous requests
+   for(i = 0; i < MODBUS_CLIENT_MAX_ASYNC_REQUESTS; i++)
+   {
+      //Outstanding request?
+      if(context->asyncRequests[i].state != MODBUS_REQUEST_STATE_FREE)
+      {
+         //Notify the user application
+         modbusClientCompleteAsyncRequest(context, &context->asyncRequests[i],
+            error);
+      }
+   }
+}
+
+#endif
+
 #endif
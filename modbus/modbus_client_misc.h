@@ -54,6 +54,42 @@ void *modbusClientGetResponsePdu(ModbusClientContext *context, size_t *length);
 
 error_t modbusClientCheckTimeout(ModbusClientContext *context);
 
+#if (MODBUS_CLIENT_ASYNC_SUPPORT == ENABLED)
+
+error_t modbusClientAllocateAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest **request);
+
+void modbusClientQueueAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request);
+
+bool_t modbusClientCoalesceAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request);
+
+error_t modbusClientSendAsyncRequests(ModbusClientContext *context);
+
+error_t modbusClientFinishAsyncTransmission(ModbusClientContext *context);
+
+error_t modbusClientReceiveAsyncResponses(ModbusClientContext *context,
+   systime_t timeout);
+
+error_t modbusClientProcessAsyncResp(ModbusClientContext *context);
+
+error_t modbusClientParseAsyncResp(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request, uint16_t address, uint_t quantity);
+
+error_t modbusClientParseAsyncReadRegsResp(ModbusClientContext *context,
+   uint_t offset, uint_t quantity, uint_t totalQuantity, uint16_t *value);
+
+void modbusClientCompleteAsyncRequest(ModbusClientContext *context,
+   ModbusClientAsyncRequest *request, error_t error);
+
+void modbusClientCheckAsyncTimeouts(ModbusClientContext *context);
+
+void modbusClientFlushAsyncRequests(ModbusClientContext *context,
+   error_t error);
+
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 }
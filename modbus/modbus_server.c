@@ -93,6 +93,26 @@ void modbusServerGetDefaultSettings(ModbusServerSettings *settings)
    settings->readInputRegCallback = NULL;
    //Set register value callback function
    settings->writeRegCallback = NULL;
+
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Get coil states callback function
+   settings->readCoilsCallback = NULL;
+   //Get discrete input states callback function
+   settings->readDiscreteInputsCallback = NULL;
+   //Set coil states callback function
+   settings->writeCoilsCallback = NULL;
+   //Get register values callback function
+   settings->readRegsCallback = NULL;
+   //Get holding register values callback function
+   settings->readHoldingRegsCallback = NULL;
+   //Get input register values callback function
+   settings->readInputRegsCallback = NULL;
+   //Set register values callback function
+   settings->writeRegsCallback = NULL;
+   //Register map
+   settings->regMap = NULL;
+#endif
+
    //PDU processing callback
    settings->processPduCallback = NULL;
    //Tick callback function
@@ -162,6 +182,16 @@ error_t modbusServerInit(ModbusServerContext *context,
    context->readHoldingRegCallback = settings->readHoldingRegCallback;
    context->readInputRegCallback = settings->readInputRegCallback;
    context->writeRegCallback = settings->writeRegCallback;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   context->readCoilsCallback = settings->readCoilsCallback;
+   context->readDiscreteInputsCallback = settings->readDiscreteInputsCallback;
+   context->writeCoilsCallback = settings->writeCoilsCallback;
+   context->readRegsCallback = settings->readRegsCallback;
+   context->readHoldingRegsCallback = settings->readHoldingRegsCallback;
+   context->readInputRegsCallback = settings->readInputRegsCallback;
+   context->writeRegsCallback = settings->writeRegsCallback;
+   context->regMap = settings->regMap;
+#endif
    context->processPduCallback = settings->processPduCallback;
    context->tickCallback = settings->tickCallback;
 
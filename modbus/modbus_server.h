@@ -56,6 +56,20 @@
    #error MODBUS_SERVER_DIAG_SUPPORT parameter is not valid
 #endif
 
+//Block access support
+#ifndef MODBUS_SERVER_BLOCK_SUPPORT
+   #define MODBUS_SERVER_BLOCK_SUPPORT DISABLED
+#elif (MODBUS_SERVER_BLOCK_SUPPORT != ENABLED && MODBUS_SERVER_BLOCK_SUPPORT != DISABLED)
+   #error MODBUS_SERVER_BLOCK_SUPPORT parameter is not valid
+#endif
+
+//Batch processing of pipelined requests
+#ifndef MODBUS_SERVER_BATCH_SUPPORT
+   #define MODBUS_SERVER_BATCH_SUPPORT DISABLED
+#elif (MODBUS_SERVER_BATCH_SUPPORT != ENABLED && MODBUS_SERVER_BATCH_SUPPORT != DISABLED)
+   #error MODBUS_SERVER_BATCH_SUPPORT parameter is not valid
+#endif
+
 //Stack size required to run the Modbus/TCP server
 #ifndef MODBUS_SERVER_STACK_SIZE
    #define MODBUS_SERVER_STACK_SIZE 650
@@ -110,6 +124,13 @@
    #error MODBUS_SERVER_MAX_ROLE_LEN parameter is not valid
 #endif
 
+//Size of the request and response buffers (batch processing)
+#ifndef MODBUS_SERVER_BATCH_BUFFER_SIZE
+   #define MODBUS_SERVER_BATCH_BUFFER_SIZE 1040
+#elif (MODBUS_SERVER_BATCH_BUFFER_SIZE < 260)
+   #error MODBUS_SERVER_BATCH_BUFFER_SIZE parameter is not valid
+#endif
+
 //Application specific context
 #ifndef MODBUS_SERVER_PRIVATE_CONTEXT
    #define MODBUS_SERVER_PRIVATE_CONTEXT
@@ -226,6 +247,43 @@ typedef error_t (*ModbusServerWriteRegCallback)(ModbusClientConnection *connecti
    uint16_t address, uint16_t value, bool_t commit);
 
 
+//Block access supported?
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+
+/**
+ * @brief Get coil states callback function
+ **/
+
+typedef error_t (*ModbusServerReadCoilsCallback)(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *states);
+
+
+/**
+ * @brief Set coil states callback function
+ **/
+
+typedef error_t (*ModbusServerWriteCoilsCallback)(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, const uint8_t *states, bool_t commit);
+
+
+/**
+ * @brief Get register values callback function
+ **/
+
+typedef error_t (*ModbusServerReadRegsCallback)(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint16_t *values);
+
+
+/**
+ * @brief Set register values callback function
+ **/
+
+typedef error_t (*ModbusServerWriteRegsCallback)(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, const uint16_t *values, bool_t commit);
+
+#endif
+
+
 /**
  * @brief PDU processing callback function
  **/
@@ -242,6 +300,36 @@ typedef error_t (*ModbusServerProcessPduCallback)(ModbusClientConnection *connec
 typedef void (*ModbusServerTickCallback)(ModbusServerContext *context);
 
 
+//Block access supported?
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+
+/**
+ * @brief Register map
+ *
+ * Coils and discrete inputs are packed one per bit (LSB first), whereas
+ * registers are stored in host byte order
+ *
+ **/
+
+typedef struct
+{
+   uint8_t *coils;             ///<Coil states
+   uint16_t coilAddr;          ///<Address of the first coil
+   uint16_t numCoils;          ///<Number of coils
+   uint8_t *discreteInputs;    ///<Discrete input states
+   uint16_t discreteInputAddr; ///<Address of the first discrete input
+   uint16_t numDiscreteInputs; ///<Number of discrete inputs
+   uint16_t *holdingRegs;      ///<Holding register values
+   uint16_t holdingRegAddr;    ///<Address of the first holding register
+   uint16_t numHoldingRegs;    ///<Number of holding registers
+   uint16_t *inputRegs;        ///<Input register values
+   uint16_t inputRegAddr;      ///<Address of the first input register
+   uint16_t numInputRegs;      ///<Number of input registers
+} ModbusServerRegMap;
+
+#endif
+
+
 /**
  * @brief Modbus/TCP server settings
  **/
@@ -268,6 +356,16 @@ typedef struct
    ModbusServerReadRegCallback readHoldingRegCallback;     ///<Get holding register value callback function
    ModbusServerReadRegCallback readInputRegCallback;       ///<Get input register value callback function
    ModbusServerWriteRegCallback writeRegCallback;          ///<Set register value callback function
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerReadCoilsCallback readCoilsCallback;        ///<Get coil states callback function
+   ModbusServerReadCoilsCallback readDiscreteInputsCallback; ///<Get discrete input states callback function
+   ModbusServerWriteCoilsCallback writeCoilsCallback;      ///<Set coil states callback function
+   ModbusServerReadRegsCallback readRegsCallback;          ///<Get register values callback function
+   ModbusServerReadRegsCallback readHoldingRegsCallback;   ///<Get holding register values callback function
+   ModbusServerReadRegsCallback readInputRegsCallback;     ///<Get input register values callback function
+   ModbusServerWriteRegsCallback writeRegsCallback;        ///<Set register values callback function
+   ModbusServerRegMap *regMap;                             ///<Register map
+#endif
    ModbusServerProcessPduCallback processPduCallback;      ///<PDU processing callback function
    ModbusServerTickCallback tickCallback;                  ///<Tick callback function
 } ModbusServerSettings;
@@ -287,13 +385,27 @@ struct _ModbusClientConnection
 #endif
    char_t role[MODBUS_SERVER_MAX_ROLE_LEN + 1]; ///<Client role OID
    systime_t timestamp;                         ///<Time stamp
+#if (MODBUS_SERVER_BATCH_SUPPORT == ENABLED)
+   uint8_t requestAdu[MODBUS_SERVER_BATCH_BUFFER_SIZE];  ///<Request ADUs
+#else
    uint8_t requestAdu[MODBUS_MAX_ADU_SIZE];     ///<Request ADU
-   size_t requestAduLen;                        ///<Length of the request ADU, in bytes
-   size_t requestAduPos;                        ///<Current position in the request ADU
+#endif
+   size_t requestAduStart;                      ///<Offset of the current request ADU
+   size_t requestAduLen;                        ///<End of the current request ADU, in bytes
+   size_t requestAduPos;                        ///<Current position in the request buffer
    uint8_t requestUnitId;                       ///<Unit identifier
+#if (MODBUS_SERVER_BATCH_SUPPORT == ENABLED)
+   uint8_t responseAdu[MODBUS_SERVER_BATCH_BUFFER_SIZE]; ///<Response ADUs
+#else
    uint8_t responseAdu[MODBUS_MAX_ADU_SIZE];    ///<Response ADU
-   size_t responseAduLen;                       ///<Length of the response ADU, in bytes
-   size_t responseAduPos;                       ///<Current position in the response ADU
+#endif
+   size_t responseAduStart;                     ///<Offset of the current response ADU
+   size_t responseAduLen;                       ///<End of the current response ADU, in bytes
+   size_t responseAduPos;                       ///<Current position in the response buffer
+   uint_t lockCount;                            ///<Number of nested locks on the Modbus table
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   uint16_t regValues[125];                     ///<Register values exchanged with block callbacks
+#endif
 };
 
 
@@ -322,6 +434,16 @@ struct _ModbusServerContext
    ModbusServerReadRegCallback readHoldingRegCallback;     ///<Get holding register value callback function
    ModbusServerReadRegCallback readInputRegCallback;       ///<Get input register value callback function
    ModbusServerWriteRegCallback writeRegCallback;          ///<Set register value callback function
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerReadCoilsCallback readCoilsCallback;        ///<Get coil states callback function
+   ModbusServerReadCoilsCallback readDiscreteInputsCallback; ///<Get discrete input states callback function
+   ModbusServerWriteCoilsCallback writeCoilsCallback;      ///<Set coil states callback function
+   ModbusServerReadRegsCallback readRegsCallback;          ///<Get register values callback function
+   ModbusServerReadRegsCallback readHoldingRegsCallback;   ///<Get holding register values callback function
+   ModbusServerReadRegsCallback readInputRegsCallback;     ///<Get input register values callback function
+   ModbusServerWriteRegsCallback writeRegsCallback;        ///<Set register values callback function
+   ModbusServerRegMap *regMap;                             ///<Register map
+#endif
    ModbusServerProcessPduCallback processPduCallback;      ///<PDU processing callback function
    ModbusServerTickCallback tickCallback;                  ///<Tick callback function
    bool_t running;                                         ///<Operational state of the Modbus/TCP server
@@ -175,13 +175,18 @@ void modbusServerProcessConnectionEvents(ModbusClientConnection *connection)
 {
    error_t error;
    size_t n;
+#if (MODBUS_SERVER_BATCH_SUPPORT == DISABLED || MODBUS_SERVER_DIAG_SUPPORT == ENABLED)
    ModbusServerContext *context;
+#endif
 
    //Initialize status code
    error = NO_ERROR;
 
+#if (MODBUS_SERVER_BATCH_SUPPORT == DISABLED || MODBUS_SERVER_DIAG_SUPPORT == ENABLED)
    //Point to the Modbus/TCP server context
    context = connection->context;
+#endif
+
    //Update time stamp
    connection->timestamp = osGetSystemTime();
 
@@ -203,6 +208,35 @@ void modbusServerProcessConnectionEvents(ModbusClientConnection *connection)
       error = ERROR_WRONG_STATE;
 #endif
    }
+#if (MODBUS_SERVER_BATCH_SUPPORT == ENABLED)
+   else if(connection->state == MODBUS_CONNECTION_STATE_RECEIVE)
+   {
+      //Receive as much data as possible, so that pipelined requests can be
+      //processed in a single pass
+      error = modbusServerReceiveData(connection,
+         connection->requestAdu + connection->requestAduPos,
+         MODBUS_SERVER_BATCH_BUFFER_SIZE - connection->requestAduPos, &n, 0);
+
+      //Check status code
+      if(error == NO_ERROR)
+      {
+         //Advance data pointer
+         connection->requestAduPos += n;
+
+         //Process all the complete request ADUs
+         error = modbusServerProcessRequestBatch(connection);
+      }
+      else if(error == ERROR_END_OF_STREAM)
+      {
+         //Initiate a graceful connection shutdown
+         error = modbusServerShutdownConnection(connection);
+      }
+      else
+      {
+         //Just for sanity
+      }
+   }
+#else
    else if(connection->state == MODBUS_CONNECTION_STATE_RECEIVE)
    {
       //Receive Modbus request
@@ -273,6 +307,7 @@ void modbusServerProcessConnectionEvents(ModbusClientConnection *connection)
          error = ERROR_WRONG_STATE;
       }
    }
+#endif
    else if(connection->state == MODBUS_CONNECTION_STATE_SEND)
    {
       //Send Modbus response
@@ -293,6 +328,17 @@ void modbusServerProcessConnectionEvents(ModbusClientConnection *connection)
             //Modbus response successfully sent?
             if(connection->responseAduPos >= connection->responseAduLen)
             {
+#if (MODBUS_SERVER_BATCH_SUPPORT == ENABLED)
+               //Flush transmit buffer
+               connection->responseAduLen = 0;
+               connection->responseAduPos = 0;
+
+               //Wait for the next Modbus request
+               connection->state = MODBUS_CONNECTION_STATE_RECEIVE;
+
+               //Complete requests may have been left in the receive buffer
+               error = modbusServerProcessRequestBatch(connection);
+#else
 #if (MODBUS_SERVER_DIAG_SUPPORT == ENABLED)
                //Total number of messages sent
                context->txMessageCount++;
@@ -303,6 +349,7 @@ void modbusServerProcessConnectionEvents(ModbusClientConnection *connection)
 
                //Wait for the next Modbus request
                connection->state = MODBUS_CONNECTION_STATE_RECEIVE;
+#endif
             }
          }
       }
@@ -343,6 +390,155 @@ void modbusServerProcessConnectionEvents(ModbusClientConnection *connection)
 }
 
 
+#if (MODBUS_SERVER_BATCH_SUPPORT == ENABLED)
+
+/**
+ * @brief Process the request ADUs present in the receive buffer
+ *
+ * All the complete request ADUs are processed in a single pass, with the
+ * Modbus table locked once. Their responses are appended to the transmit
+ * buffer so that they can be sent back to the client at once
+ *
+ * @param[in] connection Pointer to the client connection
+ * @return Error code
+ **/
+
+error_t modbusServerProcessRequestBatch(ModbusClientConnection *connection)
+{
+   error_t error;
+   size_t n;
+   bool_t locked;
+   ModbusServerContext *context;
+
+   //Initialize status code
+   error = NO_ERROR;
+   //The Modbus table is not locked yet
+   locked = FALSE;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+
+   //Start of the first request ADU
+   connection->requestAduStart = 0;
+
+   //Process the complete request ADUs
+   while(!error)
+   {
+      //Incomplete MBAP header?
+      if(connection->requestAduPos < (connection->requestAduStart +
+         sizeof(ModbusHeader)))
+      {
+         break;
+      }
+
+      //Parse MBAP header
+      error = modbusServerParseMbapHeader(connection);
+      //Malformed request?
+      if(error)
+         break;
+
+      //Incomplete request ADU?
+      if(connection->requestAduPos < connection->requestAduLen)
+         break;
+
+      //Make sure there is enough room left in the transmit buffer
+      if((connection->responseAduLen + MODBUS_MAX_ADU_SIZE) >
+         MODBUS_SERVER_BATCH_BUFFER_SIZE)
+      {
+         //The remaining requests will be processed once the pending
+         //responses have been sent
+         break;
+      }
+
+      //Lock access to Modbus table for the whole batch
+      if(!locked)
+      {
+         modbusServerLock(connection);
+         locked = TRUE;
+      }
+
+#if (MODBUS_SERVER_DIAG_SUPPORT == ENABLED)
+      //Total number of messages received
+      context->rxMessageCount++;
+#endif
+
+      //The response is appended to the previous ones
+      connection->responseAduStart = connection->responseAduLen;
+
+      //Check unit identifier
+      if(context->unitId == 0 ||
+         context->unitId == 255 ||
+         context->unitId == connection->requestUnitId)
+      {
+         //Process Modbus request
+         error = modbusServerProcessRequest(connection);
+      }
+
+#if (MODBUS_SERVER_DIAG_SUPPORT == ENABLED)
+      //Any response generated?
+      if(connection->responseAduLen > connection->responseAduStart)
+      {
+         //Total number of messages sent
+         context->txMessageCount++;
+      }
+#endif
+
+      //Point to the next request ADU
+      connection->requestAduStart = connection->requestAduLen;
+   }
+
+   //The lock must be released whatever the outcome of the batch
+   if(locked)
+   {
+      //Unlock access to Modbus table
+      modbusServerUnlock(connection);
+   }
+
+   //Any request processed?
+   if(connection->requestAduStart > 0)
+   {
+      //Number of bytes left in the receive buffer
+      n = connection->requestAduPos - connection->requestAduStart;
+
+      //Move the incomplete request ADU, if any, to the beginning of the
+      //receive buffer
+      osMemmove(connection->requestAdu, connection->requestAdu +
+         connection->requestAduStart, n);
+
+      //Update the position in the receive buffer
+      connection->requestAduPos = n;
+   }
+
+   //Rewind to the beginning of the buffers
+   connection->requestAduStart = 0;
+   connection->requestAduLen = 0;
+   connection->responseAduStart = 0;
+
+   //Check status code
+   if(!error)
+   {
+      //Any response to send?
+      if(connection->responseAduLen > 0)
+      {
+         //Rewind to the beginning of the transmit buffer
+         connection->responseAduPos = 0;
+         //Send all the response ADUs to the client at once
+         connection->state = MODBUS_CONNECTION_STATE_SEND;
+      }
+      else
+      {
+         //Wait for the next Modbus request
+         connection->state = MODBUS_CONNECTION_STATE_RECEIVE;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+#endif
+
+
 /**
  * @brief Parse request MBAP header
  * @param[in] connection Pointer to the client connection
@@ -355,11 +551,15 @@ error_t modbusServerParseMbapHeader(ModbusClientConnection *connection)
    ModbusHeader *requestHeader;
 
    //Sanity check
-   if(connection->requestAduPos < sizeof(ModbusHeader))
+   if(connection->requestAduPos < (connection->requestAduStart +
+      sizeof(ModbusHeader)))
+   {
       return ERROR_INVALID_LENGTH;
+   }
 
    //Point to the beginning of the request ADU
-   requestHeader = (ModbusHeader *) connection->requestAdu;
+   requestHeader = (ModbusHeader *) (connection->requestAdu +
+      connection->requestAduStart);
 
    //The length field is a byte count of the following fields, including
    //the unit identifier and data fields
@@ -393,7 +593,8 @@ error_t modbusServerParseMbapHeader(ModbusClientConnection *connection)
    //Save unit identifier
    connection->requestUnitId = requestHeader->unitId;
    //Compute the length of the request ADU
-   connection->requestAduLen = sizeof(ModbusHeader) + n;
+   connection->requestAduLen = connection->requestAduStart +
+      sizeof(ModbusHeader) + n;
 
    //Successful processing
    return NO_ERROR;
@@ -414,13 +615,18 @@ error_t modbusServerFormatMbapHeader(ModbusClientConnection *connection,
    ModbusHeader *responseHeader;
 
    //Sanity check
-   if(connection->requestAduPos < sizeof(ModbusHeader))
+   if(connection->requestAduPos < (connection->requestAduStart +
+      sizeof(ModbusHeader)))
+   {
       return ERROR_INVALID_LENGTH;
+   }
 
    //Point to the beginning of the request ADU
-   requestHeader = (ModbusHeader *) connection->requestAdu;
+   requestHeader = (ModbusHeader *) (connection->requestAdu +
+      connection->requestAduStart);
    //Point to the beginning of the response ADU
-   responseHeader = (ModbusHeader *) connection->responseAdu;
+   responseHeader = (ModbusHeader *) (connection->responseAdu +
+      connection->responseAduStart);
 
    //Format MBAP header
    responseHeader->transactionId = requestHeader->transactionId;
@@ -429,11 +635,12 @@ error_t modbusServerFormatMbapHeader(ModbusClientConnection *connection,
    responseHeader->unitId = requestHeader->unitId;
 
    //Compute the length of the response ADU
-   connection->responseAduLen = sizeof(ModbusHeader) + length;
+   connection->responseAduLen = connection->responseAduStart +
+      sizeof(ModbusHeader) + length;
 
    //Debug message
    TRACE_DEBUG("Modbus Server: Sending ADU (%" PRIuSIZE " bytes)...\r\n",
-      connection->responseAduLen);
+      sizeof(ModbusHeader) + length);
 
    //Dump MBAP header
    TRACE_DEBUG("  Transaction ID = %" PRIu16 "\r\n", ntohs(responseHeader->transactionId));
@@ -464,12 +671,15 @@ void *modbusServerGetRequestPdu(ModbusClientConnection *connection,
    uint8_t *requestPdu;
 
    //Point to the request PDU
-   requestPdu = connection->requestAdu + sizeof(ModbusHeader);
+   requestPdu = connection->requestAdu + connection->requestAduStart +
+      sizeof(ModbusHeader);
 
    //Retrieve the length of the PDU
-   if(connection->requestAduLen >= sizeof(ModbusHeader))
+   if(connection->requestAduLen >= (connection->requestAduStart +
+      sizeof(ModbusHeader)))
    {
-      *length = connection->requestAduLen - sizeof(ModbusHeader);
+      *length = connection->requestAduLen - connection->requestAduStart -
+         sizeof(ModbusHeader);
    }
    else
    {
@@ -490,7 +700,8 @@ void *modbusServerGetRequestPdu(ModbusClientConnection *connection,
 void *modbusServerGetResponsePdu(ModbusClientConnection *connection)
 {
    //Point to the response PDU
-   return connection->responseAdu + sizeof(ModbusHeader);
+   return connection->responseAdu + connection->responseAduStart +
+      sizeof(ModbusHeader);
 }
 
 
@@ -506,11 +717,15 @@ void modbusServerLock(ModbusClientConnection *connection)
    //Point to the Modbus/TCP server context
    context = connection->context;
 
-   //Any registered callback?
-   if(context->lockCallback != NULL)
+   //The Modbus table may already be locked for the whole batch of requests
+   if(connection->lockCount++ == 0)
    {
-      //Invoke user callback function
-      context->lockCallback(connection);
+      //Any registered callback?
+      if(context->lockCallback != NULL)
+      {
+         //Invoke user callback function
+         context->lockCallback(connection);
+      }
    }
 }
 
@@ -527,11 +742,15 @@ void modbusServerUnlock(ModbusClientConnection *connection)
    //Point to the Modbus/TCP server context
    context = connection->context;
 
-   //Any registered callback?
-   if(context->unlockCallback != NULL)
+   //Release the lock when the outermost section is left
+   if(connection->lockCount > 0 && --connection->lockCount == 0)
    {
-      //Invoke user callback function
-      context->unlockCallback(connection);
+      //Any registered callback?
+      if(context->unlockCallback != NULL)
+      {
+         //Invoke user callback function
+         context->unlockCallback(connection);
+      }
    }
 }
 
@@ -549,16 +768,45 @@ error_t modbusServerReadCoil(ModbusClientConnection *connection,
 {
    error_t error;
    ModbusServerContext *context;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   uint8_t temp;
+   ModbusServerRegMap *regMap;
+#endif
 
    //Point to the Modbus/TCP server context
    context = connection->context;
 
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Is the coil mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->coils,
+      regMap->coilAddr, regMap->numCoils, address, 1))
+   {
+      //Retrieve the state of the coil
+      *state = MODBUS_TEST_COIL(regMap->coils, address - regMap->coilAddr);
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else
+#endif
    //Any registered callback?
    if(context->readCoilCallback != NULL)
    {
       //Invoke user callback function
       error = context->readCoilCallback(connection, address, state);
    }
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   else if(context->readCoilsCallback != NULL)
+   {
+      //Read a block of one coil
+      temp = 0;
+      error = context->readCoilsCallback(connection, address, 1, &temp);
+      //Retrieve the state of the coil
+      *state = (temp & 0x01) ? TRUE : FALSE;
+   }
+#endif
    else
    {
       //Report an error
@@ -583,10 +831,31 @@ error_t modbusServerReadDiscreteInput(ModbusClientConnection *connection,
 {
    error_t error;
    ModbusServerContext *context;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   uint8_t temp;
+   ModbusServerRegMap *regMap;
+#endif
 
    //Point to the Modbus/TCP server context
    context = connection->context;
 
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Is the discrete input mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->discreteInputs,
+      regMap->discreteInputAddr, regMap->numDiscreteInputs, address, 1))
+   {
+      //Retrieve the state of the discrete input
+      *state = MODBUS_TEST_COIL(regMap->discreteInputs,
+         address - regMap->discreteInputAddr);
+
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else
+#endif
    //Any registered callback?
    if(context->readDiscreteInputCallback != NULL)
    {
@@ -598,6 +867,24 @@ error_t modbusServerReadDiscreteInput(ModbusClientConnection *connection,
       //Invoke user callback function
       error = context->readCoilCallback(connection, address, state);
    }
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   else if(context->readDiscreteInputsCallback != NULL)
+   {
+      //Read a block of one discrete input
+      temp = 0;
+      error = context->readDiscreteInputsCallback(connection, address, 1, &temp);
+      //Retrieve the state of the discrete input
+      *state = (temp & 0x01) ? TRUE : FALSE;
+   }
+   else if(context->readCoilsCallback != NULL)
+   {
+      //Read a block of one coil
+      temp = 0;
+      error = context->readCoilsCallback(connection, address, 1, &temp);
+      //Retrieve the state of the coil
+      *state = (temp & 0x01) ? TRUE : FALSE;
+   }
+#endif
    else
    {
       //Report an error
@@ -624,16 +911,55 @@ error_t modbusServerWriteCoil(ModbusClientConnection *connection,
 {
    error_t error;
    ModbusServerContext *context;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   uint8_t temp;
+   ModbusServerRegMap *regMap;
+#endif
 
    //Point to the Modbus/TCP server context
    context = connection->context;
 
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Is the coil mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->coils,
+      regMap->coilAddr, regMap->numCoils, address, 1))
+   {
+      //Write phase?
+      if(commit)
+      {
+         //Force the coil to the desired ON/OFF state
+         if(state)
+         {
+            MODBUS_SET_COIL(regMap->coils, address - regMap->coilAddr);
+         }
+         else
+         {
+            MODBUS_RESET_COIL(regMap->coils, address - regMap->coilAddr);
+         }
+      }
+
+      //Successful write operation
+      error = NO_ERROR;
+   }
+   else
+#endif
    //Any registered callback?
    if(context->writeCoilCallback != NULL)
    {
       //Invoke user callback function
       error = context->writeCoilCallback(connection, address, state, commit);
    }
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   else if(context->writeCoilsCallback != NULL)
+   {
+      //Write a block of one coil
+      temp = state ? 1 : 0;
+      error = context->writeCoilsCallback(connection, address, 1, &temp, commit);
+   }
+#endif
    else
    {
       //Report an error
@@ -658,10 +984,28 @@ error_t modbusServerReadHoldingReg(ModbusClientConnection *connection,
 {
    error_t error;
    ModbusServerContext *context;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerRegMap *regMap;
+#endif
 
    //Point to the Modbus/TCP server context
    context = connection->context;
 
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Is the holding register mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->holdingRegs,
+      regMap->holdingRegAddr, regMap->numHoldingRegs, address, 1))
+   {
+      //Retrieve the value of the holding register
+      *value = regMap->holdingRegs[address - regMap->holdingRegAddr];
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else
+#endif
    //Any registered callback?
    if(context->readHoldingRegCallback != NULL)
    {
@@ -673,6 +1017,18 @@ error_t modbusServerReadHoldingReg(ModbusClientConnection *connection,
       //Invoke user callback function
       error = context->readRegCallback(connection, address, value);
    }
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   else if(context->readHoldingRegsCallback != NULL)
+   {
+      //Read a block of one register
+      error = context->readHoldingRegsCallback(connection, address, 1, value);
+   }
+   else if(context->readRegsCallback != NULL)
+   {
+      //Read a block of one register
+      error = context->readRegsCallback(connection, address, 1, value);
+   }
+#endif
    else
    {
       //Report an error
@@ -697,10 +1053,28 @@ error_t modbusServerReadInputReg(ModbusClientConnection *connection,
 {
    error_t error;
    ModbusServerContext *context;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerRegMap *regMap;
+#endif
 
    //Point to the Modbus/TCP server context
    context = connection->context;
 
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Is the input register mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->inputRegs,
+      regMap->inputRegAddr, regMap->numInputRegs, address, 1))
+   {
+      //Retrieve the value of the input register
+      *value = regMap->inputRegs[address - regMap->inputRegAddr];
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else
+#endif
    //Any registered callback?
    if(context->readInputRegCallback != NULL)
    {
@@ -712,6 +1086,18 @@ error_t modbusServerReadInputReg(ModbusClientConnection *connection,
       //Invoke user callback function
       error = context->readRegCallback(connection, address, value);
    }
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   else if(context->readInputRegsCallback != NULL)
+   {
+      //Read a block of one register
+      error = context->readInputRegsCallback(connection, address, 1, value);
+   }
+   else if(context->readRegsCallback != NULL)
+   {
+      //Read a block of one register
+      error = context->readRegsCallback(connection, address, 1, value);
+   }
+#endif
    else
    {
       //Report an error
@@ -738,16 +1124,47 @@ error_t modbusServerWriteReg(ModbusClientConnection *connection,
 {
    error_t error;
    ModbusServerContext *context;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerRegMap *regMap;
+#endif
 
    //Point to the Modbus/TCP server context
    context = connection->context;
 
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Is the holding register mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->holdingRegs,
+      regMap->holdingRegAddr, regMap->numHoldingRegs, address, 1))
+   {
+      //Write phase?
+      if(commit)
+      {
+         //Update the value of the holding register
+         regMap->holdingRegs[address - regMap->holdingRegAddr] = value;
+      }
+
+      //Successful write operation
+      error = NO_ERROR;
+   }
+   else
+#endif
    //Any registered callback?
    if(context->writeRegCallback != NULL)
    {
       //Invoke user callback function
       error = context->writeRegCallback(connection, address, value, commit);
    }
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   else if(context->writeRegsCallback != NULL)
+   {
+      //Write a block of one register
+      error = context->writeRegsCallback(connection, address, 1, &value,
+         commit);
+   }
+#endif
    else
    {
       //Report an error
@@ -759,6 +1176,593 @@ error_t modbusServerWriteReg(ModbusClientConnection *connection,
 }
 
 
+/**
+ * @brief Read a block of contiguous coils
+ * @param[in] connection Pointer to the client connection
+ * @param[in] address Address of the first coil
+ * @param[in] quantity Number of coils to be read
+ * @param[out] states Coil states, packed as one coil per bit
+ * @return Error code
+ **/
+
+error_t modbusServerReadCoils(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *states)
+{
+   error_t error;
+   uint_t i;
+   bool_t state;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerContext *context;
+   ModbusServerRegMap *regMap;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Are the coils mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->coils,
+      regMap->coilAddr, regMap->numCoils, address, quantity))
+   {
+      //Copy the coil states from the register map
+      modbusServerCopyCoils(states, 0, regMap->coils,
+         address - regMap->coilAddr, quantity);
+
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else if(context->readCoilsCallback != NULL)
+   {
+      //Invoke user callback function
+      error = context->readCoilsCallback(connection, address, quantity,
+         states);
+
+      //The remaining bits in the final data byte are padded with zeros
+      if((quantity % 8) != 0)
+      {
+         states[quantity / 8] &= (1 << (quantity % 8)) - 1;
+      }
+   }
+   else
+#endif
+   {
+      //Initialize status code
+      error = NO_ERROR;
+
+      //Read the specified number of coils
+      for(i = 0; i < quantity && !error; i++)
+      {
+         //Retrieve the state of the current coil
+         error = modbusServerReadCoil(connection, address + i, &state);
+
+         //Successful read operation?
+         if(!error)
+         {
+            //The coils are packed as one coil per bit of the data field
+            if(state)
+            {
+               MODBUS_SET_COIL(states, i);
+            }
+            else
+            {
+               MODBUS_RESET_COIL(states, i);
+            }
+         }
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Read a block of contiguous discrete inputs
+ * @param[in] connection Pointer to the client connection
+ * @param[in] address Address of the first discrete input
+ * @param[in] quantity Number of discrete inputs to be read
+ * @param[out] states Discrete input states, packed as one input per bit
+ * @return Error code
+ **/
+
+error_t modbusServerReadDiscreteInputs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *states)
+{
+   error_t error;
+   uint_t i;
+   bool_t state;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerContext *context;
+   ModbusServerRegMap *regMap;
+   ModbusServerReadCoilsCallback callback;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Discrete inputs fall back to the coil block callback
+   if(context->readDiscreteInputsCallback != NULL)
+   {
+      callback = context->readDiscreteInputsCallback;
+   }
+   else if(context->readDiscreteInputCallback == NULL &&
+      context->readCoilCallback == NULL)
+   {
+      callback = context->readCoilsCallback;
+   }
+   else
+   {
+      callback = NULL;
+   }
+
+   //Are the discrete inputs mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->discreteInputs,
+      regMap->discreteInputAddr, regMap->numDiscreteInputs, address, quantity))
+   {
+      //Copy the discrete input states from the register map
+      modbusServerCopyCoils(states, 0, regMap->discreteInputs,
+         address - regMap->discreteInputAddr, quantity);
+
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else if(callback != NULL)
+   {
+      //Invoke user callback function
+      error = callback(connection, address, quantity, states);
+
+      //The remaining bits in the final data byte are padded with zeros
+      if((quantity % 8) != 0)
+      {
+         states[quantity / 8] &= (1 << (quantity % 8)) - 1;
+      }
+   }
+   else
+#endif
+   {
+      //Initialize status code
+      error = NO_ERROR;
+
+      //Read the specified number of discrete inputs
+      for(i = 0; i < quantity && !error; i++)
+      {
+         //Retrieve the state of the current discrete input
+         error = modbusServerReadDiscreteInput(connection, address + i, &state);
+
+         //Successful read operation?
+         if(!error)
+         {
+            //The discrete inputs are packed as one input per bit of the
+            //data field
+            if(state)
+            {
+               MODBUS_SET_COIL(states, i);
+            }
+            else
+            {
+               MODBUS_RESET_COIL(states, i);
+            }
+         }
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write a block of contiguous coils
+ * @param[in] connection Pointer to the client connection
+ * @param[in] address Address of the first coil
+ * @param[in] quantity Number of coils to be written
+ * @param[in] states Desired coil states, packed as one coil per bit
+ * @param[in] commit This flag indicates the current phase (validation phase
+ *   or write phase if the validation was successful)
+ * @return Error code
+ **/
+
+error_t modbusServerWriteCoils(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, const uint8_t *states, bool_t commit)
+{
+   error_t error;
+   uint_t i;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerContext *context;
+   ModbusServerRegMap *regMap;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Are the coils mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->coils,
+      regMap->coilAddr, regMap->numCoils, address, quantity))
+   {
+      //Write phase?
+      if(commit)
+      {
+         //Copy the coil states to the register map
+         modbusServerCopyCoils(regMap->coils, address - regMap->coilAddr,
+            states, 0, quantity);
+      }
+
+      //Successful write operation
+      error = NO_ERROR;
+   }
+   else if(context->writeCoilsCallback != NULL)
+   {
+      //Invoke user callback function
+      error = context->writeCoilsCallback(connection, address, quantity,
+         states, commit);
+   }
+   else
+#endif
+   {
+      //Initialize status code
+      error = NO_ERROR;
+
+      //Write the specified number of coils
+      for(i = 0; i < quantity && !error; i++)
+      {
+         //Force the current coil to the desired ON/OFF state
+         error = modbusServerWriteCoil(connection, address + i,
+            MODBUS_TEST_COIL(states, i), commit);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Read a block of contiguous holding registers
+ * @param[in] connection Pointer to the client connection
+ * @param[in] address Address of the first holding register
+ * @param[in] quantity Number of holding registers to be read
+ * @param[out] values Register values, in network byte order
+ * @return Error code
+ **/
+
+error_t modbusServerReadHoldingRegs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *values)
+{
+   error_t error;
+   uint_t i;
+   uint16_t value;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerContext *context;
+   ModbusServerRegMap *regMap;
+   ModbusServerReadRegsCallback callback;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Holding registers fall back to the generic block callback
+   if(context->readHoldingRegsCallback != NULL)
+   {
+      callback = context->readHoldingRegsCallback;
+   }
+   else if(context->readHoldingRegCallback == NULL &&
+      context->readRegCallback == NULL)
+   {
+      callback = context->readRegsCallback;
+   }
+   else
+   {
+      callback = NULL;
+   }
+
+   //Are the holding registers mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->holdingRegs,
+      regMap->holdingRegAddr, regMap->numHoldingRegs, address, quantity))
+   {
+      //Point to the first register
+      address -= regMap->holdingRegAddr;
+
+      //Copy the register values from the register map
+      for(i = 0; i < quantity; i++)
+      {
+         STORE16BE(regMap->holdingRegs[address + i], values + i * 2);
+      }
+
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else if(callback != NULL && quantity <= arraysize(connection->regValues))
+   {
+      //Invoke user callback function
+      error = callback(connection, address, quantity, connection->regValues);
+
+      //Check status code
+      if(!error)
+      {
+         //Convert the values to network byte order
+         for(i = 0; i < quantity; i++)
+         {
+            STORE16BE(connection->regValues[i], values + i * 2);
+         }
+      }
+   }
+   else
+#endif
+   {
+      //Initialize status code
+      error = NO_ERROR;
+
+      //Read the specified number of registers
+      for(i = 0; i < quantity && !error; i++)
+      {
+         //Retrieve the value of the current register
+         error = modbusServerReadHoldingReg(connection, address + i, &value);
+         //Convert the value to network byte order
+         STORE16BE(value, values + i * 2);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Read a block of contiguous input registers
+ * @param[in] connection Pointer to the client connection
+ * @param[in] address Address of the first input register
+ * @param[in] quantity Number of input registers to be read
+ * @param[out] values Register values, in network byte order
+ * @return Error code
+ **/
+
+error_t modbusServerReadInputRegs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *values)
+{
+   error_t error;
+   uint_t i;
+   uint16_t value;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerContext *context;
+   ModbusServerRegMap *regMap;
+   ModbusServerReadRegsCallback callback;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Input registers fall back to the generic block callback
+   if(context->readInputRegsCallback != NULL)
+   {
+      callback = context->readInputRegsCallback;
+   }
+   else if(context->readInputRegCallback == NULL &&
+      context->readRegCallback == NULL)
+   {
+      callback = context->readRegsCallback;
+   }
+   else
+   {
+      callback = NULL;
+   }
+
+   //Are the input registers mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->inputRegs,
+      regMap->inputRegAddr, regMap->numInputRegs, address, quantity))
+   {
+      //Point to the first register
+      address -= regMap->inputRegAddr;
+
+      //Copy the register values from the register map
+      for(i = 0; i < quantity; i++)
+      {
+         STORE16BE(regMap->inputRegs[address + i], values + i * 2);
+      }
+
+      //Successful read operation
+      error = NO_ERROR;
+   }
+   else if(callback != NULL && quantity <= arraysize(connection->regValues))
+   {
+      //Invoke user callback function
+      error = callback(connection, address, quantity, connection->regValues);
+
+      //Check status code
+      if(!error)
+      {
+         //Convert the values to network byte order
+         for(i = 0; i < quantity; i++)
+         {
+            STORE16BE(connection->regValues[i], values + i * 2);
+         }
+      }
+   }
+   else
+#endif
+   {
+      //Initialize status code
+      error = NO_ERROR;
+
+      //Read the specified number of registers
+      for(i = 0; i < quantity && !error; i++)
+      {
+         //Retrieve the value of the current register
+         error = modbusServerReadInputReg(connection, address + i, &value);
+         //Convert the value to network byte order
+         STORE16BE(value, values + i * 2);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Write a block of contiguous registers
+ * @param[in] connection Pointer to the client connection
+ * @param[in] address Address of the first register
+ * @param[in] quantity Number of registers to be written
+ * @param[in] values Desired register values, in network byte order
+ * @param[in] commit This flag indicates the current phase (validation phase
+ *   or write phase if the validation was successful)
+ * @return Error code
+ **/
+
+error_t modbusServerWriteRegs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, const uint8_t *values, bool_t commit)
+{
+   error_t error;
+   uint_t i;
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+   ModbusServerContext *context;
+   ModbusServerRegMap *regMap;
+
+   //Point to the Modbus/TCP server context
+   context = connection->context;
+   //Point to the register map
+   regMap = context->regMap;
+
+   //Are the holding registers mapped into memory?
+   if(regMap != NULL && modbusServerCheckRegMapRange(regMap->holdingRegs,
+      regMap->holdingRegAddr, regMap->numHoldingRegs, address, quantity))
+   {
+      //Write phase?
+      if(commit)
+      {
+         //Point to the first register
+         address -= regMap->holdingRegAddr;
+
+         //Copy the register values to the register map
+         for(i = 0; i < quantity; i++)
+         {
+            regMap->holdingRegs[address + i] = LOAD16BE(values + i * 2);
+         }
+      }
+
+      //Successful write operation
+      error = NO_ERROR;
+   }
+   else if(context->writeRegsCallback != NULL &&
+      quantity <= arraysize(connection->regValues))
+   {
+      //Convert the values to host byte order
+      for(i = 0; i < quantity; i++)
+      {
+         connection->regValues[i] = LOAD16BE(values + i * 2);
+      }
+
+      //Invoke user callback function
+      error = context->writeRegsCallback(connection, address, quantity,
+         connection->regValues, commit);
+   }
+   else
+#endif
+   {
+      //Initialize status code
+      error = NO_ERROR;
+
+      //Write the specified number of registers
+      for(i = 0; i < quantity && !error; i++)
+      {
+         //Write the value of the current register
+         error = modbusServerWriteReg(connection, address + i,
+            LOAD16BE(values + i * 2), commit);
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+//Block access supported?
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+
+/**
+ * @brief Check whether a range of items is covered by the register map
+ * @param[in] table Pointer to the memory area backing the table
+ * @param[in] tableAddr Address of the first item of the table
+ * @param[in] tableSize Number of items in the table
+ * @param[in] address Address of the first item to be accessed
+ * @param[in] quantity Number of items to be accessed
+ * @return TRUE if the whole range is mapped into memory, else FALSE
+ **/
+
+bool_t modbusServerCheckRegMapRange(const void *table, uint16_t tableAddr,
+   uint16_t tableSize, uint16_t address, uint_t quantity)
+{
+   bool_t res;
+
+   //The table must be backed by a memory area and the requested items must
+   //lie entirely within the table
+   if(table != NULL && address >= tableAddr &&
+      ((uint32_t) address + quantity) <= ((uint32_t) tableAddr + tableSize))
+   {
+      res = TRUE;
+   }
+   else
+   {
+      res = FALSE;
+   }
+
+   //Return TRUE if the whole range is mapped into memory
+   return res;
+}
+
+
+/**
+ * @brief Copy a sequence of packed coil states
+ * @param[out] dest Destination bit array
+ * @param[in] destOffset Bit offset in the destination array
+ * @param[in] src Source bit array
+ * @param[in] srcOffset Bit offset in the source array
+ * @param[in] quantity Number of coils to be copied
+ **/
+
+void modbusServerCopyCoils(uint8_t *dest, uint_t destOffset,
+   const uint8_t *src, uint_t srcOffset, uint_t quantity)
+{
+   uint_t i;
+   uint_t n;
+
+   //Byte-aligned bit arrays can be copied a whole byte at a time
+   if((destOffset % 8) == 0 && (srcOffset % 8) == 0)
+   {
+      //Number of whole bytes to copy
+      n = quantity / 8;
+      //Copy whole bytes
+      osMemcpy(dest + destOffset / 8, src + srcOffset / 8, n);
+      //Number of bits copied so far
+      i = n * 8;
+   }
+   else
+   {
+      //Copy the sequence bit by bit
+      i = 0;
+   }
+
+   //Copy the remaining bits
+   for(; i < quantity; i++)
+   {
+      if(MODBUS_TEST_COIL(src, srcOffset + i))
+      {
+         MODBUS_SET_COIL(dest, destOffset + i);
+      }
+      else
+      {
+         MODBUS_RESET_COIL(dest, destOffset + i);
+      }
+   }
+}
+
+#endif
+
+
 /**
  * @brief Translate exception code
  * @param[in] status Status code
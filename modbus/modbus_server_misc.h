@@ -48,6 +48,10 @@ void modbusServerRegisterConnectionEvents(ModbusClientConnection *connection,
 
 void modbusServerProcessConnectionEvents(ModbusClientConnection *connection);
 
+#if (MODBUS_SERVER_BATCH_SUPPORT == ENABLED)
+error_t modbusServerProcessRequestBatch(ModbusClientConnection *connection);
+#endif
+
 error_t modbusServerParseMbapHeader(ModbusClientConnection *connection);
 
 error_t modbusServerFormatMbapHeader(ModbusClientConnection *connection,
@@ -79,6 +83,34 @@ error_t modbusServerReadInputReg(ModbusClientConnection *connection,
 error_t modbusServerWriteReg(ModbusClientConnection *connection,
    uint16_t address, uint16_t value, bool_t commit);
 
+error_t modbusServerReadCoils(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *states);
+
+error_t modbusServerReadDiscreteInputs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *states);
+
+error_t modbusServerWriteCoils(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, const uint8_t *states, bool_t commit);
+
+error_t modbusServerReadHoldingRegs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *values);
+
+error_t modbusServerReadInputRegs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, uint8_t *values);
+
+error_t modbusServerWriteRegs(ModbusClientConnection *connection,
+   uint16_t address, uint_t quantity, const uint8_t *values, bool_t commit);
+
+#if (MODBUS_SERVER_BLOCK_SUPPORT == ENABLED)
+
+bool_t modbusServerCheckRegMapRange(const void *table, uint16_t tableAddr,
+   uint16_t tableSize, uint16_t address, uint_t quantity);
+
+void modbusServerCopyCoils(uint8_t *dest, uint_t destOffset,
+   const uint8_t *src, uint_t srcOffset, uint_t quantity);
+
+#endif
+
 ModbusExceptionCode modbusServerTranslateExceptionCode(error_t status);
 
 //C++ guard
@@ -241,15 +241,10 @@ error_t modbusServerProcessReadCoilsReq(ModbusClientConnection *connection,
    const ModbusReadCoilsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t quantity;
    uint16_t address;
-   bool_t state;
    ModbusReadCoilsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusReadCoilsReq))
       return ERROR_INVALID_LENGTH;
@@ -281,26 +276,8 @@ error_t modbusServerProcessReadCoilsReq(ModbusClientConnection *connection,
    modbusServerLock(connection);
 
    //Read the specified number of coils
-   for(i = 0; i < quantity && !error; i++)
-   {
-      //Retrieve the state of the current coil
-      error = modbusServerReadCoil(connection, address + i, &state);
-
-      //Successful read operation?
-      if(!error)
-      {
-         //The coils in the response message are packed as one coil per bit
-         //of the data field
-         if(state)
-         {
-            MODBUS_SET_COIL(response->coilStatus, i);
-         }
-         else
-         {
-            MODBUS_RESET_COIL(response->coilStatus, i);
-         }
-      }
-   }
+   error = modbusServerReadCoils(connection, address, quantity,
+      response->coilStatus);
 
    //Unlock access to Modbus table
    modbusServerUnlock(connection);
@@ -339,15 +316,10 @@ error_t modbusServerProcessReadDiscreteInputsReq(ModbusClientConnection *connect
    const ModbusReadDiscreteInputsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t address;
    uint16_t quantity;
-   bool_t state;
    ModbusReadDiscreteInputsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusReadDiscreteInputsReq))
       return ERROR_INVALID_LENGTH;
@@ -378,27 +350,9 @@ error_t modbusServerProcessReadDiscreteInputsReq(ModbusClientConnection *connect
    //Lock access to Modbus table
    modbusServerLock(connection);
 
-   //Read the specified number of coils
-   for(i = 0; i < quantity && !error; i++)
-   {
-      //Retrieve the state of the current coil
-      error = modbusServerReadDiscreteInput(connection, address + i, &state);
-
-      //Successful read operation?
-      if(!error)
-      {
-         //The coils in the response message are packed as one coil per bit
-         //of the data field
-         if(state)
-         {
-            MODBUS_SET_COIL(response->inputStatus, i);
-         }
-         else
-         {
-            MODBUS_RESET_COIL(response->inputStatus, i);
-         }
-      }
-   }
+   //Read the specified number of discrete inputs
+   error = modbusServerReadDiscreteInputs(connection, address, quantity,
+      response->inputStatus);
 
    //Unlock access to Modbus table
    modbusServerUnlock(connection);
@@ -437,15 +391,10 @@ error_t modbusServerProcessReadHoldingRegsReq(ModbusClientConnection *connection
    const ModbusReadHoldingRegsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t address;
    uint16_t quantity;
-   uint16_t value;
    ModbusReadHoldingRegsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusReadHoldingRegsReq))
       return ERROR_INVALID_LENGTH;
@@ -470,13 +419,8 @@ error_t modbusServerProcessReadHoldingRegsReq(ModbusClientConnection *connection
    modbusServerLock(connection);
 
    //Read the specified number of registers
-   for(i = 0; i < quantity && !error; i++)
-   {
-      //Retrieve the value of the current register
-      error = modbusServerReadHoldingReg(connection, address + i, &value);
-      //Convert the value to network byte order
-      response->regValue[i] = htons(value);
-   }
+   error = modbusServerReadHoldingRegs(connection, address, quantity,
+      (uint8_t *) response->regValue);
 
    //Unlock access to Modbus table
    modbusServerUnlock(connection);
@@ -515,15 +459,10 @@ error_t modbusServerProcessReadInputRegsReq(ModbusClientConnection *connection,
    const ModbusReadInputRegsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t address;
    uint16_t quantity;
-   uint16_t value;
    ModbusReadInputRegsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusReadInputRegsReq))
       return ERROR_INVALID_LENGTH;
@@ -548,13 +487,8 @@ error_t modbusServerProcessReadInputRegsReq(ModbusClientConnection *connection,
    modbusServerLock(connection);
 
    //Read the specified number of registers
-   for(i = 0; i < quantity && !error; i++)
-   {
-      //Retrieve the value of the current register
-      error = modbusServerReadInputReg(connection, address + i, &value);
-      //Convert the value to network byte order
-      response->regValue[i] = htons(value);
-   }
+   error = modbusServerReadInputRegs(connection, address, quantity,
+      (uint8_t *) response->regValue);
 
    //Unlock access to Modbus table
    modbusServerUnlock(connection);
@@ -732,14 +666,10 @@ error_t modbusServerProcessWriteMultipleCoilsReq(ModbusClientConnection *connect
    const ModbusWriteMultipleCoilsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t address;
    uint16_t quantity;
    ModbusWriteMultipleCoilsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusWriteMultipleCoilsReq))
       return ERROR_INVALID_LENGTH;
@@ -768,19 +698,15 @@ error_t modbusServerProcessWriteMultipleCoilsReq(ModbusClientConnection *connect
    modbusServerLock(connection);
 
    //Consistency check (first phase)
-   for(i = 0; i < quantity && !error; i++)
-   {
-      //Validate coil address
-      error = modbusServerWriteCoil(connection, address + i,
-         MODBUS_TEST_COIL(request->outputValue, i), FALSE);
-   }
+   error = modbusServerWriteCoils(connection, address, quantity,
+      request->outputValue, FALSE);
 
-   //Commit changes (second phase)
-   for(i = 0; i < quantity && !error; i++)
+   //Check status code
+   if(!error)
    {
-      //Force the current coil to the desired ON/OFF state
-      error = modbusServerWriteCoil(connection, address + i,
-         MODBUS_TEST_COIL(request->outputValue, i), TRUE);
+      //Commit changes (second phase)
+      error = modbusServerWriteCoils(connection, address, quantity,
+         request->outputValue, TRUE);
    }
 
    //Unlock access to Modbus table
@@ -829,14 +755,10 @@ error_t modbusServerProcessWriteMultipleRegsReq(ModbusClientConnection *connecti
    const ModbusWriteMultipleRegsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t address;
    uint16_t quantity;
    ModbusWriteMultipleRegsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusWriteMultipleRegsReq))
       return ERROR_INVALID_LENGTH;
@@ -865,19 +787,15 @@ error_t modbusServerProcessWriteMultipleRegsReq(ModbusClientConnection *connecti
    modbusServerLock(connection);
 
    //Consistency check (first phase)
-   for(i = 0; i < quantity && !error; i++)
-   {
-      //Validate register address
-      error = modbusServerWriteReg(connection, address + i,
-         ntohs(request->regValue[i]), FALSE);
-   }
+   error = modbusServerWriteRegs(connection, address, quantity,
+      (const uint8_t *) request->regValue, FALSE);
 
-   //Commit changes (second phase)
-   for(i = 0; i < quantity && !error; i++)
+   //Check status code
+   if(!error)
    {
-      //Write the value of the current register
-      error = modbusServerWriteReg(connection, address + i,
-         ntohs(request->regValue[i]), TRUE);
+      //Commit changes (second phase)
+      error = modbusServerWriteRegs(connection, address, quantity,
+         (const uint8_t *) request->regValue, TRUE);
    }
 
    //Unlock access to Modbus table
@@ -1005,17 +923,12 @@ error_t modbusServerProcessReadWriteMultipleRegsReq(ModbusClientConnection *conn
    const ModbusReadWriteMultipleRegsReq *request, size_t length)
 {
    error_t error;
-   uint16_t i;
    uint16_t readAddress;
    uint16_t readQuantity;
    uint16_t writeAddress;
    uint16_t writeQuantity;
-   uint16_t value;
    ModbusReadWriteMultipleRegsResp *response;
 
-   //Initialize status code
-   error = NO_ERROR;
-
    //Malformed PDU?
    if(length < sizeof(ModbusReadWriteMultipleRegsReq))
       return ERROR_INVALID_LENGTH;
@@ -1059,29 +972,23 @@ error_t modbusServerProcessReadWriteMultipleRegsReq(ModbusClientConnection *conn
    modbusServerLock(connection);
 
    //Consistency check (first phase)
-   for(i = 0; i < writeQuantity && !error; i++)
-   {
-      //Validate register address
-      error = modbusServerWriteReg(connection, writeAddress + i,
-         ntohs(request->writeRegValue[i]), FALSE);
-   }
+   error = modbusServerWriteRegs(connection, writeAddress, writeQuantity,
+      (const uint8_t *) request->writeRegValue, FALSE);
 
-   //Commit changes (second phase)
-   for(i = 0; i < writeQuantity && !error; i++)
+   //Check status code
+   if(!error)
    {
-      //Write the value of the current register
-      error = modbusServerWriteReg(connection, writeAddress + i,
-         ntohs(request->writeRegValue[i]), TRUE);
+      //Commit changes (second phase)
+      error = modbusServerWriteRegs(connection, writeAddress, writeQuantity,
+         (const uint8_t *) request->writeRegValue, TRUE);
    }
 
-   //Read the specified number of registers
-   for(i = 0; i < readQuantity && !error; i++)
+   //Check status code
+   if(!error)
    {
-      //Retrieve the value of the current register
-      error = modbusServerReadHoldingReg(connection, readAddress + i, &value);
-
-      //Convert the value to network byte order
-      response->readRegValue[i] = htons(value);
+      //Read the specified number of registers
+      error = modbusServerReadHoldingRegs(connection, readAddress,
+         readQuantity, (uint8_t *) response->readRegValue);
    }
 
    //Unlock access to Modbus table
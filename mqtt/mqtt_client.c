@@ -89,6 +89,12 @@ error_t mqttClientInit(MqttClientContext *context)
    //Initialize packet identifier
    context->packetId = 0;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //Default values until a CONNACK packet is received
+   context->serverReceiveMax = UINT16_MAX;
+   context->serverMaxQos = MQTT_QOS_LEVEL_2;
+#endif
+
    //Successful initialization
    return NO_ERROR;
 }
@@ -131,7 +137,7 @@ error_t mqttClientRegisterCallbacks(MqttClientContext *context,
 /**
  * @brief Set the MQTT protocol version to be used
  * @param[in] context Pointer to the MQTT client context
- * @param[in] version MQTT protocol version (3.1 or 3.1.1)
+ * @param[in] version MQTT protocol version (3.1, 3.1.1 or 5.0)
  * @return Error code
  **/
 
@@ -141,6 +147,12 @@ error_t mqttClientSetVersion(MqttClientContext *context, MqttVersion version)
    if(context == NULL)
       return ERROR_INVALID_PARAMETER;
 
+#if (MQTT_CLIENT_V5_SUPPORT == DISABLED)
+   //MQTT 5.0 support is disabled
+   if(version == MQTT_VERSION_5_0)
+      return ERROR_INVALID_VERSION;
+#endif
+
    //Save the MQTT protocol version to be used
    context->settings.version = version;
 
@@ -378,6 +390,34 @@ error_t mqttClientSetAuthInfo(MqttClientContext *context,
 }
 
 
+/**
+ * @brief Set the session expiry interval (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] interval Time, in seconds, during which the server keeps the
+ *   session state after the network connection is closed
+ * @return Error code
+ **/
+
+error_t mqttClientSetSessionExpiryInterval(MqttClientContext *context,
+   uint32_t interval)
+{
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //Make sure the MQTT client context is valid
+   if(context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Save session expiry interval
+   context->settings.sessionExpiryInterval = interval;
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief Specify the Will message
  * @param[in] context Pointer to the MQTT client context
@@ -496,6 +536,13 @@ error_t mqttClientConnect(MqttClientContext *context,
             TRACE_INFO("MQTT: Connecting to server %s port %" PRIu16 "...\r\n",
                ipAddrToString(serverIpAddr, NULL), serverPort);
 
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+            //Discard any data left over from a previous connection
+            context->rxBufferPos = 0;
+            context->rxBufferLen = 0;
+            context->rxStreamRemaining = 0;
+#endif
+
             //The network connection is open
             mqttClientChangeState(context, MQTT_CLIENT_STATE_CONNECTING);
             //Save current time
@@ -520,6 +567,18 @@ error_t mqttClientConnect(MqttClientContext *context,
       }
       else if(context->state == MQTT_CLIENT_STATE_CONNECTED)
       {
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+         //Topic aliases and server capabilities only apply to a single
+         //network connection
+         context->reasonCode = MQTT_REASON_CODE_SUCCESS;
+         context->serverReceiveMax = UINT16_MAX;
+         context->serverTopicAliasMax = 0;
+         context->serverMaxPacketSize = 0;
+         context->serverMaxQos = MQTT_QOS_LEVEL_2;
+         context->numTxTopicAliases = 0;
+         osMemset(context->rxTopicAliases, 0, sizeof(context->rxTopicAliases));
+#endif
+
          //Format CONNECT packet
          error = mqttClientFormatConnect(context, cleanSession);
 
@@ -560,6 +619,11 @@ error_t mqttClientConnect(MqttClientContext *context,
          context->packetType = MQTT_PACKET_TYPE_INVALID;
          //A CONNACK packet has been received
          mqttClientChangeState(context, MQTT_CLIENT_STATE_IDLE);
+
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+         //Retransmit unacknowledged PUBLISH and PUBREL packets
+         mqttClientResumeInflight(context, cleanSession);
+#endif
       }
       else if(context->state == MQTT_CLIENT_STATE_IDLE)
       {
@@ -680,11 +744,32 @@ error_t mqttClientPublishEx(MqttClientContext *context, const char_t *topic,
       if(context->state == MQTT_CLIENT_STATE_IDLE)
       {
          //Check for transmission completion
-         if(context->packetType == MQTT_PACKET_TYPE_INVALID)
+         if(context->packetType != MQTT_PACKET_TYPE_INVALID)
          {
+            //Reset packet type
+            context->packetType = MQTT_PACKET_TYPE_INVALID;
+            //We are done
+            break;
+         }
+         else if(qos != MQTT_QOS_LEVEL_0 && !mqttClientCheckSendQuota(context))
+         {
+            //The Receive Maximum of the server has been reached. Wait for
+            //an outstanding QoS 1 or QoS 2 message to be acknowledged
+            error = mqttClientProcessEvents(context, context->settings.timeout);
+         }
+         else
+         {
+            //Each time a client sends a new PUBLISH packet it must assign it
+            //a currently unused packet identifier
+            if(qos != MQTT_QOS_LEVEL_0)
+            {
+               context->packetId = mqttClientGeneratePacketId(context,
+                  context->packetId);
+            }
+
             //Format PUBLISH packet
             error = mqttClientFormatPublish(context, topic, message, length,
-               dup, qos, retain);
+               context->packetId, dup, qos, retain);
 
             //Check status code
             if(!error)
@@ -713,13 +798,6 @@ error_t mqttClientPublishEx(MqttClientContext *context, const char_t *topic,
                context->startTime = osGetSystemTime();
             }
          }
-         else
-         {
-            //Reset packet type
-            context->packetType = MQTT_PACKET_TYPE_INVALID;
-            //We are done
-            break;
-         }
       }
       else if(context->state == MQTT_CLIENT_STATE_SENDING_PACKET)
       {
@@ -758,6 +836,18 @@ error_t mqttClientPublishEx(MqttClientContext *context, const char_t *topic,
       {
          //A PUBACK/PUBCOMP packet has been received
          mqttClientChangeState(context, MQTT_CLIENT_STATE_IDLE);
+
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+         //The message has been rejected by the server?
+         if(context->settings.version == MQTT_VERSION_5_0 &&
+            context->reasonCode >= MQTT_REASON_CODE_UNSPECIFIED_ERROR)
+         {
+            //Reset packet type
+            context->packetType = MQTT_PACKET_TYPE_INVALID;
+            //Report an error
+            error = ERROR_REQUEST_REJECTED;
+         }
+#endif
       }
       else
       {
@@ -778,6 +868,118 @@ error_t mqttClientPublishEx(MqttClientContext *context, const char_t *topic,
 }
 
 
+/**
+ * @brief Queue a message for asynchronous publishing
+ *
+ * The PUBLISH packet is stored in the in-flight table and sent by
+ * mqttClientTask, so that up to MQTT_CLIENT_MAX_INFLIGHT messages can await
+ * acknowledgment at the same time. The publish completion callback is
+ * invoked once the message has been sent (QoS 0) or acknowledged (QoS 1
+ * and 2). Unacknowledged messages are retransmitted upon reconnection
+ *
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] topic Topic name
+ * @param[in] message Message payload
+ * @param[in] length Length of the message payload
+ * @param[in] qos QoS level to be used when publishing the message
+ * @param[in] retain This flag specifies if the message is to be retained
+ * @param[out] packetId Packet identifier assigned to the message (optional
+ *   parameter)
+ * @return Error code (ERROR_WOULD_BLOCK if the in-flight window is full)
+ **/
+
+error_t mqttClientPublishAsync(MqttClientContext *context, const char_t *topic,
+   const void *message, size_t length, MqttQosLevel qos, bool_t retain,
+   uint16_t *packetId)
+{
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   uint_t i;
+   size_t n;
+   MqttClientInflightEntry *entry;
+
+   //Check parameters
+   if(context == NULL || topic == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   if(message == NULL && length != 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check QoS level
+   if(qos != MQTT_QOS_LEVEL_0 && qos != MQTT_QOS_LEVEL_1 &&
+      qos != MQTT_QOS_LEVEL_2)
+   {
+      return ERROR_INVALID_PARAMETER;
+   }
+
+   //Loop through the in-flight packets
+   for(i = 0; i < MQTT_CLIENT_MAX_INFLIGHT; i++)
+   {
+      //Check whether the current entry is available
+      if(context->inflight[i].state == MQTT_CLIENT_INFLIGHT_STATE_FREE)
+         break;
+   }
+
+   //The in-flight window is full?
+   if(i >= MQTT_CLIENT_MAX_INFLIGHT)
+      return ERROR_WOULD_BLOCK;
+
+   //Point to the free entry
+   entry = &context->inflight[i];
+   //Length of the topic name
+   n = osStrlen(topic);
+
+   //The entry holds the topic name and the payload. The PUBLISH packet is
+   //formatted at transmission time
+   if((n + 1 + length) > MQTT_CLIENT_INFLIGHT_PACKET_SIZE)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Check QoS level
+   if(qos != MQTT_QOS_LEVEL_0)
+   {
+      //Each time a client sends a new PUBLISH packet it must assign it
+      //a currently unused packet identifier
+      context->inflightPacketId = mqttClientGeneratePacketId(context,
+         context->inflightPacketId);
+
+      //Save packet identifier
+      entry->packetId = context->inflightPacketId;
+   }
+   else
+   {
+      //No packet identifier
+      entry->packetId = 0;
+   }
+
+   //Copy the topic name, including the terminating NULL character
+   osMemcpy(entry->data, topic, n + 1);
+   //Copy the message payload
+   osMemcpy(entry->data + n + 1, message, length);
+
+   //Save message parameters
+   entry->length = length;
+   entry->qos = qos;
+   entry->retain = retain;
+   entry->dup = FALSE;
+   //Preserve the order in which messages are published
+   entry->sequence = ++context->inflightSequence;
+   //The packet is waiting for transmission
+   entry->state = MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_PENDING;
+
+   //Return the packet identifier assigned to the message
+   if(packetId != NULL)
+   {
+      *packetId = entry->packetId;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief Subscribe to topic
  * @param[in] context Pointer to the MQTT client context
@@ -875,6 +1077,17 @@ error_t mqttClientSubscribe(MqttClientContext *context, const char_t *topic,
       {
          //A SUBACK packet has been received
          mqttClientChangeState(context, MQTT_CLIENT_STATE_IDLE);
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+         //The request has been rejected by the server?
+         if(context->settings.version == MQTT_VERSION_5_0 &&
+            context->reasonCode >= MQTT_REASON_CODE_UNSPECIFIED_ERROR)
+         {
+            //Reset packet type
+            context->packetType = MQTT_PACKET_TYPE_INVALID;
+            //Report an error
+            error = ERROR_REQUEST_REJECTED;
+         }
+#endif
       }
       else
       {
@@ -990,6 +1203,17 @@ error_t mqttClientUnsubscribe(MqttClientContext *context, const char_t *topic,
       {
          //An UNSUBACK packet has been received
          mqttClientChangeState(context, MQTT_CLIENT_STATE_IDLE);
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+         //The request has been rejected by the server?
+         if(context->settings.version == MQTT_VERSION_5_0 &&
+            context->reasonCode >= MQTT_REASON_CODE_UNSPECIFIED_ERROR)
+         {
+            //Reset packet type
+            context->packetType = MQTT_PACKET_TYPE_INVALID;
+            //Report an error
+            error = ERROR_REQUEST_REJECTED;
+         }
+#endif
       }
       else
       {
@@ -1124,6 +1348,34 @@ error_t mqttClientPing(MqttClientContext *context, systime_t *rtt)
 }
 
 
+/**
+ * @brief Retrieve the reason code of the last acknowledgment (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[out] reasonCode Reason code received in the last CONNACK, PUBACK,
+ *   PUBREC, PUBCOMP, SUBACK, UNSUBACK or DISCONNECT packet
+ * @return Error code
+ **/
+
+error_t mqttClientGetReasonCode(MqttClientContext *context,
+   uint8_t *reasonCode)
+{
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //Check parameters
+   if(context == NULL || reasonCode == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Return the reason code
+   *reasonCode = context->reasonCode;
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief Process MQTT client events
  * @param[in] context Pointer to the MQTT client context
@@ -42,6 +42,13 @@
    #error MQTT_CLIENT_SUPPORT parameter is not valid
 #endif
 
+//MQTT 5.0 support
+#ifndef MQTT_CLIENT_V5_SUPPORT
+   #define MQTT_CLIENT_V5_SUPPORT DISABLED
+#elif (MQTT_CLIENT_V5_SUPPORT != ENABLED && MQTT_CLIENT_V5_SUPPORT != DISABLED)
+   #error MQTT_CLIENT_V5_SUPPORT parameter is not valid
+#endif
+
 //MQTT over TLS
 #ifndef MQTT_CLIENT_TLS_SUPPORT
    #define MQTT_CLIENT_TLS_SUPPORT DISABLED
@@ -126,6 +133,55 @@
    #error MQTT_CLIENT_BUFFER_SIZE parameter is not valid
 #endif
 
+//Asynchronous publishing with an in-flight window
+#ifndef MQTT_CLIENT_INFLIGHT_SUPPORT
+   #define MQTT_CLIENT_INFLIGHT_SUPPORT DISABLED
+#elif (MQTT_CLIENT_INFLIGHT_SUPPORT != ENABLED && MQTT_CLIENT_INFLIGHT_SUPPORT != DISABLED)
+   #error MQTT_CLIENT_INFLIGHT_SUPPORT parameter is not valid
+#endif
+
+//Maximum number of in-flight PUBLISH packets
+#ifndef MQTT_CLIENT_MAX_INFLIGHT
+   #define MQTT_CLIENT_MAX_INFLIGHT 8
+#elif (MQTT_CLIENT_MAX_INFLIGHT < 1)
+   #error MQTT_CLIENT_MAX_INFLIGHT parameter is not valid
+#endif
+
+//Size of the buffer holding the topic and payload of an in-flight message
+#ifndef MQTT_CLIENT_INFLIGHT_PACKET_SIZE
+   #define MQTT_CLIENT_INFLIGHT_PACKET_SIZE 256
+#elif (MQTT_CLIENT_INFLIGHT_PACKET_SIZE < 16)
+   #error MQTT_CLIENT_INFLIGHT_PACKET_SIZE parameter is not valid
+#endif
+
+//Number of topic aliases in each direction (MQTT 5.0)
+#ifndef MQTT_CLIENT_MAX_TOPIC_ALIASES
+   #define MQTT_CLIENT_MAX_TOPIC_ALIASES 4
+#elif (MQTT_CLIENT_MAX_TOPIC_ALIASES < 0 || MQTT_CLIENT_MAX_TOPIC_ALIASES > 65535)
+   #error MQTT_CLIENT_MAX_TOPIC_ALIASES parameter is not valid
+#endif
+
+//Maximum length of a topic name that can be aliased (MQTT 5.0)
+#ifndef MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN
+   #define MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN 64
+#elif (MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN < 1)
+   #error MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN parameter is not valid
+#endif
+
+//Buffered reception of incoming packets
+#ifndef MQTT_CLIENT_RX_BUFFER_SUPPORT
+   #define MQTT_CLIENT_RX_BUFFER_SUPPORT DISABLED
+#elif (MQTT_CLIENT_RX_BUFFER_SUPPORT != ENABLED && MQTT_CLIENT_RX_BUFFER_SUPPORT != DISABLED)
+   #error MQTT_CLIENT_RX_BUFFER_SUPPORT parameter is not valid
+#endif
+
+//Size of the receive buffer
+#ifndef MQTT_CLIENT_RX_BUFFER_SIZE
+   #define MQTT_CLIENT_RX_BUFFER_SIZE MQTT_CLIENT_BUFFER_SIZE
+#elif (MQTT_CLIENT_RX_BUFFER_SIZE < 16)
+   #error MQTT_CLIENT_RX_BUFFER_SIZE parameter is not valid
+#endif
+
 //Application specific context
 #ifndef MQTT_CLIENT_PRIVATE_CONTEXT
    #define MQTT_CLIENT_PRIVATE_CONTEXT
@@ -171,6 +227,20 @@ typedef enum
 } MqttClientState;
 
 
+/**
+ * @brief In-flight packet states
+ **/
+
+typedef enum
+{
+   MQTT_CLIENT_INFLIGHT_STATE_FREE            = 0,
+   MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_PENDING = 1,
+   MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT    = 2,
+   MQTT_CLIENT_INFLIGHT_STATE_PUBREL_PENDING  = 3,
+   MQTT_CLIENT_INFLIGHT_STATE_PUBREL_SENT     = 4
+} MqttClientInflightState;
+
+
 /**
  * @brief CONNACK message received callback
  **/
@@ -243,6 +313,24 @@ typedef void (*MqttClientUnsubAckCallback)(MqttClientContext *context,
 typedef void (*MqttClientPingRespCallback)(MqttClientContext *context);
 
 
+/**
+ * @brief PUBLISH message received callback (payload delivered in chunks)
+ **/
+
+typedef void (*MqttClientPublishStreamCallback)(MqttClientContext *context,
+   const char_t *topic, const uint8_t *data, size_t length, size_t offset,
+   size_t totalLength, bool_t dup, MqttQosLevel qos, bool_t retain,
+   uint16_t packetId);
+
+
+/**
+ * @brief Asynchronous publish completion callback
+ **/
+
+typedef void (*MqttClientPublishCompleteCallback)(MqttClientContext *context,
+   uint16_t packetId, error_t status);
+
+
 //TLS supported?
 #if (MQTT_CLIENT_TLS_SUPPORT == ENABLED)
 
@@ -285,6 +373,12 @@ typedef struct
    MqttClientPubAckCallback subAckCallback;     ///<SUBACK message received callback
    MqttClientPubAckCallback unsubAckCallback;   ///<UNSUBACK message received callback
    MqttClientPingRespCallback pingRespCallback; ///<PINGRESP message received callback
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+   MqttClientPublishStreamCallback publishStreamCallback; ///<Oversized PUBLISH message received callback
+#endif
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   MqttClientPublishCompleteCallback publishCompleteCallback; ///<Asynchronous publish completion callback
+#endif
 #if (MQTT_CLIENT_TLS_SUPPORT == ENABLED)
    MqttClientTlsInitCallback tlsInitCallback;   ///<TLS initialization callback
 #endif
@@ -309,9 +403,39 @@ typedef struct
    char_t username[MQTT_CLIENT_MAX_USERNAME_LEN + 1]; ///<User name
    char_t password[MQTT_CLIENT_MAX_PASSWORD_LEN + 1]; ///<Password
    MqttClientWillMessage willMessage;                 ///<Will message
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   uint32_t sessionExpiryInterval;                    ///<Session expiry interval, in seconds (MQTT 5.0)
+#endif
 } MqttClientSettings;
 
 
+/**
+ * @brief In-flight PUBLISH packet
+ **/
+
+typedef struct
+{
+   MqttClientInflightState state;                  ///<State of the entry
+   MqttQosLevel qos;                               ///<QoS level of the message
+   bool_t retain;                                  ///<RETAIN flag
+   bool_t dup;                                     ///<DUP flag
+   uint16_t packetId;                              ///<Packet identifier
+   uint32_t sequence;                              ///<Sequence number used to preserve ordering
+   size_t length;                                  ///<Length of the message payload
+   char_t data[MQTT_CLIENT_INFLIGHT_PACKET_SIZE];  ///<Topic name (NULL-terminated) followed by the payload
+} MqttClientInflightEntry;
+
+
+/**
+ * @brief Topic alias (MQTT 5.0)
+ **/
+
+typedef struct
+{
+   char_t topic[MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN + 1]; ///<Topic name
+} MqttClientTopicAlias;
+
+
 /**
  * @brief MQTT client context
  **/
@@ -339,6 +463,35 @@ struct _MqttClientContext
    MqttPacketType packetType;               ///<Control packet type
    uint16_t packetId;                       ///<Packet identifier
    size_t remainingLen;                     ///<Length of the variable header and payload
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+   uint8_t rxBuffer[MQTT_CLIENT_RX_BUFFER_SIZE]; ///<Receive buffer
+   size_t rxBufferPos;                      ///<Position of the first unprocessed byte
+   size_t rxBufferLen;                      ///<Number of bytes in the receive buffer
+   size_t rxStreamHeaderLen;                ///<Length of the header of the PUBLISH packet being streamed
+   size_t rxStreamOffset;                   ///<Offset of the next payload chunk
+   size_t rxStreamRemaining;                ///<Number of payload bytes that remain to be received
+   const char_t *rxStreamTopic;             ///<Topic name of the PUBLISH packet being streamed
+   bool_t rxStreamDup;                      ///<DUP flag of the PUBLISH packet being streamed
+   MqttQosLevel rxStreamQos;                ///<QoS level of the PUBLISH packet being streamed
+   bool_t rxStreamRetain;                   ///<RETAIN flag of the PUBLISH packet being streamed
+   uint16_t rxStreamPacketId;               ///<Packet identifier of the PUBLISH packet being streamed
+#endif
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   MqttClientInflightEntry inflight[MQTT_CLIENT_MAX_INFLIGHT]; ///<In-flight PUBLISH packets
+   uint_t inflightIndex;                    ///<In-flight packet being transmitted (index + 1)
+   uint16_t inflightPacketId;               ///<Last packet identifier assigned to an in-flight packet
+   uint32_t inflightSequence;               ///<Sequence number of the last queued packet
+#endif
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   uint8_t reasonCode;                      ///<Reason code of the last acknowledgment
+   uint16_t serverReceiveMax;               ///<Maximum number of unacknowledged QoS 1/2 messages
+   uint16_t serverTopicAliasMax;            ///<Highest topic alias accepted by the server
+   uint32_t serverMaxPacketSize;            ///<Maximum packet size accepted by the server
+   MqttQosLevel serverMaxQos;               ///<Maximum QoS level supported by the server
+   MqttClientTopicAlias txTopicAliases[MQTT_CLIENT_MAX_TOPIC_ALIASES + 1]; ///<Topic aliases (client to server)
+   uint_t numTxTopicAliases;                ///<Number of topic aliases assigned by the client
+   MqttClientTopicAlias rxTopicAliases[MQTT_CLIENT_MAX_TOPIC_ALIASES + 1]; ///<Topic aliases (server to client)
+#endif
    MQTT_CLIENT_PRIVATE_CONTEXT              ///<Application specific context
 };
 
@@ -377,6 +530,9 @@ error_t mqttClientSetIdentifier(MqttClientContext *context,
 error_t mqttClientSetAuthInfo(MqttClientContext *context,
    const char_t *username, const char_t *password);
 
+error_t mqttClientSetSessionExpiryInterval(MqttClientContext *context,
+   uint32_t interval);
+
 error_t mqttClientSetWillMessage(MqttClientContext *context, const char_t *topic,
    const void *message, size_t length, MqttQosLevel qos, bool_t retain);
 
@@ -396,6 +552,10 @@ error_t mqttClientPublishEx(MqttClientContext *context, const char_t *topic,
    const void *message, size_t length, bool_t dup, MqttQosLevel qos,
    bool_t retain, uint16_t *packetId);
 
+error_t mqttClientPublishAsync(MqttClientContext *context, const char_t *topic,
+   const void *message, size_t length, MqttQosLevel qos, bool_t retain,
+   uint16_t *packetId);
+
 error_t mqttClientSubscribe(MqttClientContext *context, const char_t *topic,
    MqttQosLevel qos, uint16_t *packetId);
 
@@ -404,6 +564,9 @@ error_t mqttClientUnsubscribe(MqttClientContext *context, const char_t *topic,
 
 error_t mqttClientPing(MqttClientContext *context, systime_t *rtt);
 
+error_t mqttClientGetReasonCode(MqttClientContext *context,
+   uint8_t *reasonCode);
+
 error_t mqttClientTask(MqttClientContext *context, systime_t timeout);
 
 error_t mqttClientDisconnect(MqttClientContext *context);
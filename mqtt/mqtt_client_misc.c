@@ -80,35 +80,76 @@ error_t mqttClientProcessEvents(MqttClientContext *context, systime_t timeout)
       if(context->state == MQTT_CLIENT_STATE_IDLE ||
          context->state == MQTT_CLIENT_STATE_PACKET_SENT)
       {
-         //Wait for incoming data
-         error = mqttClientWaitForData(context, timeout);
-
-         //Check status code
-         if(!error)
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+         //Any queued PUBLISH or PUBREL packet ready to be sent?
+         if(mqttClientPrepareInflight(context))
          {
-            //Initialize context
-            context->packet = context->buffer;
-            context->packetPos = 0;
-            context->packetLen = 0;
-            context->remainingLen = 0;
-
-            //Start receiving the packet
+            //Send the in-flight packet
+            mqttClientChangeState(context, MQTT_CLIENT_STATE_SENDING_PACKET);
+         }
+         else
+#endif
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+         //Any data left in the receive buffer?
+         if(context->rxBufferPos < context->rxBufferLen)
+         {
+            //Process the next packet without waiting for the transport layer
             mqttClientChangeState(context, MQTT_CLIENT_STATE_RECEIVING_PACKET);
          }
+         else
+#endif
+         {
+            //Wait for incoming data
+            error = mqttClientWaitForData(context, timeout);
+
+            //Check status code
+            if(!error)
+            {
+               //Initialize context
+               context->packet = context->buffer;
+               context->packetPos = 0;
+               context->packetLen = 0;
+               context->remainingLen = 0;
+
+               //Start receiving the packet
+               mqttClientChangeState(context, MQTT_CLIENT_STATE_RECEIVING_PACKET);
+            }
+         }
       }
       else if(context->state == MQTT_CLIENT_STATE_RECEIVING_PACKET)
       {
-         //Receive the incoming packet
-         error = mqttClientReceivePacket(context);
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+         //Payload of an oversized PUBLISH packet being received?
+         if(context->rxStreamRemaining > 0)
+         {
+            //Pass the next chunk of the payload to the application
+            error = mqttClientReceivePublishData(context);
+         }
+         else
+#endif
+         {
+            //Receive the incoming packet
+            error = mqttClientReceivePacket(context);
+
+            //Check status code
+            if(!error)
+            {
+               //Process MQTT control packet
+               error = mqttClientProcessPacket(context);
+            }
+         }
 
          //Check status code
          if(!error)
          {
-            //Process MQTT control packet
-            error = mqttClientProcessPacket(context);
-
-            //Update MQTT client state
+            //Update MQTT client state, unless the payload of an oversized
+            //PUBLISH packet is still being received
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+            if(context->state == MQTT_CLIENT_STATE_RECEIVING_PACKET &&
+               context->rxStreamRemaining == 0)
+#else
             if(context->state == MQTT_CLIENT_STATE_RECEIVING_PACKET)
+#endif
             {
                if(context->packetType == MQTT_PACKET_TYPE_INVALID)
                {
@@ -138,6 +179,11 @@ error_t mqttClientProcessEvents(MqttClientContext *context, systime_t timeout)
             //Save the time at which the message was sent
             context->keepAliveTimestamp = osGetSystemTime();
 
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+            //Update the state of the in-flight packet, if any
+            mqttClientProcessInflightTx(context);
+#endif
+
             //Update MQTT client state
             if(context->packetType == MQTT_PACKET_TYPE_INVALID)
             {
@@ -432,6 +478,88 @@ error_t mqttSerializeData(uint8_t *buffer, size_t bufferLen,
 }
 
 
+/**
+ * @brief Write a 32-bit integer to the output buffer
+ * @param[in] buffer Pointer to the output buffer
+ * @param[in] bufferLen Maximum number of bytes the output buffer can hold
+ * @param[in,out] pos Current position
+ * @param[in] value 32-bit integer to be serialized
+ * @return Error code
+ **/
+
+error_t mqttSerializeLong(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint32_t value)
+{
+   size_t n;
+
+   //Point to the current position
+   n = *pos;
+
+   //Make sure the output buffer is large enough
+   if((n + sizeof(uint32_t)) > bufferLen)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Write the integer to the output buffer
+   STORE32BE(value, buffer + n);
+
+   //Advance current position
+   *pos = n + sizeof(uint32_t);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Serialize an integer property (MQTT 5.0)
+ * @param[in] buffer Pointer to the output buffer
+ * @param[in] bufferLen Maximum number of bytes the output buffer can hold
+ * @param[in,out] pos Current position
+ * @param[in] id Property identifier
+ * @param[in] value Value of the property
+ * @return Error code
+ **/
+
+error_t mqttSerializeProperty(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint8_t id, uint32_t value)
+{
+   error_t error;
+
+   //Write the property identifier
+   error = mqttSerializeByte(buffer, bufferLen, pos, id);
+
+   //Check status code
+   if(!error)
+   {
+      //The size of the value depends on the property
+      switch(id)
+      {
+      //Two Byte Integer?
+      case MQTT_PROP_SERVER_KEEP_ALIVE:
+      case MQTT_PROP_RECEIVE_MAXIMUM:
+      case MQTT_PROP_TOPIC_ALIAS_MAXIMUM:
+      case MQTT_PROP_TOPIC_ALIAS:
+         error = mqttSerializeShort(buffer, bufferLen, pos, (uint16_t) value);
+         break;
+      //Four Byte Integer?
+      case MQTT_PROP_MESSAGE_EXPIRY_INTERVAL:
+      case MQTT_PROP_SESSION_EXPIRY_INTERVAL:
+      case MQTT_PROP_WILL_DELAY_INTERVAL:
+      case MQTT_PROP_MAXIMUM_PACKET_SIZE:
+         error = mqttSerializeLong(buffer, bufferLen, pos, value);
+         break;
+      //Byte?
+      default:
+         error = mqttSerializeByte(buffer, bufferLen, pos, (uint8_t) value);
+         break;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
 /**
  * @brief Deserialize fixed header
  * @param[in] buffer Pointer to the input buffer
@@ -618,6 +746,192 @@ error_t mqttDeserializeString(uint8_t *buffer, size_t bufferLen,
 }
 
 
+/**
+ * @brief Read a 32-bit integer from the input buffer
+ * @param[in] buffer Pointer to the input buffer
+ * @param[in] bufferLen Length of the input buffer
+ * @param[in,out] pos Current position
+ * @param[out] value Value of the 32-bit integer
+ * @return Error code
+ **/
+
+error_t mqttDeserializeLong(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint32_t *value)
+{
+   size_t n;
+
+   //Point to the current position
+   n = *pos;
+
+   //Make sure the input buffer is large enough
+   if((n + sizeof(uint32_t)) > bufferLen)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Read the integer from the input buffer
+   *value = LOAD32BE(buffer + n);
+
+   //Advance current position
+   *pos = n + sizeof(uint32_t);
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Read a variable byte integer from the input buffer
+ * @param[in] buffer Pointer to the input buffer
+ * @param[in] bufferLen Length of the input buffer
+ * @param[in,out] pos Current position
+ * @param[out] value Value of the integer
+ * @return Error code
+ **/
+
+error_t mqttDeserializeVarInt(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint32_t *value)
+{
+   uint_t i;
+   size_t n;
+
+   //Point to the current position
+   n = *pos;
+   //Initialize value
+   *value = 0;
+
+   //The integer is encoded using at most 4 bytes
+   for(i = 0; i < 4; i++)
+   {
+      //Make sure the input buffer is large enough
+      if(n >= bufferLen)
+         return ERROR_BUFFER_OVERFLOW;
+
+      //The least significant seven bits of each byte encode the data
+      *value |= (buffer[n] & 0x7F) << (7 * i);
+
+      //The most significant bit is used to indicate that there are
+      //following bytes in the representation
+      if((buffer[n++] & 0x80) == 0)
+         break;
+   }
+
+   //Malformed integer?
+   if(i >= 4)
+      return ERROR_INVALID_SYNTAX;
+
+   //Advance current position
+   *pos = n;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Deserialize a property (MQTT 5.0)
+ * @param[in] buffer Pointer to the input buffer
+ * @param[in] bufferLen Length of the input buffer (end of the property list)
+ * @param[in,out] pos Current position
+ * @param[out] property Decoded property
+ * @return Error code
+ **/
+
+error_t mqttDeserializeProperty(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, MqttProperty *property)
+{
+   error_t error;
+   uint8_t value8;
+   uint16_t value16;
+   uint32_t value32;
+   char_t *data;
+
+   //Clear the structure
+   osMemset(property, 0, sizeof(MqttProperty));
+
+   //Read the property identifier
+   error = mqttDeserializeVarInt(buffer, bufferLen, pos, &value32);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Save the property identifier
+   property->id = (uint8_t) value32;
+
+   //The format of the value depends on the property
+   switch(value32)
+   {
+   //Byte?
+   case MQTT_PROP_PAYLOAD_FORMAT_INDICATOR:
+   case MQTT_PROP_REQUEST_PROBLEM_INFO:
+   case MQTT_PROP_REQUEST_RESPONSE_INFO:
+   case MQTT_PROP_MAXIMUM_QOS:
+   case MQTT_PROP_RETAIN_AVAILABLE:
+   case MQTT_PROP_WILDCARD_SUB_AVAILABLE:
+   case MQTT_PROP_SUBSCRIPTION_ID_AVAILABLE:
+   case MQTT_PROP_SHARED_SUB_AVAILABLE:
+      error = mqttDeserializeByte(buffer, bufferLen, pos, &value8);
+      property->value = value8;
+      break;
+   //Two Byte Integer?
+   case MQTT_PROP_SERVER_KEEP_ALIVE:
+   case MQTT_PROP_RECEIVE_MAXIMUM:
+   case MQTT_PROP_TOPIC_ALIAS_MAXIMUM:
+   case MQTT_PROP_TOPIC_ALIAS:
+      error = mqttDeserializeShort(buffer, bufferLen, pos, &value16);
+      property->value = value16;
+      break;
+   //Four Byte Integer?
+   case MQTT_PROP_MESSAGE_EXPIRY_INTERVAL:
+   case MQTT_PROP_SESSION_EXPIRY_INTERVAL:
+   case MQTT_PROP_WILL_DELAY_INTERVAL:
+   case MQTT_PROP_MAXIMUM_PACKET_SIZE:
+      error = mqttDeserializeLong(buffer, bufferLen, pos, &property->value);
+      break;
+   //Variable Byte Integer?
+   case MQTT_PROP_SUBSCRIPTION_ID:
+      error = mqttDeserializeVarInt(buffer, bufferLen, pos, &property->value);
+      break;
+   //UTF-8 Encoded String or Binary Data?
+   case MQTT_PROP_CONTENT_TYPE:
+   case MQTT_PROP_RESPONSE_TOPIC:
+   case MQTT_PROP_CORRELATION_DATA:
+   case MQTT_PROP_ASSIGNED_CLIENT_ID:
+   case MQTT_PROP_AUTH_METHOD:
+   case MQTT_PROP_AUTH_DATA:
+   case MQTT_PROP_RESPONSE_INFO:
+   case MQTT_PROP_SERVER_REFERENCE:
+   case MQTT_PROP_REASON_STRING:
+      error = mqttDeserializeString(buffer, bufferLen, pos, &data,
+         &property->length);
+      property->data = (uint8_t *) data;
+      break;
+   //UTF-8 String Pair?
+   case MQTT_PROP_USER_PROPERTY:
+      //Read the name of the user property
+      error = mqttDeserializeString(buffer, bufferLen, pos, &data,
+         &property->length);
+      property->data = (uint8_t *) data;
+
+      //Check status code
+      if(!error)
+      {
+         //Read the value of the user property
+         error = mqttDeserializeString(buffer, bufferLen, pos, &data,
+            &property->length2);
+         property->data2 = (uint8_t *) data;
+      }
+      break;
+   //Unknown property?
+   default:
+      //Report an error
+      error = ERROR_INVALID_PACKET;
+      break;
+   }
+
+   //Return status code
+   return error;
+}
+
+
 /**
  * @brief Determine whether a timeout error has occurred
  * @param[in] context Pointer to the MQTT client context
@@ -653,4 +967,779 @@ error_t mqttClientCheckTimeout(MqttClientContext *context)
 #endif
 }
 
+
+/**
+ * @brief Generate a new packet identifier
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] packetId Last packet identifier that was assigned
+ * @return Packet identifier that is not currently in use
+ **/
+
+uint16_t mqttClientGeneratePacketId(MqttClientContext *context,
+   uint16_t packetId)
+{
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   uint_t i;
+   uint_t n;
+   MqttClientInflightEntry *entry;
+
+   //An identifier may be skipped at most once per in-flight packet
+   for(n = 0; n <= (MQTT_CLIENT_MAX_INFLIGHT + 1); n++)
+   {
+      //Packet identifiers are non-zero 16-bit integers
+      packetId = (packetId < UINT16_MAX) ? packetId + 1 : 1;
+
+      //The identifier of the pending synchronous request must not be reused
+      if(context->packetType != MQTT_PACKET_TYPE_INVALID &&
+         context->packetId == packetId)
+      {
+         continue;
+      }
+
+      //Loop through the in-flight packets
+      for(i = 0; i < MQTT_CLIENT_MAX_INFLIGHT; i++)
+      {
+         //Point to the current entry
+         entry = &context->inflight[i];
+
+         //Check whether the packet identifier is in use
+         if(entry->state != MQTT_CLIENT_INFLIGHT_STATE_FREE &&
+            entry->qos != MQTT_QOS_LEVEL_0 && entry->packetId == packetId)
+         {
+            break;
+         }
+      }
+
+      //Unused packet identifier?
+      if(i >= MQTT_CLIENT_MAX_INFLIGHT)
+         break;
+   }
+#else
+   //Packet identifiers are non-zero 16-bit integers
+   packetId = (packetId < UINT16_MAX) ? packetId + 1 : 1;
+#endif
+
+   //Return the packet identifier
+   return packetId;
+}
+
+
+/**
+ * @brief Check whether another QoS 1 or QoS 2 message can be sent
+ * @param[in] context Pointer to the MQTT client context
+ * @return TRUE if the Receive Maximum of the server has not been reached
+ **/
+
+bool_t mqttClientCheckSendQuota(MqttClientContext *context)
+{
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   uint_t n;
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   uint_t i;
+   MqttClientInflightEntry *entry;
+#endif
+
+   //Flow control is only available with MQTT 5.0
+   if(context->settings.version != MQTT_VERSION_5_0)
+      return TRUE;
+
+   //Pending synchronous PUBLISH request?
+   n = (context->packetType == MQTT_PACKET_TYPE_PUBLISH) ? 1 : 0;
+
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   //Loop through the in-flight packets
+   for(i = 0; i < MQTT_CLIENT_MAX_INFLIGHT; i++)
+   {
+      //Point to the current entry
+      entry = &context->inflight[i];
+
+      //A QoS 1 or QoS 2 message is unacknowledged until the PUBACK or the
+      //PUBCOMP packet is received
+      if(entry->qos != MQTT_QOS_LEVEL_0 &&
+         (entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT ||
+         entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBREL_PENDING ||
+         entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBREL_SENT))
+      {
+         n++;
+      }
+   }
+#endif
+
+   //Check the send quota
+   return (n < context->serverReceiveMax) ? TRUE : FALSE;
+#else
+   //Flow control is not supported
+   return TRUE;
+#endif
+}
+
+
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+
+/**
+ * @brief Format CONNECT properties (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in,out] pos Current position in the output buffer
+ * @return Error code
+ **/
+
+error_t mqttClientFormatConnectProperties(MqttClientContext *context,
+   size_t *pos)
+{
+   error_t error;
+   size_t n;
+
+   //Save the position of the Property Length field
+   n = *pos;
+
+   //The properties are short enough for the Property Length field to be
+   //encoded on a single byte. Its value is updated once all the properties
+   //have been serialized
+   error = mqttSerializeByte(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+      pos, 0);
+
+   //Check status code
+   if(!error && context->settings.sessionExpiryInterval != 0)
+   {
+      //The session state is kept by the server after the network connection
+      //is closed
+      error = mqttSerializeProperty(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         pos, MQTT_PROP_SESSION_EXPIRY_INTERVAL,
+         context->settings.sessionExpiryInterval);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //The server must not send packets exceeding the size of the buffer
+      error = mqttSerializeProperty(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         pos, MQTT_PROP_MAXIMUM_PACKET_SIZE, MQTT_CLIENT_BUFFER_SIZE);
+   }
+
+   //Check status code
+   if(!error && MQTT_CLIENT_MAX_TOPIC_ALIASES > 0)
+   {
+      //Highest value that the client accepts as a topic alias sent by
+      //the server
+      error = mqttSerializeProperty(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         pos, MQTT_PROP_TOPIC_ALIAS_MAXIMUM, MQTT_CLIENT_MAX_TOPIC_ALIASES);
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Update the Property Length field
+      context->buffer[n] = (uint8_t) (*pos - n - 1);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Parse CONNACK properties (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @return Error code
+ **/
+
+error_t mqttClientParseConnAckProperties(MqttClientContext *context)
+{
+   error_t error;
+   size_t end;
+   uint32_t length;
+   MqttProperty property;
+
+   //Read the Property Length field
+   error = mqttDeserializeVarInt(context->packet, context->packetLen,
+      &context->packetPos, &length);
+
+   //Failed to deserialize the Property Length field?
+   if(error)
+      return error;
+
+   //Malformed packet?
+   if(length > (context->packetLen - context->packetPos))
+      return ERROR_INVALID_PACKET;
+
+   //Point to the end of the property list
+   end = context->packetPos + length;
+
+   //Parse the properties
+   while(context->packetPos < end)
+   {
+      //Decode the current property
+      error = mqttDeserializeProperty(context->packet, end,
+         &context->packetPos, &property);
+
+      //Failed to decode property?
+      if(error)
+         return error;
+
+      //Check property identifier
+      if(property.id == MQTT_PROP_RECEIVE_MAXIMUM)
+      {
+         //It is a protocol error to include the Receive Maximum value of 0
+         if(property.value == 0)
+            return ERROR_INVALID_PACKET;
+
+         //Save the number of QoS 1 and QoS 2 messages the server is willing
+         //to process concurrently
+         context->serverReceiveMax = (uint16_t) property.value;
+      }
+      else if(property.id == MQTT_PROP_TOPIC_ALIAS_MAXIMUM)
+      {
+         //Save the highest topic alias accepted by the server
+         context->serverTopicAliasMax = (uint16_t) property.value;
+      }
+      else if(property.id == MQTT_PROP_MAXIMUM_QOS)
+      {
+         //Save the maximum QoS level supported by the server
+         if(property.value <= MQTT_QOS_LEVEL_2)
+            context->serverMaxQos = (MqttQosLevel) property.value;
+      }
+      else if(property.id == MQTT_PROP_MAXIMUM_PACKET_SIZE)
+      {
+         //Save the maximum packet size accepted by the server
+         context->serverMaxPacketSize = property.value;
+      }
+      else if(property.id == MQTT_PROP_SERVER_KEEP_ALIVE)
+      {
+         //The client must use the keep alive value assigned by the server
+         context->settings.keepAlive = (uint16_t) property.value;
+      }
+      else
+      {
+         //Discard unused properties
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Parse PUBLISH properties (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[out] alias Topic alias (0 if not present)
+ * @return Error code
+ **/
+
+error_t mqttClientParsePublishProperties(MqttClientContext *context,
+   uint16_t *alias)
+{
+   error_t error;
+   size_t end;
+   uint32_t length;
+   MqttProperty property;
+
+   //No topic alias
+   *alias = 0;
+
+   //Read the Property Length field
+   error = mqttDeserializeVarInt(context->packet, context->packetLen,
+      &context->packetPos, &length);
+
+   //Failed to deserialize the Property Length field?
+   if(error)
+      return error;
+
+   //Malformed packet?
+   if(length > (context->packetLen - context->packetPos))
+      return ERROR_INVALID_PACKET;
+
+   //Point to the end of the property list
+   end = context->packetPos + length;
+
+   //Parse the properties
+   while(context->packetPos < end)
+   {
+      //Decode the current property
+      error = mqttDeserializeProperty(context->packet, end,
+         &context->packetPos, &property);
+
+      //Failed to decode property?
+      if(error)
+         return error;
+
+      //Topic alias?
+      if(property.id == MQTT_PROP_TOPIC_ALIAS)
+      {
+         //The server must not send a topic alias greater than the Topic
+         //Alias Maximum value sent by the client
+         if(property.value == 0 || property.value > MQTT_CLIENT_MAX_TOPIC_ALIASES)
+            return ERROR_INVALID_PACKET;
+
+         //Save the topic alias
+         *alias = (uint16_t) property.value;
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Parse the reason code of an acknowledgment (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] type Type of the acknowledgment
+ * @return Error code
+ **/
+
+error_t mqttClientParseReasonCode(MqttClientContext *context,
+   MqttPacketType type)
+{
+   error_t error;
+   uint32_t length;
+
+   //The reason code 0x00 is used when the Remaining Length is 2
+   context->reasonCode = MQTT_REASON_CODE_SUCCESS;
+
+   //SUBACK and UNSUBACK packets carry their properties before the list of
+   //reason codes
+   if(type == MQTT_PACKET_TYPE_SUBACK || type == MQTT_PACKET_TYPE_UNSUBACK)
+   {
+      //Read the Property Length field
+      error = mqttDeserializeVarInt(context->packet, context->packetLen,
+         &context->packetPos, &length);
+
+      //Failed to deserialize the Property Length field?
+      if(error)
+         return error;
+
+      //Malformed packet?
+      if(length > (context->packetLen - context->packetPos))
+         return ERROR_INVALID_PACKET;
+
+      //Properties are not used
+      context->packetPos += length;
+   }
+
+   //Any reason code?
+   if(context->packetPos < context->packetLen)
+   {
+      //Read the reason code
+      error = mqttDeserializeByte(context->packet, context->packetLen,
+         &context->packetPos, &context->reasonCode);
+   }
+   else
+   {
+      //The reason code is not present
+      error = NO_ERROR;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Select a topic alias for an outgoing PUBLISH packet (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] topic Topic name
+ * @param[out] newAlias TRUE if the mapping must be established by sending
+ *   both the topic name and the alias
+ * @return Topic alias (0 if no alias can be used)
+ **/
+
+uint_t mqttClientGetTopicAlias(MqttClientContext *context,
+   const char_t *topic, bool_t *newAlias)
+{
+   uint_t i;
+   uint_t n;
+
+   //No new mapping
+   *newAlias = FALSE;
+
+   //Topic aliases are only available with MQTT 5.0
+   if(context->settings.version != MQTT_VERSION_5_0)
+      return 0;
+
+   //Loop through the topic aliases that have already been established
+   for(i = 1; i <= context->numTxTopicAliases; i++)
+   {
+      //Matching topic name?
+      if(!osStrcmp(context->txTopicAliases[i].topic, topic))
+         return i;
+   }
+
+   //The client must not send a topic alias greater than the Topic Alias
+   //Maximum value returned by the server in the CONNACK packet
+   n = MIN(context->serverTopicAliasMax, MQTT_CLIENT_MAX_TOPIC_ALIASES);
+
+   //Any alias available?
+   if(context->numTxTopicAliases < n &&
+      osStrlen(topic) <= MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN)
+   {
+      //Assign a new topic alias
+      *newAlias = TRUE;
+      return context->numTxTopicAliases + 1;
+   }
+
+   //The full topic name must be sent
+   return 0;
+}
+
+#endif
+
+
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+
+/**
+ * @brief Select the next in-flight packet to be sent
+ *
+ * The packet is formatted in the internal buffer at transmission time, so
+ * that topic aliases and the DUP flag always reflect the current connection
+ *
+ * @param[in] context Pointer to the MQTT client context
+ * @return TRUE if a packet is ready to be sent, else FALSE
+ **/
+
+bool_t mqttClientPrepareInflight(MqttClientContext *context)
+{
+   error_t error;
+   uint_t i;
+   uint_t k;
+   uint_t m;
+   const char_t *topic;
+   MqttClientInflightEntry *entry;
+
+   //The client must not send any PUBLISH packet before the CONNACK packet
+   //has been received, nor after a DISCONNECT packet has been sent
+   if(context->packetType == MQTT_PACKET_TYPE_CONNECT ||
+      context->packetType == MQTT_PACKET_TYPE_DISCONNECT)
+   {
+      return FALSE;
+   }
+
+   //Initialize indexes
+   k = 0;
+   m = 0;
+
+   //Loop through the in-flight packets
+   for(i = 0; i < MQTT_CLIENT_MAX_INFLIGHT; i++)
+   {
+      //Point to the current entry
+      entry = &context->inflight[i];
+
+      //Packets must be sent in the order they were queued
+      if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_PENDING)
+      {
+         //Oldest PUBLISH packet waiting for transmission
+         if(k == 0 || (int32_t) (entry->sequence -
+            context->inflight[k - 1].sequence) < 0)
+         {
+            k = i + 1;
+         }
+      }
+      else if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBREL_PENDING)
+      {
+         //Oldest PUBREL packet waiting for transmission
+         if(m == 0 || (int32_t) (entry->sequence -
+            context->inflight[m - 1].sequence) < 0)
+         {
+            m = i + 1;
+         }
+      }
+      else
+      {
+         //Just for sanity
+      }
+   }
+
+   //PUBREL packets take precedence since they are not subject to flow
+   //control and complete outstanding QoS 2 exchanges
+   if(m != 0)
+   {
+      //Point to the entry
+      entry = &context->inflight[m - 1];
+
+      //Format PUBREL packet
+      error = mqttClientFormatPubRel(context, entry->packetId);
+
+      //Check status code
+      if(!error)
+      {
+         //Debug message
+         TRACE_INFO("MQTT: Sending PUBREL packet (%" PRIuSIZE " bytes)...\r\n",
+            context->packetLen);
+
+         //Wait for the PUBCOMP packet
+         entry->state = MQTT_CLIENT_INFLIGHT_STATE_PUBREL_SENT;
+      }
+
+      //Index of the entry
+      k = m;
+   }
+   else if(k != 0)
+   {
+      //Point to the entry
+      entry = &context->inflight[k - 1];
+
+      //The server may limit the number of unacknowledged QoS 1 and QoS 2
+      //messages (Receive Maximum)
+      if(entry->qos != MQTT_QOS_LEVEL_0 && !mqttClientCheckSendQuota(context))
+         return FALSE;
+
+      //The topic name is followed by the message payload
+      topic = entry->data;
+
+      //Format PUBLISH packet
+      error = mqttClientFormatPublish(context, topic,
+         entry->data + osStrlen(topic) + 1, entry->length, entry->packetId,
+         entry->dup, entry->qos, entry->retain);
+
+      //Check status code
+      if(!error)
+      {
+         //Debug message
+         TRACE_INFO("MQTT: Sending PUBLISH packet (%" PRIuSIZE " bytes)...\r\n",
+            context->packetLen);
+
+         //Wait for the PUBACK or PUBREC packet
+         entry->state = MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT;
+      }
+      else
+      {
+         //The message cannot be sent
+         entry->state = MQTT_CLIENT_INFLIGHT_STATE_FREE;
+
+         //Any registered callback?
+         if(context->callbacks.publishCompleteCallback != NULL)
+         {
+            //Invoke user callback function
+            context->callbacks.publishCompleteCallback(context,
+               entry->packetId, error);
+         }
+
+         //Do not send anything
+         return FALSE;
+      }
+   }
+   else
+   {
+      //No packet ready to be sent
+      return FALSE;
+   }
+
+   //Failed to format the packet?
+   if(error)
+      return FALSE;
+
+   //Dump the contents of the packet
+   TRACE_DEBUG_ARRAY("  ", context->packet, context->packetLen);
+
+   //Point to the beginning of the packet
+   context->packetPos = 0;
+   //Remember which entry is being transmitted
+   context->inflightIndex = k;
+
+   //A packet is ready to be sent
+   return TRUE;
+}
+
+
+/**
+ * @brief Update in-flight state once a packet has been transmitted
+ * @param[in] context Pointer to the MQTT client context
+ **/
+
+void mqttClientProcessInflightTx(MqttClientContext *context)
+{
+   MqttClientInflightEntry *entry;
+
+   //Any in-flight packet being transmitted?
+   if(context->inflightIndex != 0)
+   {
+      //Point to the corresponding entry
+      entry = &context->inflight[context->inflightIndex - 1];
+
+      //No response is sent by the receiver for QoS level 0 messages
+      if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT &&
+         entry->qos == MQTT_QOS_LEVEL_0)
+      {
+         //Release the entry
+         entry->state = MQTT_CLIENT_INFLIGHT_STATE_FREE;
+
+         //Any registered callback?
+         if(context->callbacks.publishCompleteCallback != NULL)
+         {
+            //Invoke user callback function
+            context->callbacks.publishCompleteCallback(context,
+               entry->packetId, NO_ERROR);
+         }
+      }
+
+      //The transmission is complete
+      context->inflightIndex = 0;
+   }
+}
+
+
+/**
+ * @brief Process an acknowledgment for an in-flight packet
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] type Type of the acknowledgment (PUBACK, PUBREC or PUBCOMP)
+ * @param[in] packetId Packet identifier
+ **/
+
+void mqttClientProcessInflightAck(MqttClientContext *context,
+   MqttPacketType type, uint16_t packetId)
+{
+   uint_t i;
+   bool_t complete;
+   error_t status;
+   MqttClientInflightEntry *entry;
+
+   //Loop through the in-flight packets
+   for(i = 0; i < MQTT_CLIENT_MAX_INFLIGHT; i++)
+   {
+      //Point to the current entry
+      entry = &context->inflight[i];
+
+      //Matching packet identifier?
+      if(entry->state != MQTT_CLIENT_INFLIGHT_STATE_FREE &&
+         entry->qos != MQTT_QOS_LEVEL_0 && entry->packetId == packetId)
+      {
+         break;
+      }
+   }
+
+   //No matching entry?
+   if(i >= MQTT_CLIENT_MAX_INFLIGHT)
+      return;
+
+   //Initialize variables
+   complete = FALSE;
+   status = NO_ERROR;
+
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //With MQTT 5.0, a reason code of 0x80 or greater indicates that the
+   //message has been rejected and that the protocol exchange is over
+   if(context->settings.version == MQTT_VERSION_5_0 &&
+      context->reasonCode >= MQTT_REASON_CODE_UNSPECIFIED_ERROR)
+   {
+      //Release the entry
+      complete = TRUE;
+      status = ERROR_REQUEST_REJECTED;
+   }
+   else
+#endif
+   //Check the type of the acknowledgment
+   if(type == MQTT_PACKET_TYPE_PUBACK)
+   {
+      //A PUBACK packet completes the QoS 1 protocol exchange
+      if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT &&
+         entry->qos == MQTT_QOS_LEVEL_1)
+      {
+         complete = TRUE;
+      }
+   }
+   else if(type == MQTT_PACKET_TYPE_PUBREC)
+   {
+      //The PUBREL packet is sent in response to the PUBREC packet
+      if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT &&
+         entry->qos == MQTT_QOS_LEVEL_2)
+      {
+         //Wait for the PUBCOMP packet
+         entry->state = MQTT_CLIENT_INFLIGHT_STATE_PUBREL_SENT;
+      }
+   }
+   else if(type == MQTT_PACKET_TYPE_PUBCOMP)
+   {
+      //A PUBCOMP packet completes the QoS 2 protocol exchange
+      if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBREL_SENT)
+      {
+         complete = TRUE;
+      }
+   }
+   else
+   {
+      //Just for sanity
+   }
+
+   //Protocol exchange complete?
+   if(complete)
+   {
+      //Release the entry
+      entry->state = MQTT_CLIENT_INFLIGHT_STATE_FREE;
+
+      //Any registered callback?
+      if(context->callbacks.publishCompleteCallback != NULL)
+      {
+         //Invoke user callback function
+         context->callbacks.publishCompleteCallback(context, packetId,
+            status);
+      }
+   }
+}
+
+
+/**
+ * @brief Retransmit unacknowledged in-flight packets after reconnection
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] cleanSession Clean session flag used for the new connection
+ **/
+
+void mqttClientResumeInflight(MqttClientContext *context, bool_t cleanSession)
+{
+   uint_t i;
+   MqttClientInflightEntry *entry;
+
+   //No packet is being transmitted
+   context->inflightIndex = 0;
+
+   //Loop through the in-flight packets
+   for(i = 0; i < MQTT_CLIENT_MAX_INFLIGHT; i++)
+   {
+      //Point to the current entry
+      entry = &context->inflight[i];
+
+      //Check the state of the entry
+      if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_SENT)
+      {
+         //When a client reconnects with clean session set to 0, it must re-send
+         //any unacknowledged PUBLISH packets using their original packet
+         //identifiers, with the DUP flag set
+         if(!cleanSession && entry->qos != MQTT_QOS_LEVEL_0)
+         {
+            entry->dup = TRUE;
+         }
+
+         //Queue the PUBLISH packet for retransmission
+         entry->state = MQTT_CLIENT_INFLIGHT_STATE_PUBLISH_PENDING;
+      }
+      else if(entry->state == MQTT_CLIENT_INFLIGHT_STATE_PUBREL_SENT)
+      {
+         //Check whether the session state has been discarded
+         if(cleanSession)
+         {
+            //The receiver has already taken ownership of the message
+            entry->state = MQTT_CLIENT_INFLIGHT_STATE_FREE;
+
+            //Any registered callback?
+            if(context->callbacks.publishCompleteCallback != NULL)
+            {
+               //Invoke user callback function
+               context->callbacks.publishCompleteCallback(context,
+                  entry->packetId, NO_ERROR);
+            }
+         }
+         else
+         {
+            //Queue the PUBREL packet for retransmission
+            entry->state = MQTT_CLIENT_INFLIGHT_STATE_PUBREL_PENDING;
+         }
+      }
+      else
+      {
+         //Just for sanity
+      }
+   }
+}
+
+#endif
+
 #endif
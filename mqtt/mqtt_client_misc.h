@@ -62,6 +62,12 @@ error_t mqttSerializeString(uint8_t *buffer, size_t bufferLen,
 error_t mqttSerializeData(uint8_t *buffer, size_t bufferLen,
    size_t *pos, const void *data, size_t dataLen);
 
+error_t mqttSerializeLong(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint32_t value);
+
+error_t mqttSerializeProperty(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint8_t id, uint32_t value);
+
 error_t mqttDeserializeHeader(uint8_t *buffer, size_t bufferLen, size_t *pos,
    MqttPacketType *type, bool_t *dup, MqttQosLevel *qos, bool_t *retain, size_t *remainingLen);
 
@@ -74,8 +80,44 @@ error_t mqttDeserializeShort(uint8_t *buffer, size_t bufferLen,
 error_t mqttDeserializeString(uint8_t *buffer, size_t bufferLen,
    size_t *pos, char_t **string, size_t *stringLen);
 
+error_t mqttDeserializeLong(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint32_t *value);
+
+error_t mqttDeserializeVarInt(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, uint32_t *value);
+
+error_t mqttDeserializeProperty(uint8_t *buffer, size_t bufferLen,
+   size_t *pos, MqttProperty *property);
+
 error_t mqttClientCheckTimeout(MqttClientContext *context);
 
+uint16_t mqttClientGeneratePacketId(MqttClientContext *context,
+   uint16_t packetId);
+
+bool_t mqttClientCheckSendQuota(MqttClientContext *context);
+
+error_t mqttClientFormatConnectProperties(MqttClientContext *context,
+   size_t *pos);
+
+error_t mqttClientParseConnAckProperties(MqttClientContext *context);
+
+error_t mqttClientParsePublishProperties(MqttClientContext *context,
+   uint16_t *alias);
+
+error_t mqttClientParseReasonCode(MqttClientContext *context,
+   MqttPacketType type);
+
+uint_t mqttClientGetTopicAlias(MqttClientContext *context,
+   const char_t *topic, bool_t *newAlias);
+
+bool_t mqttClientPrepareInflight(MqttClientContext *context);
+void mqttClientProcessInflightTx(MqttClientContext *context);
+
+void mqttClientProcessInflightAck(MqttClientContext *context,
+   MqttPacketType type, uint16_t packetId);
+
+void mqttClientResumeInflight(MqttClientContext *context, bool_t cleanSession);
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -60,7 +60,7 @@ const char_t *const mqttPacketLabel[16] =
    "PINGREQ",     //12
    "PINGRESP",    //13
    "DISCONNECT",  //14
-   "Reserved"     //15
+   "AUTH"         //15
 };
 
 
@@ -72,6 +72,10 @@ const char_t *const mqttPacketLabel[16] =
 
 error_t mqttClientReceivePacket(MqttClientContext *context)
 {
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+   //Incoming data are read in bulk
+   return mqttClientReceiveBufferedPacket(context);
+#else
    error_t error;
    size_t n;
    uint8_t value;
@@ -155,10 +159,195 @@ error_t mqttClientReceivePacket(MqttClientContext *context)
          break;
    }
 
+   //Return status code
+   return error;
+#endif
+}
+
+
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+
+/**
+ * @brief Receive MQTT packet using the receive buffer
+ *
+ * As much data as possible is read at once, so that consecutive packets
+ * can be processed without further calls to the transport layer. Each
+ * packet is processed in place
+ *
+ * @param[in] context Pointer to the MQTT client context
+ * @return Error code
+ **/
+
+error_t mqttClientReceiveBufferedPacket(MqttClientContext *context)
+{
+   error_t error;
+   uint_t i;
+   size_t n;
+   size_t length;
+   size_t remainingLen;
+   uint8_t *p;
+
+   //Receive incoming packet
+   while(1)
+   {
+      //Point to the first unprocessed byte
+      p = context->rxBuffer + context->rxBufferPos;
+      //Number of bytes available in the receive buffer
+      n = context->rxBufferLen - context->rxBufferPos;
+
+      //Initialize variables
+      length = 0;
+      remainingLen = 0;
+
+      //The Remaining Length is encoded using a variable length encoding scheme
+      for(i = 1; i < n && i <= 4; i++)
+      {
+         //The least significant seven bits of each byte encode the data
+         remainingLen |= (p[i] & 0x7F) << (7 * (i - 1));
+
+         //The most significant bit is used to indicate that there are
+         //following bytes in the representation
+         if((p[i] & 0x80) == 0)
+         {
+            //Calculate the length of the control packet
+            length = i + 1 + remainingLen;
+            break;
+         }
+      }
+
+      //Applications can send control packets of size up to 256 MB
+      if(length == 0 && i > 4)
+         return ERROR_INVALID_SYNTAX;
+
+      //Check whether the fixed header has been received
+      if(length != 0)
+      {
+         //Complete packet?
+         if(length <= n)
+         {
+            //The packet is processed in place
+            context->packet = p;
+            context->packetPos = 0;
+            context->packetLen = length;
+            context->remainingLen = remainingLen;
+
+            //Consume the packet
+            context->rxBufferPos += length;
+
+            //The packet has been successfully received
+            return NO_ERROR;
+         }
+
+         //The packet does not fit in the receive buffer?
+         if(length > MQTT_CLIENT_RX_BUFFER_SIZE)
+         {
+            //Only the payload of PUBLISH packets can be passed to the
+            //application in chunks
+            if((p[0] >> 4) != MQTT_PACKET_TYPE_PUBLISH ||
+               context->callbacks.publishStreamCallback == NULL)
+            {
+               return ERROR_INVALID_LENGTH;
+            }
+
+            //Wait for the receive buffer to be full
+            if(context->rxBufferPos == 0 &&
+               context->rxBufferLen == MQTT_CLIENT_RX_BUFFER_SIZE)
+            {
+               //The beginning of the packet is processed in place
+               context->packet = context->rxBuffer;
+               context->packetPos = 0;
+               context->packetLen = MQTT_CLIENT_RX_BUFFER_SIZE;
+               context->remainingLen = remainingLen;
+
+               //Number of bytes that have not been received yet
+               context->rxStreamRemaining = length - MQTT_CLIENT_RX_BUFFER_SIZE;
+               //The contents of the receive buffer have been consumed
+               context->rxBufferPos = MQTT_CLIENT_RX_BUFFER_SIZE;
+
+               //The beginning of the packet has been successfully received
+               return NO_ERROR;
+            }
+         }
+      }
+
+      //Move the unprocessed data to the beginning of the receive buffer
+      if(context->rxBufferPos > 0)
+      {
+         osMemmove(context->rxBuffer, p, n);
+         context->rxBufferPos = 0;
+         context->rxBufferLen = n;
+      }
+
+      //Read as much data as possible
+      error = mqttClientReceiveData(context,
+         context->rxBuffer + context->rxBufferLen,
+         MQTT_CLIENT_RX_BUFFER_SIZE - context->rxBufferLen, &n, 0);
+
+      //Any error to report?
+      if(error)
+         return error;
+
+      //Update the length of the buffered data
+      context->rxBufferLen += n;
+   }
+}
+
+
+/**
+ * @brief Receive the next chunk of an oversized PUBLISH packet
+ * @param[in] context Pointer to the MQTT client context
+ * @return Error code
+ **/
+
+error_t mqttClientReceivePublishData(MqttClientContext *context)
+{
+   error_t error;
+   size_t n;
+   uint8_t *p;
+
+   //The header of the PUBLISH packet is kept at the beginning of the
+   //receive buffer. The rest of the buffer holds the current chunk
+   p = context->rxBuffer + context->rxStreamHeaderLen;
+
+   //Do not read beyond the end of the PUBLISH packet
+   n = MIN(context->rxStreamRemaining,
+      MQTT_CLIENT_RX_BUFFER_SIZE - context->rxStreamHeaderLen);
+
+   //Read the next chunk of the payload
+   error = mqttClientReceiveData(context, p, n, &n, 0);
+
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Invoke user callback function
+   context->callbacks.publishStreamCallback(context, context->rxStreamTopic,
+      p, n, context->rxStreamOffset, context->rxStreamOffset +
+      context->rxStreamRemaining, context->rxStreamDup, context->rxStreamQos,
+      context->rxStreamRetain, context->rxStreamPacketId);
+
+   //Advance data pointer
+   context->rxStreamOffset += n;
+   context->rxStreamRemaining -= n;
+
+   //Check whether the whole payload has been received
+   if(context->rxStreamRemaining == 0)
+   {
+      //Flush the receive buffer
+      context->rxBufferPos = 0;
+      context->rxBufferLen = 0;
+
+      //Acknowledge the PUBLISH packet
+      error = mqttClientAcknowledgePublish(context, context->rxStreamQos,
+         context->rxStreamPacketId);
+   }
+
    //Return status code
    return error;
 }
 
+#endif
+
 
 /**
  * @brief Process incoming MQTT packet
@@ -241,6 +430,13 @@ error_t mqttClientProcessPacket(MqttClientContext *context)
       //Process incoming PINGRESP packet
       error = mqttClientProcessPingResp(context, dup, qos, retain, remainingLen);
       break;
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //DISCONNECT packet received?
+   case MQTT_PACKET_TYPE_DISCONNECT:
+      //Process incoming DISCONNECT packet
+      error = mqttClientProcessDisconnect(context, dup, qos, retain, remainingLen);
+      break;
+#endif
    //Unknown packet received?
    default:
       //Report an error
@@ -288,6 +484,22 @@ error_t mqttClientProcessConnAck(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Save the Connect Reason Code
+      context->reasonCode = connectReturnCode;
+
+      //Parse CONNACK properties
+      error = mqttClientParseConnAckProperties(context);
+
+      //Failed to parse properties?
+      if(error)
+         return error;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.connAckCallback != NULL)
    {
@@ -327,6 +539,9 @@ error_t mqttClientProcessPublish(MqttClientContext *context,
    size_t topicLen;
    uint8_t *message;
    size_t messageLen;
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   uint16_t alias;
+#endif
 
    //The Topic Name must be present as the first field in the PUBLISH
    //packet variable header
@@ -355,6 +570,22 @@ error_t mqttClientProcessPublish(MqttClientContext *context,
       packetId = 0;
    }
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //No topic alias
+   alias = 0;
+
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Parse PUBLISH properties
+      error = mqttClientParsePublishProperties(context, &alias);
+
+      //Failed to parse properties?
+      if(error)
+         return error;
+   }
+#endif
+
    //The payload contains the Application Message that is being published
    message = context->packet + context->packetPos;
 
@@ -369,6 +600,60 @@ error_t mqttClientProcessPublish(MqttClientContext *context,
    //Point to the first character of the Topic Name
    topic--;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //Topic alias?
+   if(alias != 0)
+   {
+      //Check whether the Topic Name is present
+      if(topicLen > 0)
+      {
+         //The topic name cannot be stored in the table
+         if(topicLen > MQTT_CLIENT_MAX_TOPIC_ALIAS_LEN)
+            return ERROR_BUFFER_OVERFLOW;
+
+         //Establish the mapping between the topic alias and the topic name
+         osStrcpy(context->rxTopicAliases[alias].topic, topic);
+      }
+      else
+      {
+         //The topic alias must refer to an existing mapping
+         if(context->rxTopicAliases[alias].topic[0] == '\0')
+            return ERROR_INVALID_PACKET;
+
+         //Retrieve the topic name
+         topic = context->rxTopicAliases[alias].topic;
+      }
+   }
+#endif
+
+#if (MQTT_CLIENT_RX_BUFFER_SUPPORT == ENABLED)
+   //The PUBLISH packet does not fit in the receive buffer?
+   if(context->rxStreamRemaining > 0)
+   {
+      //Make sure there is room left for the payload
+      if(context->packetPos >= MQTT_CLIENT_RX_BUFFER_SIZE)
+         return ERROR_BUFFER_OVERFLOW;
+
+      //Invoke user callback function
+      context->callbacks.publishStreamCallback(context, topic, message,
+         messageLen, 0, messageLen + context->rxStreamRemaining, dup, qos,
+         retain, packetId);
+
+      //Save the header of the PUBLISH packet until the whole payload
+      //has been received
+      context->rxStreamHeaderLen = context->packetPos;
+      context->rxStreamOffset = messageLen;
+      context->rxStreamTopic = topic;
+      context->rxStreamDup = dup;
+      context->rxStreamQos = qos;
+      context->rxStreamRetain = retain;
+      context->rxStreamPacketId = packetId;
+
+      //The response is sent once the last chunk has been received
+      return NO_ERROR;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.publishCallback != NULL)
    {
@@ -377,6 +662,27 @@ error_t mqttClientProcessPublish(MqttClientContext *context,
          message, messageLen, dup, qos, retain, packetId);
    }
 
+   //Acknowledge the PUBLISH packet
+   return mqttClientAcknowledgePublish(context, qos, packetId);
+}
+
+
+/**
+ * @brief Send the response to a PUBLISH packet
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] qos QoS level of the PUBLISH packet
+ * @param[in] packetId Packet identifier of the PUBLISH packet
+ * @return Error code
+ **/
+
+error_t mqttClientAcknowledgePublish(MqttClientContext *context,
+   MqttQosLevel qos, uint16_t packetId)
+{
+   error_t error;
+
+   //Initialize status code
+   error = NO_ERROR;
+
    //Check QoS level
    if(qos == MQTT_QOS_LEVEL_1)
    {
@@ -451,6 +757,19 @@ error_t mqttClientProcessPubAck(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Read the PUBACK reason code
+      error = mqttClientParseReasonCode(context, MQTT_PACKET_TYPE_PUBACK);
+
+      //Failed to parse the reason code?
+      if(error)
+         return error;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.pubAckCallback != NULL)
    {
@@ -458,6 +777,11 @@ error_t mqttClientProcessPubAck(MqttClientContext *context,
       context->callbacks.pubAckCallback(context, packetId);
    }
 
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   //Release the matching in-flight PUBLISH packet, if any
+   mqttClientProcessInflightAck(context, MQTT_PACKET_TYPE_PUBACK, packetId);
+#endif
+
    //Notify the application that a PUBACK packet has been received
    if(context->packetType == MQTT_PACKET_TYPE_PUBLISH && context->packetId == packetId)
       mqttClientChangeState(context, MQTT_CLIENT_STATE_PACKET_RECEIVED);
@@ -495,6 +819,19 @@ error_t mqttClientProcessPubRec(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Read the PUBREC reason code
+      error = mqttClientParseReasonCode(context, MQTT_PACKET_TYPE_PUBREC);
+
+      //Failed to parse the reason code?
+      if(error)
+         return error;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.pubRecCallback != NULL)
    {
@@ -502,6 +839,26 @@ error_t mqttClientProcessPubRec(MqttClientContext *context,
       context->callbacks.pubRecCallback(context, packetId);
    }
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //A reason code of 0x80 or greater indicates that the QoS 2 protocol
+   //exchange ends here, and no PUBREL packet is sent
+   if(context->settings.version == MQTT_VERSION_5_0 &&
+      context->reasonCode >= MQTT_REASON_CODE_UNSPECIFIED_ERROR)
+   {
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+      //Release the matching in-flight PUBLISH packet, if any
+      mqttClientProcessInflightAck(context, MQTT_PACKET_TYPE_PUBREC, packetId);
+#endif
+
+      //Notify the application that the PUBLISH packet has been rejected
+      if(context->packetType == MQTT_PACKET_TYPE_PUBLISH && context->packetId == packetId)
+         mqttClientChangeState(context, MQTT_CLIENT_STATE_PACKET_RECEIVED);
+
+      //Successful processing
+      return NO_ERROR;
+   }
+#endif
+
    //A PUBREL packet is the response to a PUBREC packet. It is the third
    //packet of the QoS 2 protocol exchange
    error = mqttClientFormatPubRel(context, packetId);
@@ -509,6 +866,11 @@ error_t mqttClientProcessPubRec(MqttClientContext *context,
    //Check status code
    if(!error)
    {
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+      //Keep a copy of the PUBREL packet in the in-flight table
+      mqttClientProcessInflightAck(context, MQTT_PACKET_TYPE_PUBREC, packetId);
+#endif
+
       //Debug message
       TRACE_INFO("MQTT: Sending PUBREL packet (%" PRIuSIZE " bytes)...\r\n", context->packetLen);
       TRACE_DEBUG_ARRAY("  ", context->packet, context->packetLen);
@@ -611,6 +973,19 @@ error_t mqttClientProcessPubComp(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Read the PUBCOMP reason code
+      error = mqttClientParseReasonCode(context, MQTT_PACKET_TYPE_PUBCOMP);
+
+      //Failed to parse the reason code?
+      if(error)
+         return error;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.pubCompCallback != NULL)
    {
@@ -618,6 +993,11 @@ error_t mqttClientProcessPubComp(MqttClientContext *context,
       context->callbacks.pubCompCallback(context, packetId);
    }
 
+#if (MQTT_CLIENT_INFLIGHT_SUPPORT == ENABLED)
+   //Release the matching in-flight PUBLISH packet, if any
+   mqttClientProcessInflightAck(context, MQTT_PACKET_TYPE_PUBCOMP, packetId);
+#endif
+
    //Notify the application that a PUBCOMP packet has been received
    if(context->packetType == MQTT_PACKET_TYPE_PUBLISH && context->packetId == packetId)
       mqttClientChangeState(context, MQTT_CLIENT_STATE_PACKET_RECEIVED);
@@ -655,6 +1035,19 @@ error_t mqttClientProcessSubAck(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Read the first SUBACK reason code
+      error = mqttClientParseReasonCode(context, MQTT_PACKET_TYPE_SUBACK);
+
+      //Failed to parse the reason code?
+      if(error)
+         return error;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.subAckCallback != NULL)
    {
@@ -699,6 +1092,19 @@ error_t mqttClientProcessUnsubAck(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Read the first UNSUBACK reason code
+      error = mqttClientParseReasonCode(context, MQTT_PACKET_TYPE_UNSUBACK);
+
+      //Failed to parse the reason code?
+      if(error)
+         return error;
+   }
+#endif
+
    //Any registered callback?
    if(context->callbacks.unsubAckCallback != NULL)
    {
@@ -747,6 +1153,49 @@ error_t mqttClientProcessPingResp(MqttClientContext *context,
 }
 
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+
+/**
+ * @brief Process incoming DISCONNECT packet (MQTT 5.0)
+ * @param[in] context Pointer to the MQTT client context
+ * @param[in] dup DUP flag from the fixed header
+ * @param[in] qos QoS field from the fixed header
+ * @param[in] retain RETAIN flag from the fixed header
+ * @param[in] remainingLen Length of the variable header and the payload
+ **/
+
+error_t mqttClientProcessDisconnect(MqttClientContext *context,
+   bool_t dup, MqttQosLevel qos, bool_t retain, size_t remainingLen)
+{
+   error_t error;
+
+   //If invalid flags are received, the receiver must close the network connection
+   if(dup != FALSE && qos != MQTT_QOS_LEVEL_0 && retain != FALSE)
+      return ERROR_INVALID_PACKET;
+
+   //A server may only send a DISCONNECT packet with MQTT 5.0
+   if(context->settings.version != MQTT_VERSION_5_0)
+      return ERROR_INVALID_PACKET;
+
+   //The Disconnect Reason Code indicates why the server is closing the
+   //network connection
+   error = mqttClientParseReasonCode(context, MQTT_PACKET_TYPE_DISCONNECT);
+
+   //Failed to parse the reason code?
+   if(error)
+      return error;
+
+   //Debug message
+   TRACE_INFO("MQTT: Server closed the connection (reason code 0x%02" PRIX8 ")\r\n",
+      context->reasonCode);
+
+   //The network connection is about to be closed by the server
+   return ERROR_CONNECTION_RESET;
+}
+
+#endif
+
+
 /**
  * @brief Format CONNECT packet
  * @param[in] context Pointer to the MQTT client context
@@ -781,6 +1230,15 @@ error_t mqttClientFormatConnect(MqttClientContext *context,
       error = mqttSerializeString(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
          &n, MQTT_PROTOCOL_NAME_3_1_1, osStrlen(MQTT_PROTOCOL_NAME_3_1_1));
    }
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   else if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //The Protocol Name is a UTF-8 encoded string that represents the
+      //protocol name "MQTT"
+      error = mqttSerializeString(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         &n, MQTT_PROTOCOL_NAME_5_0, osStrlen(MQTT_PROTOCOL_NAME_5_0));
+   }
+#endif
    else
    {
       //Invalid protocol level
@@ -866,6 +1324,19 @@ error_t mqttClientFormatConnect(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Format CONNECT properties
+      error = mqttClientFormatConnectProperties(context, &n);
+
+      //Failed to serialize properties?
+      if(error)
+         return error;
+   }
+#endif
+
    //The Client Identifier identifies the client to the server. The Client
    //Identifier must be present and must be the first field in the CONNECT
    //packet payload
@@ -880,6 +1351,20 @@ error_t mqttClientFormatConnect(MqttClientContext *context,
    //the payload
    if(willMessage->topic[0] != '\0')
    {
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+      //With MQTT 5.0, the Will Properties precede the Will Topic
+      if(context->settings.version == MQTT_VERSION_5_0)
+      {
+         //No Will Properties
+         error = mqttSerializeByte(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+            &n, 0);
+
+         //Failed to serialize data?
+         if(error)
+            return error;
+      }
+#endif
+
       //Write the Will Topic to the output buffer
       error = mqttSerializeString(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
          &n, willMessage->topic, osStrlen(willMessage->topic));
@@ -951,6 +1436,7 @@ error_t mqttClientFormatConnect(MqttClientContext *context,
  * @param[in] topic Topic name
  * @param[in] message Message payload
  * @param[in] length Length of the message payload
+ * @param[in] packetId Packet identifier (QoS 1 and QoS 2 only)
  * @param[in] dup DUP flag
  * @param[in] qos QoS level to be used when publishing the message
  * @param[in] retain This flag specifies if the message is to be retained
@@ -958,19 +1444,44 @@ error_t mqttClientFormatConnect(MqttClientContext *context,
  **/
 
 error_t mqttClientFormatPublish(MqttClientContext *context, const char_t *topic,
-   const void *message, size_t length, bool_t dup, MqttQosLevel qos,
-   bool_t retain)
+   const void *message, size_t length, uint16_t packetId, bool_t dup,
+   MqttQosLevel qos, bool_t retain)
 {
    error_t error;
    size_t n;
+   size_t topicLen;
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   uint_t alias;
+   bool_t newAlias;
+#endif
 
    //Make room for the fixed header
    n = MQTT_MAX_HEADER_SIZE;
+   //Length of the topic name
+   topicLen = osStrlen(topic);
+
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //Select a topic alias, if any
+   alias = mqttClientGetTopicAlias(context, topic, &newAlias);
+
+   //Once the alias has been established, the topic name can be omitted
+   if(alias != 0 && !newAlias)
+   {
+      topicLen = 0;
+   }
+
+   //The server may not support the requested QoS level
+   if(context->settings.version == MQTT_VERSION_5_0 &&
+      qos > context->serverMaxQos)
+   {
+      return ERROR_REQUEST_REJECTED;
+   }
+#endif
 
    //The Topic Name must be present as the first field in the PUBLISH
    //packet variable header
    error = mqttSerializeString(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
-      &n, topic, osStrlen(topic));
+      &n, topic, topicLen);
 
    //Failed to serialize Topic Name?
    if(error)
@@ -979,27 +1490,38 @@ error_t mqttClientFormatPublish(MqttClientContext *context, const char_t *topic,
    //Check QoS level
    if(qos != MQTT_QOS_LEVEL_0)
    {
-      //Each time a client sends a new PUBLISH packet it must assign it
-      //a currently unused packet identifier
-      if(context->packetId < UINT16_MAX)
-      {
-         context->packetId++;
-      }
-      else
-      {
-         context->packetId = 1;
-      }
-
       //The Packet Identifier field is only present in PUBLISH packets
       //where the QoS level is 1 or 2
       error = mqttSerializeShort(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
-         &n, context->packetId);
+         &n, packetId);
 
       //Failed to serialize Packet Identifier field?
       if(error)
          return error;
    }
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //MQTT 5.0 connection?
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //Write the Property Length field
+      error = mqttSerializeByte(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         &n, (alias != 0) ? 3 : 0);
+
+      //Check status code
+      if(!error && alias != 0)
+      {
+         //The Topic Alias replaces the Topic Name in subsequent packets
+         error = mqttSerializeProperty(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+            &n, MQTT_PROP_TOPIC_ALIAS, alias);
+      }
+
+      //Failed to serialize properties?
+      if(error)
+         return error;
+   }
+#endif
+
    //The payload contains the Application Message that is being published
    error = mqttSerializeData(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
       &n, message, length);
@@ -1027,6 +1549,23 @@ error_t mqttClientFormatPublish(MqttClientContext *context, const char_t *topic,
    //Calculate the length of the MQTT packet
    context->packetLen += MQTT_MAX_HEADER_SIZE - n;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //The client must not send packets exceeding the Maximum Packet Size
+   if(context->settings.version == MQTT_VERSION_5_0 &&
+      context->serverMaxPacketSize != 0 &&
+      context->packetLen > context->serverMaxPacketSize)
+   {
+      return ERROR_MESSAGE_TOO_LONG;
+   }
+
+   //The mapping is only recorded once the packet has been formatted
+   if(newAlias)
+   {
+      osStrcpy(context->txTopicAliases[alias].topic, topic);
+      context->numTxTopicAliases = alias;
+   }
+#endif
+
    //Successful processing
    return NO_ERROR;
 }
@@ -1244,14 +1783,8 @@ error_t mqttClientFormatSubscribe(MqttClientContext *context,
 
    //Each time a client sends a new SUBSCRIBE packet it must assign it
    //a currently unused packet identifier
-   if(context->packetId < UINT16_MAX)
-   {
-      context->packetId++;
-   }
-   else
-   {
-      context->packetId = 1;
-   }
+   context->packetId = mqttClientGeneratePacketId(context,
+      context->packetId);
 
    //Write Packet Identifier to the output buffer
    error = mqttSerializeShort(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
@@ -1261,6 +1794,20 @@ error_t mqttClientFormatSubscribe(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //With MQTT 5.0, the Packet Identifier is followed by the properties
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //No properties
+      error = mqttSerializeByte(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         &n, 0);
+
+      //Failed to serialize data?
+      if(error)
+         return error;
+   }
+#endif
+
    //Write the Topic Filter to the output buffer
    error = mqttSerializeString(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
       &n, topic, osStrlen(topic));
@@ -1319,14 +1866,8 @@ error_t mqttClientFormatUnsubscribe(MqttClientContext *context,
 
    //Each time a client sends a new UNSUBSCRIBE packet it must assign it
    //a currently unused packet identifier
-   if(context->packetId < UINT16_MAX)
-   {
-      context->packetId++;
-   }
-   else
-   {
-      context->packetId = 1;
-   }
+   context->packetId = mqttClientGeneratePacketId(context,
+      context->packetId);
 
    //Write Packet Identifier to the output buffer
    error = mqttSerializeShort(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
@@ -1336,6 +1877,20 @@ error_t mqttClientFormatUnsubscribe(MqttClientContext *context,
    if(error)
       return error;
 
+#if (MQTT_CLIENT_V5_SUPPORT == ENABLED)
+   //With MQTT 5.0, the Packet Identifier is followed by the properties
+   if(context->settings.version == MQTT_VERSION_5_0)
+   {
+      //No properties
+      error = mqttSerializeByte(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
+         &n, 0);
+
+      //Failed to serialize data?
+      if(error)
+         return error;
+   }
+#endif
+
    //Write the Topic Filter to the output buffer
    error = mqttSerializeString(context->buffer, MQTT_CLIENT_BUFFER_SIZE,
       &n, topic, osStrlen(topic));
@@ -42,11 +42,17 @@ extern "C" {
 
 //MQTT client related functions
 error_t mqttClientReceivePacket(MqttClientContext *context);
+error_t mqttClientReceiveBufferedPacket(MqttClientContext *context);
+error_t mqttClientReceivePublishData(MqttClientContext *context);
+
 error_t mqttClientProcessPacket(MqttClientContext *context);
 
 error_t mqttClientProcessConnAck(MqttClientContext *context,
    bool_t dup, MqttQosLevel qos, bool_t retain, size_t remainingLen);
 
+error_t mqttClientAcknowledgePublish(MqttClientContext *context,
+   MqttQosLevel qos, uint16_t packetId);
+
 error_t mqttClientProcessPubAck(MqttClientContext *context,
    bool_t dup, MqttQosLevel qos, bool_t retain, size_t remainingLen);
 
@@ -71,12 +77,15 @@ error_t mqttClientProcessUnsubAck(MqttClientContext *context,
 error_t mqttClientProcessPingResp(MqttClientContext *context,
    bool_t dup, MqttQosLevel qos, bool_t retain, size_t remainingLen);
 
+error_t mqttClientProcessDisconnect(MqttClientContext *context,
+   bool_t dup, MqttQosLevel qos, bool_t retain, size_t remainingLen);
+
 error_t mqttClientFormatConnect(MqttClientContext *context,
    bool_t cleanSession);
 
 error_t mqttClientFormatPublish(MqttClientContext *context, const char_t *topic,
-   const void *message, size_t length, bool_t dup, MqttQosLevel qos,
-   bool_t retain);
+   const void *message, size_t length, uint16_t packetId, bool_t dup,
+   MqttQosLevel qos, bool_t retain);
 
 error_t mqttClientFormatPubAck(MqttClientContext *context, uint16_t packetId);
 error_t mqttClientFormatPubRec(MqttClientContext *context, uint16_t packetId);
@@ -43,6 +43,8 @@
 #define MQTT_PROTOCOL_NAME_3_1 "MQIsdp"
 //MQTT 3.1.1 protocol name
 #define MQTT_PROTOCOL_NAME_3_1_1 "MQTT"
+//MQTT 5.0 protocol name
+#define MQTT_PROTOCOL_NAME_5_0 "MQTT"
 
 //Minimum size of MQTT header
 #define MQTT_MIN_HEADER_SIZE 2
@@ -62,7 +64,8 @@ extern "C" {
 typedef enum
 {
    MQTT_VERSION_3_1   = 3, ///<MQTT version 3.1
-   MQTT_VERSION_3_1_1 = 4  ///<MQTT version 3.1.1
+   MQTT_VERSION_3_1_1 = 4, ///<MQTT version 3.1.1
+   MQTT_VERSION_5_0   = 5  ///<MQTT version 5.0
 } MqttVersion;
 
 
@@ -111,7 +114,8 @@ typedef enum
    MQTT_PACKET_TYPE_UNSUBACK    = 11, ///<Unsubscribe acknowledgment
    MQTT_PACKET_TYPE_PINGREQ     = 12, ///<Ping request
    MQTT_PACKET_TYPE_PINGRESP    = 13, ///<Ping response
-   MQTT_PACKET_TYPE_DISCONNECT  = 14  ///<Client is disconnecting
+   MQTT_PACKET_TYPE_DISCONNECT  = 14, ///<Client is disconnecting
+   MQTT_PACKET_TYPE_AUTH        = 15  ///<Authentication exchange (MQTT 5.0)
 } MqttPacketType;
 
 
@@ -157,6 +161,102 @@ typedef enum
 } MqttConnectRetCode;
 
 
+/**
+ * @brief Property identifiers (MQTT 5.0)
+ **/
+
+typedef enum
+{
+   MQTT_PROP_PAYLOAD_FORMAT_INDICATOR     = 0x01,
+   MQTT_PROP_MESSAGE_EXPIRY_INTERVAL      = 0x02,
+   MQTT_PROP_CONTENT_TYPE                 = 0x03,
+   MQTT_PROP_RESPONSE_TOPIC               = 0x08,
+   MQTT_PROP_CORRELATION_DATA             = 0x09,
+   MQTT_PROP_SUBSCRIPTION_ID              = 0x0B,
+   MQTT_PROP_SESSION_EXPIRY_INTERVAL      = 0x11,
+   MQTT_PROP_ASSIGNED_CLIENT_ID           = 0x12,
+   MQTT_PROP_SERVER_KEEP_ALIVE            = 0x13,
+   MQTT_PROP_AUTH_METHOD                  = 0x15,
+   MQTT_PROP_AUTH_DATA                    = 0x16,
+   MQTT_PROP_REQUEST_PROBLEM_INFO         = 0x17,
+   MQTT_PROP_WILL_DELAY_INTERVAL          = 0x18,
+   MQTT_PROP_REQUEST_RESPONSE_INFO        = 0x19,
+   MQTT_PROP_RESPONSE_INFO                = 0x1A,
+   MQTT_PROP_SERVER_REFERENCE             = 0x1C,
+   MQTT_PROP_REASON_STRING                = 0x1F,
+   MQTT_PROP_RECEIVE_MAXIMUM              = 0x21,
+   MQTT_PROP_TOPIC_ALIAS_MAXIMUM          = 0x22,
+   MQTT_PROP_TOPIC_ALIAS                  = 0x23,
+   MQTT_PROP_MAXIMUM_QOS                  = 0x24,
+   MQTT_PROP_RETAIN_AVAILABLE             = 0x25,
+   MQTT_PROP_USER_PROPERTY                = 0x26,
+   MQTT_PROP_MAXIMUM_PACKET_SIZE          = 0x27,
+   MQTT_PROP_WILDCARD_SUB_AVAILABLE       = 0x28,
+   MQTT_PROP_SUBSCRIPTION_ID_AVAILABLE    = 0x29,
+   MQTT_PROP_SHARED_SUB_AVAILABLE         = 0x2A
+} MqttPropertyId;
+
+
+/**
+ * @brief Reason codes (MQTT 5.0)
+ **/
+
+typedef enum
+{
+   MQTT_REASON_CODE_SUCCESS                 = 0x00,
+   MQTT_REASON_CODE_GRANTED_QOS_1           = 0x01,
+   MQTT_REASON_CODE_GRANTED_QOS_2           = 0x02,
+   MQTT_REASON_CODE_DISCONNECT_WITH_WILL    = 0x04,
+   MQTT_REASON_CODE_NO_MATCHING_SUBSCRIBERS = 0x10,
+   MQTT_REASON_CODE_NO_SUBSCRIPTION_EXISTED = 0x11,
+   MQTT_REASON_CODE_UNSPECIFIED_ERROR       = 0x80,
+   MQTT_REASON_CODE_MALFORMED_PACKET        = 0x81,
+   MQTT_REASON_CODE_PROTOCOL_ERROR          = 0x82,
+   MQTT_REASON_CODE_IMPL_SPECIFIC_ERROR     = 0x83,
+   MQTT_REASON_CODE_UNSUPPORTED_VERSION     = 0x84,
+   MQTT_REASON_CODE_CLIENT_ID_NOT_VALID     = 0x85,
+   MQTT_REASON_CODE_BAD_USER_NAME           = 0x86,
+   MQTT_REASON_CODE_NOT_AUTHORIZED          = 0x87,
+   MQTT_REASON_CODE_SERVER_UNAVAILABLE      = 0x88,
+   MQTT_REASON_CODE_SERVER_BUSY             = 0x89,
+   MQTT_REASON_CODE_BANNED                  = 0x8A,
+   MQTT_REASON_CODE_SERVER_SHUTTING_DOWN    = 0x8B,
+   MQTT_REASON_CODE_KEEP_ALIVE_TIMEOUT      = 0x8D,
+   MQTT_REASON_CODE_SESSION_TAKEN_OVER      = 0x8E,
+   MQTT_REASON_CODE_TOPIC_FILTER_INVALID    = 0x8F,
+   MQTT_REASON_CODE_TOPIC_NAME_INVALID      = 0x90,
+   MQTT_REASON_CODE_PACKET_ID_IN_USE        = 0x91,
+   MQTT_REASON_CODE_PACKET_ID_NOT_FOUND     = 0x92,
+   MQTT_REASON_CODE_RECEIVE_MAX_EXCEEDED    = 0x93,
+   MQTT_REASON_CODE_TOPIC_ALIAS_INVALID     = 0x94,
+   MQTT_REASON_CODE_PACKET_TOO_LARGE        = 0x95,
+   MQTT_REASON_CODE_MESSAGE_RATE_TOO_HIGH   = 0x96,
+   MQTT_REASON_CODE_QUOTA_EXCEEDED          = 0x97,
+   MQTT_REASON_CODE_ADMINISTRATIVE_ACTION   = 0x98,
+   MQTT_REASON_CODE_PAYLOAD_FORMAT_INVALID  = 0x99,
+   MQTT_REASON_CODE_RETAIN_NOT_SUPPORTED    = 0x9A,
+   MQTT_REASON_CODE_QOS_NOT_SUPPORTED       = 0x9B,
+   MQTT_REASON_CODE_USE_ANOTHER_SERVER      = 0x9C,
+   MQTT_REASON_CODE_SERVER_MOVED            = 0x9D,
+   MQTT_REASON_CODE_CONN_RATE_EXCEEDED      = 0x9F
+} MqttReasonCode;
+
+
+/**
+ * @brief Decoded property (MQTT 5.0)
+ **/
+
+typedef struct
+{
+   uint8_t id;            ///<Property identifier
+   uint32_t value;        ///<Value of integer properties
+   const uint8_t *data;   ///<String or binary data
+   size_t length;         ///<Length of the string or binary data
+   const uint8_t *data2;  ///<Value of a string pair (user property)
+   size_t length2;        ///<Length of the value of a string pair
+} MqttProperty;
+
+
 //CC-RX, CodeWarrior or Win32 compiler?
 #if defined(__CCRX__)
    #pragma pack
@@ -190,6 +190,59 @@ error_t mqttSnClientSetPredefinedTopics(MqttSnClientContext *context,
 }
 
 
+/**
+ * @brief Preload the topic table
+ *
+ * Topic IDs assigned by the gateway during a previous session (for instance
+ * saved before entering deep sleep) can be restored without any REGISTER
+ * exchange. The client must then connect with the CleanSession flag cleared
+ *
+ * @param[in] context Pointer to the MQTT-SN client context
+ * @param[in] topics List of topic name/topic ID mappings
+ * @param[in] size Number of entries in the list
+ * @return Error code
+ **/
+
+error_t mqttSnClientPreloadTopics(MqttSnClientContext *context,
+   const MqttSnPredefinedTopic *topics, uint_t size)
+{
+   error_t error;
+   uint_t i;
+
+   //Make sure the MQTT-SN client context is valid
+   if(context == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Check parameters
+   if(topics == NULL && size != 0)
+      return ERROR_INVALID_PARAMETER;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Loop through the list of mappings
+   for(i = 0; i < size && !error; i++)
+   {
+      //Check topic name and topic ID
+      if(topics[i].topicName != NULL &&
+         topics[i].topicId != MQTT_SN_INVALID_TOPIC_ID)
+      {
+         //Save mapping between topic name and topic ID
+         error = mqttSnClientAddTopic(context, topics[i].topicName,
+            topics[i].topicId);
+      }
+      else
+      {
+         //Report an error
+         error = ERROR_INVALID_PARAMETER;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
 /**
  * @brief Set communication timeout
  * @param[in] context Pointer to the MQTT-SN client context
@@ -619,6 +672,190 @@ error_t mqttSnClientConnect(MqttSnClientContext *context, bool_t cleanSession)
 }
 
 
+/**
+ * @brief Register a list of topic names
+ *
+ * Up to MQTT_SN_CLIENT_MAX_PENDING_REGISTERS REGISTER messages are sent back
+ * to back, so that the registration of several topics only takes a single
+ * round trip. Short topic names, predefined topics and topics that have
+ * already been registered are skipped
+ *
+ * @param[in] context Pointer to the MQTT-SN client context
+ * @param[in] topicNames List of topic names
+ * @param[in] count Number of topic names in the list
+ * @return Error code
+ **/
+
+error_t mqttSnClientRegisterTopics(MqttSnClientContext *context,
+   const char_t *const *topicNames, uint_t count)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   bool_t done;
+   bool_t rejected;
+   systime_t time;
+   MqttSnClientRegisterEntry *entry;
+
+   //Check parameters
+   if(context == NULL || (topicNames == NULL && count != 0))
+      return ERROR_INVALID_PARAMETER;
+
+   //Make sure the MQTT-SN client is connected
+   if(context->state != MQTT_SN_CLIENT_STATE_ACTIVE)
+      return ERROR_NOT_CONNECTED;
+
+   //Initialize status code
+   error = NO_ERROR;
+   //Index of the next topic name to be registered
+   n = 0;
+   //No registration has been rejected so far
+   rejected = FALSE;
+
+   //Release outstanding REGISTER messages
+   osMemset(context->registerTable, 0, sizeof(context->registerTable));
+
+   //Save current time
+   context->startTime = osGetSystemTime();
+
+   //Topic registration procedure
+   while(!error)
+   {
+      //Get current time
+      time = osGetSystemTime();
+      //Check whether the procedure is complete
+      done = TRUE;
+
+      //Loop through the list of outstanding REGISTER messages
+      for(i = 0; i < MQTT_SN_CLIENT_MAX_PENDING_REGISTERS && !error; i++)
+      {
+         //Point to the current entry
+         entry = &context->registerTable[i];
+
+         //Any REGACK message received for the current entry?
+         if(entry->topicName != NULL && !entry->pending)
+         {
+            //If the registration has not been accepted, the failure reason
+            //is encoded in the return code field of the REGACK message
+            if(entry->returnCode == MQTT_SN_RETURN_CODE_ACCEPTED)
+            {
+               //Save the topic ID assigned by the gateway
+               error = mqttSnClientAddTopic(context, entry->topicName,
+                  entry->topicId);
+            }
+            else
+            {
+               //Save the return code of the rejected registration
+               context->returnCode = entry->returnCode;
+               //Process the remaining topic names
+               rejected = TRUE;
+            }
+
+            //Release current entry
+            entry->topicName = NULL;
+         }
+
+         //Check status code
+         if(error)
+            break;
+
+         //Free entry?
+         if(entry->topicName == NULL)
+         {
+            //Skip topic names that do not require any registration
+            while(n < count && (topicNames[n] == NULL ||
+               mqttSnClientIsShortTopicName(topicNames[n]) ||
+               mqttSnClientFindTopicName(context, topicNames[n]) != 0 ||
+               mqttSnClientFindPredefTopicName(context, topicNames[n]) != 0))
+            {
+               n++;
+            }
+
+            //Any topic name left?
+            if(n < count)
+            {
+               //The message identifier allows the sender to match a message
+               //with its corresponding acknowledgment
+               entry->msgId = mqttSnClientGenerateMessageId(context);
+               entry->topicName = topicNames[n++];
+               entry->retransmitStartTime = time;
+               entry->pending = TRUE;
+
+               //Send REGISTER message without waiting for the REGACK messages
+               //of the previous ones
+               error = mqttSnClientSendRegister(context, entry->msgId,
+                  entry->topicName);
+            }
+         }
+         else if(timeCompare(time, entry->retransmitStartTime +
+            MQTT_SN_CLIENT_RETRY_TIMEOUT) >= 0)
+         {
+            //Save the time at which the message was sent
+            entry->retransmitStartTime = time;
+
+            //If the retry timer times out and the expected gateway's reply
+            //is not received, the client retransmits the message
+            error = mqttSnClientSendRegister(context, entry->msgId,
+               entry->topicName);
+         }
+         else
+         {
+            //Wait for the gateway's reply
+         }
+
+         //Outstanding REGISTER message?
+         if(entry->topicName != NULL)
+            done = FALSE;
+      }
+
+      //Check status code
+      if(!error)
+      {
+         //All the topic names have been processed?
+         if(done)
+         {
+            //Exit immediately
+            break;
+         }
+         else if(timeCompare(time, context->startTime + context->timeout) >= 0)
+         {
+            //Abort the retransmission procedure
+            context->state = MQTT_SN_CLIENT_STATE_DISCONNECTING;
+            //Report a timeout error
+            error = ERROR_TIMEOUT;
+         }
+         else
+         {
+            //Wait for the gateway's replies
+            error = mqttSnClientProcessEvents(context,
+               MQTT_SN_CLIENT_TICK_INTERVAL);
+         }
+      }
+   }
+
+   //Late REGACK messages must not be matched
+   osMemset(context->registerTable, 0, sizeof(context->registerTable));
+
+   //Check whether the client is still waiting for REGACK messages
+   if(context->state == MQTT_SN_CLIENT_STATE_SENDING_REQ &&
+      context->msgType == MQTT_SN_MSG_TYPE_REGISTER)
+   {
+      //Update MQTT-SN client state
+      context->state = MQTT_SN_CLIENT_STATE_ACTIVE;
+   }
+
+   //Any registration rejected by the gateway?
+   if(!error && rejected)
+   {
+      //Report an error
+      error = ERROR_REQUEST_REJECTED;
+   }
+
+   //Return status code
+   return error;
+}
+
+
 /**
  * @brief Publish message
  * @param[in] context Pointer to the MQTT-SN client context
@@ -649,6 +886,58 @@ error_t mqttSnClientPublish(MqttSnClientContext *context,
    if(dup && msgId == NULL)
       return ERROR_INVALID_PARAMETER;
 
+   //QoS level -1?
+   if(qos == MQTT_SN_QOS_LEVEL_MINUS_1)
+   {
+      //QoS level -1 messages are published using either a short topic name
+      //or a predefined topic ID, so that no registration is needed
+      if(!mqttSnClientIsShortTopicName(topicName) &&
+         mqttSnClientFindPredefTopicName(context, topicName) == 0)
+      {
+         return ERROR_NOT_FOUND;
+      }
+
+      //Check current state
+      if(context->state == MQTT_SN_CLIENT_STATE_DISCONNECTED)
+      {
+         //No connection setup is performed prior to sending the message
+         if(context->transportProtocol != MQTT_SN_TRANSPORT_PROTOCOL_UDP)
+            return ERROR_NOT_CONNECTED;
+
+         //Open network connection
+         error = mqttSnClientOpenConnection(context, FALSE);
+
+         //Check status code
+         if(!error)
+         {
+            //Send PUBLISH message to the gateway
+            error = mqttSnClientSendPublish(context, 0, topicName, message,
+               length, qos, retain, FALSE);
+         }
+
+         //Close network connection
+         mqttSnClientCloseConnection(context);
+      }
+      else if(context->state == MQTT_SN_CLIENT_STATE_ACTIVE)
+      {
+         //Use the current connection
+         error = mqttSnClientSendPublish(context, 0, topicName, message,
+            length, qos, retain, FALSE);
+      }
+      else
+      {
+         //Invalid state
+         error = ERROR_WRONG_STATE;
+      }
+
+      //The message identifier is not relevant in case of QoS level -1
+      if(msgId != NULL)
+         *msgId = 0;
+
+      //Fire-and-forget delivery
+      return error;
+   }
+
    //Initialize status code
    error = NO_ERROR;
 
@@ -685,7 +974,8 @@ error_t mqttSnClientPublish(MqttSnClientContext *context,
 
             //To register a topic name a client sends a REGISTER message to
             //the gateway
-            error = mqttSnClientSendRegister(context, topicName);
+            error = mqttSnClientSendRegister(context, context->msgId,
+               topicName);
          }
          else
          {
@@ -742,7 +1032,8 @@ error_t mqttSnClientPublish(MqttSnClientContext *context,
             if(context->msgType == MQTT_SN_MSG_TYPE_REGISTER)
             {
                //Retransmit REGISTER message
-               error = mqttSnClientSendRegister(context, topicName);
+               error = mqttSnClientSendRegister(context, context->msgId,
+                  topicName);
             }
             else if(context->msgType == MQTT_SN_MSG_TYPE_PUBLISH)
             {
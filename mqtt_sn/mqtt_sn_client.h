@@ -57,6 +57,13 @@
    #error MQTT_SN_CLIENT_TOPIC_TABLE_SIZE parameter is not valid
 #endif
 
+//Maximum number of REGISTER messages that can be outstanding
+#ifndef MQTT_SN_CLIENT_MAX_PENDING_REGISTERS
+   #define MQTT_SN_CLIENT_MAX_PENDING_REGISTERS 4
+#elif (MQTT_SN_CLIENT_MAX_PENDING_REGISTERS < 1)
+   #error MQTT_SN_CLIENT_MAX_PENDING_REGISTERS parameter is not valid
+#endif
+
 //Maximum number of QoS 2 messages that can be accepted
 #ifndef MQTT_SN_CLIENT_MSG_ID_TABLE_SIZE
    #define MQTT_SN_CLIENT_MSG_ID_TABLE_SIZE 10
@@ -217,9 +224,25 @@ typedef struct
 {
    char_t topicName[MQTT_SN_CLIENT_MAX_TOPIC_NAME_LEN + 1]; ///<Topic name
    uint16_t topicId;                                        ///<Topic identifier
+   uint32_t hash;                                           ///<Hash value of the topic name
 } MqttSnClientTopicEntry;
 
 
+/**
+ * @brief Outstanding REGISTER message
+ **/
+
+typedef struct
+{
+   const char_t *topicName;       ///<Topic name
+   uint16_t msgId;                ///<Message identifier
+   systime_t retransmitStartTime; ///<Time at which the last message was sent
+   bool_t pending;                ///<The REGACK message has not been received yet
+   uint16_t topicId;              ///<Topic identifier returned by the gateway
+   MqttSnReturnCode returnCode;   ///<Status code returned by the gateway
+} MqttSnClientRegisterEntry;
+
+
 /**
  * @brief QoS 2 message state
  **/
@@ -268,6 +291,7 @@ struct _MqttSnClientContext
    MqttSnReturnCode returnCode;                       ///<Status code returned by the gateway
    MqttSnClientTopicEntry topicTable[MQTT_SN_CLIENT_TOPIC_TABLE_SIZE];
    MqttSnClientMsgIdEntry msgIdTable[MQTT_SN_CLIENT_MSG_ID_TABLE_SIZE];
+   MqttSnClientRegisterEntry registerTable[MQTT_SN_CLIENT_MAX_PENDING_REGISTERS];
    MQTT_SN_CLIENT_PRIVATE_CONTEXT                     ///<Application specific context
 };
 
@@ -291,6 +315,9 @@ error_t mqttSnClientRegisterPublishCallback(MqttSnClientContext *context,
 error_t mqttSnClientSetPredefinedTopics(MqttSnClientContext *context,
    MqttSnPredefinedTopic *predefinedTopics, uint_t size);
 
+error_t mqttSnClientPreloadTopics(MqttSnClientContext *context,
+   const MqttSnPredefinedTopic *topics, uint_t size);
+
 error_t mqttSnClientSetTimeout(MqttSnClientContext *context,
    systime_t timeout);
 
@@ -315,6 +342,9 @@ error_t mqttSnClientSearchGateway(MqttSnClientContext *context,
 
 error_t mqttSnClientConnect(MqttSnClientContext *context, bool_t cleanSession);
 
+error_t mqttSnClientRegisterTopics(MqttSnClientContext *context,
+   const char_t *const *topicNames, uint_t count);
+
 error_t mqttSnClientPublish(MqttSnClientContext *context,
    const char_t *topicName, const void *message, size_t length,
    MqttSnQosLevel qos, bool_t retain, bool_t dup, uint16_t *msgId);
@@ -380,6 +380,7 @@ error_t mqttSnClientProcessRegAck(MqttSnClientContext *context,
    uint16_t msgId;
    uint16_t topicId;
    MqttSnReturnCode returnCode;
+   MqttSnClientRegisterEntry *entry;
 
    //Parse REGACK message
    error = mqttSnParseRegAck(message, &msgId, &topicId, &returnCode);
@@ -387,8 +388,23 @@ error_t mqttSnClientProcessRegAck(MqttSnClientContext *context,
    //Valid message received?
    if(!error)
    {
+      //Several REGISTER messages may be outstanding at the same time
+      entry = mqttSnClientFindRegisterEntry(context, msgId);
+
       //Check current state
       if(context->state == MQTT_SN_CLIENT_STATE_SENDING_REQ &&
+         context->msgType == MQTT_SN_MSG_TYPE_REGISTER &&
+         entry != NULL)
+      {
+         //The REGISTER message has been acknowledged
+         entry->pending = FALSE;
+         entry->topicId = topicId;
+         entry->returnCode = returnCode;
+
+         //The MQTT-SN gateway is alive
+         context->keepAliveCounter = 0;
+      }
+      else if(context->state == MQTT_SN_CLIENT_STATE_SENDING_REQ &&
          context->msgType == MQTT_SN_MSG_TYPE_REGISTER &&
          context->msgId == msgId)
       {
@@ -1087,19 +1103,19 @@ error_t mqttSnClientSendWillMsg(MqttSnClientContext *context)
 /**
  * @brief Send REGISTER message
  * @param[in] context Pointer to the MQTT-SN client context
+ * @param[in] msgId Message identifier
  * @param[in] topicName Topic name
  * @return Error code
  **/
 
 error_t mqttSnClientSendRegister(MqttSnClientContext *context,
-   const char_t *topicName)
+   uint16_t msgId, const char_t *topicName)
 {
    error_t error;
    systime_t time;
 
    //Format REGISTER message
-   error = mqttSnFormatRegister(&context->message, context->msgId, 0,
-      topicName);
+   error = mqttSnFormatRegister(&context->message, msgId, 0, topicName);
 
    //Check status code
    if(!error)
@@ -1278,12 +1294,17 @@ error_t mqttSnClientSendPublish(MqttSnClientContext *context,
          context->state = MQTT_SN_CLIENT_STATE_SENDING_REQ;
          context->msgType = MQTT_SN_MSG_TYPE_PUBLISH;
       }
-      else
+      else if(qos == MQTT_SN_QOS_LEVEL_0)
       {
          //In the QoS 0, no response is sent by the receiver and no retry
          //is performed by the sender
          context->state = MQTT_SN_CLIENT_STATE_ACTIVE;
       }
+      else
+      {
+         //QoS level -1 messages may be sent while the client is not
+         //connected to the gateway
+      }
    }
 
    //Return status code
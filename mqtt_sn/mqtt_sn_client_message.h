@@ -108,7 +108,7 @@ error_t mqttSnClientSendWillTopic(MqttSnClientContext *context);
 error_t mqttSnClientSendWillMsg(MqttSnClientContext *context);
 
 error_t mqttSnClientSendRegister(MqttSnClientContext *context,
-   const char_t *topicName);
+   uint16_t msgId, const char_t *topicName);
 
 error_t mqttSnClientSendRegAck(MqttSnClientContext *context, uint16_t msgId,
    uint16_t topicId, MqttSnReturnCode returnCode);
@@ -245,36 +245,44 @@ error_t mqttSnClientAddTopic(MqttSnClientContext *context,
    const char_t *topicName, uint16_t topicId)
 {
    uint_t i;
+   uint_t k;
+   uint32_t hash;
+   MqttSnClientTopicEntry *entry;
 
    //Make sure the name of the topic name is acceptable
    if(osStrlen(topicName) > MQTT_SN_CLIENT_MAX_TOPIC_NAME_LEN)
       return ERROR_INVALID_LENGTH;
 
+   //Compute the hash value of the topic name
+   hash = mqttSnClientComputeTopicHash(topicName);
+   //Index of the first entry to probe
+   k = hash % MQTT_SN_CLIENT_TOPIC_TABLE_SIZE;
+
    //Loop through the topic table
    for(i = 0; i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; i++)
    {
-      //Check whether the topic name has already been registered
-      if(osStrcmp(context->topicTable[i].topicName, topicName) == 0)
+      //Point to the current entry (linear probing)
+      entry = &context->topicTable[(k + i) % MQTT_SN_CLIENT_TOPIC_TABLE_SIZE];
+
+      //Check whether the current entry is free
+      if(entry->topicName[0] == '\0')
       {
-         //Update topic identifier
-         context->topicTable[i].topicId = topicId;
+         //Save mapping between topic name and topic ID
+         osStrcpy(entry->topicName, topicName);
+         entry->topicId = topicId;
+         entry->hash = hash;
 
-         //We are done
+         //A new entry has been successfully created
          return NO_ERROR;
       }
-   }
 
-   //Loop through the topic table
-   for(i = 0; i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; i++)
-   {
-      //Check whether the current entry is free
-      if(context->topicTable[i].topicName[0] == '\0')
+      //Check whether the topic name has already been registered
+      if(entry->hash == hash && osStrcmp(entry->topicName, topicName) == 0)
       {
-         //Save mapping between topic name and topic ID
-         osStrcpy(context->topicTable[i].topicName, topicName);
-         context->topicTable[i].topicId = topicId;
+         //Update topic identifier
+         entry->topicId = topicId;
 
-         //A new entry has been successfully created
+         //We are done
          return NO_ERROR;
       }
    }
@@ -295,23 +303,118 @@ error_t mqttSnClientDeleteTopic(MqttSnClientContext *context,
    const char_t *topicName)
 {
    uint_t i;
+   uint_t j;
+   uint_t k;
+   uint_t n;
 
-   //Loop through the list of topics that have been registered
-   for(i = 0; i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; i++)
+   //Search the topic table for the specified topic name
+   j = mqttSnClientFindTopicEntry(context, topicName);
+
+   //The specified topic name does not exist?
+   if(j >= MQTT_SN_CLIENT_TOPIC_TABLE_SIZE)
+      return ERROR_NOT_FOUND;
+
+   //Release current entry
+   context->topicTable[j].topicName[0] = '\0';
+
+   //Entries that follow the released entry in the same cluster may have to
+   //be moved back so that they can still be reached by linear probing
+   for(i = j, n = 1; n < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; n++)
    {
-      //Matching topic name?
-      if(osStrcmp(context->topicTable[i].topicName, topicName) == 0)
+      //Point to the next entry
+      i = (i + 1) % MQTT_SN_CLIENT_TOPIC_TABLE_SIZE;
+
+      //The end of the cluster has been reached?
+      if(context->topicTable[i].topicName[0] == '\0')
+         break;
+
+      //Index of the first entry probed for this topic name
+      k = context->topicTable[i].hash % MQTT_SN_CLIENT_TOPIC_TABLE_SIZE;
+
+      //Check whether the entry can be moved to the free slot
+      if((j < i && (k <= j || k > i)) || (j > i && k <= j && k > i))
       {
-         //Release current entry
+         //Move the entry to the free slot
+         context->topicTable[j] = context->topicTable[i];
          context->topicTable[i].topicName[0] = '\0';
 
-         //We are done
-         return NO_ERROR;
+         //The current entry is now free
+         j = i;
       }
    }
 
-   //The specified topic name does not exist
-   return ERROR_NOT_FOUND;
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Search the topic table for a given topic name
+ * @param[in] context Pointer to the MQTT-SN client context
+ * @param[in] topicName Topic name
+ * @return Index of the matching entry, or MQTT_SN_CLIENT_TOPIC_TABLE_SIZE
+ *   if the topic name has not been registered
+ **/
+
+uint_t mqttSnClientFindTopicEntry(MqttSnClientContext *context,
+   const char_t *topicName)
+{
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   uint32_t hash;
+   MqttSnClientTopicEntry *entry;
+
+   //Compute the hash value of the topic name
+   hash = mqttSnClientComputeTopicHash(topicName);
+   //Index of the first entry to probe
+   k = hash % MQTT_SN_CLIENT_TOPIC_TABLE_SIZE;
+
+   //Loop through the topic table
+   for(i = 0; i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; i++)
+   {
+      //Point to the current entry (linear probing)
+      j = (k + i) % MQTT_SN_CLIENT_TOPIC_TABLE_SIZE;
+      entry = &context->topicTable[j];
+
+      //An empty entry terminates the search
+      if(entry->topicName[0] == '\0')
+         break;
+
+      //Matching topic name?
+      if(entry->hash == hash && osStrcmp(entry->topicName, topicName) == 0)
+         return j;
+   }
+
+   //The topic name has not been registered
+   return MQTT_SN_CLIENT_TOPIC_TABLE_SIZE;
+}
+
+
+/**
+ * @brief Compute the hash value of a topic name
+ * @param[in] topicName Topic name
+ * @return Hash value
+ **/
+
+uint32_t mqttSnClientComputeTopicHash(const char_t *topicName)
+{
+   uint32_t hash;
+
+   //Initialize the hash value (FNV-1a offset basis)
+   hash = 2166136261UL;
+
+   //Process the topic name
+   while(*topicName != '\0')
+   {
+      //Mix the current character
+      hash ^= (uint8_t) *(topicName++);
+      //Multiply by the FNV prime
+      hash *= 16777619UL;
+   }
+
+   //Return the resulting hash value
+   return hash;
 }
 
 
@@ -338,7 +441,8 @@ const char_t *mqttSnClientFindTopicId(MqttSnClientContext *context,
       for(i = 0; i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; i++)
       {
          //Matching topic identifier?
-         if(context->topicTable[i].topicId == topicId)
+         if(context->topicTable[i].topicName[0] != '\0' &&
+            context->topicTable[i].topicId == topicId)
          {
             //Retrieve the corresponding topic name
             topicName = context->topicTable[i].topicName;
@@ -371,16 +475,14 @@ uint16_t mqttSnClientFindTopicName(MqttSnClientContext *context,
    //Valid topic name?
    if(topicName != NULL)
    {
-      //Loop through the list of registered topics that have been registered
-      for(i = 0; i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE; i++)
+      //Search the topic table for the specified topic name
+      i = mqttSnClientFindTopicEntry(context, topicName);
+
+      //Matching entry found?
+      if(i < MQTT_SN_CLIENT_TOPIC_TABLE_SIZE)
       {
-         //Matching topic name?
-         if(osStrcmp(context->topicTable[i].topicName, topicName) == 0)
-         {
-            //Retrieve the corresponding topic identifier
-            topicId = context->topicTable[i].topicId;
-            break;
-         }
+         //Retrieve the corresponding topic identifier
+         topicId = context->topicTable[i].topicId;
       }
    }
 
@@ -486,6 +588,38 @@ uint16_t mqttSnClientGenerateMessageId(MqttSnClientContext *context)
 }
 
 
+/**
+ * @brief Find the outstanding REGISTER message that matches a message ID
+ * @param[in] context Pointer to the MQTT-SN client context
+ * @param[in] msgId Message identifier
+ * @return Pointer to the matching entry, if any
+ **/
+
+MqttSnClientRegisterEntry *mqttSnClientFindRegisterEntry(
+   MqttSnClientContext *context, uint16_t msgId)
+{
+   uint_t i;
+   MqttSnClientRegisterEntry *entry;
+
+   //Loop through the list of outstanding REGISTER messages
+   for(i = 0; i < MQTT_SN_CLIENT_MAX_PENDING_REGISTERS; i++)
+   {
+      //Point to the current entry
+      entry = &context->registerTable[i];
+
+      //Matching message identifier?
+      if(entry->topicName != NULL && entry->pending && entry->msgId == msgId)
+      {
+         //Return a pointer to the matching entry
+         return entry;
+      }
+   }
+
+   //No matching entry
+   return NULL;
+}
+
+
 /**
  * @brief Store message ID (QoS 2 message processing)
  * @param[in] context Pointer to the MQTT-SN client context
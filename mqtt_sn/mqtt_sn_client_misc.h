@@ -53,6 +53,11 @@ error_t mqttSnClientAddTopic(MqttSnClientContext *context,
 error_t mqttSnClientDeleteTopic(MqttSnClientContext *context,
    const char_t *topicName);
 
+uint_t mqttSnClientFindTopicEntry(MqttSnClientContext *context,
+   const char_t *topicName);
+
+uint32_t mqttSnClientComputeTopicHash(const char_t *topicName);
+
 const char_t *mqttSnClientFindTopicId(MqttSnClientContext *context,
    uint16_t topicId);
 
@@ -67,6 +72,9 @@ uint16_t mqttSnClientFindPredefTopicName(MqttSnClientContext *context,
 
 uint16_t mqttSnClientGenerateMessageId(MqttSnClientContext *context);
 
+MqttSnClientRegisterEntry *mqttSnClientFindRegisterEntry(
+   MqttSnClientContext *context, uint16_t msgId);
+
 error_t mqttSnClientStoreMessageId(MqttSnClientContext *context,
    uint16_t msgId);
 
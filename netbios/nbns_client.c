@@ -135,6 +135,9 @@ error_t nbnsResolve(NetInterface *interface, const char_t *name, IpAddr *ipAddr)
          //Switch state
          entry->state = DNS_STATE_IN_PROGRESS;
 
+         //Update the DNS cache index
+         dnsUpdateEntry(entry);
+
 #if (NET_RTOS_SUPPORT == ENABLED)
          //Initialize the reference count
          entry->refCount = 1;
@@ -402,6 +405,9 @@ void nbnsProcessResponse(NetInterface *interface, const Ipv4PseudoHeader *pseudo
 
                //Host name successfully resolved
                entry->state = DNS_STATE_RESOLVED;
+
+               //Update the DNS cache index
+               dnsUpdateEntry(entry);
             }
          }
       }
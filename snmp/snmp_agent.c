@@ -53,8 +53,10 @@
 #include "snmp/snmp_agent_dispatch.h"
 #include "snmp/snmp_agent_pdu.h"
 #include "snmp/snmp_agent_misc.h"
+#include "snmp/snmp_agent_object.h"
 #include "snmp/snmp_agent_trap.h"
 #include "snmp/snmp_agent_inform.h"
+#include "snmp/snmp_agent_notify.h"
 #include "mibs/mib2_module.h"
 #include "core/crypto.h"
 #include "encoding/asn1.h"
@@ -423,6 +425,11 @@ error_t snmpAgentLoadMib(SnmpAgentContext *context, const MibModule *module)
          {
             //Add the MIB to the list
             context->mibTable[i] = module;
+
+#if (SNMP_AGENT_MIB_INDEX_SUPPORT == ENABLED)
+            //Merge the objects of the MIB into the index
+            snmpUpdateMibIndex(context);
+#endif
          }
       }
       else
@@ -480,6 +487,11 @@ error_t snmpAgentUnloadMib(SnmpAgentContext *context, const MibModule *module)
       //Remove the MIB from the list
       context->mibTable[i] = NULL;
 
+#if (SNMP_AGENT_MIB_INDEX_SUPPORT == ENABLED)
+      //Remove the objects of the MIB from the index
+      snmpUpdateMibIndex(context);
+#endif
+
       //Successful processing
       error = NO_ERROR;
    }
@@ -1011,6 +1023,10 @@ error_t snmpAgentCreateUser(SnmpAgentContext *context,
       //Check status code
       if(!error)
       {
+#if (SNMP_V3_SUPPORT == ENABLED && SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+         //Precompute HMAC states and cipher key schedules
+         snmpUpdateKeyCache(entry);
+#endif
          //The entry is now available for use
          entry->status = MIB_ROW_STATUS_ACTIVE;
       }
@@ -1174,6 +1190,11 @@ error_t snmpAgentJoinGroup(SnmpAgentContext *context, const char_t *userName,
       error = ERROR_OUT_OF_RESOURCES;
    }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The VACM tables have been modified
+   snmpInvalidateVacmCache(context);
+#endif
+
    //Release exclusive access to the SNMP agent context
    osReleaseMutex(&context->mutex);
 
@@ -1229,6 +1250,11 @@ error_t snmpAgentLeaveGroup(SnmpAgentContext *context,
       error = ERROR_NOT_FOUND;
    }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The VACM tables have been modified
+   snmpInvalidateVacmCache(context);
+#endif
+
    //Release exclusive access to the SNMP agent context
    osReleaseMutex(&context->mutex);
 
@@ -1368,6 +1394,11 @@ error_t snmpAgentCreateAccess(SnmpAgentContext *context,
       error = ERROR_OUT_OF_RESOURCES;
    }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The VACM tables have been modified
+   snmpInvalidateVacmCache(context);
+#endif
+
    //Release exclusive access to the SNMP agent context
    osReleaseMutex(&context->mutex);
 
@@ -1426,6 +1457,11 @@ error_t snmpAgentDeleteAccess(SnmpAgentContext *context,
       error = ERROR_NOT_FOUND;
    }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The VACM tables have been modified
+   snmpInvalidateVacmCache(context);
+#endif
+
    //Release exclusive access to the SNMP agent context
    osReleaseMutex(&context->mutex);
 
@@ -1531,6 +1567,11 @@ error_t snmpAgentCreateView(SnmpAgentContext *context,
       error = ERROR_OUT_OF_RESOURCES;
    }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The VACM tables have been modified
+   snmpInvalidateVacmCache(context);
+#endif
+
    //Release exclusive access to the SNMP agent context
    osReleaseMutex(&context->mutex);
 
@@ -1586,6 +1627,11 @@ error_t snmpAgentDeleteView(SnmpAgentContext *context,
       error = ERROR_NOT_FOUND;
    }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The VACM tables have been modified
+   snmpInvalidateVacmCache(context);
+#endif
+
    //Release exclusive access to the SNMP agent context
    osReleaseMutex(&context->mutex);
 
@@ -1959,6 +2005,162 @@ error_t snmpAgentSendInform(SnmpAgentContext *context,
 }
 
 
+/**
+ * @brief Queue SNMP trap notification
+ *
+ * The notification is sent asynchronously by the SNMP agent task. The values
+ * of the objects are retrieved at the time the notification is sent
+ *
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] destIpAddr Destination IP address
+ * @param[in] version SNMP version identifier
+ * @param[in] userName User name or community name
+ * @param[in] genericTrapType Generic trap type
+ * @param[in] specificTrapCode Specific code
+ * @param[in] objectList List of object names
+ * @param[in] objectListSize Number of entries in the list
+ * @return Error code
+ **/
+
+error_t snmpAgentQueueTrap(SnmpAgentContext *context,
+   const IpAddr *destIpAddr, SnmpVersion version, const char_t *userName,
+   uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize)
+{
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED && SNMP_AGENT_TRAP_SUPPORT == ENABLED)
+   error_t error;
+
+   //Check parameters
+   if(context == NULL || destIpAddr == NULL || userName == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Make sure the list of objects is valid
+   if(objectListSize > 0 && objectList == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Acquire exclusive access to the SNMP agent context
+   osAcquireMutex(&context->mutex);
+
+   //Add the notification to the queue
+   error = snmpQueueNotification(context, FALSE, destIpAddr, version,
+      userName, genericTrapType, specificTrapCode, objectList,
+      objectListSize);
+
+   //Release exclusive access to the SNMP agent context
+   osReleaseMutex(&context->mutex);
+
+   //Check status code
+   if(!error)
+   {
+      //Notify the SNMP agent task that a notification is pending
+      osSetEvent(&context->event);
+   }
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+/**
+ * @brief Queue SNMP inform request
+ *
+ * The inform request is sent asynchronously by the SNMP agent task and
+ * retransmitted until an acknowledgment is received
+ *
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] destIpAddr Destination IP address
+ * @param[in] version SNMP version identifier
+ * @param[in] userName User name or community name
+ * @param[in] genericTrapType Generic trap type
+ * @param[in] specificTrapCode Specific code
+ * @param[in] objectList List of object names
+ * @param[in] objectListSize Number of entries in the list
+ * @return Error code
+ **/
+
+error_t snmpAgentQueueInform(SnmpAgentContext *context,
+   const IpAddr *destIpAddr, SnmpVersion version, const char_t *userName,
+   uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize)
+{
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED && SNMP_AGENT_INFORM_SUPPORT == ENABLED)
+   error_t error;
+
+   //Check parameters
+   if(context == NULL || destIpAddr == NULL || userName == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Make sure the list of objects is valid
+   if(objectListSize > 0 && objectList == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Engine discovery is only performed by snmpAgentSendInform, hence
+   //SNMPv3 inform requests cannot be queued
+   if(version != SNMP_VERSION_2C)
+      return ERROR_INVALID_VERSION;
+
+   //Acquire exclusive access to the SNMP agent context
+   osAcquireMutex(&context->mutex);
+
+   //Add the notification to the queue
+   error = snmpQueueNotification(context, TRUE, destIpAddr, version,
+      userName, genericTrapType, specificTrapCode, objectList,
+      objectListSize);
+
+   //Release exclusive access to the SNMP agent context
+   osReleaseMutex(&context->mutex);
+
+   //Check status code
+   if(!error)
+   {
+      //Notify the SNMP agent task that a notification is pending
+      osSetEvent(&context->event);
+   }
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+/**
+ * @brief Retrieve notification queue statistics
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[out] stats Notification queue statistics
+ * @return Error code
+ **/
+
+error_t snmpAgentGetNotifyStats(SnmpAgentContext *context,
+   SnmpNotifyStats *stats)
+{
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED)
+   //Check parameters
+   if(context == NULL || stats == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Acquire exclusive access to the SNMP agent context
+   osAcquireMutex(&context->mutex);
+   //Copy statistics
+   *stats = context->notifyStats;
+   //Release exclusive access to the SNMP agent context
+   osReleaseMutex(&context->mutex);
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief SNMP agent task
  * @param[in] context Pointer to the SNMP agent context
@@ -1983,8 +2185,14 @@ void snmpAgentTask(SnmpAgentContext *context)
       eventDesc.eventMask = SOCKET_EVENT_RX_READY;
       eventDesc.eventFlags = 0;
 
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED)
+      //Wait for an event (the notification queue is processed periodically)
+      socketPoll(&eventDesc, 1, &context->event,
+         SNMP_AGENT_NOTIFY_TICK_INTERVAL);
+#else
       //Wait for an event
       socketPoll(&eventDesc, 1, &context->event, INFINITE_DELAY);
+#endif
 
       //Stop request?
       if(context->stop)
@@ -2082,6 +2290,15 @@ void snmpAgentTask(SnmpAgentContext *context)
             }
          }
       }
+
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED)
+      //Acquire exclusive access to the SNMP agent context
+      osAcquireMutex(&context->mutex);
+      //Send pending notifications and retransmit unacknowledged inform requests
+      snmpProcessNotifyQueue(context);
+      //Release exclusive access to the SNMP agent context
+      osReleaseMutex(&context->mutex);
+#endif
 #if (NET_RTOS_SUPPORT == ENABLED)
    }
 #endif
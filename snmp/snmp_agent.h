@@ -41,6 +41,7 @@ struct _SnmpAgentContext;
 #include "snmp/snmp_agent_message.h"
 #include "snmp/snmp_agent_trap.h"
 #include "snmp/snmp_agent_inform.h"
+#include "snmp/snmp_agent_notify.h"
 #include "snmp/snmp_agent_usm.h"
 #include "snmp/snmp_agent_vacm.h"
 #include "mibs/mib_common.h"
@@ -71,6 +72,20 @@ struct _SnmpAgentContext;
    #error SNMP_AGENT_MAX_MIBS parameter is not valid
 #endif
 
+//Sorted index of the objects of all the loaded MIBs
+#ifndef SNMP_AGENT_MIB_INDEX_SUPPORT
+   #define SNMP_AGENT_MIB_INDEX_SUPPORT DISABLED
+#elif (SNMP_AGENT_MIB_INDEX_SUPPORT != ENABLED && SNMP_AGENT_MIB_INDEX_SUPPORT != DISABLED)
+   #error SNMP_AGENT_MIB_INDEX_SUPPORT parameter is not valid
+#endif
+
+//Maximum number of objects in the MIB index
+#ifndef SNMP_AGENT_MIB_INDEX_SIZE
+   #define SNMP_AGENT_MIB_INDEX_SIZE 512
+#elif (SNMP_AGENT_MIB_INDEX_SIZE < 1)
+   #error SNMP_AGENT_MIB_INDEX_SIZE parameter is not valid
+#endif
+
 //Maximum number of community strings
 #ifndef SNMP_AGENT_MAX_COMMUNITIES
    #define SNMP_AGENT_MAX_COMMUNITIES 3
@@ -124,6 +139,26 @@ extern "C" {
 typedef error_t (*SnmpAgentRandCallback)(uint8_t *data, size_t length);
 
 
+#if (SNMP_AGENT_VACM_SUPPORT == ENABLED && SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+
+/**
+ * @brief VACM access-decision cache
+ **/
+
+typedef struct
+{
+   bool_t sorted;                                     ///<The sorted view table is up to date
+   SnmpViewEntry *views[SNMP_AGENT_VIEW_TABLE_SIZE];  ///<View entries, sorted by view name and in order of precedence
+   uint_t numViews;                                   ///<Number of entries in the sorted view table
+   bool_t resolved;                                   ///<The MIB view of the current request has been resolved
+   error_t status;                                    ///<Result of the resolution
+   uint_t firstView;                                  ///<Index of the first entry of the MIB view
+   uint_t lastView;                                   ///<Index following the last entry of the MIB view
+} SnmpVacmCache;
+
+#endif
+
+
 /**
  * @brief SNMP agent settings
  **/
@@ -163,6 +198,11 @@ struct _SnmpAgentContext
    uint8_t enterpriseOid[SNMP_MAX_OID_SIZE];                  ///<Enterprise OID
    size_t enterpriseOidLen;                                   ///<Length of the enterprise OID
    const MibModule *mibTable[SNMP_AGENT_MAX_MIBS];            ///<MIB modules
+#if (SNMP_AGENT_MIB_INDEX_SUPPORT == ENABLED)
+   const MibObject *mibIndex[SNMP_AGENT_MIB_INDEX_SIZE];      ///<Objects of all the loaded MIBs, in lexicographic order
+   uint_t mibIndexSize;                                       ///<Number of objects in the MIB index
+   bool_t mibIndexValid;                                      ///<The MIB index covers all the loaded MIBs
+#endif
 #if (SNMP_V1_SUPPORT == ENABLED || SNMP_V2C_SUPPORT == ENABLED)
    SnmpUserEntry communityTable[SNMP_AGENT_MAX_COMMUNITIES];  ///<Community strings
 #endif
@@ -173,6 +213,9 @@ struct _SnmpAgentContext
    SnmpGroupEntry groupTable[SNMP_AGENT_GROUP_TABLE_SIZE];    ///<List of groups
    SnmpAccessEntry accessTable[SNMP_AGENT_ACCESS_TABLE_SIZE]; ///<Access rights for groups
    SnmpViewEntry viewTable[SNMP_AGENT_VIEW_TABLE_SIZE];       ///<Families of subtrees within MIB views
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   SnmpVacmCache vacmCache;                                   ///<VACM access-decision cache
+#endif
 #endif
    Socket *socket;                                            ///<Underlying socket
    NetInterface *localInterface;                              ///<Network interface the SNMP request was received on
@@ -207,6 +250,14 @@ struct _SnmpAgentContext
    int32_t informEngineTime;                                  ///<SNMP engine time of the remote application
    int32_t informMsgId;                                       ///<Message identifier
 #endif
+#endif
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED)
+   SnmpNotifyEntry notifyQueue[SNMP_AGENT_NOTIFY_QUEUE_SIZE]; ///<Notification queue
+   systime_t notifyTimestamp;                                 ///<Time at which the last queued notification was sent
+   SnmpNotifyStats notifyStats;                               ///<Notification queue statistics
+#if (SNMP_AGENT_INFORM_SUPPORT == ENABLED)
+   uint8_t notifyBuffer[SNMP_AGENT_NOTIFY_MAX_OUTSTANDING][SNMP_MAX_MSG_SIZE]; ///<Inform requests awaiting acknowledgment
+#endif
 #endif
    SNMP_AGENT_PRIVATE_CONTEXT                                 ///<Application specific context
 };
@@ -285,6 +336,19 @@ error_t snmpAgentSendInform(SnmpAgentContext *context,
    uint_t genericTrapType, uint_t specificTrapCode,
    const SnmpTrapObject *objectList, uint_t objectListSize);
 
+error_t snmpAgentQueueTrap(SnmpAgentContext *context,
+   const IpAddr *destIpAddr, SnmpVersion version, const char_t *userName,
+   uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize);
+
+error_t snmpAgentQueueInform(SnmpAgentContext *context,
+   const IpAddr *destIpAddr, SnmpVersion version, const char_t *userName,
+   uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize);
+
+error_t snmpAgentGetNotifyStats(SnmpAgentContext *context,
+   SnmpNotifyStats *stats);
+
 void snmpAgentTask(SnmpAgentContext *context);
 
 void snmpAgentDeinit(SnmpAgentContext *context);
@@ -36,6 +36,7 @@
 #include "snmp/snmp_agent.h"
 #include "snmp/snmp_agent_misc.h"
 #include "snmp/snmp_agent_inform.h"
+#include "snmp/snmp_agent_notify.h"
 #include "mibs/mib2_module.h"
 #include "debug.h"
 
@@ -310,6 +311,12 @@ error_t snmpFormatInformRequestPdu(SnmpAgentContext *context,
    if(error)
       return error;
 
+#if (SNMP_AGENT_VACM_SUPPORT == ENABLED && SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The MIB view resolved for the last request cannot be reused, since the
+   //notify view of the target must be used
+   snmpResetVacmCache(context);
+#endif
+
    //Format the list of variable bindings
    error = snmpWriteTrapVarBindingList(context, genericTrapType,
       specificTrapCode, objectList, objectListSize);
@@ -461,6 +468,12 @@ error_t snmpProcessGetResponsePdu(SnmpAgentContext *context)
          //The inform request has been acknowledged
          osSetEvent(&context->informEvent);
       }
+
+#if (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED)
+      //Check whether a queued inform request has been acknowledged
+      snmpAcknowledgeNotification(context, &context->remoteIpAddr,
+         message->requestId);
+#endif
    }
 
    //Successful processing
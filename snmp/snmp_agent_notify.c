@@ -0,0 +1,600 @@
+/**
+ * @file snmp_agent_notify.c
+ * @brief SNMP notification queue
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL SNMP_TRACE_LEVEL
+
+//Dependencies
+#include "core/net.h"
+#include "snmp/snmp_agent.h"
+#include "snmp/snmp_agent_misc.h"
+#include "snmp/snmp_agent_trap.h"
+#include "snmp/snmp_agent_inform.h"
+#include "snmp/snmp_agent_notify.h"
+#include "snmp/snmp_agent_usm.h"
+#include "mibs/mib2_module.h"
+#include "encoding/asn1.h"
+#include "debug.h"
+
+//Check TCP/IP stack configuration
+#if (SNMP_AGENT_SUPPORT == ENABLED && SNMP_AGENT_NOTIFY_QUEUE_SUPPORT == ENABLED)
+
+
+/**
+ * @brief Add a notification to the queue
+ *
+ * A notification identical to a pending one is coalesced with it. The values
+ * of the objects are retrieved when the notification is actually sent
+ *
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] inform Inform request (TRUE) or trap (FALSE)
+ * @param[in] destIpAddr Destination IP address
+ * @param[in] version SNMP version identifier
+ * @param[in] userName User name or community name
+ * @param[in] genericTrapType Generic trap type
+ * @param[in] specificTrapCode Specific code
+ * @param[in] objectList List of object names
+ * @param[in] objectListSize Number of entries in the list
+ * @return Error code
+ **/
+
+error_t snmpQueueNotification(SnmpAgentContext *context, bool_t inform,
+   const IpAddr *destIpAddr, SnmpVersion version, const char_t *userName,
+   uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize)
+{
+   uint_t i;
+   SnmpNotifyEntry *entry;
+
+   //Make sure the list of objects fits in a queue entry
+   if(objectListSize > SNMP_AGENT_NOTIFY_MAX_OBJECTS)
+      return ERROR_INVALID_LENGTH;
+
+   //Make sure the length of the user name is acceptable
+   if(osStrlen(userName) > SNMP_MAX_USER_NAME_LEN)
+      return ERROR_INVALID_LENGTH;
+
+   //Search the queue for an identical notification that has not been sent yet
+   entry = snmpFindPendingNotification(context, inform, destIpAddr, version,
+      userName, genericTrapType, specificTrapCode, objectList, objectListSize);
+
+   //Duplicate notification?
+   if(entry != NULL)
+   {
+      //Coalesce the notifications
+      entry->count++;
+      //Update statistics
+      context->notifyStats.coalesced++;
+
+      //Successful processing
+      return NO_ERROR;
+   }
+
+   //Loop through the notification queue
+   for(i = 0; i < SNMP_AGENT_NOTIFY_QUEUE_SIZE; i++)
+   {
+      //Check whether the current entry is free
+      if(context->notifyQueue[i].state == SNMP_NOTIFY_STATE_NONE)
+      {
+         entry = &context->notifyQueue[i];
+         break;
+      }
+   }
+
+   //The queue is full?
+   if(entry == NULL)
+   {
+      //Update statistics
+      context->notifyStats.dropped++;
+      //The notification is discarded
+      return ERROR_OUT_OF_RESOURCES;
+   }
+
+   //Save the parameters of the notification
+   entry->inform = inform;
+   entry->destIpAddr = *destIpAddr;
+   entry->version = version;
+   osStrcpy(entry->userName, userName);
+   entry->genericTrapType = genericTrapType;
+   entry->specificTrapCode = specificTrapCode;
+
+   //Copy the list of object names
+   for(i = 0; i < objectListSize; i++)
+   {
+      entry->objectList[i] = objectList[i];
+   }
+
+   //Save the number of objects
+   entry->objectListSize = objectListSize;
+
+   //Initialize retransmission parameters
+   entry->timeout = SNMP_AGENT_INFORM_TIMEOUT;
+   entry->retransmitCount = 0;
+
+   //Save the time at which the notification was queued
+   entry->timestamp = osGetSystemTime();
+   entry->count = 1;
+
+   //The notification is pending
+   entry->state = SNMP_NOTIFY_STATE_PENDING;
+
+   //Update statistics
+   context->notifyStats.queued++;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Search the queue for a pending notification
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] inform Inform request (TRUE) or trap (FALSE)
+ * @param[in] destIpAddr Destination IP address
+ * @param[in] version SNMP version identifier
+ * @param[in] userName User name or community name
+ * @param[in] genericTrapType Generic trap type
+ * @param[in] specificTrapCode Specific code
+ * @param[in] objectList List of object names
+ * @param[in] objectListSize Number of entries in the list
+ * @return Pointer to the matching entry, if any
+ **/
+
+SnmpNotifyEntry *snmpFindPendingNotification(SnmpAgentContext *context,
+   bool_t inform, const IpAddr *destIpAddr, SnmpVersion version,
+   const char_t *userName, uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize)
+{
+   uint_t i;
+   uint_t j;
+   SnmpNotifyEntry *entry;
+
+   //Loop through the notification queue
+   for(i = 0; i < SNMP_AGENT_NOTIFY_QUEUE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &context->notifyQueue[i];
+
+      //Only notifications that have not been sent yet can be coalesced
+      if(entry->state != SNMP_NOTIFY_STATE_PENDING)
+         continue;
+
+      //Compare the parameters of the notifications
+      if(entry->inform != inform || entry->version != version ||
+         entry->genericTrapType != genericTrapType ||
+         entry->specificTrapCode != specificTrapCode ||
+         entry->objectListSize != objectListSize)
+      {
+         continue;
+      }
+
+      //Compare destination addresses and user names
+      if(!ipCompAddr(&entry->destIpAddr, destIpAddr) ||
+         osStrcmp(entry->userName, userName))
+      {
+         continue;
+      }
+
+      //Compare the lists of object names
+      for(j = 0; j < objectListSize; j++)
+      {
+         if(entry->objectList[j].oidLen != objectList[j].oidLen ||
+            osMemcmp(entry->objectList[j].oid, objectList[j].oid,
+            objectList[j].oidLen))
+         {
+            break;
+         }
+      }
+
+      //Matching notification?
+      if(j == objectListSize)
+         return entry;
+   }
+
+   //No matching notification
+   return NULL;
+}
+
+
+/**
+ * @brief Process the notification queue
+ *
+ * This routine sends the pending notifications in FIFO order and manages
+ * the retransmission of the inform requests that have not been acknowledged
+ *
+ * @param[in] context Pointer to the SNMP agent context
+ **/
+
+void snmpProcessNotifyQueue(SnmpAgentContext *context)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   systime_t time;
+   SnmpNotifyEntry *entry;
+
+   //Get current time
+   time = osGetSystemTime();
+
+   //Number of outstanding inform requests
+   n = 0;
+
+   //Loop through the notification queue
+   for(i = 0; i < SNMP_AGENT_NOTIFY_QUEUE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &context->notifyQueue[i];
+
+      //Inform request awaiting acknowledgment?
+      if(entry->state == SNMP_NOTIFY_STATE_WAITING_RESP)
+      {
+         //Check whether the retransmission timeout has elapsed
+         if(timeCompare(time, entry->timestamp + entry->timeout) >= 0)
+         {
+            //The request should be retransmitted if no corresponding response
+            //is received in an appropriate time interval
+            if(entry->retransmitCount < SNMP_AGENT_INFORM_MAX_RETRIES)
+            {
+               //The retransmission timeout is doubled each time
+               entry->timeout = MIN(entry->timeout * 2,
+                  SNMP_AGENT_NOTIFY_MAX_TIMEOUT);
+
+               //Retransmit the inform request
+               snmpRetransmitNotification(context, entry);
+
+               //Update statistics
+               context->notifyStats.retransmitted++;
+            }
+            else
+            {
+               //Update statistics
+               context->notifyStats.timedOut++;
+               //Release the entry
+               entry->state = SNMP_NOTIFY_STATE_NONE;
+            }
+         }
+
+         //Still waiting for an acknowledgment?
+         if(entry->state == SNMP_NOTIFY_STATE_WAITING_RESP)
+         {
+            n++;
+         }
+      }
+   }
+
+   //Send pending notifications
+   while(1)
+   {
+#if (SNMP_AGENT_NOTIFY_MIN_INTERVAL > 0)
+      //Limit the rate at which notifications are sent
+      if(timeCompare(time, context->notifyTimestamp +
+         SNMP_AGENT_NOTIFY_MIN_INTERVAL) < 0)
+      {
+         break;
+      }
+#endif
+
+      //Select the oldest pending notification
+      entry = NULL;
+
+      //Loop through the notification queue
+      for(i = 0; i < SNMP_AGENT_NOTIFY_QUEUE_SIZE; i++)
+      {
+         //Pending notification?
+         if(context->notifyQueue[i].state == SNMP_NOTIFY_STATE_PENDING)
+         {
+            //Limit the number of outstanding inform requests
+            if(context->notifyQueue[i].inform &&
+               n >= SNMP_AGENT_NOTIFY_MAX_OUTSTANDING)
+            {
+               continue;
+            }
+
+            //Keep track of the oldest entry
+            if(entry == NULL || timeCompare(context->notifyQueue[i].timestamp,
+               entry->timestamp) < 0)
+            {
+               entry = &context->notifyQueue[i];
+            }
+         }
+      }
+
+      //No more notification to send?
+      if(entry == NULL)
+         break;
+
+      //Send the notification
+      error = snmpSendNotification(context, entry);
+
+      //Check status code
+      if(!error)
+      {
+         //Update statistics
+         context->notifyStats.sent++;
+
+         //Inform request?
+         if(entry->inform)
+         {
+            //Wait for the acknowledgment
+            entry->state = SNMP_NOTIFY_STATE_WAITING_RESP;
+            //Increment the number of outstanding inform requests
+            n++;
+         }
+         else
+         {
+            //Release the entry
+            entry->state = SNMP_NOTIFY_STATE_NONE;
+         }
+      }
+      else
+      {
+         //Update statistics
+         context->notifyStats.dropped++;
+         //Release the entry
+         entry->state = SNMP_NOTIFY_STATE_NONE;
+      }
+
+      //Save the time at which the last notification was sent
+      context->notifyTimestamp = time;
+   }
+}
+
+
+/**
+ * @brief Send a queued notification
+ *
+ * Inform requests are formatted once. The resulting message is kept until
+ * the request is acknowledged, so that retransmissions carry the same
+ * request-id and the same variable bindings
+ *
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] entry Pointer to the queued notification
+ * @return Error code
+ **/
+
+error_t snmpSendNotification(SnmpAgentContext *context,
+   SnmpNotifyEntry *entry)
+{
+   error_t error;
+#if (SNMP_AGENT_INFORM_SUPPORT == ENABLED)
+   uint_t i;
+   uint_t j;
+   int32_t informRequestId;
+#endif
+
+#if (SNMP_V3_SUPPORT == ENABLED)
+   //Refresh SNMP engine time
+   snmpRefreshEngineTime(context);
+#endif
+
+#if (SNMP_AGENT_INFORM_SUPPORT == ENABLED)
+   //Inform request?
+   if(entry->inform)
+   {
+      //Loop through the buffers that hold the inform requests
+      for(i = 0; i < SNMP_AGENT_NOTIFY_MAX_OUTSTANDING; i++)
+      {
+         //Check whether the current buffer is in use
+         for(j = 0; j < SNMP_AGENT_NOTIFY_QUEUE_SIZE; j++)
+         {
+            if(context->notifyQueue[j].state == SNMP_NOTIFY_STATE_WAITING_RESP &&
+               context->notifyQueue[j].bufferIndex == i)
+            {
+               break;
+            }
+         }
+
+         //Free buffer?
+         if(j >= SNMP_AGENT_NOTIFY_QUEUE_SIZE)
+            break;
+      }
+
+      //Any buffer available?
+      if(i < SNMP_AGENT_NOTIFY_MAX_OUTSTANDING)
+      {
+         //Preserve the request identifier of a blocking inform request that
+         //may be in progress
+         informRequestId = context->informRequestId;
+
+         //Format InformRequest message
+         error = snmpFormatInformRequestMessage(context, entry->version,
+            entry->userName, entry->genericTrapType, entry->specificTrapCode,
+            entry->objectList, entry->objectListSize);
+
+         //Save the request identifier of the queued inform request
+         entry->requestId = context->informRequestId;
+         //Restore the request identifier of the blocking inform request
+         context->informRequestId = informRequestId;
+
+         //Check status code
+         if(!error)
+         {
+            //Keep a copy of the message for retransmissions
+            osMemcpy(context->notifyBuffer[i], context->response.pos,
+               context->response.length);
+
+            //Save the location and the length of the message
+            entry->bufferIndex = i;
+            entry->messageLen = context->response.length;
+
+            //Send the inform request
+            error = snmpRetransmitNotification(context, entry);
+            //The first transmission is not a retransmission
+            entry->retransmitCount = 0;
+         }
+      }
+      else
+      {
+         //Report an error
+         error = ERROR_OUT_OF_RESOURCES;
+      }
+   }
+   else
+#endif
+#if (SNMP_AGENT_TRAP_SUPPORT == ENABLED)
+   //Trap notification?
+   if(!entry->inform)
+   {
+      //Format Trap message
+      error = snmpFormatTrapMessage(context, entry->version, entry->userName,
+         entry->genericTrapType, entry->specificTrapCode, entry->objectList,
+         entry->objectListSize);
+
+      //Check status code
+      if(!error)
+      {
+         //Total number of messages which were passed from the SNMP protocol
+         //entity to the transport service
+         MIB2_SNMP_INC_COUNTER32(snmpOutPkts, 1);
+
+         //Debug message
+         TRACE_INFO("Sending SNMP message to %s port %" PRIu16 " (%" PRIuSIZE " bytes)...\r\n",
+            ipAddrToString(&entry->destIpAddr, NULL), context->trapPort,
+            context->response.length);
+
+         //Display the contents of the SNMP message
+         TRACE_DEBUG_ARRAY("  ", context->response.pos, context->response.length);
+         //Display ASN.1 structure
+         asn1DumpObject(context->response.pos, context->response.length, 0);
+
+         //Send SNMP message
+         error = socketSendTo(context->socket, &entry->destIpAddr,
+            context->trapPort, context->response.pos, context->response.length,
+            NULL, 0);
+      }
+   }
+   else
+#endif
+   //Unsupported notification type?
+   {
+      //Report an error
+      error = ERROR_NOT_IMPLEMENTED;
+   }
+
+   //Save the time at which the notification was sent
+   entry->timestamp = osGetSystemTime();
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Retransmit a queued inform request
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] entry Pointer to the queued inform request
+ * @return Error code
+ **/
+
+error_t snmpRetransmitNotification(SnmpAgentContext *context,
+   SnmpNotifyEntry *entry)
+{
+#if (SNMP_AGENT_INFORM_SUPPORT == ENABLED)
+   error_t error;
+   const uint8_t *message;
+
+   //Point to the formatted inform request
+   message = context->notifyBuffer[entry->bufferIndex];
+
+   //Total number of messages which were passed from the SNMP protocol
+   //entity to the transport service
+   MIB2_SNMP_INC_COUNTER32(snmpOutPkts, 1);
+
+   //Debug message
+   TRACE_INFO("Sending SNMP message to %s port %" PRIu16 " (%" PRIuSIZE " bytes)...\r\n",
+      ipAddrToString(&entry->destIpAddr, NULL), context->trapPort,
+      entry->messageLen);
+
+   //Display the contents of the SNMP message
+   TRACE_DEBUG_ARRAY("  ", message, entry->messageLen);
+   //Display ASN.1 structure
+   asn1DumpObject(message, entry->messageLen, 0);
+
+   //Send SNMP message
+   error = socketSendTo(context->socket, &entry->destIpAddr,
+      context->trapPort, message, entry->messageLen, NULL, 0);
+
+   //Save the time at which the inform request was sent
+   entry->timestamp = osGetSystemTime();
+   //Increment retransmission counter
+   entry->retransmitCount++;
+
+   //Return status code
+   return error;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+/**
+ * @brief Acknowledge a queued inform request
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] srcIpAddr Source IP address of the GetResponse-PDU
+ * @param[in] requestId Request identifier of the GetResponse-PDU
+ * @return TRUE if a matching inform request has been found, else FALSE
+ **/
+
+bool_t snmpAcknowledgeNotification(SnmpAgentContext *context,
+   const IpAddr *srcIpAddr, int32_t requestId)
+{
+   uint_t i;
+   SnmpNotifyEntry *entry;
+
+   //Loop through the notification queue
+   for(i = 0; i < SNMP_AGENT_NOTIFY_QUEUE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &context->notifyQueue[i];
+
+      //Inform request awaiting acknowledgment?
+      if(entry->state == SNMP_NOTIFY_STATE_WAITING_RESP)
+      {
+         //Compare the request-id and the address of the peer
+         if(entry->requestId == requestId &&
+            ipCompAddr(&entry->destIpAddr, srcIpAddr))
+         {
+            //Update statistics
+            context->notifyStats.acknowledged++;
+            //The inform request has been acknowledged
+            entry->state = SNMP_NOTIFY_STATE_NONE;
+
+            //A matching inform request has been found
+            return TRUE;
+         }
+      }
+   }
+
+   //No matching inform request
+   return FALSE;
+}
+
+#endif
@@ -0,0 +1,173 @@
+/**
+ * @file snmp_agent_notify.h
+ * @brief SNMP notification queue
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+#ifndef _SNMP_AGENT_NOTIFY_H
+#define _SNMP_AGENT_NOTIFY_H
+
+//Dependencies
+#include "core/net.h"
+#include "snmp/snmp_agent.h"
+
+//Notification queue support
+#ifndef SNMP_AGENT_NOTIFY_QUEUE_SUPPORT
+   #define SNMP_AGENT_NOTIFY_QUEUE_SUPPORT DISABLED
+#elif (SNMP_AGENT_NOTIFY_QUEUE_SUPPORT != ENABLED && SNMP_AGENT_NOTIFY_QUEUE_SUPPORT != DISABLED)
+   #error SNMP_AGENT_NOTIFY_QUEUE_SUPPORT parameter is not valid
+#endif
+
+//Size of the notification queue
+#ifndef SNMP_AGENT_NOTIFY_QUEUE_SIZE
+   #define SNMP_AGENT_NOTIFY_QUEUE_SIZE 8
+#elif (SNMP_AGENT_NOTIFY_QUEUE_SIZE < 1)
+   #error SNMP_AGENT_NOTIFY_QUEUE_SIZE parameter is not valid
+#endif
+
+//Maximum number of objects per queued notification
+#ifndef SNMP_AGENT_NOTIFY_MAX_OBJECTS
+   #define SNMP_AGENT_NOTIFY_MAX_OBJECTS 4
+#elif (SNMP_AGENT_NOTIFY_MAX_OBJECTS < 1)
+   #error SNMP_AGENT_NOTIFY_MAX_OBJECTS parameter is not valid
+#endif
+
+//Maximum number of outstanding inform requests
+#ifndef SNMP_AGENT_NOTIFY_MAX_OUTSTANDING
+   #define SNMP_AGENT_NOTIFY_MAX_OUTSTANDING 2
+#elif (SNMP_AGENT_NOTIFY_MAX_OUTSTANDING < 1)
+   #error SNMP_AGENT_NOTIFY_MAX_OUTSTANDING parameter is not valid
+#endif
+
+//Maximum retransmission timeout of queued inform requests
+#ifndef SNMP_AGENT_NOTIFY_MAX_TIMEOUT
+   #define SNMP_AGENT_NOTIFY_MAX_TIMEOUT 16000
+#elif (SNMP_AGENT_NOTIFY_MAX_TIMEOUT < 1000)
+   #error SNMP_AGENT_NOTIFY_MAX_TIMEOUT parameter is not valid
+#endif
+
+//Minimum interval between two notifications (0 means no rate limiting)
+#ifndef SNMP_AGENT_NOTIFY_MIN_INTERVAL
+   #define SNMP_AGENT_NOTIFY_MIN_INTERVAL 0
+#elif (SNMP_AGENT_NOTIFY_MIN_INTERVAL < 0)
+   #error SNMP_AGENT_NOTIFY_MIN_INTERVAL parameter is not valid
+#endif
+
+//Notification queue processing interval
+#ifndef SNMP_AGENT_NOTIFY_TICK_INTERVAL
+   #define SNMP_AGENT_NOTIFY_TICK_INTERVAL 100
+#elif (SNMP_AGENT_NOTIFY_TICK_INTERVAL < 10)
+   #error SNMP_AGENT_NOTIFY_TICK_INTERVAL parameter is not valid
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief State of a queued notification
+ **/
+
+typedef enum
+{
+   SNMP_NOTIFY_STATE_NONE         = 0,
+   SNMP_NOTIFY_STATE_PENDING      = 1,
+   SNMP_NOTIFY_STATE_WAITING_RESP = 2
+} SnmpNotifyState;
+
+
+/**
+ * @brief Queued notification
+ **/
+
+typedef struct
+{
+   SnmpNotifyState state;                                    ///<State of the notification
+   bool_t inform;                                            ///<Inform request (TRUE) or trap (FALSE)
+   IpAddr destIpAddr;                                        ///<Destination IP address
+   SnmpVersion version;                                      ///<SNMP version identifier
+   char_t userName[SNMP_MAX_USER_NAME_LEN + 1];              ///<User name or community name
+   uint_t genericTrapType;                                   ///<Generic trap type
+   uint_t specificTrapCode;                                  ///<Specific code
+   SnmpTrapObject objectList[SNMP_AGENT_NOTIFY_MAX_OBJECTS]; ///<List of object names
+   uint_t objectListSize;                                    ///<Number of entries in the list
+   uint_t count;                                             ///<Number of coalesced notifications
+   int32_t requestId;                                        ///<Request identifier of the inform request
+   uint_t bufferIndex;                                       ///<Buffer holding the formatted inform request
+   size_t messageLen;                                        ///<Length of the formatted inform request
+   systime_t timestamp;                                      ///<Time at which the entry was queued or last sent
+   systime_t timeout;                                        ///<Retransmission timeout
+   uint_t retransmitCount;                                   ///<Retransmission counter
+} SnmpNotifyEntry;
+
+
+/**
+ * @brief Notification queue statistics
+ **/
+
+typedef struct
+{
+   uint32_t queued;        ///<Number of notifications added to the queue
+   uint32_t coalesced;     ///<Number of notifications merged with a pending duplicate
+   uint32_t dropped;       ///<Number of notifications discarded because the queue was full or could not be sent
+   uint32_t sent;          ///<Number of notifications sent (first transmission)
+   uint32_t retransmitted; ///<Number of inform requests retransmitted
+   uint32_t acknowledged;  ///<Number of inform requests acknowledged
+   uint32_t timedOut;      ///<Number of inform requests that were never acknowledged
+} SnmpNotifyStats;
+
+
+//SNMP notification queue related functions
+error_t snmpQueueNotification(SnmpAgentContext *context, bool_t inform,
+   const IpAddr *destIpAddr, SnmpVersion version, const char_t *userName,
+   uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize);
+
+SnmpNotifyEntry *snmpFindPendingNotification(SnmpAgentContext *context,
+   bool_t inform, const IpAddr *destIpAddr, SnmpVersion version,
+   const char_t *userName, uint_t genericTrapType, uint_t specificTrapCode,
+   const SnmpTrapObject *objectList, uint_t objectListSize);
+
+void snmpProcessNotifyQueue(SnmpAgentContext *context);
+
+error_t snmpSendNotification(SnmpAgentContext *context,
+   SnmpNotifyEntry *entry);
+
+error_t snmpRetransmitNotification(SnmpAgentContext *context,
+   SnmpNotifyEntry *entry);
+
+bool_t snmpAcknowledgeNotification(SnmpAgentContext *context,
+   const IpAddr *srcIpAddr, int32_t requestId);
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
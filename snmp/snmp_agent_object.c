@@ -181,6 +181,11 @@ error_t snmpSetObjectValue(SnmpAgentContext *context,
    {
       //Invoke callback function to assign object value
       error = object->setValue(object, var->oid, var->oidLen, value, n, commit);
+
+#if (SNMP_AGENT_VACM_SUPPORT == ENABLED && SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+      //The callback may have modified the VACM tables
+      snmpInvalidateVacmCache(context);
+#endif
    }
    //Simple scalar objects can also be attached to a variable
    else if(object->value != NULL)
@@ -445,6 +450,12 @@ error_t snmpGetNextObject(SnmpAgentContext *context,
    const MibObject *object;
    const MibObject *nextObject;
 
+#if (SNMP_AGENT_MIB_INDEX_SUPPORT == ENABLED)
+   //Search the sorted index rather than walking through every MIB
+   if(context->mibIndexValid)
+      return snmpGetNextIndexedObject(context, message, var);
+#endif
+
    //Initialize status code
    error = NO_ERROR;
 
@@ -676,6 +687,320 @@ error_t snmpGetNextObject(SnmpAgentContext *context,
 }
 
 
+#if (SNMP_AGENT_MIB_INDEX_SUPPORT == ENABLED)
+
+/**
+ * @brief Search the MIB index for the next object
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] message Pointer to the received SNMP message
+ * @param[in] var Variable binding
+ * @return Error pointer
+ **/
+
+error_t snmpGetNextIndexedObject(SnmpAgentContext *context,
+   const SnmpMessage *message, SnmpVarBind *var)
+{
+   error_t error;
+   uint_t i;
+   uint_t left;
+   uint_t right;
+   size_t n;
+   size_t bufferLen;
+   uint8_t *curOid;
+   size_t curOidLen;
+   uint8_t *tempOid;
+   size_t tempOidLen;
+   const MibObject *object;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Calculate the length of the buffer
+   bufferLen = context->response.varBindListMaxLen -
+      context->response.varBindListLen;
+
+   //Sanity check
+   if(var->oidLen > bufferLen)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Copy the OID from the specified variable binding
+   curOid = context->response.varBindList + context->response.varBindListLen;
+   curOidLen = var->oidLen;
+   osMemcpy(curOid, var->oid, var->oidLen);
+
+   //Initialize variables
+   tempOid = curOid;
+   tempOidLen = 0;
+
+   //Binary search for the first object whose subtree does not precede the
+   //specified OID
+   left = 0;
+   right = context->mibIndexSize;
+
+   //Loop until the object is found
+   while(left < right)
+   {
+      //Point to the middle object
+      i = (left + right) / 2;
+      object = context->mibIndex[i];
+
+      //Discard instance sub-identifier
+      n = MIN(curOidLen, object->oidLen);
+
+      //Perform lexicographical comparison
+      if(oidComp(curOid, n, object->oid, object->oidLen) > 0)
+      {
+         left = i + 1;
+      }
+      else
+      {
+         right = i;
+      }
+   }
+
+   //The objects are sorted, so the first object that yields an instance
+   //holds the next object in the MIB
+   for(i = left; i < context->mibIndexSize; )
+   {
+      //Point to the current object
+      object = context->mibIndex[i];
+
+      //Buffer where to store the OID of the next object
+      tempOid = curOid + curOidLen;
+
+      //Make sure the current object is accessible
+      if(object->access == MIB_ACCESS_READ_ONLY ||
+         object->access == MIB_ACCESS_READ_WRITE ||
+         object->access == MIB_ACCESS_READ_CREATE)
+      {
+         //Scalar or tabular object?
+         if(object->getNext == NULL)
+         {
+            //Perform lexicographical comparison
+            if(oidComp(curOid, curOidLen, object->oid, object->oidLen) <= 0)
+            {
+               //Take in account the instance sub-identifier to determine
+               //the length of the OID
+               tempOidLen = object->oidLen + 1;
+
+               //Make sure the buffer is large enough to hold the entire OID
+               if((curOidLen + tempOidLen) <= bufferLen)
+               {
+                  //Copy object identifier
+                  osMemcpy(tempOid, object->oid, object->oidLen);
+                  //Append instance sub-identifier
+                  tempOid[tempOidLen - 1] = 0;
+
+                  //Successful processing
+                  error = NO_ERROR;
+               }
+               else
+               {
+                  //Report an error
+                  error = ERROR_BUFFER_OVERFLOW;
+               }
+            }
+            else
+            {
+               //The specified OID does not lexicographically precede
+               //the name of the current object
+               error = ERROR_OBJECT_NOT_FOUND;
+            }
+         }
+         else
+         {
+            //Discard instance sub-identifier
+            n = MIN(curOidLen, object->oidLen);
+
+            //Perform lexicographical comparison
+            if(oidComp(curOid, n, object->oid, object->oidLen) <= 0)
+            {
+               //Maximum acceptable size of the OID
+               tempOidLen = bufferLen - curOidLen;
+
+               //Search the MIB for the next object
+               error = object->getNext(object, curOid, curOidLen,
+                  tempOid, &tempOidLen);
+            }
+            else
+            {
+               //The specified OID does not lexicographically precede
+               //the name of the current object
+               error = ERROR_OBJECT_NOT_FOUND;
+            }
+         }
+
+#if (SNMP_V1_SUPPORT == ENABLED)
+         //Check status code
+         if(error == NO_ERROR)
+         {
+            //On receipt of an SNMPv1 GetNextRequest-PDU, any object
+            //instance which contains a syntax of Counter64 shall be
+            //skipped (refer to RFC 3584, section 4.2.2.1)
+            if(message->version == SNMP_VERSION_1)
+            {
+               //Counter64 type?
+               if(object->objClass == ASN1_CLASS_APPLICATION &&
+                  object->objType == MIB_TYPE_COUNTER64)
+               {
+                  //Skip current object
+                  error = ERROR_OBJECT_NOT_FOUND;
+               }
+            }
+         }
+#endif
+#if (SNMP_AGENT_VACM_SUPPORT == ENABLED)
+         //Check status code
+         if(error == NO_ERROR)
+         {
+            //Access control verification
+            error = snmpIsAccessAllowed(context, message, tempOid,
+               tempOidLen);
+         }
+#endif
+         //Check status code
+         if(error == NO_ERROR)
+         {
+            //We are done
+            break;
+         }
+         else if(error == ERROR_OBJECT_NOT_FOUND)
+         {
+            //Catch exception
+            error = NO_ERROR;
+
+            //Jump to the next object
+            i++;
+         }
+         else if(error == ERROR_UNKNOWN_CONTEXT ||
+            error == ERROR_AUTHORIZATION_FAILED)
+         {
+            //Catch exception
+            error = NO_ERROR;
+
+            //Check the next instance of the same object
+            curOidLen = tempOidLen;
+            osMemmove(curOid, tempOid, tempOidLen);
+         }
+         else
+         {
+            //Exit immediately
+            break;
+         }
+      }
+      else
+      {
+         //The current object is not accessible
+         i++;
+      }
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //Next object found?
+      if(i < context->mibIndexSize)
+      {
+         //Move the resulting OID to the beginning of the buffer
+         osMemmove(curOid, tempOid, tempOidLen);
+
+         //Replace the original OID with the name of the next object
+         var->oid = curOid;
+         var->oidLen = tempOidLen;
+
+         //Save the length of the OID
+         context->response.oidLen = tempOidLen;
+      }
+      else
+      {
+         //The specified OID does not lexicographically precede the
+         //name of some object
+         error = ERROR_OBJECT_NOT_FOUND;
+      }
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Rebuild the sorted index of the objects of all the loaded MIBs
+ *
+ * If the objects do not fit in the index, the index is invalidated and
+ * snmpGetNextObject() falls back to walking through every MIB
+ *
+ * @param[in] context Pointer to the SNMP agent context
+ **/
+
+void snmpUpdateMibIndex(SnmpAgentContext *context)
+{
+   uint_t i;
+   uint_t j;
+   uint_t k;
+   const MibModule *module;
+   const MibObject *object;
+
+   //Flush the index
+   context->mibIndexSize = 0;
+   context->mibIndexValid = TRUE;
+
+   //Loop through MIBs
+   for(i = 0; i < SNMP_AGENT_MAX_MIBS; i++)
+   {
+      //Point to the current MIB
+      module = context->mibTable[i];
+
+      //Valid MIB?
+      if(module != NULL && module->numObjects > 0)
+      {
+         //Make sure the index is large enough to hold the objects of the MIB
+         if((context->mibIndexSize + module->numObjects) >
+            SNMP_AGENT_MIB_INDEX_SIZE)
+         {
+            //The index cannot be used
+            context->mibIndexSize = 0;
+            context->mibIndexValid = FALSE;
+            break;
+         }
+
+         //The objects of a MIB are sorted in lexicographic order, so they can
+         //be merged into the index, starting from the end
+         j = context->mibIndexSize;
+         k = module->numObjects;
+
+         //Merge the two lists
+         while(k > 0)
+         {
+            //Point to the last object of the MIB that has not been merged yet
+            object = &module->objects[k - 1];
+
+            //Perform lexicographical comparison
+            if(j > 0 && oidComp(context->mibIndex[j - 1]->oid,
+               context->mibIndex[j - 1]->oidLen, object->oid,
+               object->oidLen) > 0)
+            {
+               //Shift the existing entry
+               context->mibIndex[j + k - 1] = context->mibIndex[j - 1];
+               j--;
+            }
+            else
+            {
+               //Insert the object of the MIB
+               context->mibIndex[j + k - 1] = object;
+               k--;
+            }
+         }
+
+         //Update the number of objects in the index
+         context->mibIndexSize += module->numObjects;
+      }
+   }
+}
+
+#endif
+
+
 /**
  * @brief Search MIBs for the given object
  * @param[in] context Pointer to the SNMP agent context
@@ -50,6 +50,13 @@ error_t snmpGetObjectValue(SnmpAgentContext *context,
 error_t snmpGetNextObject(SnmpAgentContext *context,
    const SnmpMessage *message, SnmpVarBind *var);
 
+#if (SNMP_AGENT_MIB_INDEX_SUPPORT == ENABLED)
+error_t snmpGetNextIndexedObject(SnmpAgentContext *context,
+   const SnmpMessage *message, SnmpVarBind *var);
+
+void snmpUpdateMibIndex(SnmpAgentContext *context);
+#endif
+
 error_t snmpFindMibObject(SnmpAgentContext *context,
    const uint8_t *oid, size_t oidLen, const MibObject **object);
 
@@ -73,6 +73,16 @@ error_t snmpProcessPdu(SnmpAgentContext *context)
    //Initialize response message
    snmpInitMessage(&context->response);
 
+#if (MIB_SNAPSHOT_SUPPORT == ENABLED)
+   //All the variable bindings of the PDU are served from the same snapshots
+   mibUpdateSnapshotTime();
+#endif
+
+#if (SNMP_AGENT_VACM_SUPPORT == ENABLED && SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The MIB view is resolved again for each request
+   snmpResetVacmCache(context);
+#endif
+
    //Check PDU type
    switch(context->request.pduType)
    {
@@ -334,6 +334,12 @@ error_t snmpFormatTrapPdu(SnmpAgentContext *context, SnmpVersion version,
    if(error)
       return error;
 
+#if (SNMP_AGENT_VACM_SUPPORT == ENABLED && SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   //The MIB view resolved for the last request cannot be reused, since the
+   //notify view of the target must be used
+   snmpResetVacmCache(context);
+#endif
+
    //Format the list of variable bindings
    error = snmpWriteTrapVarBindingList(context, genericTrapType,
       specificTrapCode, objectList, objectListSize);
@@ -314,6 +314,11 @@ void snmpCloneSecurityParameters(SnmpUserEntry *user,
    user->privProtocol = cloneFromUser->privProtocol;
    user->rawPrivKey = cloneFromUser->rawPrivKey;
    user->localizedPrivKey = cloneFromUser->localizedPrivKey;
+
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+   //Precompute HMAC states and cipher key schedules
+   snmpUpdateKeyCache(user);
+#endif
 }
 
 
@@ -486,10 +491,24 @@ error_t snmpAuthOutgoingMessage(const SnmpUserEntry *user, SnmpMessage *message)
    if(message->msgAuthParametersLen != macLen)
       return ERROR_FAILURE;
 
-   //The MAC is calculated over the whole message
-   hmacInit(&hmacContext, hashAlgo, user->localizedAuthKey.b, hashAlgo->digestSize);
-   hmacUpdate(&hmacContext, message->pos, message->length);
-   hmacFinal(&hmacContext, NULL);
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+   //Check whether the HMAC states have been precomputed for the current key
+   if(user->keyCache.authProtocol == user->authProtocol &&
+      osMemcmp(user->keyCache.authKey.b, user->localizedAuthKey.b,
+      hashAlgo->digestSize) == 0)
+   {
+      //The MAC is calculated over the whole message
+      snmpComputeCachedMac(user, hashAlgo, message->pos, message->length,
+         hmacContext.digest);
+   }
+   else
+#endif
+   {
+      //The MAC is calculated over the whole message
+      hmacInit(&hmacContext, hashAlgo, user->localizedAuthKey.b, hashAlgo->digestSize);
+      hmacUpdate(&hmacContext, message->pos, message->length);
+      hmacFinal(&hmacContext, NULL);
+   }
 
    //Replace the msgAuthenticationParameters field with the calculated MAC
    osMemcpy(message->msgAuthParameters, hmacContext.digest, macLen);
@@ -534,10 +553,24 @@ error_t snmpAuthIncomingMessage(const SnmpUserEntry *user, SnmpMessage *message)
    //a null octet string
    osMemset(message->msgAuthParameters, 0, macLen);
 
-   //The MAC is calculated over the whole message
-   hmacInit(&hmacContext, hashAlgo, user->localizedAuthKey.b, hashAlgo->digestSize);
-   hmacUpdate(&hmacContext, message->buffer, message->bufferLen);
-   hmacFinal(&hmacContext, NULL);
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+   //Check whether the HMAC states have been precomputed for the current key
+   if(user->keyCache.authProtocol == user->authProtocol &&
+      osMemcmp(user->keyCache.authKey.b, user->localizedAuthKey.b,
+      hashAlgo->digestSize) == 0)
+   {
+      //The MAC is calculated over the whole message
+      snmpComputeCachedMac(user, hashAlgo, message->buffer, message->bufferLen,
+         hmacContext.digest);
+   }
+   else
+#endif
+   {
+      //The MAC is calculated over the whole message
+      hmacInit(&hmacContext, hashAlgo, user->localizedAuthKey.b, hashAlgo->digestSize);
+      hmacUpdate(&hmacContext, message->buffer, message->bufferLen);
+      hmacFinal(&hmacContext, NULL);
+   }
 
    //Restore the value of the msgAuthenticationParameters field
    osMemcpy(message->msgAuthParameters, mac, macLen);
@@ -581,6 +614,7 @@ error_t snmpEncryptData(const SnmpUserEntry *user, SnmpMessage *message,
    if(user->privProtocol == SNMP_PRIV_PROTOCOL_DES)
    {
       DesContext desContext;
+      DesContext *cipherContext;
       uint8_t iv[DES_BLOCK_SIZE];
 
       //The data to be encrypted is treated as sequence of octets. Its length
@@ -603,11 +637,26 @@ error_t snmpEncryptData(const SnmpUserEntry *user, SnmpMessage *message,
       //The resulting salt is then put into the msgPrivacyParameters field
       message->msgPrivParametersLen = 8;
 
-      //Initialize DES context
-      error = desInit(&desContext, user->localizedPrivKey.b, 8);
-      //Initialization failed?
-      if(error)
-         return error;
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+      //Check whether the key schedule has been precomputed for the current key
+      if(user->keyCache.privProtocol == user->privProtocol &&
+         osMemcmp(user->keyCache.privKey.b, user->localizedPrivKey.b, 16) == 0)
+      {
+         //Use the precomputed key schedule
+         cipherContext = (DesContext *) &user->keyCache.desContext;
+      }
+      else
+#endif
+      {
+         //Initialize DES context
+         error = desInit(&desContext, user->localizedPrivKey.b, 8);
+         //Initialization failed?
+         if(error)
+            return error;
+
+         //Use the newly initialized context
+         cipherContext = &desContext;
+      }
 
       //The last 8 octets of the 16-octet secret (private privacy key) are
       //used as pre-IV
@@ -620,7 +669,7 @@ error_t snmpEncryptData(const SnmpUserEntry *user, SnmpMessage *message,
       }
 
       //Perform CBC encryption
-      error = cbcEncrypt(DES_CIPHER_ALGO, &desContext, iv, message->pos,
+      error = cbcEncrypt(DES_CIPHER_ALGO, cipherContext, iv, message->pos,
          message->pos, message->length);
       //Any error to report?
       if(error)
@@ -633,6 +682,7 @@ error_t snmpEncryptData(const SnmpUserEntry *user, SnmpMessage *message,
    if(user->privProtocol == SNMP_PRIV_PROTOCOL_AES)
    {
       AesContext aesContext;
+      AesContext *cipherContext;
       uint8_t iv[AES_BLOCK_SIZE];
 
       //The 32-bit snmpEngineBoots is converted to the first 4 octets of the IV
@@ -648,14 +698,29 @@ error_t snmpEncryptData(const SnmpUserEntry *user, SnmpMessage *message,
       osMemcpy((uint8_t *) message->msgPrivParameters, salt, 8);
       message->msgPrivParametersLen = 8;
 
-      //Initialize AES context
-      error = aesInit(&aesContext, user->localizedPrivKey.b, 16);
-      //Initialization failed?
-      if(error)
-         return error;
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+      //Check whether the key schedule has been precomputed for the current key
+      if(user->keyCache.privProtocol == user->privProtocol &&
+         osMemcmp(user->keyCache.privKey.b, user->localizedPrivKey.b, 16) == 0)
+      {
+         //Use the precomputed key schedule
+         cipherContext = (AesContext *) &user->keyCache.aesContext;
+      }
+      else
+#endif
+      {
+         //Initialize AES context
+         error = aesInit(&aesContext, user->localizedPrivKey.b, 16);
+         //Initialization failed?
+         if(error)
+            return error;
+
+         //Use the newly initialized context
+         cipherContext = &aesContext;
+      }
 
       //Perform CFB-128 encryption
-      error = cfbEncrypt(AES_CIPHER_ALGO, &aesContext, 128, iv, message->pos,
+      error = cfbEncrypt(AES_CIPHER_ALGO, cipherContext, 128, iv, message->pos,
          message->pos, message->length);
       //Any error to report?
       if(error)
@@ -736,6 +801,7 @@ error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message)
    if(user->privProtocol == SNMP_PRIV_PROTOCOL_DES)
    {
       DesContext desContext;
+      DesContext *cipherContext;
       uint8_t iv[DES_BLOCK_SIZE];
 
       //Before decryption, the encrypted data length is verified. The length
@@ -747,11 +813,26 @@ error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message)
       if(message->msgPrivParametersLen != 8)
          return ERROR_DECRYPTION_FAILED;
 
-      //Initialize DES context
-      error = desInit(&desContext, user->localizedPrivKey.b, 8);
-      //Initialization failed?
-      if(error)
-         return error;
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+      //Check whether the key schedule has been precomputed for the current key
+      if(user->keyCache.privProtocol == user->privProtocol &&
+         osMemcmp(user->keyCache.privKey.b, user->localizedPrivKey.b, 16) == 0)
+      {
+         //Use the precomputed key schedule
+         cipherContext = (DesContext *) &user->keyCache.desContext;
+      }
+      else
+#endif
+      {
+         //Initialize DES context
+         error = desInit(&desContext, user->localizedPrivKey.b, 8);
+         //Initialization failed?
+         if(error)
+            return error;
+
+         //Use the newly initialized context
+         cipherContext = &desContext;
+      }
 
       //The last 8 octets of the 16-octet secret (private privacy key) are
       //used as pre-IV
@@ -764,7 +845,7 @@ error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message)
       }
 
       //Perform CBC decryption
-      error = cbcDecrypt(DES_CIPHER_ALGO, &desContext, iv, message->pos,
+      error = cbcDecrypt(DES_CIPHER_ALGO, cipherContext, iv, message->pos,
          message->pos, message->length);
       //Any error to report?
       if(error)
@@ -777,6 +858,7 @@ error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message)
    if(user->privProtocol == SNMP_PRIV_PROTOCOL_AES)
    {
       AesContext aesContext;
+      AesContext *cipherContext;
       uint8_t iv[AES_BLOCK_SIZE];
 
       //Check the length of the msgPrivacyParameters field
@@ -790,14 +872,29 @@ error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message)
       //The 64-bit integer is then converted to the last 8 octets
       osMemcpy(iv + 8, message->msgPrivParameters, 8);
 
-      //Initialize AES context
-      error = aesInit(&aesContext, user->localizedPrivKey.b, 16);
-      //Initialization failed?
-      if(error)
-         return error;
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+      //Check whether the key schedule has been precomputed for the current key
+      if(user->keyCache.privProtocol == user->privProtocol &&
+         osMemcmp(user->keyCache.privKey.b, user->localizedPrivKey.b, 16) == 0)
+      {
+         //Use the precomputed key schedule
+         cipherContext = (AesContext *) &user->keyCache.aesContext;
+      }
+      else
+#endif
+      {
+         //Initialize AES context
+         error = aesInit(&aesContext, user->localizedPrivKey.b, 16);
+         //Initialization failed?
+         if(error)
+            return error;
+
+         //Use the newly initialized context
+         cipherContext = &aesContext;
+      }
 
       //Perform CFB-128 encryption
-      error = cfbDecrypt(AES_CIPHER_ALGO, &aesContext, 128, iv, message->pos,
+      error = cfbDecrypt(AES_CIPHER_ALGO, cipherContext, 128, iv, message->pos,
          message->pos, message->length);
       //Any error to report?
       if(error)
@@ -823,6 +920,145 @@ error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message)
 }
 
 
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+
+/**
+ * @brief Precompute HMAC states and cipher key schedules
+ *
+ * The cached states are bound to the localized keys they were computed
+ * from. They are ignored as soon as the keys or the protocols change, until
+ * this function is called again
+ *
+ * @param[in,out] user Security profile of the user
+ **/
+
+void snmpUpdateKeyCache(SnmpUserEntry *user)
+{
+   error_t error;
+   size_t i;
+   size_t j;
+   size_t n;
+   const HashAlgo *hashAlgo;
+   SnmpKeyCache *cache;
+   uint8_t ipad[SNMP_MAX_KEY_SIZE];
+   uint8_t opad[SNMP_MAX_KEY_SIZE];
+
+   //Point to the cache
+   cache = &user->keyCache;
+
+   //Invalidate the cached states
+   cache->authProtocol = SNMP_AUTH_PROTOCOL_NONE;
+   cache->privProtocol = SNMP_PRIV_PROTOCOL_NONE;
+
+   //Get the hash algorithm to be used for HMAC computation
+   hashAlgo = snmpGetHashAlgo(user->authProtocol);
+
+   //Valid authentication protocol?
+   if(hashAlgo != NULL)
+   {
+      //Initialize hash contexts
+      hashAlgo->init(&cache->innerContext);
+      hashAlgo->init(&cache->outerContext);
+
+      //The key is padded with zeroes to the block size of the hash function,
+      //then XOR-ed with ipad and opad (refer to RFC 2104, section 2)
+      for(i = 0; i < hashAlgo->blockSize; i += n)
+      {
+         //Process the padded key chunk by chunk
+         n = MIN(hashAlgo->blockSize - i, SNMP_MAX_KEY_SIZE);
+
+         //XOR the current chunk with ipad and opad
+         for(j = 0; j < n; j++)
+         {
+            //The localized key is as long as the digest
+            if((i + j) < hashAlgo->digestSize)
+            {
+               ipad[j] = user->localizedAuthKey.b[i + j] ^ HMAC_IPAD;
+               opad[j] = user->localizedAuthKey.b[i + j] ^ HMAC_OPAD;
+            }
+            else
+            {
+               ipad[j] = HMAC_IPAD;
+               opad[j] = HMAC_OPAD;
+            }
+         }
+
+         //Absorb the current chunk
+         hashAlgo->update(&cache->innerContext, ipad, n);
+         hashAlgo->update(&cache->outerContext, opad, n);
+      }
+
+      //The states are bound to the current key
+      cache->authKey = user->localizedAuthKey;
+      cache->authProtocol = user->authProtocol;
+   }
+
+#if (SNMP_DES_SUPPORT == ENABLED)
+   //DES-CBC privacy protocol?
+   if(user->privProtocol == SNMP_PRIV_PROTOCOL_DES)
+   {
+      //Expand the first 8 octets of the privacy key
+      error = desInit(&cache->desContext, user->localizedPrivKey.b, 8);
+   }
+   else
+#endif
+#if (SNMP_AES_SUPPORT == ENABLED)
+   //AES-128-CFB privacy protocol?
+   if(user->privProtocol == SNMP_PRIV_PROTOCOL_AES)
+   {
+      //Expand the first 16 octets of the privacy key
+      error = aesInit(&cache->aesContext, user->localizedPrivKey.b, 16);
+   }
+   else
+#endif
+   //No privacy?
+   {
+      //Nothing to precompute
+      error = ERROR_FAILURE;
+   }
+
+   //Check status code
+   if(!error)
+   {
+      //The key schedule is bound to the current key
+      cache->privKey = user->localizedPrivKey;
+      cache->privProtocol = user->privProtocol;
+   }
+}
+
+
+/**
+ * @brief Compute HMAC using the precomputed inner and outer states
+ * @param[in] user Security profile of the user
+ * @param[in] hashAlgo Hash algorithm to be used for HMAC computation
+ * @param[in] data Pointer to the message
+ * @param[in] length Length of the message, in bytes
+ * @param[out] digest Resulting MAC (not truncated)
+ **/
+
+void snmpComputeCachedMac(const SnmpUserEntry *user, const HashAlgo *hashAlgo,
+   const uint8_t *data, size_t length, uint8_t *digest)
+{
+   HashContext hashContext;
+
+   //Resume from the inner state
+   osMemcpy(&hashContext, &user->keyCache.innerContext, hashAlgo->contextSize);
+
+   //Compute H(K XOR ipad || text)
+   hashAlgo->update(&hashContext, data, length);
+   hashAlgo->final(&hashContext, digest);
+
+   //Resume from the outer state
+   osMemcpy(&hashContext, &user->keyCache.outerContext, hashAlgo->contextSize);
+
+   //Compute H(K XOR opad || H(K XOR ipad || text))
+   hashAlgo->update(&hashContext, digest, hashAlgo->digestSize);
+   hashAlgo->final(&hashContext, digest);
+}
+
+#endif
+
+
 /**
  * @brief Get the hash algorithm to be used for a given authentication protocol
  * @param[in] authProtocol Authentication protocol (MD5, SHA-1, SHA-224,
@@ -100,6 +100,13 @@
    #error SNMP_AES_SUPPORT parameter is not valid
 #endif
 
+//Cache of HMAC states and cipher key schedules
+#ifndef SNMP_USM_KEY_CACHE_SUPPORT
+   #define SNMP_USM_KEY_CACHE_SUPPORT DISABLED
+#elif (SNMP_USM_KEY_CACHE_SUPPORT != ENABLED && SNMP_USM_KEY_CACHE_SUPPORT != DISABLED)
+   #error SNMP_USM_KEY_CACHE_SUPPORT parameter is not valid
+#endif
+
 //Support for MD5 authentication?
 #if (SNMP_MD5_SUPPORT == ENABLED)
    #include "hash/md5.h"
@@ -130,6 +137,11 @@
    #include "hash/sha512.h"
 #endif
 
+//Precomputed HMAC states?
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+   #include "hash/hash_algorithms.h"
+#endif
+
 //Support for DES encryption?
 #if (SNMP_DES_SUPPORT == ENABLED)
    #include "cipher/des.h"
@@ -287,6 +299,31 @@ typedef struct
 } SnmpKey;
 
 
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+
+/**
+ * @brief Precomputed HMAC states and cipher key schedules
+ **/
+
+typedef struct
+{
+   SnmpAuthProtocol authProtocol; ///<Authentication protocol the HMAC states were computed for
+   SnmpKey authKey;               ///<Localized authentication key the HMAC states were computed from
+   HashContext innerContext;      ///<Hash state after absorbing the key XOR-ed with ipad
+   HashContext outerContext;      ///<Hash state after absorbing the key XOR-ed with opad
+   SnmpPrivProtocol privProtocol; ///<Privacy protocol the key schedule was computed for
+   SnmpKey privKey;               ///<Localized privacy key the key schedule was computed from
+#if (SNMP_DES_SUPPORT == ENABLED)
+   DesContext desContext;         ///<DES key schedule
+#endif
+#if (SNMP_AES_SUPPORT == ENABLED)
+   AesContext aesContext;         ///<AES key schedule
+#endif
+} SnmpKeyCache;
+
+#endif
+
+
 /**
  * @brief User table entry
  **/
@@ -305,6 +342,9 @@ typedef struct
    SnmpKey localizedPrivKey;                        ///<Localized privacy key
    uint8_t publicValue[SNMP_MAX_PUBLIC_VALUE_SIZE]; ///<Public value
    size_t publicValueLen;                           ///<Length of the public value
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+   SnmpKeyCache keyCache;                           ///<Precomputed HMAC states and cipher key schedules
+#endif
 #endif
 } SnmpUserEntry;
 
@@ -349,6 +389,13 @@ error_t snmpEncryptData(const SnmpUserEntry *user, SnmpMessage *message,
 
 error_t snmpDecryptData(const SnmpUserEntry *user, SnmpMessage *message);
 
+#if (SNMP_USM_KEY_CACHE_SUPPORT == ENABLED)
+void snmpUpdateKeyCache(SnmpUserEntry *user);
+
+void snmpComputeCachedMac(const SnmpUserEntry *user, const HashAlgo *hashAlgo,
+   const uint8_t *data, size_t length, uint8_t *digest);
+#endif
+
 const HashAlgo *snmpGetHashAlgo(SnmpAuthProtocol authProtocol);
 size_t snmpGetMacLength(SnmpAuthProtocol authProtocol);
 
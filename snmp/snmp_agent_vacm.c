@@ -60,6 +60,116 @@
 
 error_t snmpIsAccessAllowed(SnmpAgentContext *context,
    const SnmpMessage *message, const uint8_t *oid, size_t oidLen)
+{
+   const SnmpViewEntry *viewEntry;
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+   uint_t i;
+   uint_t left;
+   uint_t right;
+   const char_t *viewName;
+   SnmpVacmCache *cache;
+
+   //Point to the VACM cache
+   cache = &context->vacmCache;
+
+   //The MIB view is resolved once per request
+   if(!cache->resolved)
+   {
+      //Resolve the MIB view
+      cache->status = snmpResolveView(context, message, &viewName);
+
+      //Check status code
+      if(!cache->status)
+      {
+         //Make sure the sorted view table is up to date
+         if(!cache->sorted)
+         {
+            snmpSortViewTable(context);
+         }
+
+         //Binary search for the first entry of the MIB view
+         left = 0;
+         right = cache->numViews;
+
+         //Loop until the entry is found
+         while(left < right)
+         {
+            //Point to the middle entry
+            i = (left + right) / 2;
+
+            //Compare view names
+            if(osStrcmp(cache->views[i]->viewName, viewName) < 0)
+            {
+               left = i + 1;
+            }
+            else
+            {
+               right = i;
+            }
+         }
+
+         //Search for the last entry of the MIB view
+         for(i = left; i < cache->numViews; i++)
+         {
+            //Compare view names
+            if(osStrcmp(cache->views[i]->viewName, viewName) != 0)
+               break;
+         }
+
+         //Save the range of entries that belong to the MIB view
+         cache->firstView = left;
+         cache->lastView = i;
+      }
+
+      //The decision remains valid until the end of the request
+      cache->resolved = TRUE;
+   }
+
+   //Any error to report?
+   if(cache->status)
+      return cache->status;
+
+   //Check whether the specified variableName is in the MIB view
+   viewEntry = snmpSelectCachedViewEntry(context, oid, oidLen);
+#else
+   error_t error;
+   const char_t *viewName;
+
+   //Resolve the MIB view
+   error = snmpResolveView(context, message, &viewName);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //Check whether the specified variableName is in the MIB view
+   viewEntry = snmpSelectViewEntry(context, viewName, oid, oidLen);
+#endif
+
+   //If there is no view configured for the specified viewType, then an
+   //errorIndication (noSuchView) is returned to the calling module
+   if(viewEntry == NULL)
+      return ERROR_AUTHORIZATION_FAILED;
+
+   //If the specified variableName (object instance) is not in the MIB view,
+   //then an errorIndication (notInView) is returned to the calling module
+   if(viewEntry->type != SNMP_VIEW_TYPE_INCLUDED)
+      return ERROR_AUTHORIZATION_FAILED;
+
+   //Otherwise, the specified variableName is in the MIB view
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Select the MIB view that applies to a request
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] message Pointer to the received SNMP message
+ * @param[out] viewName Name of the MIB view
+ * @return Error code
+ **/
+
+error_t snmpResolveView(SnmpAgentContext *context,
+   const SnmpMessage *message, const char_t **viewName)
 {
    SnmpSecurityModel securityModel;
    SnmpSecurityLevel securityLevel;
@@ -67,10 +177,8 @@ error_t snmpIsAccessAllowed(SnmpAgentContext *context,
    size_t securityNameLen;
    const char_t *contextName;
    size_t contextNameLen;
-   const char_t *viewName;
    const SnmpGroupEntry *groupEntry;
    const SnmpAccessEntry *accessEntry;
-   const SnmpViewEntry *viewEntry;
 
 #if (SNMP_V1_SUPPORT == ENABLED)
    //SNMPv1 version?
@@ -171,19 +279,19 @@ error_t snmpIsAccessAllowed(SnmpAgentContext *context,
       message->pduType == SNMP_PDU_GET_BULK_REQUEST)
    {
       //The read view is used for checking access rights
-      viewName = accessEntry->readViewName;
+      *viewName = accessEntry->readViewName;
    }
    else if(message->pduType == SNMP_PDU_SET_REQUEST)
    {
       //The write view is used for checking access rights
-      viewName = accessEntry->writeViewName;
+      *viewName = accessEntry->writeViewName;
    }
    else if(message->pduType == SNMP_PDU_TRAP ||
       message->pduType == SNMP_PDU_TRAP_V2 ||
       message->pduType == SNMP_PDU_INFORM_REQUEST)
    {
       //The notify view is used for checking access rights
-      viewName = accessEntry->notifyViewName;
+      *viewName = accessEntry->notifyViewName;
    }
    else
    {
@@ -193,23 +301,10 @@ error_t snmpIsAccessAllowed(SnmpAgentContext *context,
 
    //If the view to be used is the empty view (zero length viewName) then
    //an errorIndication (noSuchView) is returned to the calling module
-   if(viewName[0] == '\0')
-      return ERROR_AUTHORIZATION_FAILED;
-
-   //Check whether the specified variableName is in the MIB view
-   viewEntry = snmpSelectViewEntry(context, viewName, oid, oidLen);
-
-   //If there is no view configured for the specified viewType, then an
-   //errorIndication (noSuchView) is returned to the calling module
-   if(viewEntry == NULL)
+   if((*viewName)[0] == '\0')
       return ERROR_AUTHORIZATION_FAILED;
 
-   //If the specified variableName (object instance) is not in the MIB view,
-   //then an errorIndication (notInView) is returned to the calling module
-   if(viewEntry->type != SNMP_VIEW_TYPE_INCLUDED)
-      return ERROR_AUTHORIZATION_FAILED;
-
-   //Otherwise, the specified variableName is in the MIB view
+   //Successful processing
    return NO_ERROR;
 }
 
@@ -743,4 +838,190 @@ SnmpViewEntry *snmpSelectViewEntry(SnmpAgentContext *context,
    return selectedEntry;
 }
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+
+/**
+ * @brief Discard the MIB view resolved for the previous request
+ * @param[in] context Pointer to the SNMP agent context
+ **/
+
+void snmpResetVacmCache(SnmpAgentContext *context)
+{
+   //The MIB view must be resolved again
+   context->vacmCache.resolved = FALSE;
+}
+
+
+/**
+ * @brief Invalidate the VACM cache after a change to the VACM tables
+ * @param[in] context Pointer to the SNMP agent context
+ **/
+
+void snmpInvalidateVacmCache(SnmpAgentContext *context)
+{
+   //The sorted view table must be rebuilt
+   context->vacmCache.sorted = FALSE;
+   //The MIB view must be resolved again
+   context->vacmCache.resolved = FALSE;
+}
+
+
+/**
+ * @brief Sort the view table by view name and in order of precedence
+ * @param[in] context Pointer to the SNMP agent context
+ **/
+
+void snmpSortViewTable(SnmpAgentContext *context)
+{
+   uint_t i;
+   uint_t j;
+   SnmpViewEntry *entry;
+   SnmpVacmCache *cache;
+
+   //Point to the VACM cache
+   cache = &context->vacmCache;
+
+   //Flush the sorted view table
+   cache->numViews = 0;
+
+   //Loop through the list of MIB views
+   for(i = 0; i < SNMP_AGENT_VIEW_TABLE_SIZE; i++)
+   {
+      //Point to the current entry
+      entry = &context->viewTable[i];
+
+      //Check current status
+      if(entry->status == MIB_ROW_STATUS_UNUSED)
+         continue;
+
+      //Insertion sort
+      for(j = cache->numViews; j > 0; j--)
+      {
+         //Entries are sorted in ascending order
+         if(snmpCompViewEntries(cache->views[j - 1], entry) <= 0)
+            break;
+
+         //Shift the current entry
+         cache->views[j] = cache->views[j - 1];
+      }
+
+      //Insert the entry
+      cache->views[j] = entry;
+      cache->numViews++;
+   }
+
+   //The sorted view table is now up to date
+   cache->sorted = TRUE;
+}
+
+
+/**
+ * @brief Compare view entries
+ *
+ * Entries are sorted by view name. Entries of the same view are sorted in
+ * order of precedence, as defined in RFC 3415, section 5.2, so that the
+ * first entry that matches a given OID is the one to be selected
+ *
+ * @param[in] entry1 Pointer to the first view entry
+ * @param[in] entry2 Pointer to the second view entry
+ * @return Comparison result
+ **/
+
+int_t snmpCompViewEntries(const SnmpViewEntry *entry1,
+   const SnmpViewEntry *entry2)
+{
+   int_t res;
+   uint_t subtreeLen1;
+   uint_t subtreeLen2;
+
+   //Compare view names
+   res = osStrcmp(entry1->viewName, entry2->viewName);
+
+   //Same view?
+   if(res == 0)
+   {
+      //Calculate the number of sub-identifiers of the subtrees
+      subtreeLen1 = oidCountSubIdentifiers(entry1->subtree,
+         entry1->subtreeLen);
+      subtreeLen2 = oidCountSubIdentifiers(entry2->subtree,
+         entry2->subtreeLen);
+
+      //The entry whose subtree has the most sub-identifiers comes first. If
+      //both subtrees have the same number of sub-identifiers, then the entry
+      //with the lexicographically greatest subtree and type comes first
+      if(subtreeLen1 > subtreeLen2)
+      {
+         res = -1;
+      }
+      else if(subtreeLen1 < subtreeLen2)
+      {
+         res = 1;
+      }
+      else
+      {
+         //Compare subtrees
+         res = -oidComp(entry1->subtree, entry1->subtreeLen,
+            entry2->subtree, entry2->subtreeLen);
+
+         //Identical subtrees?
+         if(res == 0)
+         {
+            //Compare types
+            if(entry1->type > entry2->type)
+            {
+               res = -1;
+            }
+            else if(entry1->type < entry2->type)
+            {
+               res = 1;
+            }
+         }
+      }
+   }
+
+   //Return comparison result
+   return res;
+}
+
+
+/**
+ * @brief Find the view entry that applies to an OID, using the VACM cache
+ * @param[in] context Pointer to the SNMP agent context
+ * @param[in] oid OID for the managed object
+ * @param[in] oidLen Length of the OID, in bytes
+ * @return Pointer to the matching entry
+ **/
+
+SnmpViewEntry *snmpSelectCachedViewEntry(SnmpAgentContext *context,
+   const uint8_t *oid, size_t oidLen)
+{
+   uint_t i;
+   SnmpViewEntry *entry;
+   SnmpVacmCache *cache;
+
+   //Point to the VACM cache
+   cache = &context->vacmCache;
+
+   //Loop through the entries of the MIB view, in order of precedence
+   for(i = cache->firstView; i < cache->lastView; i++)
+   {
+      //Point to the current entry
+      entry = cache->views[i];
+
+      //Check whether the OID matches the subtree (the mask allows for a
+      //simple form of wildcarding)
+      if(oidMatch(oid, oidLen, entry->subtree, entry->subtreeLen,
+         entry->mask, entry->maskLen))
+      {
+         //The first matching entry takes precedence
+         return entry;
+      }
+   }
+
+   //No matching entry
+   return NULL;
+}
+
+#endif
+
 #endif
@@ -44,6 +44,13 @@
    #error SNMP_AGENT_VACM_SUPPORT parameter is not valid
 #endif
 
+//VACM access-decision cache
+#ifndef SNMP_AGENT_VACM_CACHE_SUPPORT
+   #define SNMP_AGENT_VACM_CACHE_SUPPORT DISABLED
+#elif (SNMP_AGENT_VACM_CACHE_SUPPORT != ENABLED && SNMP_AGENT_VACM_CACHE_SUPPORT != DISABLED)
+   #error SNMP_AGENT_VACM_CACHE_SUPPORT parameter is not valid
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 extern "C" {
@@ -121,10 +128,14 @@ typedef struct
 } SnmpViewEntry;
 
 
+
 //VACM related functions
 error_t snmpIsAccessAllowed(SnmpAgentContext *context,
    const SnmpMessage *message, const uint8_t *oid, size_t oidLen);
 
+error_t snmpResolveView(SnmpAgentContext *context,
+   const SnmpMessage *message, const char_t **viewName);
+
 SnmpGroupEntry *snmpCreateGroupEntry(SnmpAgentContext *context);
 
 SnmpGroupEntry *snmpFindGroupEntry(SnmpAgentContext *context,
@@ -148,6 +159,18 @@ SnmpViewEntry *snmpFindViewEntry(SnmpAgentContext *context,
 SnmpViewEntry *snmpSelectViewEntry(SnmpAgentContext *context,
    const char_t *viewName, const uint8_t *oid, size_t oidLen);
 
+#if (SNMP_AGENT_VACM_CACHE_SUPPORT == ENABLED)
+void snmpResetVacmCache(SnmpAgentContext *context);
+void snmpInvalidateVacmCache(SnmpAgentContext *context);
+void snmpSortViewTable(SnmpAgentContext *context);
+
+int_t snmpCompViewEntries(const SnmpViewEntry *entry1,
+   const SnmpViewEntry *entry2);
+
+SnmpViewEntry *snmpSelectCachedViewEntry(SnmpAgentContext *context,
+   const uint8_t *oid, size_t oidLen);
+#endif
+
 //C++ guard
 #ifdef __cplusplus
 }
@@ -39,6 +39,7 @@
 #include "web_socket/web_socket_frame.h"
 #include "web_socket/web_socket_transport.h"
 #include "web_socket/web_socket_misc.h"
+#include "web_socket/web_socket_deflate.h"
 #include "str.h"
 #include "encoding/base64.h"
 #include "debug.h"
@@ -351,6 +352,33 @@ error_t webSocketSetSubProtocol(WebSocket *webSocket, const char_t *subProtocol)
 }
 
 
+/**
+ * @brief Enable permessage-deflate extension
+ * @param[in] webSocket Handle to a WebSocket
+ * @param[in] enable When set, the extension is offered (client) or accepted
+ *   (server) during the opening handshake
+ * @return Error code
+ **/
+
+error_t webSocketEnableDeflate(WebSocket *webSocket, bool_t enable)
+{
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   //Make sure the WebSocket handle is valid
+   if(webSocket == NULL)
+      return ERROR_INVALID_PARAMETER;
+
+   //Save parameter
+   webSocket->deflateEnabled = enable;
+
+   //Successful processing
+   return NO_ERROR;
+#else
+   //Not implemented
+   return ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
 /**
  * @brief Set authentication information
  * @param[in] webSocket Handle to a WebSocket
@@ -709,6 +737,11 @@ error_t webSocketSetClientKey(WebSocket *webSocket, const char_t *clientKey)
    webSocket->handshakeContext.connectionUpgrade = TRUE;
    webSocket->handshakeContext.upgradeWebSocket = TRUE;
 
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   //The Sec-WebSocket-Extensions header field is not available
+   webSocket->handshakeContext.perMessageDeflate = FALSE;
+#endif
+
    //Initialize FIN flag
    webSocket->rxContext.fin = TRUE;
 
@@ -997,8 +1030,9 @@ error_t webSocketSendEx(WebSocket *webSocket, const void *data, size_t length,
 {
    error_t error;
    size_t i;
-   size_t j;
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
    size_t k;
+#endif
    size_t n;
    const uint8_t *p;
    WebSocketFrameContext *txContext;
@@ -1039,11 +1073,44 @@ error_t webSocketSendEx(WebSocket *webSocket, const void *data, size_t length,
             type = WS_FRAME_TYPE_CONTINUATION;
          }
 
-         //Format WebSocket frame header
-         error = webSocketFormatFrameHeader(webSocket, lastFrag, type, length - i);
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+         //The first fragment of a data message determines whether the
+         //message is compressed
+         if(type == WS_FRAME_TYPE_TEXT || type == WS_FRAME_TYPE_BINARY)
+         {
+            //Compress the message if the extension has been negotiated
+            txContext->compressed = webSocket->handshakeContext.perMessageDeflate;
 
-         //Send the frame header
-         txContext->state = WS_SUB_STATE_FRAME_HEADER;
+            //Compressed message?
+            if(txContext->compressed)
+            {
+               //Prepare the compression context for a new message
+               webSocketDeflateStartMessage(&webSocket->deflateContext);
+
+               //Save the opcode of the first frame
+               txContext->dataFrameType = type;
+               //No compressed data is pending
+               txContext->payloadLen = 0;
+               txContext->bufferPos = 0;
+               txContext->bufferLen = 0;
+            }
+         }
+
+         //Control frames are never compressed
+         if(txContext->compressed && type < WS_FRAME_TYPE_CLOSE)
+         {
+            //Compress the application data
+            txContext->state = WS_SUB_STATE_FRAME_DEFLATE;
+         }
+         else
+#endif
+         {
+            //Format WebSocket frame header
+            error = webSocketFormatFrameHeader(webSocket, lastFrag, type, length - i);
+
+            //Send the frame header
+            txContext->state = WS_SUB_STATE_FRAME_HEADER;
+         }
       }
       else if(txContext->state == WS_SUB_STATE_FRAME_HEADER)
       {
@@ -1094,29 +1161,40 @@ error_t webSocketSendEx(WebSocket *webSocket, const void *data, size_t length,
             {
                //Calculate the number of bytes that are pending
                n = MIN(length - i, txContext->payloadLen - txContext->payloadPos);
-               //Limit the number of bytes to be copied at a time
-               n = MIN(n, WEB_SOCKET_BUFFER_SIZE);
-
-               //Copy application data to the transmit buffer
-               osMemcpy(txContext->buffer, p + i, n);
 
                //All frames sent from the client to the server are masked
                if(webSocket->endpoint == WS_ENDPOINT_CLIENT)
                {
-                  //Apply masking
-                  for(j = 0; j < n; j++)
-                  {
-                     //Index of the masking key to be applied
-                     k = (txContext->payloadPos + j) % 4;
-                     //Convert unmasked data into masked data
-                     txContext->buffer[j] ^= txContext->maskingKey[k];
-                  }
-               }
+                  //Limit the number of bytes to be copied at a time
+                  n = MIN(n, WEB_SOCKET_BUFFER_SIZE);
 
-               //Rewind to the beginning of the buffer
-               txContext->bufferPos = 0;
-               //Update the number of data buffered but not yet sent
-               txContext->bufferLen = n;
+                  //Copy application data to the transmit buffer
+                  osMemcpy(txContext->buffer, p + i, n);
+
+                  //Convert unmasked data into masked data
+                  webSocketApplyMask(txContext->buffer, n,
+                     txContext->maskingKey, txContext->payloadPos);
+
+                  //Rewind to the beginning of the buffer
+                  txContext->bufferPos = 0;
+                  //Update the number of data buffered but not yet sent
+                  txContext->bufferLen = n;
+               }
+               else
+               {
+                  //Frames sent from the server to the client are not masked.
+                  //The application data is passed directly to the transport
+                  //layer, without being copied to the transmit buffer. Since
+                  //the frame header was sent with the SOCKET_FLAG_DELAY flag,
+                  //header and payload are coalesced into the same segment
+                  error = webSocketSendData(webSocket, p + i, n, &n, 0);
+
+                  //Advance data pointer
+                  txContext->payloadPos += n;
+
+                  //Total number of data that have been written
+                  i += n;
+               }
             }
             else
             {
@@ -1131,6 +1209,97 @@ error_t webSocketSendEx(WebSocket *webSocket, const void *data, size_t length,
             }
          }
       }
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+      else if(txContext->state == WS_SUB_STATE_FRAME_DEFLATE)
+      {
+         //Room available for compressed data (the beginning of the buffer is
+         //reserved for the frame header)
+         n = WEB_SOCKET_BUFFER_SIZE - WEB_SOCKET_DEFLATE_HEADER_SIZE -
+            txContext->payloadLen;
+
+         //Any remaining data to be sent?
+         if(txContext->bufferPos < txContext->bufferLen)
+         {
+            //Send more data
+            error = webSocketSendData(webSocket,
+               txContext->buffer + txContext->bufferPos,
+               txContext->bufferLen - txContext->bufferPos, &n, 0);
+
+            //Advance data pointer
+            txContext->bufferPos += n;
+         }
+         else if(txContext->bufferLen > 0)
+         {
+            //Flush the transmit buffer
+            txContext->payloadLen = 0;
+            txContext->bufferPos = 0;
+            txContext->bufferLen = 0;
+
+            //Write operation complete?
+            if(txContext->fin || (!lastFrag && i >= length))
+            {
+               //Prepare to send a new WebSocket frame
+               txContext->state = WS_SUB_STATE_INIT;
+               break;
+            }
+         }
+         else if(i < length)
+         {
+            //Compress as much data as possible
+            error = webSocketDeflateCompress(&webSocket->deflateContext,
+               p + i, length - i, &k, txContext->buffer +
+               WEB_SOCKET_DEFLATE_HEADER_SIZE + txContext->payloadLen, n, &n);
+
+            //Check status code
+            if(!error)
+            {
+               //Number of bytes that have been processed
+               i += k;
+               //Update the length of the compressed data
+               txContext->payloadLen += n;
+
+               //The transmit buffer is full?
+               if(k == 0)
+               {
+                  //Format a frame that carries the compressed data
+                  error = webSocketFormatCompressedFrame(webSocket, FALSE);
+               }
+            }
+         }
+         else if(lastFrag)
+         {
+            //Terminate the compressed message
+            error = webSocketDeflateFlush(&webSocket->deflateContext,
+               txContext->buffer + WEB_SOCKET_DEFLATE_HEADER_SIZE +
+               txContext->payloadLen, n, &n);
+
+            //Check status code
+            if(!error)
+            {
+               //Update the length of the compressed data
+               txContext->payloadLen += n;
+               //Format the last frame of the message
+               error = webSocketFormatCompressedFrame(webSocket, TRUE);
+            }
+            else if(error == ERROR_BUFFER_OVERFLOW)
+            {
+               //Send the pending data before flushing the compressor
+               error = webSocketFormatCompressedFrame(webSocket, FALSE);
+            }
+         }
+         else if(txContext->payloadLen > 0)
+         {
+            //Send the compressed data produced so far
+            error = webSocketFormatCompressedFrame(webSocket, FALSE);
+         }
+         else
+         {
+            //Prepare to send a new WebSocket frame
+            txContext->state = WS_SUB_STATE_INIT;
+            break;
+         }
+      }
+#endif
       else
       {
          //Invalid state
@@ -1193,11 +1362,15 @@ error_t webSocketReceiveEx(WebSocket *webSocket, void *data, size_t size,
 {
    error_t error;
    size_t i;
-   size_t j;
    size_t k;
    size_t n;
    WebSocketFrame *frame;
    WebSocketFrameContext *rxContext;
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   uint8_t *p;
+   size_t m;
+   uint8_t temp[64];
+#endif
 
    //Make sure the WebSocket handle is valid
    if(webSocket == NULL)
@@ -1340,8 +1513,20 @@ error_t webSocketReceiveEx(WebSocket *webSocket, void *data, size_t size,
             rxContext->bufferPos = 0;
             rxContext->bufferLen = 0;
 
-            //Decode the payload of the WebSocket frame
-            rxContext->state = WS_SUB_STATE_FRAME_PAYLOAD;
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+            //Compressed data frame?
+            if(rxContext->compressed &&
+               rxContext->controlFrameType == WS_FRAME_TYPE_CONTINUATION)
+            {
+               //Decompress the payload of the WebSocket frame
+               rxContext->state = WS_SUB_STATE_FRAME_DEFLATE;
+            }
+            else
+#endif
+            {
+               //Decode the payload of the WebSocket frame
+               rxContext->state = WS_SUB_STATE_FRAME_PAYLOAD;
+            }
          }
       }
       else if(rxContext->state == WS_SUB_STATE_FRAME_PAYLOAD)
@@ -1359,14 +1544,9 @@ error_t webSocketReceiveEx(WebSocket *webSocket, void *data, size_t size,
             //All frames sent from the client to the server are masked
             if(rxContext->mask)
             {
-               //Unmask the data
-               for(j = 0; j < n; j++)
-               {
-                  //Index of the masking key to be applied
-                  k = (rxContext->payloadPos + j) % 4;
-                  //Convert masked data into unmasked data
-                  rxContext->buffer[j] ^= rxContext->maskingKey[k];
-               }
+               //Convert masked data into unmasked data
+               webSocketApplyMask(rxContext->buffer, n,
+                  rxContext->maskingKey, rxContext->payloadPos);
             }
 
             //Text frame?
@@ -1426,6 +1606,140 @@ error_t webSocketReceiveEx(WebSocket *webSocket, void *data, size_t size,
             }
          }
       }
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+      else if(rxContext->state == WS_SUB_STATE_FRAME_DEFLATE)
+      {
+         //Any compressed data pending in the receive buffer?
+         if(rxContext->bufferPos < rxContext->bufferLen ||
+            rxContext->endOfMessage)
+         {
+            //Sanity check
+            if(data != NULL)
+            {
+               //Decompress data directly to the application buffer
+               p = (uint8_t *) data + i;
+               m = size - i;
+            }
+            else
+            {
+               //The decompressed data are discarded, but the compressed data
+               //must still go through the decompressor so that the sliding
+               //window remains consistent with the peer
+               p = temp;
+               m = MIN(size - i, sizeof(temp));
+            }
+
+            //Decompress as much data as possible
+            error = webSocketInflateDecompress(&webSocket->inflateContext,
+               rxContext->buffer + rxContext->bufferPos,
+               rxContext->bufferLen - rxContext->bufferPos, &k, p, m, &n);
+
+            //The decompressor must make progress while input data remain
+            if(!error && k == 0 && n == 0 &&
+               rxContext->bufferPos < rxContext->bufferLen)
+            {
+               error = ERROR_INVALID_SYNTAX;
+            }
+
+            //Check status code
+            if(error)
+            {
+               //Report a protocol error
+               webSocket->statusCode = WS_STATUS_CODE_PROTOCOL_ERROR;
+               //The endpoint must fail the WebSocket connection
+               error = ERROR_INVALID_FRAME;
+            }
+            else if(rxContext->dataFrameType == WS_FRAME_TYPE_TEXT && n > 0)
+            {
+               //Invalid UTF-8 sequence?
+               if(!webSocketCheckUtf8Stream(&webSocket->utf8Context, p, n, 0))
+               {
+                  //The received data is not consistent with the type of the message
+                  webSocket->statusCode = WS_STATUS_CODE_INVALID_PAYLOAD_DATA;
+                  //The endpoint must fail the WebSocket connection
+                  error = ERROR_INVALID_FRAME;
+               }
+            }
+
+            //Advance data pointers
+            rxContext->bufferPos += k;
+            i += n;
+
+            //The decompressor stops when the output buffer is full or when
+            //the compressed data have been entirely processed
+            if(!error && rxContext->endOfMessage &&
+               rxContext->bufferPos >= rxContext->bufferLen && i < size)
+            {
+               //Make sure the UTF-8 stream is properly terminated
+               if(rxContext->dataFrameType == WS_FRAME_TYPE_TEXT &&
+                  webSocket->utf8Context.utf8CharIndex != 0)
+               {
+                  //The received data is not consistent with the type of the message
+                  webSocket->statusCode = WS_STATUS_CODE_INVALID_PAYLOAD_DATA;
+                  //The endpoint must fail the WebSocket connection
+                  error = ERROR_INVALID_FRAME;
+               }
+               else
+               {
+                  //Decode the next WebSocket frame
+                  rxContext->state = WS_SUB_STATE_INIT;
+
+                  //Last fragment of the message
+                  if(lastFrag != NULL)
+                  {
+                     *lastFrag = TRUE;
+                  }
+
+                  //Exit immediately
+                  break;
+               }
+            }
+         }
+         else if(rxContext->payloadPos < rxContext->payloadLen)
+         {
+            //Limit the number of bytes to read at a time
+            n = MIN(rxContext->payloadLen - rxContext->payloadPos,
+               WEB_SOCKET_BUFFER_SIZE);
+
+            //Read more data
+            error = webSocketReceiveData(webSocket, rxContext->buffer, n, &n, 0);
+
+            //All frames sent from the client to the server are masked
+            if(rxContext->mask)
+            {
+               //Convert masked data into unmasked data
+               webSocketApplyMask(rxContext->buffer, n,
+                  rxContext->maskingKey, rxContext->payloadPos);
+            }
+
+            //Advance data pointer
+            rxContext->payloadPos += n;
+
+            //Compressed data are pending in the receive buffer
+            rxContext->bufferPos = 0;
+            rxContext->bufferLen = n;
+         }
+         else if(rxContext->fin)
+         {
+            //Append 4 octets of 0x00 0x00 0xff 0xff to the tail end of the
+            //payload of the message (refer to RFC 7692, section 7.2.2)
+            rxContext->buffer[0] = 0x00;
+            rxContext->buffer[1] = 0x00;
+            rxContext->buffer[2] = 0xFF;
+            rxContext->buffer[3] = 0xFF;
+
+            //Decompress the trailer
+            rxContext->bufferPos = 0;
+            rxContext->bufferLen = 4;
+            rxContext->endOfMessage = TRUE;
+         }
+         else
+         {
+            //Decode the next fragment of the message
+            rxContext->state = WS_SUB_STATE_INIT;
+         }
+      }
+#endif
       else
       {
          //Invalid state
@@ -56,6 +56,27 @@
    #error WEB_SOCKET_TLS_SUPPORT parameter is not valid
 #endif
 
+//Permessage-deflate extension support
+#ifndef WEB_SOCKET_DEFLATE_SUPPORT
+   #define WEB_SOCKET_DEFLATE_SUPPORT DISABLED
+#elif (WEB_SOCKET_DEFLATE_SUPPORT != ENABLED && WEB_SOCKET_DEFLATE_SUPPORT != DISABLED)
+   #error WEB_SOCKET_DEFLATE_SUPPORT parameter is not valid
+#endif
+
+//Size of the LZ77 sliding window (base-2 logarithm)
+#ifndef WEB_SOCKET_DEFLATE_WINDOW_BITS
+   #define WEB_SOCKET_DEFLATE_WINDOW_BITS 10
+#elif (WEB_SOCKET_DEFLATE_WINDOW_BITS < 9 || WEB_SOCKET_DEFLATE_WINDOW_BITS > 15)
+   #error WEB_SOCKET_DEFLATE_WINDOW_BITS parameter is not valid
+#endif
+
+//Size of the compressor hash table (base-2 logarithm)
+#ifndef WEB_SOCKET_DEFLATE_HASH_BITS
+   #define WEB_SOCKET_DEFLATE_HASH_BITS 9
+#elif (WEB_SOCKET_DEFLATE_HASH_BITS < 6 || WEB_SOCKET_DEFLATE_HASH_BITS > 15)
+   #error WEB_SOCKET_DEFLATE_HASH_BITS parameter is not valid
+#endif
+
 //Basic access authentication support
 #ifndef WEB_SOCKET_BASIC_AUTH_SUPPORT
    #define WEB_SOCKET_BASIC_AUTH_SUPPORT DISABLED
@@ -172,6 +193,11 @@
 //Server key size
 #define WEB_SOCKET_SERVER_KEY_SIZE 28
 
+//Size of the LZ77 sliding window
+#define WEB_SOCKET_DEFLATE_WINDOW_SIZE (1U << WEB_SOCKET_DEFLATE_WINDOW_BITS)
+//Size of the compressor hash table
+#define WEB_SOCKET_DEFLATE_HASH_SIZE (1U << WEB_SOCKET_DEFLATE_HASH_BITS)
+
 //Forward declaration of WebSocket structure
 struct _WebSocket;
 #define WebSocket struct _WebSocket
@@ -251,7 +277,8 @@ typedef enum
    //WebSocket frame decoding
    WS_SUB_STATE_FRAME_HEADER           = 4,
    WS_SUB_STATE_FRAME_EXT_HEADER       = 5,
-   WS_SUB_STATE_FRAME_PAYLOAD          = 6
+   WS_SUB_STATE_FRAME_PAYLOAD          = 6,
+   WS_SUB_STATE_FRAME_DEFLATE          = 7
 } WebSocketSubState;
 
 
@@ -388,6 +415,13 @@ typedef struct
    char_t serverKey[WEB_SOCKET_SERVER_KEY_SIZE + 1];
    bool_t closingFrameSent;
    bool_t closingFrameReceived;
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   bool_t perMessageDeflate;
+   uint_t clientMaxWindowBits;
+   uint_t serverMaxWindowBits;
+   bool_t clientNoContextTakeover;
+   bool_t serverNoContextTakeover;
+#endif
 } WebSocketHandshakeContext;
 
 
@@ -408,9 +442,82 @@ typedef struct
    uint8_t buffer[WEB_SOCKET_BUFFER_SIZE]; ///<Data buffer
    size_t bufferLen;                       ///<Length of the data buffer
    size_t bufferPos;                       ///<Current position
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   bool_t compressed;                      ///<Compressed message (RSV1 bit set)
+   bool_t endOfMessage;                    ///<The end of the compressed message has been reached
+#endif
 } WebSocketFrameContext;
 
 
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+
+/**
+ * @brief DEFLATE compression context
+ **/
+
+typedef struct
+{
+   uint_t windowBits;                                        ///<Maximum LZ77 window size (base-2 logarithm)
+   bool_t noContextTakeover;                                 ///<Reset the LZ77 window at the start of each message
+   bool_t blockStarted;                                      ///<A compressed block has been started
+   uint32_t bitBuffer;                                       ///<Pending output bits
+   uint_t bitCount;                                          ///<Number of pending output bits
+   size_t windowLen;                                         ///<Number of bytes in the sliding window
+   uint16_t hashTable[WEB_SOCKET_DEFLATE_HASH_SIZE];         ///<Hash table (most recent position of each 3-byte sequence)
+   uint8_t window[2 * WEB_SOCKET_DEFLATE_WINDOW_SIZE];       ///<Sliding window
+} WebSocketDeflateContext;
+
+
+/**
+ * @brief DEFLATE decompression states
+ **/
+
+typedef enum
+{
+   WS_INFLATE_STATE_BLOCK_HEADER   = 0,
+   WS_INFLATE_STATE_STORED_HEADER  = 1,
+   WS_INFLATE_STATE_STORED_DATA    = 2,
+   WS_INFLATE_STATE_DYNAMIC_HEADER = 3,
+   WS_INFLATE_STATE_CODE_LEN_LENS  = 4,
+   WS_INFLATE_STATE_CODE_LENS      = 5,
+   WS_INFLATE_STATE_LIT_LEN        = 6,
+   WS_INFLATE_STATE_DIST           = 7,
+   WS_INFLATE_STATE_COPY           = 8,
+   WS_INFLATE_STATE_DONE           = 9
+} WebSocketInflateState;
+
+
+/**
+ * @brief DEFLATE decompression context
+ **/
+
+typedef struct
+{
+   uint_t windowBits;                                        ///<Maximum LZ77 window size (base-2 logarithm)
+   bool_t noContextTakeover;                                 ///<Reset the LZ77 window at the start of each message
+   WebSocketInflateState state;                              ///<Decompression state
+   bool_t finalBlock;                                        ///<Last block of the DEFLATE stream
+   uint64_t bitBuffer;                                       ///<Pending input bits
+   uint_t bitCount;                                          ///<Number of pending input bits
+   uint_t numLitLenCodes;                                    ///<Number of literal/length codes
+   uint_t numDistCodes;                                      ///<Number of distance codes
+   uint_t numCodeLenCodes;                                   ///<Number of code length codes
+   uint_t index;                                             ///<Current code length index
+   uint_t length;                                            ///<Remaining length of the current match or stored block
+   uint_t distance;                                          ///<Distance of the current match
+   uint8_t codeLengths[320];                                 ///<Code lengths
+   uint16_t litLenCount[16];                                 ///<Number of literal/length codes of each length
+   uint16_t litLenSymbol[288];                               ///<Literal/length symbols ordered by code
+   uint16_t distCount[16];                                   ///<Number of distance codes of each length
+   uint16_t distSymbol[32];                                  ///<Distance symbols ordered by code
+   size_t windowPos;                                         ///<Current position in the sliding window
+   size_t windowLen;                                         ///<Number of valid bytes in the sliding window
+   uint8_t window[WEB_SOCKET_DEFLATE_WINDOW_SIZE];           ///<Sliding window
+} WebSocketInflateContext;
+
+#endif
+
+
 /**
  * @brief UTF-8 decoding context
  **/
@@ -455,6 +562,11 @@ struct _WebSocket
    WebSocketFrameContext txContext;
    WebSocketFrameContext rxContext;
    WebSocketUtf8Context utf8Context;
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   bool_t deflateEnabled;                    ///<Permessage-deflate extension enabled
+   WebSocketDeflateContext deflateContext;   ///<Compression context
+   WebSocketInflateContext inflateContext;   ///<Decompression context
+#endif
 };
 
 
@@ -483,6 +595,7 @@ error_t webSocketSetTimeout(WebSocket *webSocket, systime_t timeout);
 error_t webSocketSetHost(WebSocket *webSocket, const char_t *host);
 error_t webSocketSetOrigin(WebSocket *webSocket, const char_t *origin);
 error_t webSocketSetSubProtocol(WebSocket *webSocket, const char_t *subProtocol);
+error_t webSocketEnableDeflate(WebSocket *webSocket, bool_t enable);
 
 error_t webSocketSetAuthInfo(WebSocket *webSocket, const char_t *username,
    const char_t *password, uint_t allowedAuthModes);
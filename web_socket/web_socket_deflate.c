@@ -0,0 +1,1722 @@
+/**
+ * @file web_socket_deflate.c
+ * @brief WebSocket permessage-deflate extension (RFC 7692)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+//Switch to the appropriate trace level
+#define TRACE_LEVEL WEB_SOCKET_TRACE_LEVEL
+
+//Dependencies
+#include "core/net.h"
+#include "web_socket/web_socket.h"
+#include "web_socket/web_socket_frame.h"
+#include "web_socket/web_socket_deflate.h"
+#include "str.h"
+#include "debug.h"
+
+//Check TCP/IP stack configuration
+#if (WEB_SOCKET_SUPPORT == ENABLED && WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+
+//Base lengths for length codes 257 to 285
+static const uint16_t lengthBase[29] =
+{
+   3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+   35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+//Extra bits for length codes 257 to 285
+static const uint8_t lengthExtraBits[29] =
+{
+   0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+   3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+//Base distances for distance codes 0 to 29
+static const uint16_t distBase[30] =
+{
+   1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+   257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+//Extra bits for distance codes 0 to 29
+static const uint8_t distExtraBits[30] =
+{
+   0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+   7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+//Order in which the code length code lengths are transmitted
+static const uint8_t codeLenOrder[19] =
+{
+   16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+
+/**
+ * @brief Format Sec-WebSocket-Extensions header field
+ * @param[in] webSocket Handle to a WebSocket
+ * @param[out] output Buffer where to format the header field
+ * @return Total length of the header field
+ **/
+
+size_t webSocketAddExtensionsField(WebSocket *webSocket, char_t *output)
+{
+   size_t n;
+   WebSocketHandshakeContext *handshakeContext;
+
+   //Point to the handshake context
+   handshakeContext = &webSocket->handshakeContext;
+
+   //Length of the header field
+   n = 0;
+
+   //Client or server operation?
+   if(webSocket->endpoint == WS_ENDPOINT_CLIENT)
+   {
+      //Check whether the permessage-deflate extension should be offered
+      if(webSocket->deflateEnabled)
+      {
+         //The server is requested to limit the size of its LZ77 window so
+         //that the memory footprint of the decompressor remains bounded. The
+         //client_max_window_bits parameter lets the server limit the client's
+         //window in the same way
+         n = osSprintf(output, "Sec-WebSocket-Extensions: permessage-deflate; "
+            "client_max_window_bits; server_max_window_bits=%u\r\n",
+            WEB_SOCKET_DEFLATE_WINDOW_BITS);
+      }
+   }
+   else
+   {
+      //Check whether the offer has been accepted
+      if(handshakeContext->perMessageDeflate)
+      {
+         //Format the extension negotiation response
+         n = osSprintf(output, "Sec-WebSocket-Extensions: permessage-deflate; "
+            "server_max_window_bits=%u", handshakeContext->serverMaxWindowBits);
+
+         //The client_max_window_bits parameter must not be included unless
+         //the offer contains it
+         if(handshakeContext->clientMaxWindowBits != 0)
+         {
+            n += osSprintf(output + n, "; client_max_window_bits=%u",
+               handshakeContext->clientMaxWindowBits);
+         }
+
+         //The server resets its LZ77 window at the start of each message
+         if(handshakeContext->serverNoContextTakeover)
+         {
+            n += osSprintf(output + n, "; server_no_context_takeover");
+         }
+
+         //The client is expected to reset its LZ77 window at the start of
+         //each message
+         if(handshakeContext->clientNoContextTakeover)
+         {
+            n += osSprintf(output + n, "; client_no_context_takeover");
+         }
+
+         //Terminate the header field with a CRLF sequence
+         n += osSprintf(output + n, "\r\n");
+      }
+   }
+
+   //Return the length of the header field
+   return n;
+}
+
+
+/**
+ * @brief Parse Sec-WebSocket-Extensions header field
+ * @param[in] webSocket Handle to a WebSocket
+ * @param[in] value NULL-terminated string that contains the value of header field
+ * @return Error code
+ **/
+
+error_t webSocketParseExtensionsField(WebSocket *webSocket, char_t *value)
+{
+   error_t error;
+   char_t *p;
+   char_t *token;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Get the first extension of the list
+   token = osStrtok_r(value, ",", &p);
+
+   //Parse the comma-separated list
+   while(token != NULL)
+   {
+      //Client or server operation?
+      if(webSocket->endpoint == WS_ENDPOINT_CLIENT)
+      {
+         //The client must fail the connection if the response contains an
+         //extension that was not offered or invalid parameters
+         error = webSocketParseDeflateResponse(webSocket, token);
+         //Any error to report?
+         if(error)
+            break;
+      }
+      else
+      {
+         //The server accepts the first acceptable offer
+         if(webSocket->deflateEnabled &&
+            !webSocket->handshakeContext.perMessageDeflate)
+         {
+            //Unacceptable offers are silently declined
+            webSocketParseDeflateOffer(webSocket, token);
+         }
+      }
+
+      //Get next extension
+      token = osStrtok_r(NULL, ",", &p);
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Parse permessage-deflate extension offer (server side)
+ * @param[in] webSocket Handle to a WebSocket
+ * @param[in] offer NULL-terminated string that contains the extension offer
+ * @return Error code
+ **/
+
+error_t webSocketParseDeflateOffer(WebSocket *webSocket, char_t *offer)
+{
+   error_t error;
+   uint_t windowBits;
+   uint_t clientMaxWindowBits;
+   uint_t serverMaxWindowBits;
+   bool_t clientNoContextTakeover;
+   bool_t serverNoContextTakeover;
+   char_t *p;
+   char_t *name;
+   char_t *value;
+   char_t *token;
+   WebSocketHandshakeContext *handshakeContext;
+
+   //Point to the handshake context
+   handshakeContext = &webSocket->handshakeContext;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //Default parameters
+   clientMaxWindowBits = 0;
+   serverMaxWindowBits = WEB_SOCKET_DEFLATE_WINDOW_BITS;
+   clientNoContextTakeover = FALSE;
+   serverNoContextTakeover = FALSE;
+
+   //The extension name is followed by a semicolon-separated list of
+   //parameters
+   token = osStrtok_r(offer, ";", &p);
+
+   //Check extension name
+   if(token == NULL || osStrcasecmp(strTrimWhitespace(token),
+      "permessage-deflate") != 0)
+   {
+      return ERROR_UNSUPPORTED_EXTENSION;
+   }
+
+   //Get the first parameter
+   token = osStrtok_r(NULL, ";", &p);
+
+   //Parse the list of parameters
+   while(token != NULL && !error)
+   {
+      //Check whether a value is present
+      value = osStrchr(token, '=');
+
+      //Split the parameter
+      if(value != NULL)
+      {
+         *value = '\0';
+         value = strTrimWhitespace(value + 1);
+      }
+
+      //Get parameter name
+      name = strTrimWhitespace(token);
+
+      //Check parameter name
+      if(osStrcasecmp(name, "server_no_context_takeover") == 0)
+      {
+         //This parameter has no value
+         if(value == NULL)
+            serverNoContextTakeover = TRUE;
+         else
+            error = ERROR_INVALID_SYNTAX;
+      }
+      else if(osStrcasecmp(name, "client_no_context_takeover") == 0)
+      {
+         //This parameter has no value
+         if(value == NULL)
+            clientNoContextTakeover = TRUE;
+         else
+            error = ERROR_INVALID_SYNTAX;
+      }
+      else if(osStrcasecmp(name, "server_max_window_bits") == 0)
+      {
+         //Parse the value of the parameter
+         error = webSocketParseWindowBits(value, &windowBits);
+
+         //Check status code
+         if(!error)
+         {
+            //The server's LZ77 window must not exceed the requested size
+            serverMaxWindowBits = MIN(windowBits, WEB_SOCKET_DEFLATE_WINDOW_BITS);
+         }
+      }
+      else if(osStrcasecmp(name, "client_max_window_bits") == 0)
+      {
+         //The value of this parameter is optional
+         if(value != NULL)
+         {
+            //Parse the value of the parameter
+            error = webSocketParseWindowBits(value, &windowBits);
+         }
+         else
+         {
+            //The client supports limiting its LZ77 window
+            windowBits = WEB_SOCKET_DEFLATE_MAX_WINDOW_BITS;
+         }
+
+         //Check status code
+         if(!error)
+         {
+            //Limit the client's LZ77 window to the size of the decompressor's
+            //window
+            clientMaxWindowBits = MIN(windowBits, WEB_SOCKET_DEFLATE_WINDOW_BITS);
+         }
+      }
+      else
+      {
+         //Unknown parameter
+         error = ERROR_INVALID_SYNTAX;
+      }
+
+      //Get next parameter
+      token = osStrtok_r(NULL, ";", &p);
+   }
+
+   //Any error to report?
+   if(error)
+      return error;
+
+   //If the offer does not contain the client_max_window_bits parameter, the
+   //client may use a 32KB LZ77 window, which cannot be accommodated unless
+   //the decompressor is configured for the maximum window size
+   if(clientMaxWindowBits == 0 &&
+      WEB_SOCKET_DEFLATE_WINDOW_BITS < WEB_SOCKET_DEFLATE_MAX_WINDOW_BITS)
+   {
+      return ERROR_UNSUPPORTED_CONFIGURATION;
+   }
+
+   //Accept the offer
+   handshakeContext->perMessageDeflate = TRUE;
+   handshakeContext->clientMaxWindowBits = clientMaxWindowBits;
+   handshakeContext->serverMaxWindowBits = serverMaxWindowBits;
+   handshakeContext->clientNoContextTakeover = clientNoContextTakeover;
+   handshakeContext->serverNoContextTakeover = serverNoContextTakeover;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Parse permessage-deflate extension response (client side)
+ * @param[in] webSocket Handle to a WebSocket
+ * @param[in] response NULL-terminated string that contains the extension
+ *   negotiation response
+ * @return Error code
+ **/
+
+error_t webSocketParseDeflateResponse(WebSocket *webSocket, char_t *response)
+{
+   error_t error;
+   uint_t windowBits;
+   char_t *p;
+   char_t *name;
+   char_t *value;
+   char_t *token;
+   WebSocketHandshakeContext *handshakeContext;
+
+   //Point to the handshake context
+   handshakeContext = &webSocket->handshakeContext;
+
+   //Initialize status code
+   error = NO_ERROR;
+
+   //The server must not accept an extension that has not been offered by
+   //the client
+   if(!webSocket->deflateEnabled || handshakeContext->perMessageDeflate)
+      return ERROR_UNSUPPORTED_EXTENSION;
+
+   //The extension name is followed by a semicolon-separated list of
+   //parameters
+   token = osStrtok_r(response, ";", &p);
+
+   //Check extension name
+   if(token == NULL || osStrcasecmp(strTrimWhitespace(token),
+      "permessage-deflate") != 0)
+   {
+      return ERROR_UNSUPPORTED_EXTENSION;
+   }
+
+   //Default parameters
+   handshakeContext->clientMaxWindowBits = WEB_SOCKET_DEFLATE_WINDOW_BITS;
+   handshakeContext->serverMaxWindowBits = WEB_SOCKET_DEFLATE_MAX_WINDOW_BITS;
+   handshakeContext->clientNoContextTakeover = FALSE;
+   handshakeContext->serverNoContextTakeover = FALSE;
+
+   //Get the first parameter
+   token = osStrtok_r(NULL, ";", &p);
+
+   //Parse the list of parameters
+   while(token != NULL && !error)
+   {
+      //Check whether a value is present
+      value = osStrchr(token, '=');
+
+      //Split the parameter
+      if(value != NULL)
+      {
+         *value = '\0';
+         value = strTrimWhitespace(value + 1);
+      }
+
+      //Get parameter name
+      name = strTrimWhitespace(token);
+
+      //Check parameter name
+      if(osStrcasecmp(name, "server_no_context_takeover") == 0)
+      {
+         //This parameter has no value
+         if(value == NULL)
+            handshakeContext->serverNoContextTakeover = TRUE;
+         else
+            error = ERROR_INVALID_SYNTAX;
+      }
+      else if(osStrcasecmp(name, "client_no_context_takeover") == 0)
+      {
+         //This parameter has no value
+         if(value == NULL)
+            handshakeContext->clientNoContextTakeover = TRUE;
+         else
+            error = ERROR_INVALID_SYNTAX;
+      }
+      else if(osStrcasecmp(name, "server_max_window_bits") == 0)
+      {
+         //Parse the value of the parameter
+         error = webSocketParseWindowBits(value, &windowBits);
+
+         //Check status code
+         if(!error)
+         {
+            handshakeContext->serverMaxWindowBits = windowBits;
+         }
+      }
+      else if(osStrcasecmp(name, "client_max_window_bits") == 0)
+      {
+         //Parse the value of the parameter
+         error = webSocketParseWindowBits(value, &windowBits);
+
+         //Check status code
+         if(!error)
+         {
+            //The client must not use an LZ77 window larger than the value
+            //specified by the server
+            handshakeContext->clientMaxWindowBits = MIN(windowBits,
+               WEB_SOCKET_DEFLATE_WINDOW_BITS);
+         }
+      }
+      else
+      {
+         //Unknown parameter
+         error = ERROR_INVALID_SYNTAX;
+      }
+
+      //Get next parameter
+      token = osStrtok_r(NULL, ";", &p);
+   }
+
+   //Any error to report?
+   if(error)
+      return error;
+
+   //The server's LZ77 window must fit in the decompressor's window
+   if(handshakeContext->serverMaxWindowBits > WEB_SOCKET_DEFLATE_WINDOW_BITS)
+      return ERROR_UNSUPPORTED_CONFIGURATION;
+
+   //The permessage-deflate extension is in use
+   handshakeContext->perMessageDeflate = TRUE;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Parse the value of a max_window_bits parameter
+ * @param[in] value NULL-terminated string that contains the value
+ * @param[out] windowBits Base-2 logarithm of the LZ77 window size
+ * @return Error code
+ **/
+
+error_t webSocketParseWindowBits(const char_t *value, uint_t *windowBits)
+{
+   size_t n;
+   char_t *p;
+   char_t temp[4];
+
+   //The parameter must have a value
+   if(value == NULL)
+      return ERROR_INVALID_SYNTAX;
+
+   //The value may be a quoted string
+   if(value[0] == '\"')
+      value++;
+
+   //Retrieve the length of the value
+   n = osStrlen(value);
+
+   //Remove the closing quote, if any
+   if(n > 0 && value[n - 1] == '\"')
+   {
+      n--;
+   }
+
+   //Valid values consist of one or two decimal digits
+   if(n < 1 || n > 2)
+      return ERROR_INVALID_SYNTAX;
+
+   //Copy the decimal value
+   osMemcpy(temp, value, n);
+   //Properly terminate the string with a NULL character
+   temp[n] = '\0';
+
+   //Convert the string to an integer
+   *windowBits = osStrtoul(temp, &p, 10);
+
+   //Make sure the value is a decimal integer in the range 8 to 15
+   if(temp[0] == '\0' || *p != '\0' ||
+      *windowBits < WEB_SOCKET_DEFLATE_MIN_WINDOW_BITS ||
+      *windowBits > WEB_SOCKET_DEFLATE_MAX_WINDOW_BITS)
+   {
+      return ERROR_INVALID_SYNTAX;
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Initialize compression and decompression contexts
+ * @param[in] webSocket Handle to a WebSocket
+ **/
+
+void webSocketInitDeflate(WebSocket *webSocket)
+{
+   uint_t windowBits;
+   WebSocketHandshakeContext *handshakeContext;
+
+   //Point to the handshake context
+   handshakeContext = &webSocket->handshakeContext;
+
+   //No message is being compressed or decompressed
+   webSocket->txContext.compressed = FALSE;
+   webSocket->rxContext.compressed = FALSE;
+
+   //Permessage-deflate extension negotiated?
+   if(handshakeContext->perMessageDeflate)
+   {
+      //Client or server operation?
+      if(webSocket->endpoint == WS_ENDPOINT_CLIENT)
+      {
+         //Initialize compression context
+         webSocketDeflateInit(&webSocket->deflateContext,
+            handshakeContext->clientMaxWindowBits,
+            handshakeContext->clientNoContextTakeover);
+
+         //Initialize decompression context
+         webSocketInflateInit(&webSocket->inflateContext,
+            handshakeContext->serverMaxWindowBits,
+            handshakeContext->serverNoContextTakeover);
+      }
+      else
+      {
+         //Initialize compression context
+         webSocketDeflateInit(&webSocket->deflateContext,
+            handshakeContext->serverMaxWindowBits,
+            handshakeContext->serverNoContextTakeover);
+
+         //The client may use a 32KB window if the offer does not contain
+         //the client_max_window_bits parameter
+         if(handshakeContext->clientMaxWindowBits != 0)
+         {
+            windowBits = handshakeContext->clientMaxWindowBits;
+         }
+         else
+         {
+            windowBits = WEB_SOCKET_DEFLATE_MAX_WINDOW_BITS;
+         }
+
+         //Initialize decompression context
+         webSocketInflateInit(&webSocket->inflateContext, windowBits,
+            handshakeContext->clientNoContextTakeover);
+      }
+   }
+}
+
+
+/**
+ * @brief Format a frame that carries compressed data
+ * @param[in] webSocket Handle to a WebSocket
+ * @param[in] fin FIN flag
+ * @return Error code
+ **/
+
+error_t webSocketFormatCompressedFrame(WebSocket *webSocket, bool_t fin)
+{
+   error_t error;
+   size_t n;
+   WebSocketFrame *frame;
+   WebSocketFrameContext *txContext;
+
+   //Point to the TX context
+   txContext = &webSocket->txContext;
+   //Point to the frame header
+   frame = (WebSocketFrame *) txContext->buffer;
+
+   //Length of the compressed data
+   n = txContext->payloadLen;
+
+   //Format WebSocket frame header
+   error = webSocketFormatFrameHeader(webSocket, fin,
+      txContext->dataFrameType, n);
+   //Any error to report?
+   if(error)
+      return error;
+
+   //The RSV1 bit is set on the first frame of a compressed message only
+   if(txContext->dataFrameType != WS_FRAME_TYPE_CONTINUATION)
+   {
+      frame->reserved = WEB_SOCKET_DEFLATE_RSV1;
+   }
+
+   //The compressed data immediately follows the frame header
+   osMemmove(txContext->buffer + txContext->bufferLen,
+      txContext->buffer + WEB_SOCKET_DEFLATE_HEADER_SIZE, n);
+
+   //All frames sent from the client to the server are masked
+   if(webSocket->endpoint == WS_ENDPOINT_CLIENT)
+   {
+      //Convert unmasked data into masked data
+      webSocketApplyMask(txContext->buffer + txContext->bufferLen, n,
+         txContext->maskingKey, 0);
+   }
+
+   //Update the number of data buffered but not yet sent
+   txContext->bufferLen += n;
+   txContext->bufferPos = 0;
+
+   //Subsequent frames of the message are continuation frames
+   txContext->dataFrameType = WS_FRAME_TYPE_CONTINUATION;
+   //Save the FIN flag
+   txContext->fin = fin;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Initialize compression context
+ * @param[in] context Pointer to the compression context
+ * @param[in] windowBits Maximum LZ77 window size (base-2 logarithm)
+ * @param[in] noContextTakeover Reset the LZ77 window at the start of each message
+ **/
+
+void webSocketDeflateInit(WebSocketDeflateContext *context,
+   uint_t windowBits, bool_t noContextTakeover)
+{
+   //Clear compression context
+   osMemset(context, 0, sizeof(WebSocketDeflateContext));
+
+   //Save parameters
+   context->windowBits = MIN(windowBits, WEB_SOCKET_DEFLATE_WINDOW_BITS);
+   context->noContextTakeover = noContextTakeover;
+}
+
+
+/**
+ * @brief Prepare the compression context for a new message
+ * @param[in] context Pointer to the compression context
+ **/
+
+void webSocketDeflateStartMessage(WebSocketDeflateContext *context)
+{
+   //Each message starts with a new block
+   context->blockStarted = FALSE;
+   context->bitBuffer = 0;
+   context->bitCount = 0;
+
+   //Check whether the LZ77 window can be reused across messages
+   if(context->noContextTakeover)
+   {
+      //Flush the sliding window
+      context->windowLen = 0;
+      osMemset(context->hashTable, 0, sizeof(context->hashTable));
+   }
+}
+
+
+/**
+ * @brief Compress data using fixed Huffman codes
+ * @param[in] context Pointer to the compression context
+ * @param[in] input Data to be compressed
+ * @param[in] inputLen Length of the data to be compressed
+ * @param[out] consumed Number of input bytes that have been processed
+ * @param[out] output Buffer where to store the compressed data
+ * @param[in] outputSize Size of the output buffer
+ * @param[out] written Number of bytes written to the output buffer
+ * @return Error code
+ **/
+
+error_t webSocketDeflateCompress(WebSocketDeflateContext *context,
+   const uint8_t *input, size_t inputLen, size_t *consumed,
+   uint8_t *output, size_t outputSize, size_t *written)
+{
+   uint_t h;
+   uint_t k;
+   size_t i;
+   size_t n;
+   size_t pos;
+   size_t end;
+   size_t shift;
+   size_t match;
+   size_t matchLen;
+   size_t maxLen;
+   size_t distance;
+   uint8_t *p;
+
+   //Initialize variables
+   *consumed = 0;
+   *written = 0;
+
+   //Each input byte produces at most 9 bits of output. Reserve room for the
+   //block header and for the pending bits
+   if(outputSize < 3)
+      return NO_ERROR;
+
+   //Limit the number of bytes to process at a time
+   n = MIN(inputLen, (outputSize * 8 - 10) / 9);
+   n = MIN(n, WEB_SOCKET_DEFLATE_WINDOW_SIZE);
+
+   //Nothing to compress?
+   if(n == 0)
+      return NO_ERROR;
+
+   //Start a new block?
+   if(!context->blockStarted)
+   {
+      //BFINAL = 0, BTYPE = 01 (compressed with fixed Huffman codes)
+      webSocketDeflateWriteBits(context, 2, 3, output, written);
+      context->blockStarted = TRUE;
+   }
+
+   //Make room in the sliding window
+   if((context->windowLen + n) > (2 * WEB_SOCKET_DEFLATE_WINDOW_SIZE))
+   {
+      //Keep the most recent bytes only
+      shift = context->windowLen - WEB_SOCKET_DEFLATE_WINDOW_SIZE;
+
+      //Slide the window
+      osMemmove(context->window, context->window + shift,
+         WEB_SOCKET_DEFLATE_WINDOW_SIZE);
+
+      context->windowLen = WEB_SOCKET_DEFLATE_WINDOW_SIZE;
+
+      //Update the hash table
+      for(h = 0; h < WEB_SOCKET_DEFLATE_HASH_SIZE; h++)
+      {
+         if(context->hashTable[h] >= shift)
+         {
+            context->hashTable[h] -= shift;
+         }
+         else
+         {
+            context->hashTable[h] = 0;
+         }
+      }
+   }
+
+   //Append the data to the sliding window
+   osMemcpy(context->window + context->windowLen, input, n);
+
+   //Point to the sliding window
+   p = context->window;
+   //Range of bytes to be processed
+   pos = context->windowLen;
+   end = context->windowLen + n;
+
+   //Maximum distance of a match
+   distance = (size_t) 1 << context->windowBits;
+
+   //Process the data
+   while(pos < end)
+   {
+      //Length of the longest match
+      matchLen = 0;
+      match = 0;
+
+      //At least 3 bytes are required to search for a match
+      if((pos + WEB_SOCKET_DEFLATE_MIN_MATCH) <= end)
+      {
+         //Hash the next 3 bytes
+         h = WEB_SOCKET_DEFLATE_HASH(p + pos);
+
+         //Retrieve the most recent occurrence of the same hash value
+         match = context->hashTable[h];
+         context->hashTable[h] = (uint16_t) pos;
+
+         //Check the distance of the candidate
+         if(match < pos && (pos - match) <= distance)
+         {
+            //Limit the length of the match
+            maxLen = MIN(end - pos, WEB_SOCKET_DEFLATE_MAX_MATCH);
+
+            //Compute the length of the match
+            while(matchLen < maxLen && p[match + matchLen] == p[pos + matchLen])
+            {
+               matchLen++;
+            }
+         }
+      }
+
+      //Any match found?
+      if(matchLen >= WEB_SOCKET_DEFLATE_MIN_MATCH)
+      {
+         //Select the relevant length code
+         for(k = 0; k < 28 && lengthBase[k + 1] <= matchLen; k++)
+         {
+         }
+
+         //Encode the length of the match
+         webSocketDeflateWriteCode(context, 257 + k, output, written);
+
+         webSocketDeflateWriteBits(context, matchLen - lengthBase[k],
+            lengthExtraBits[k], output, written);
+
+         //Select the relevant distance code
+         for(k = 0; k < 29 && distBase[k + 1] <= (pos - match); k++)
+         {
+         }
+
+         //Distance codes 0-29 are represented by fixed-length 5-bit codes.
+         //Huffman codes are packed starting with the most significant bit
+         webSocketDeflateWriteBits(context, ((k & 0x01) << 4) |
+            ((k & 0x02) << 2) | (k & 0x04) | ((k & 0x08) >> 2) |
+            ((k & 0x10) >> 4), 5, output, written);
+
+         //Encode the distance of the match
+         webSocketDeflateWriteBits(context, pos - match - distBase[k],
+            distExtraBits[k], output, written);
+
+         //Insert the strings covered by the match into the hash table
+         for(i = 1; i < matchLen; i++)
+         {
+            if((pos + i + WEB_SOCKET_DEFLATE_MIN_MATCH) <= end)
+            {
+               context->hashTable[WEB_SOCKET_DEFLATE_HASH(p + pos + i)] =
+                  (uint16_t) (pos + i);
+            }
+         }
+
+         //Skip the matching bytes
+         pos += matchLen;
+      }
+      else
+      {
+         //Encode a literal byte
+         webSocketDeflateWriteCode(context, p[pos], output, written);
+         pos++;
+      }
+   }
+
+   //Update the length of the sliding window
+   context->windowLen = end;
+   //Number of input bytes that have been processed
+   *consumed = n;
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Terminate the compressed data of a message
+ * @param[in] context Pointer to the compression context
+ * @param[out] output Buffer where to store the compressed data
+ * @param[in] outputSize Size of the output buffer
+ * @param[out] written Number of bytes written to the output buffer
+ * @return Error code
+ **/
+
+error_t webSocketDeflateFlush(WebSocketDeflateContext *context,
+   uint8_t *output, size_t outputSize, size_t *written)
+{
+   //Initialize variables
+   *written = 0;
+
+   //The end-of-block code, the header of the empty stored block and the
+   //pending bits fit in 3 bytes
+   if(outputSize < 3)
+      return ERROR_BUFFER_OVERFLOW;
+
+   //Any block in progress?
+   if(context->blockStarted)
+   {
+      //Encode the end-of-block symbol
+      webSocketDeflateWriteCode(context, 256, output, written);
+      context->blockStarted = FALSE;
+   }
+
+   //Append an empty stored block (BFINAL = 0, BTYPE = 00)
+   webSocketDeflateWriteBits(context, 0, 3, output, written);
+
+   //Stored blocks are aligned on a byte boundary
+   if(context->bitCount > 0)
+   {
+      webSocketDeflateWriteBits(context, 0, 8 - context->bitCount, output,
+         written);
+   }
+
+   //The LEN and NLEN fields of the empty stored block (0x00 0x00 0xFF 0xFF)
+   //are removed from the payload (refer to RFC 7692, section 7.2.1)
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Write bits to the compressed stream
+ * @param[in] context Pointer to the compression context
+ * @param[in] value Bits to be written
+ * @param[in] length Number of bits
+ * @param[out] output Output buffer
+ * @param[in,out] written Number of bytes written to the output buffer
+ **/
+
+void webSocketDeflateWriteBits(WebSocketDeflateContext *context,
+   uint32_t value, uint_t length, uint8_t *output, size_t *written)
+{
+   //Data elements are packed starting with the least-significant bit
+   context->bitBuffer |= value << context->bitCount;
+   context->bitCount += length;
+
+   //Flush complete bytes
+   while(context->bitCount >= 8)
+   {
+      output[(*written)++] = context->bitBuffer & 0xFF;
+      context->bitBuffer >>= 8;
+      context->bitCount -= 8;
+   }
+}
+
+
+/**
+ * @brief Write a literal/length symbol using fixed Huffman codes
+ * @param[in] context Pointer to the compression context
+ * @param[in] symbol Literal/length symbol
+ * @param[out] output Output buffer
+ * @param[in,out] written Number of bytes written to the output buffer
+ **/
+
+void webSocketDeflateWriteCode(WebSocketDeflateContext *context,
+   uint_t symbol, uint8_t *output, size_t *written)
+{
+   uint_t i;
+   uint_t n;
+   uint_t code;
+   uint32_t value;
+
+   //Fixed Huffman codes (refer to RFC 1951, section 3.2.6)
+   if(symbol < 144)
+   {
+      code = 0x30 + symbol;
+      n = 8;
+   }
+   else if(symbol < 256)
+   {
+      code = 0x190 + symbol - 144;
+      n = 9;
+   }
+   else if(symbol < 280)
+   {
+      code = symbol - 256;
+      n = 7;
+   }
+   else
+   {
+      code = 0xC0 + symbol - 280;
+      n = 8;
+   }
+
+   //Huffman codes are packed starting with the most-significant bit
+   for(value = 0, i = 0; i < n; i++)
+   {
+      value = (value << 1) | (code & 0x01);
+      code >>= 1;
+   }
+
+   //Write the code
+   webSocketDeflateWriteBits(context, value, n, output, written);
+}
+
+
+/**
+ * @brief Initialize decompression context
+ * @param[in] context Pointer to the decompression context
+ * @param[in] windowBits Maximum LZ77 window size (base-2 logarithm)
+ * @param[in] noContextTakeover Reset the LZ77 window at the start of each message
+ **/
+
+void webSocketInflateInit(WebSocketInflateContext *context,
+   uint_t windowBits, bool_t noContextTakeover)
+{
+   //Clear decompression context
+   osMemset(context, 0, sizeof(WebSocketInflateContext));
+
+   //Save parameters
+   context->windowBits = windowBits;
+   context->noContextTakeover = noContextTakeover;
+
+   //Wait for the first block header
+   context->state = WS_INFLATE_STATE_BLOCK_HEADER;
+}
+
+
+/**
+ * @brief Prepare the decompression context for a new message
+ * @param[in] context Pointer to the decompression context
+ **/
+
+void webSocketInflateStartMessage(WebSocketInflateContext *context)
+{
+   //Each message starts with a new block
+   context->state = WS_INFLATE_STATE_BLOCK_HEADER;
+   context->finalBlock = FALSE;
+   context->bitBuffer = 0;
+   context->bitCount = 0;
+
+   //Check whether the peer reuses its LZ77 window across messages
+   if(context->noContextTakeover)
+   {
+      //Flush the sliding window
+      context->windowPos = 0;
+      context->windowLen = 0;
+   }
+}
+
+
+/**
+ * @brief Decompress data
+ * @param[in] context Pointer to the decompression context
+ * @param[in] input Compressed data
+ * @param[in] inputLen Length of the compressed data
+ * @param[out] consumed Number of input bytes that have been processed
+ * @param[out] output Buffer where to store the decompressed data
+ * @param[in] outputSize Size of the output buffer
+ * @param[out] written Number of bytes written to the output buffer
+ * @return Error code
+ **/
+
+error_t webSocketInflateDecompress(WebSocketInflateContext *context,
+   const uint8_t *input, size_t inputLen, size_t *consumed,
+   uint8_t *output, size_t outputSize, size_t *written)
+{
+   error_t error;
+   uint_t i;
+   uint_t n;
+   uint_t k;
+   uint_t value;
+   uint_t extraBits;
+   size_t pos;
+
+   //Initialize variables
+   error = NO_ERROR;
+   pos = 0;
+   *written = 0;
+
+   //Decompress as much data as possible
+   while(!error)
+   {
+      //Stored data are copied directly from the input
+      if(context->state != WS_INFLATE_STATE_STORED_DATA)
+      {
+         //Refill the bit buffer (a distance code and its extra bits may
+         //require up to 28 bits)
+         while(context->bitCount <= 56 && pos < inputLen)
+         {
+            context->bitBuffer |= (uint64_t) input[pos++] << context->bitCount;
+            context->bitCount += 8;
+         }
+      }
+
+      //Check current state
+      if(context->state == WS_INFLATE_STATE_BLOCK_HEADER)
+      {
+         //The last block of the stream has been processed?
+         if(context->finalBlock)
+         {
+            context->state = WS_INFLATE_STATE_DONE;
+         }
+         else if(context->bitCount < 3)
+         {
+            //More data required
+            error = ERROR_BUFFER_UNDERFLOW;
+         }
+         else
+         {
+            //Parse BFINAL and BTYPE fields
+            context->finalBlock = context->bitBuffer & 0x01;
+            value = (context->bitBuffer >> 1) & 0x03;
+            webSocketInflateDropBits(context, 3);
+
+            //Check block type
+            if(value == 0)
+            {
+               //Stored blocks are aligned on a byte boundary
+               webSocketInflateDropBits(context, context->bitCount & 0x07);
+               context->state = WS_INFLATE_STATE_STORED_HEADER;
+            }
+            else if(value == 1)
+            {
+               //Fixed literal/length code lengths
+               for(i = 0; i < 288; i++)
+               {
+                  if(i < 144)
+                     context->codeLengths[i] = 8;
+                  else if(i < 256)
+                     context->codeLengths[i] = 9;
+                  else if(i < 280)
+                     context->codeLengths[i] = 7;
+                  else
+                     context->codeLengths[i] = 8;
+               }
+
+               //Fixed distance code lengths
+               for(i = 0; i < 30; i++)
+               {
+                  context->codeLengths[288 + i] = 5;
+               }
+
+               //Build Huffman tables
+               webSocketInflateBuildTable(context->litLenCount,
+                  context->litLenSymbol, context->codeLengths, 288);
+
+               webSocketInflateBuildTable(context->distCount,
+                  context->distSymbol, context->codeLengths + 288, 30);
+
+               //Decode literal/length symbols
+               context->state = WS_INFLATE_STATE_LIT_LEN;
+            }
+            else if(value == 2)
+            {
+               //Parse the header of the dynamic block
+               context->state = WS_INFLATE_STATE_DYNAMIC_HEADER;
+            }
+            else
+            {
+               //Invalid block type
+               error = ERROR_INVALID_SYNTAX;
+            }
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_STORED_HEADER)
+      {
+         //The header consists of the LEN and NLEN fields
+         if(context->bitCount < 32)
+         {
+            //More data required
+            error = ERROR_BUFFER_UNDERFLOW;
+         }
+         else
+         {
+            //NLEN is the one's complement of LEN
+            value = context->bitBuffer & 0xFFFF;
+            n = (context->bitBuffer >> 16) & 0xFFFF;
+            webSocketInflateDropBits(context, 32);
+
+            //Check the consistency of the header
+            if(value == (~n & 0xFFFF))
+            {
+               context->length = value;
+               context->state = WS_INFLATE_STATE_STORED_DATA;
+            }
+            else
+            {
+               error = ERROR_INVALID_SYNTAX;
+            }
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_STORED_DATA)
+      {
+         //End of the stored block?
+         if(context->length == 0)
+         {
+            context->state = WS_INFLATE_STATE_BLOCK_HEADER;
+         }
+         else if(*written >= outputSize)
+         {
+            //The output buffer is full
+            error = ERROR_BUFFER_OVERFLOW;
+         }
+         else if(context->bitCount >= 8)
+         {
+            //Bytes that are already present in the bit buffer come first
+            webSocketInflatePutByte(context, context->bitBuffer & 0xFF,
+               output, written);
+
+            webSocketInflateDropBits(context, 8);
+            context->length--;
+         }
+         else if(pos < inputLen)
+         {
+            //Copy as many bytes as possible
+            n = MIN(context->length, inputLen - pos);
+            n = MIN(n, outputSize - *written);
+
+            for(i = 0; i < n; i++)
+            {
+               webSocketInflatePutByte(context, input[pos++], output, written);
+            }
+
+            context->length -= n;
+         }
+         else
+         {
+            //More data required
+            error = ERROR_BUFFER_UNDERFLOW;
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_DYNAMIC_HEADER)
+      {
+         //The header consists of the HLIT, HDIST and HCLEN fields
+         if(context->bitCount < 14)
+         {
+            //More data required
+            error = ERROR_BUFFER_UNDERFLOW;
+         }
+         else
+         {
+            //Parse HLIT, HDIST and HCLEN fields
+            context->numLitLenCodes = (context->bitBuffer & 0x1F) + 257;
+            context->numDistCodes = ((context->bitBuffer >> 5) & 0x1F) + 1;
+            context->numCodeLenCodes = ((context->bitBuffer >> 10) & 0x0F) + 4;
+            webSocketInflateDropBits(context, 14);
+
+            //Check the number of codes
+            if(context->numLitLenCodes <= 286 && context->numDistCodes <= 30)
+            {
+               context->index = 0;
+               context->state = WS_INFLATE_STATE_CODE_LEN_LENS;
+            }
+            else
+            {
+               error = ERROR_INVALID_SYNTAX;
+            }
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_CODE_LEN_LENS)
+      {
+         //Read code lengths for the code length alphabet
+         if(context->index < context->numCodeLenCodes)
+         {
+            //Each code length is represented by a 3-bit integer
+            if(context->bitCount < 3)
+            {
+               //More data required
+               error = ERROR_BUFFER_UNDERFLOW;
+            }
+            else
+            {
+               context->codeLengths[codeLenOrder[context->index++]] =
+                  context->bitBuffer & 0x07;
+
+               webSocketInflateDropBits(context, 3);
+            }
+         }
+         else
+         {
+            //Unused code lengths are zero
+            while(context->index < 19)
+            {
+               context->codeLengths[codeLenOrder[context->index++]] = 0;
+            }
+
+            //Build the code length Huffman table
+            error = webSocketInflateBuildTable(context->litLenCount,
+               context->litLenSymbol, context->codeLengths, 19);
+
+            //Read literal/length and distance code lengths
+            context->index = 0;
+            context->state = WS_INFLATE_STATE_CODE_LENS;
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_CODE_LENS)
+      {
+         //Total number of code lengths
+         k = context->numLitLenCodes + context->numDistCodes;
+
+         //Read literal/length and distance code lengths
+         if(context->index < k)
+         {
+            //Decode the next symbol
+            error = webSocketInflateDecodeSymbol(context, context->litLenCount,
+               context->litLenSymbol, &value, &n);
+
+            //Check status code
+            if(error)
+            {
+            }
+            else if(value < 16)
+            {
+               //Code lengths 0-15 are represented literally
+               context->codeLengths[context->index++] = value;
+               webSocketInflateDropBits(context, n);
+            }
+            else
+            {
+               //Symbols 16, 17 and 18 are followed by extra bits
+               extraBits = (value == 16) ? 2 : (value == 17) ? 3 : 7;
+
+               //Make sure the extra bits are available
+               if((n + extraBits) > context->bitCount)
+               {
+                  //More data required
+                  error = ERROR_BUFFER_UNDERFLOW;
+               }
+               else
+               {
+                  //Compute the repeat count
+                  i = (context->bitBuffer >> n) & ((1U << extraBits) - 1);
+                  i += (value == 16) ? 3 : (value == 17) ? 3 : 11;
+                  webSocketInflateDropBits(context, n + extraBits);
+
+                  //Symbol 16 repeats the previous code length
+                  if(value == 16 && context->index == 0)
+                  {
+                     error = ERROR_INVALID_SYNTAX;
+                  }
+                  else if((context->index + i) > k)
+                  {
+                     error = ERROR_INVALID_SYNTAX;
+                  }
+                  else
+                  {
+                     //Code length to be repeated
+                     value = (value == 16) ?
+                        context->codeLengths[context->index - 1] : 0;
+
+                     //Repeat the code length
+                     while(i-- > 0)
+                     {
+                        context->codeLengths[context->index++] = value;
+                     }
+                  }
+               }
+            }
+         }
+         else
+         {
+            //The end-of-block symbol must be present
+            if(context->codeLengths[256] == 0)
+            {
+               error = ERROR_INVALID_SYNTAX;
+            }
+
+            //Check status code
+            if(!error)
+            {
+               //Build the literal/length Huffman table
+               error = webSocketInflateBuildTable(context->litLenCount,
+                  context->litLenSymbol, context->codeLengths,
+                  context->numLitLenCodes);
+            }
+
+            //Check status code
+            if(!error)
+            {
+               //Build the distance Huffman table
+               error = webSocketInflateBuildTable(context->distCount,
+                  context->distSymbol, context->codeLengths +
+                  context->numLitLenCodes, context->numDistCodes);
+            }
+
+            //Decode literal/length symbols
+            context->state = WS_INFLATE_STATE_LIT_LEN;
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_LIT_LEN)
+      {
+         //Make sure the output buffer is not full
+         if(*written >= outputSize)
+         {
+            error = ERROR_BUFFER_OVERFLOW;
+         }
+         else
+         {
+            //Decode the next symbol
+            error = webSocketInflateDecodeSymbol(context, context->litLenCount,
+               context->litLenSymbol, &value, &n);
+         }
+
+         //Check status code
+         if(error)
+         {
+         }
+         else if(value < 256)
+         {
+            //Literal byte
+            webSocketInflatePutByte(context, value, output, written);
+            webSocketInflateDropBits(context, n);
+         }
+         else if(value == 256)
+         {
+            //End of block
+            webSocketInflateDropBits(context, n);
+            context->state = WS_INFLATE_STATE_BLOCK_HEADER;
+         }
+         else if(value < 286)
+         {
+            //Get the number of extra bits
+            value -= 257;
+            extraBits = lengthExtraBits[value];
+
+            //Make sure the extra bits are available
+            if((n + extraBits) > context->bitCount)
+            {
+               //More data required
+               error = ERROR_BUFFER_UNDERFLOW;
+            }
+            else
+            {
+               //Compute the length of the match
+               context->length = lengthBase[value] +
+                  ((context->bitBuffer >> n) & ((1U << extraBits) - 1));
+
+               //Decode the distance
+               webSocketInflateDropBits(context, n + extraBits);
+               context->state = WS_INFLATE_STATE_DIST;
+            }
+         }
+         else
+         {
+            //Invalid symbol
+            error = ERROR_INVALID_SYNTAX;
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_DIST)
+      {
+         //Decode the next symbol
+         error = webSocketInflateDecodeSymbol(context, context->distCount,
+            context->distSymbol, &value, &n);
+
+         //Check status code
+         if(error)
+         {
+         }
+         else if(value < 30)
+         {
+            //Get the number of extra bits
+            extraBits = distExtraBits[value];
+
+            //Make sure the extra bits are available
+            if((n + extraBits) > context->bitCount)
+            {
+               //More data required
+               error = ERROR_BUFFER_UNDERFLOW;
+            }
+            else
+            {
+               //Compute the distance of the match
+               context->distance = distBase[value] +
+                  ((context->bitBuffer >> n) & ((1U << extraBits) - 1));
+
+               webSocketInflateDropBits(context, n + extraBits);
+
+               //The distance cannot refer past the beginning of the window
+               if(context->distance <= context->windowLen)
+               {
+                  context->state = WS_INFLATE_STATE_COPY;
+               }
+               else
+               {
+                  error = ERROR_INVALID_SYNTAX;
+               }
+            }
+         }
+         else
+         {
+            //Invalid symbol
+            error = ERROR_INVALID_SYNTAX;
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_COPY)
+      {
+         //End of the match?
+         if(context->length == 0)
+         {
+            context->state = WS_INFLATE_STATE_LIT_LEN;
+         }
+         else if(*written >= outputSize)
+         {
+            //The output buffer is full
+            error = ERROR_BUFFER_OVERFLOW;
+         }
+         else
+         {
+            //Copy as many bytes as possible
+            n = MIN(context->length, outputSize - *written);
+
+            for(i = 0; i < n; i++)
+            {
+               webSocketInflatePutByte(context, context->window[
+                  (context->windowPos - context->distance) &
+                  (WEB_SOCKET_DEFLATE_WINDOW_SIZE - 1)], output, written);
+            }
+
+            context->length -= n;
+         }
+      }
+      else if(context->state == WS_INFLATE_STATE_DONE)
+      {
+         //Any data following the final block is ignored
+         pos = inputLen;
+         context->bitBuffer = 0;
+         context->bitCount = 0;
+
+         //Wait for the next message
+         error = ERROR_BUFFER_UNDERFLOW;
+      }
+      else
+      {
+         //Invalid state
+         error = ERROR_WRONG_STATE;
+      }
+   }
+
+   //Number of input bytes that have been processed
+   *consumed = pos;
+
+   //The decompressor stops when more input data is required or when the
+   //output buffer is full
+   if(error == ERROR_BUFFER_UNDERFLOW || error == ERROR_BUFFER_OVERFLOW)
+   {
+      error = NO_ERROR;
+   }
+
+   //Return status code
+   return error;
+}
+
+
+/**
+ * @brief Discard bits from the bit buffer
+ * @param[in] context Pointer to the decompression context
+ * @param[in] length Number of bits to discard
+ **/
+
+void webSocketInflateDropBits(WebSocketInflateContext *context, uint_t length)
+{
+   //Shift the bit buffer
+   if(length < 64)
+   {
+      context->bitBuffer >>= length;
+   }
+   else
+   {
+      context->bitBuffer = 0;
+   }
+
+   //Update the number of pending bits
+   context->bitCount -= length;
+}
+
+
+/**
+ * @brief Output a decompressed byte
+ * @param[in] context Pointer to the decompression context
+ * @param[in] value Decompressed byte
+ * @param[out] output Output buffer
+ * @param[in,out] written Number of bytes written to the output buffer
+ **/
+
+void webSocketInflatePutByte(WebSocketInflateContext *context, uint8_t value,
+   uint8_t *output, size_t *written)
+{
+   //Copy the byte to the output buffer
+   output[(*written)++] = value;
+
+   //Save the byte in the sliding window
+   context->window[context->windowPos] = value;
+
+   //Advance write position
+   context->windowPos = (context->windowPos + 1) &
+      (WEB_SOCKET_DEFLATE_WINDOW_SIZE - 1);
+
+   //Update the number of valid bytes in the sliding window
+   if(context->windowLen < WEB_SOCKET_DEFLATE_WINDOW_SIZE)
+   {
+      context->windowLen++;
+   }
+}
+
+
+/**
+ * @brief Build a canonical Huffman decoding table
+ * @param[out] count Number of codes of each length
+ * @param[out] symbol Symbols ordered by code
+ * @param[in] lengths Code length of each symbol
+ * @param[in] n Number of symbols
+ * @return Error code
+ **/
+
+error_t webSocketInflateBuildTable(uint16_t *count, uint16_t *symbol,
+   const uint8_t *lengths, uint_t n)
+{
+   uint_t i;
+   int_t left;
+   uint16_t offset[16];
+
+   //Count the number of codes of each length
+   osMemset(count, 0, 16 * sizeof(uint16_t));
+
+   for(i = 0; i < n; i++)
+   {
+      count[lengths[i]]++;
+   }
+
+   //Check for an over-subscribed set of lengths
+   for(left = 1, i = 1; i < 16; i++)
+   {
+      left = (left << 1) - count[i];
+
+      if(left < 0)
+         return ERROR_INVALID_SYNTAX;
+   }
+
+   //Compute the offset of the first symbol of each length
+   for(offset[1] = 0, i = 1; i < 15; i++)
+   {
+      offset[i + 1] = offset[i] + count[i];
+   }
+
+   //Sort symbols by code length
+   for(i = 0; i < n; i++)
+   {
+      if(lengths[i] != 0)
+      {
+         symbol[offset[lengths[i]]++] = i;
+      }
+   }
+
+   //Successful processing
+   return NO_ERROR;
+}
+
+
+/**
+ * @brief Decode a Huffman-encoded symbol
+ *
+ * The bits are not discarded from the bit buffer, so that the operation can
+ * be retried once more data is available
+ *
+ * @param[in] context Pointer to the decompression context
+ * @param[in] count Number of codes of each length
+ * @param[in] symbol Symbols ordered by code
+ * @param[out] value Decoded symbol
+ * @param[out] length Length of the code, in bits
+ * @return Error code
+ **/
+
+error_t webSocketInflateDecodeSymbol(WebSocketInflateContext *context,
+   const uint16_t *count, const uint16_t *symbol, uint_t *value,
+   uint_t *length)
+{
+   uint_t i;
+   int_t n;
+   int_t code;
+   int_t first;
+   int_t index;
+   uint64_t bits;
+
+   //Initialize variables
+   code = 0;
+   first = 0;
+   index = 0;
+   bits = context->bitBuffer;
+
+   //Huffman codes are packed starting with the most-significant bit
+   for(i = 1; i < 16; i++)
+   {
+      //More data required?
+      if(i > context->bitCount)
+         return ERROR_BUFFER_UNDERFLOW;
+
+      //Get the next bit of the code
+      code |= bits & 0x01;
+      bits >>= 1;
+
+      //Number of codes of the current length
+      n = count[i];
+
+      //Valid code?
+      if((code - n) < first)
+      {
+         *value = symbol[index + (code - first)];
+         *length = i;
+         return NO_ERROR;
+      }
+
+      //Process the next bit
+      index += n;
+      first = (first + n) << 1;
+      code <<= 1;
+   }
+
+   //Invalid code
+   return ERROR_INVALID_SYNTAX;
+}
+
+#endif
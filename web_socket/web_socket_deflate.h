@@ -0,0 +1,123 @@
+/**
+ * @file web_socket_deflate.h
+ * @brief WebSocket permessage-deflate extension (RFC 7692)
+ *
+ * @section License
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * Copyright (C) 2010-2026 Oryx Embedded SARL. All rights reserved.
+ *
+ * This file is part of CycloneTCP Open.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * @author Oryx Embedded SARL (www.oryx-embedded.com)
+ * @version 2.6.2
+ **/
+
+#ifndef _WEB_SOCKET_DEFLATE_H
+#define _WEB_SOCKET_DEFLATE_H
+
+//Dependencies
+#include "core/net.h"
+#include "web_socket/web_socket.h"
+
+//Minimum size of the LZ77 sliding window (base-2 logarithm)
+#define WEB_SOCKET_DEFLATE_MIN_WINDOW_BITS 8
+//Maximum size of the LZ77 sliding window (base-2 logarithm)
+#define WEB_SOCKET_DEFLATE_MAX_WINDOW_BITS 15
+
+//Minimum match length
+#define WEB_SOCKET_DEFLATE_MIN_MATCH 3
+//Maximum match length
+#define WEB_SOCKET_DEFLATE_MAX_MATCH 258
+
+//Room reserved for the frame header in front of the compressed data
+#define WEB_SOCKET_DEFLATE_HEADER_SIZE 14
+//RSV1 bit (compressed message)
+#define WEB_SOCKET_DEFLATE_RSV1 0x04
+
+//Hash function used to search for matches
+#define WEB_SOCKET_DEFLATE_HASH(p) ((((uint32_t) (p)[0] << 16) | \
+   ((uint32_t) (p)[1] << 8) | (p)[2]) * 0x9E3779B1U >> (32 - WEB_SOCKET_DEFLATE_HASH_BITS))
+
+//C++ guard
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//Permessage-deflate extension supported?
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+
+//Permessage-deflate related functions
+size_t webSocketAddExtensionsField(WebSocket *webSocket, char_t *output);
+error_t webSocketParseExtensionsField(WebSocket *webSocket, char_t *value);
+
+error_t webSocketParseDeflateOffer(WebSocket *webSocket, char_t *offer);
+error_t webSocketParseDeflateResponse(WebSocket *webSocket, char_t *response);
+
+error_t webSocketParseWindowBits(const char_t *value, uint_t *windowBits);
+
+void webSocketInitDeflate(WebSocket *webSocket);
+error_t webSocketFormatCompressedFrame(WebSocket *webSocket, bool_t fin);
+
+void webSocketDeflateInit(WebSocketDeflateContext *context,
+   uint_t windowBits, bool_t noContextTakeover);
+
+void webSocketDeflateStartMessage(WebSocketDeflateContext *context);
+
+error_t webSocketDeflateCompress(WebSocketDeflateContext *context,
+   const uint8_t *input, size_t inputLen, size_t *consumed,
+   uint8_t *output, size_t outputSize, size_t *written);
+
+error_t webSocketDeflateFlush(WebSocketDeflateContext *context,
+   uint8_t *output, size_t outputSize, size_t *written);
+
+void webSocketDeflateWriteBits(WebSocketDeflateContext *context,
+   uint32_t value, uint_t length, uint8_t *output, size_t *written);
+
+void webSocketDeflateWriteCode(WebSocketDeflateContext *context,
+   uint_t symbol, uint8_t *output, size_t *written);
+
+void webSocketInflateInit(WebSocketInflateContext *context,
+   uint_t windowBits, bool_t noContextTakeover);
+
+void webSocketInflateStartMessage(WebSocketInflateContext *context);
+
+error_t webSocketInflateDecompress(WebSocketInflateContext *context,
+   const uint8_t *input, size_t inputLen, size_t *consumed,
+   uint8_t *output, size_t outputSize, size_t *written);
+
+void webSocketInflateDropBits(WebSocketInflateContext *context, uint_t length);
+
+void webSocketInflatePutByte(WebSocketInflateContext *context, uint8_t value,
+   uint8_t *output, size_t *written);
+
+error_t webSocketInflateBuildTable(uint16_t *count, uint16_t *symbol,
+   const uint8_t *lengths, uint_t n);
+
+error_t webSocketInflateDecodeSymbol(WebSocketInflateContext *context,
+   const uint16_t *count, const uint16_t *symbol, uint_t *value,
+   uint_t *length);
+
+#endif
+
+//C++ guard
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -37,6 +37,7 @@
 #include "web_socket/web_socket_frame.h"
 #include "web_socket/web_socket_transport.h"
 #include "web_socket/web_socket_misc.h"
+#include "web_socket/web_socket_deflate.h"
 #include "debug.h"
 
 //Check TCP/IP stack configuration
@@ -179,9 +180,9 @@ error_t webSocketFormatFrameHeader(WebSocket *webSocket,
 error_t webSocketParseFrameHeader(WebSocket *webSocket,
    const WebSocketFrame *frame, WebSocketFrameType *type)
 {
-   size_t j;
    size_t k;
    size_t n;
+   uint_t reserved;
    uint16_t statusCode;
    WebSocketFrameContext *rxContext;
 
@@ -259,10 +260,39 @@ error_t webSocketParseFrameHeader(WebSocket *webSocket,
       webSocket->utf8Context.utf8CodePoint = 0;
    }
 
+   //Retrieve the RSV field
+   reserved = frame->reserved;
+
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   //First frame of a data message?
+   if(frame->opcode == WS_FRAME_TYPE_TEXT ||
+      frame->opcode == WS_FRAME_TYPE_BINARY)
+   {
+      //When the permessage-deflate extension is in use, the RSV1 bit of the
+      //first frame indicates whether the message is compressed
+      if(webSocket->handshakeContext.perMessageDeflate &&
+         (reserved & WEB_SOCKET_DEFLATE_RSV1) != 0)
+      {
+         //Prepare the decompression context for a new message
+         webSocketInflateStartMessage(&webSocket->inflateContext);
+
+         //The message is compressed
+         rxContext->compressed = TRUE;
+         rxContext->endOfMessage = FALSE;
+         reserved &= ~WEB_SOCKET_DEFLATE_RSV1;
+      }
+      else
+      {
+         //The message is not compressed
+         rxContext->compressed = FALSE;
+      }
+   }
+#endif
+
    //If the RSV field is a nonzero value and none of the negotiated extensions
    //defines the meaning of such a nonzero value, the receiving endpoint must
    //fail the WebSocket connection
-   if(frame->reserved != 0)
+   if(reserved != 0)
    {
       //Report a protocol error
       webSocket->statusCode = WS_STATUS_CODE_PROTOCOL_ERROR;
@@ -318,13 +348,8 @@ error_t webSocketParseFrameHeader(WebSocket *webSocket,
          if(frame->mask)
          {
             //Unmask the data
-            for(j = 0; j < rxContext->payloadLen; j++)
-            {
-               //Index of the masking key to be applied
-               k = j % 4;
-               //Convert masked data into unmasked data
-               *((uint8_t *) frame + n + j) ^= rxContext->maskingKey[k];
-            }
+            webSocketApplyMask((uint8_t *) frame + n, rxContext->payloadLen,
+               rxContext->maskingKey, 0);
          }
 
          //If there is a body, the first two bytes of the body must be
@@ -476,8 +501,8 @@ error_t webSocketFormatCloseFrame(WebSocket *webSocket)
       if(webSocket->endpoint == WS_ENDPOINT_CLIENT)
       {
          //Apply masking
-         p[0] ^= webSocket->txContext.maskingKey[0];
-         p[1] ^= webSocket->txContext.maskingKey[1];
+         webSocketApplyMask(p, sizeof(uint16_t),
+            webSocket->txContext.maskingKey, 0);
       }
 
       //Adjust the length of the frame
@@ -488,4 +513,71 @@ error_t webSocketFormatCloseFrame(WebSocket *webSocket)
    return error;
 }
 
+
+/**
+ * @brief Mask or unmask payload data
+ *
+ * The masking and unmasking transformations are identical. The data is
+ * processed a word at a time once the pointer has been aligned, using the
+ * masking key rotated according to the current position in the payload
+ *
+ * @param[in,out] data Pointer to the payload data
+ * @param[in] length Number of bytes to process
+ * @param[in] maskingKey 32-bit masking key
+ * @param[in] offset Position of the first byte within the frame payload
+ **/
+
+void webSocketApplyMask(uint8_t *data, size_t length,
+   const uint8_t *maskingKey, size_t offset)
+{
+   size_t i;
+   uint32_t mask;
+   uint32_t word;
+   uint8_t temp[4];
+
+   //Process the leading bytes until the pointer is aligned on a 32-bit
+   //boundary
+   while(length > 0 && ((uintptr_t) data % sizeof(uint32_t)) != 0)
+   {
+      //Octet i of the transformed data is the XOR of octet i of the original
+      //data with octet at index i modulo 4 of the masking key
+      *(data++) ^= maskingKey[(offset++) % 4];
+      length--;
+   }
+
+   //Any data left to process?
+   if(length >= sizeof(uint32_t))
+   {
+      //Rotate the masking key so that it lines up with the current position
+      for(i = 0; i < 4; i++)
+      {
+         temp[i] = maskingKey[(offset + i) % 4];
+      }
+
+      //Load the rotated masking key in native byte order
+      osMemcpy(&mask, temp, sizeof(uint32_t));
+
+      //Process the data a word at a time. The word is copied to a local
+      //variable so that the buffer is never accessed through a uint32_t
+      //pointer
+      while(length >= sizeof(uint32_t))
+      {
+         osMemcpy(&word, data, sizeof(uint32_t));
+         word ^= mask;
+         osMemcpy(data, &word, sizeof(uint32_t));
+
+         //Next word
+         data += sizeof(uint32_t);
+         length -= sizeof(uint32_t);
+      }
+   }
+
+   //Process the trailing bytes
+   while(length > 0)
+   {
+      *(data++) ^= maskingKey[(offset++) % 4];
+      length--;
+   }
+}
+
 #endif
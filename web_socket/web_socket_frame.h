@@ -49,6 +49,9 @@ error_t webSocketParseFrameHeader(WebSocket *webSocket,
 
 error_t webSocketFormatCloseFrame(WebSocket *webSocket);
 
+void webSocketApplyMask(uint8_t *data, size_t length,
+   const uint8_t *maskingKey, size_t offset);
+
 //C++ guard
 #ifdef __cplusplus
 }
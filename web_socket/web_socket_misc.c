@@ -39,6 +39,7 @@
 #include "web_socket/web_socket_frame.h"
 #include "web_socket/web_socket_transport.h"
 #include "web_socket/web_socket_misc.h"
+#include "web_socket/web_socket_deflate.h"
 #include "encoding/base64.h"
 #include "hash/sha1.h"
 #include "str.h"
@@ -153,6 +154,10 @@ error_t webSocketParseHandshake(WebSocket *webSocket)
          webSocket->handshakeContext.closingFrameSent = FALSE;
          webSocket->handshakeContext.closingFrameReceived = FALSE;
 
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+         webSocket->handshakeContext.perMessageDeflate = FALSE;
+#endif
+
 #if (WEB_SOCKET_BASIC_AUTH_SUPPORT == ENABLED || WEB_SOCKET_DIGEST_AUTH_SUPPORT == ENABLED)
          webSocket->authContext.requiredAuthMode = WS_AUTH_MODE_NONE;
 #endif
@@ -513,6 +518,7 @@ error_t webSocketParseStatusLine(WebSocket *webSocket, char_t *line)
 
 error_t webSocketParseHeaderField(WebSocket *webSocket, char_t *line)
 {
+   error_t error;
    char_t *separator;
    char_t *name;
    char_t *value;
@@ -521,6 +527,9 @@ error_t webSocketParseHeaderField(WebSocket *webSocket, char_t *line)
    //Point to the handshake context
    handshakeContext = &webSocket->handshakeContext;
 
+   //Initialize status code
+   error = NO_ERROR;
+
    //Debug message
    TRACE_DEBUG("%s", line);
 
@@ -572,6 +581,14 @@ error_t webSocketParseHeaderField(WebSocket *webSocket, char_t *line)
                WEB_SOCKET_SERVER_KEY_SIZE + 1);
          }
       }
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+      //Sec-WebSocket-Extensions header field found?
+      else if(osStrcasecmp(name, "Sec-WebSocket-Extensions") == 0)
+      {
+         //Parse Sec-WebSocket-Extensions header field
+         error = webSocketParseExtensionsField(webSocket, value);
+      }
+#endif
 #if (WEB_SOCKET_BASIC_AUTH_SUPPORT == ENABLED || WEB_SOCKET_DIGEST_AUTH_SUPPORT == ENABLED)
       //WWW-Authenticate header field found?
       else if(osStrcasecmp(name, "WWW-Authenticate") == 0)
@@ -587,8 +604,8 @@ error_t webSocketParseHeaderField(WebSocket *webSocket, char_t *line)
       }
    }
 
-   //Successful processing
-   return NO_ERROR;
+   //Return status code
+   return error;
 }
 
 
@@ -702,6 +719,11 @@ error_t webSocketFormatClientHandshake(WebSocket *webSocket, uint16_t serverPort
    p += osSprintf(p, "Sec-WebSocket-Key: %s\r\n",
       webSocket->handshakeContext.clientKey);
 
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   //Add Sec-WebSocket-Extensions header field
+   p += webSocketAddExtensionsField(webSocket, p);
+#endif
+
    //Add Sec-WebSocket-Version header field
    p += osSprintf(p, "Sec-WebSocket-Version: 13\r\n");
    //An empty line indicates the end of the header fields
@@ -754,6 +776,13 @@ error_t webSocketFormatServerHandshake(WebSocket *webSocket)
    p += osSprintf(p, "Sec-WebSocket-Accept: %s\r\n",
       webSocket->handshakeContext.serverKey);
 
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   //Add Sec-WebSocket-Extensions header field
+   p += webSocketAddExtensionsField(webSocket, p);
+   //Initialize compression and decompression contexts
+   webSocketInitDeflate(webSocket);
+#endif
+
    //An empty line indicates the end of the header fields
    p += osSprintf(p, "\r\n");
 
@@ -952,6 +981,11 @@ error_t webSocketVerifyServerHandshake(WebSocket *webSocket)
    if(error)
       return error;
 
+#if (WEB_SOCKET_DEFLATE_SUPPORT == ENABLED)
+   //Initialize compression and decompression contexts
+   webSocketInitDeflate(webSocket);
+#endif
+
    //If the server's response is validated as provided for above, it is
    //said that the WebSocket connection is established and that the
    //WebSocket connection is in the OPEN state